@@ -0,0 +1,37 @@
+#include "pch.h"
+#include "../../src/OptimusBot/BookAnalytics.h"
+#include "../../src/OptimusBot/FastRandom.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+
+namespace BookAnalyticsBenchmarks
+{
+	// Tick of a book of the given depth on each side, all its levels accumulated: the best bid changes volume, then the features are updated
+	void BM_BookAnalyticsUpdate(benchmark::State& state)
+	{
+		const auto depth = static_cast<std::size_t>(state.range(0));
+		FastRandom random{ 42 };
+		OrderBook book;
+		for (std::size_t i = 0; i < depth; i++)
+		{
+			book.Apply(LevelDelta{ OrderSide::BID, LevelAction::ADD, Price{ 200.0 - 0.01 * i }, Quantity{ random.NextDouble(0.1, 50.0) } });
+			book.Apply(LevelDelta{ OrderSide::ASK, LevelAction::ADD, Price{ 200.01 + 0.01 * i }, Quantity{ random.NextDouble(0.1, 50.0) } });
+		}
+
+		BookAnalyticsConfig config;
+		config.DepthLevels = depth;
+		BookAnalytics analytics{ config };
+
+		std::uint64_t tick = 0;
+		for (auto _ : state)
+		{
+			book.Apply(LevelDelta{ OrderSide::BID, LevelAction::CHANGE, Price{ 200.0 }, Quantity{ 1.0 + (tick++ & 7) } });
+			benchmark::DoNotOptimize(analytics.Update(book));
+			benchmark::DoNotOptimize(analytics.GetFeatures().RollingVwap);
+		}
+
+		state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+	}
+	BENCHMARK(BM_BookAnalyticsUpdate)->ArgName("depth")->Arg(10)->Arg(100)->Arg(1000);
+}
@@ -0,0 +1,66 @@
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include "../../src/OptimusBot/BookJson.h"
+#include "../../src/OptimusBot/FastRandom.h"
+
+using namespace OptimusBot;
+
+namespace BookJsonBenchmarks
+{
+	// Payload of a book of the given depth on each side, prices and volumes having the digits returned by the API
+	std::string MakePayload(std::size_t depth)
+	{
+		FastRandom random{ 42 };
+		IDvfSimulator::OrderBook orderBook;
+		for (std::size_t i = 0; i < depth; i++)
+		{
+			orderBook.emplace_back(std::round((200.0 - 0.1 * i) * 100.0) / 100.0, std::round(random.NextDouble(0.1, 50.0) * 1e6) / 1e6);
+			orderBook.emplace_back(std::round((200.1 + 0.1 * i) * 100.0) / 100.0, -std::round(random.NextDouble(0.1, 50.0) * 1e6) / 1e6);
+		}
+
+		std::string json;
+		BookJson::Write(orderBook, json);
+		return json;
+	}
+
+	// Parse of a whole payload into a reused book
+	void BM_BookJsonParse(benchmark::State& state)
+	{
+		const auto json = MakePayload(static_cast<std::size_t>(state.range(0)));
+		IDvfSimulator::OrderBook orderBook;
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(BookJson::Parse(json, orderBook));
+			benchmark::DoNotOptimize(orderBook.data());
+		}
+
+		state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * orderBook.size()));
+		state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * json.size()));
+	}
+	BENCHMARK(BM_BookJsonParse)->ArgName("depth")->Arg(10)->Arg(100)->Arg(1000);
+
+	// Same payload received in chunks of a typical TCP segment
+	void BM_BookJsonStreamingParse(benchmark::State& state)
+	{
+		constexpr std::size_t chunkSize = 1460;
+		const auto json = MakePayload(static_cast<std::size_t>(state.range(0)));
+		BookJson::StreamingParser parser;
+		IDvfSimulator::OrderBook orderBook;
+
+		for (auto _ : state)
+		{
+			for (std::size_t offset = 0; offset < json.size(); offset += chunkSize)
+			{
+				std::string_view chunk{ json.data() + offset, std::min(chunkSize, json.size() - offset) };
+				benchmark::DoNotOptimize(parser.Feed(chunk, orderBook));
+			}
+		}
+
+		state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * orderBook.size()));
+		state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * json.size()));
+	}
+	BENCHMARK(BM_BookJsonStreamingParse)->ArgName("depth")->Arg(100)->Arg(1000);
+}
@@ -0,0 +1,50 @@
+#include "pch.h"
+#include "../../src/OptimusBot/Bot.ipp"
+#include "../../src/OptimusBot/MarketModelSimulator.h"
+
+using namespace OptimusBot;
+
+namespace BotBenchmarks
+{
+	// Full market refresh of a bot: pulling the book, diffing and applying it, extracting the best order,
+	// erasing the filled orders and updating the wallet. The market reverts around its initial mid,
+	// so that few of the initial orders are filled over the run. The wallet grows with the number of orders, the strategy
+	// not placing orders of less than 1 ETH
+	template <typename BotType>
+	void RunBotTick(benchmark::State& state)
+	{
+		const auto numberOfOrders = static_cast<int>(state.range(1));
+
+		MarketModelConfig config;
+		config.Depth = static_cast<std::size_t>(state.range(0));
+		config.LevelSpacing = 0.01;
+		auto simulator = std::make_unique<MarketModelSimulator>(config,
+			std::make_unique<MeanRevertingProcess>(config.InitialMid, 50.0, 5.0, 1.0 / (365.0 * 24.0 * 720.0)));
+
+		BotType bot{ std::move(simulator), 2.0 * numberOfOrders, 1000.0 * numberOfOrders };
+		if (!bot.PlaceInitialOrders(numberOfOrders))
+		{
+			state.SkipWithError("The initial orders could not be placed");
+			return;
+		}
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(bot.RefreshMarket());
+
+		state.counters["PendingOrders"] = static_cast<double>(bot.GetPendingOrderCount());
+	}
+
+	void BM_BotTick(benchmark::State& state)
+	{
+		RunBotTick<Bot>(state);
+	}
+	BENCHMARK(BM_BotTick)->ArgNames({ "depth", "orders" })->ArgsProduct({ { 10, 100, 1000, 10000, 100000 }, { 5, 50, 500 } });
+
+	// Same tick on a bot compiled against the market model rather than against IDvfSimulator, the simulator's calls being resolved
+	// (and inlined) at compile time
+	void BM_BotTickDevirtualized(benchmark::State& state)
+	{
+		RunBotTick<BasicBot<DirectGateway<MarketModelSimulator>, PrudentStrategy, IClock>>(state);
+	}
+	BENCHMARK(BM_BotTickDevirtualized)->ArgNames({ "depth", "orders" })->ArgsProduct({ { 10, 100, 1000, 10000, 100000 }, { 5, 50, 500 } });
+}
@@ -0,0 +1,63 @@
+#include "pch.h"
+#include <cstdio>
+#include <string>
+#include "../../src/OptimusBot/Journal.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+
+namespace JournalBenchmarks
+{
+	// Appending the events of a tick: a few placements and fills, then the wallet (without flushing, which is bound by the disk)
+	void BM_JournalAppend(benchmark::State& state)
+	{
+		const std::string path = "JournalBenchmarks.Append.log";
+		std::remove(path.c_str());
+		std::remove((path + ".snapshot").c_str());
+		{
+			Journal journal{ path, JournalConfig{ 1024 * 1024, 4096, false } };
+			IDvfSimulator::OrderID orderId = 0;
+			for (auto _ : state)
+			{
+				journal.RecordPlaced({ OrderSide::BID, ++orderId, Price{ 190.0 }, Quantity{ 1.0 } });
+				journal.RecordFilled(orderId);
+				journal.RecordWallet(Wallet{ 10.0, 2000.0 });
+				journal.Commit();
+			}
+			state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * 3));
+		}
+		std::remove(path.c_str());
+	}
+	BENCHMARK(BM_JournalAppend);
+
+	// Warm restart: opening a journal whose log holds the given number of records, half of the orders placed still pending
+	void BM_JournalRecover(benchmark::State& state)
+	{
+		const std::string path = "JournalBenchmarks.Recover.log";
+		const auto records = static_cast<IDvfSimulator::OrderID>(state.range(0));
+		std::remove(path.c_str());
+		std::remove((path + ".snapshot").c_str());
+		{
+			Journal journal{ path, JournalConfig{ 1024 * 1024, 4096, false } };
+			for (IDvfSimulator::OrderID orderId = 1; orderId <= records / 2; orderId++)
+			{
+				journal.RecordPlaced({ OrderSide::BID, orderId, Price{ 190.0 }, Quantity{ 1.0 } });
+				if (orderId % 2 == 0)
+					journal.RecordFilled(orderId);
+				else
+					journal.RecordWallet(Wallet{ 10.0, 2000.0 });
+			}
+			journal.Commit();
+		}
+
+		for (auto _ : state)
+		{
+			const Journal journal{ path, JournalConfig{ 1024 * 1024, 4096, false } };
+			benchmark::DoNotOptimize(journal.GetRecoveredState().PendingOrders.size());
+		}
+
+		state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * records));
+		std::remove(path.c_str());
+	}
+	BENCHMARK(BM_JournalRecover)->ArgName("records")->Arg(4096)->Arg(100000)->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,51 @@
+#include "pch.h"
+#include "../../src/OptimusBot/MarketDataPublisher.h"
+#include "../../src/OptimusBot/MarketModelSimulator.h"
+
+using namespace OptimusBot;
+
+namespace MarketDataBenchmarks
+{
+	MarketDataPublisher& SharedPublisher()
+	{
+		static MarketDataPublisher publisher{ std::make_unique<MarketModelSimulator>(MarketModelConfig{}, std::make_unique<RandomWalkProcess>(1.0, 1.0 / 3.0)) };
+		return publisher;
+	}
+
+	// Poll of the market and publication of its book, paid once per refresh whatever the number of readers
+	void BM_MarketDataPublish(benchmark::State& state)
+	{
+		auto& publisher = SharedPublisher();
+		for (auto _ : state)
+			benchmark::DoNotOptimize(publisher.Publish());
+	}
+	BENCHMARK(BM_MarketDataPublish);
+
+	// Read of the best levels by each of the bots sharing the market, which should not slow down as bots are added
+	void BM_MarketDataTopOfBookRead(benchmark::State& state)
+	{
+		auto& publisher = SharedPublisher();
+		if (state.thread_index() == 0)
+			publisher.Publish();
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(publisher.GetTopOfBook());
+	}
+	BENCHMARK(BM_MarketDataTopOfBookRead)->ThreadRange(1, 8);
+
+	// Same, for a consistent copy of the whole depth published
+	void BM_MarketDataSnapshotRead(benchmark::State& state)
+	{
+		auto& publisher = SharedPublisher();
+		if (state.thread_index() == 0)
+			publisher.Publish();
+
+		MarketDataSnapshot snapshot;
+		for (auto _ : state)
+		{
+			publisher.GetSnapshot(snapshot);
+			benchmark::DoNotOptimize(snapshot.BidCount);
+		}
+	}
+	BENCHMARK(BM_MarketDataSnapshotRead)->ThreadRange(1, 8);
+}
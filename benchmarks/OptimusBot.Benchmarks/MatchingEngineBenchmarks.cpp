@@ -0,0 +1,105 @@
+#include "pch.h"
+#include "../../src/OptimusBot/Bot.h"
+#include "../../src/OptimusBot/FastRandom.h"
+#include "../../src/OptimusBot/MatchingEngineSimulator.h"
+#include "../../src/OptimusBot/StreamingMarketSimulator.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+
+namespace MatchingEngineBenchmarks
+{
+	// Steady order flow on a book holding the given number of resting orders: each iteration submits a limit order
+	// (matching when it crosses) and, if the book grew, cancels a resting one picked at random
+	void BM_MatchingEngineFlow(benchmark::State& state)
+	{
+		const auto restingOrders = static_cast<std::size_t>(state.range(0));
+
+		MatchingEngine engine;
+		FastRandom random{ 42 };
+		std::vector<MatchingEngine::Trade> trades;
+		std::vector<MatchingEngine::OrderHandle> handles;
+		handles.reserve(2 * restingOrders);
+
+		const auto submit = [&]() {
+			const auto isBid = random.NextDouble() < 0.5;
+			const auto price = isBid ? random.NextDouble(150.0, 200.05) : random.NextDouble(199.95, 250.0);
+			const auto result = engine.Submit(isBid ? OrderSide::BID : OrderSide::ASK, Price{ price }, Quantity{ random.NextDouble(0.1, 2.0) }, OrderType::LIMIT, trades);
+			if (result.Resting)
+				handles.push_back(result.Resting.value());
+		};
+
+		while (engine.GetOrderCount() < restingOrders)
+			submit();
+
+		std::int64_t operations = 0;
+		for (auto _ : state)
+		{
+			trades.clear();
+			submit();
+			operations++;
+
+			// Keeps the book at its size, the handles of the orders filled since being skipped
+			while (engine.GetOrderCount() > restingOrders && !handles.empty())
+			{
+				const auto index = static_cast<std::size_t>(random() % handles.size());
+				const auto cancelled = engine.Cancel(handles[index]);
+				handles[index] = handles.back();
+				handles.pop_back();
+				operations += cancelled ? 1 : 0;
+			}
+		}
+
+		state.SetItemsProcessed(operations);
+		state.counters["RestingOrders"] = static_cast<double>(engine.GetOrderCount());
+	}
+	BENCHMARK(BM_MatchingEngineFlow)->ArgName("resting")->Arg(1000)->Arg(100000)->Arg(1000000);
+
+	// Snapshot of the simulator backed by the engine: a hundred events of order flow, then the aggregation of the top levels
+	void BM_MatchingEngineSimulatorSnapshot(benchmark::State& state)
+	{
+		MatchingSimulatorConfig config;
+		config.InitialOrders = static_cast<std::size_t>(state.range(0));
+		MatchingEngineSimulator simulator{ config, std::make_unique<RandomWalkProcess>(0.0, 0.5) };
+		IDvfSimulator::OrderBook orderBook;
+
+		for (auto _ : state)
+		{
+			simulator.GetOrderBook(orderBook);
+			benchmark::DoNotOptimize(orderBook.data());
+		}
+
+		state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * config.EventsPerSnapshot));
+	}
+	BENCHMARK(BM_MatchingEngineSimulatorSnapshot)->ArgName("initial")->Arg(1000)->Arg(100000);
+
+	// Refresh of a bot on a market pushing its events: the order flow of a snapshot, each fill and level change being queued by the bot
+	// as it happens and processed by the refresh. The per-event cost is the time the bot takes to react to a fill, against up to a poll interval when fills are inferred
+	void BM_BotStreamingTick(benchmark::State& state)
+	{
+		MatchingSimulatorConfig config;
+		config.Seed = 1;
+		auto simulator = std::make_unique<StreamingMarketSimulator>(config, std::make_unique<RandomWalkProcess>(0.05, 0.5));
+		auto& market = *simulator;
+		const auto& statistics = market.GetStatistics();
+
+		Bot bot{ std::move(simulator), 100.0, 50000.0 };
+		if (!bot.PlaceInitialOrders(static_cast<int>(state.range(0))))
+		{
+			state.SkipWithError("The initial orders could not be placed");
+			return;
+		}
+
+		const auto initialEvents = statistics.Fills + statistics.Cancels + statistics.BookChanges;
+		for (auto _ : state)
+		{
+			market.GenerateFlow();
+			benchmark::DoNotOptimize(bot.RefreshMarket());
+		}
+
+		state.SetItemsProcessed(static_cast<std::int64_t>(statistics.Fills + statistics.Cancels + statistics.BookChanges - initialEvents));
+		state.counters["Fills"] = static_cast<double>(statistics.Fills);
+		state.counters["PendingOrders"] = static_cast<double>(bot.GetPendingOrderCount());
+	}
+	BENCHMARK(BM_BotStreamingTick)->ArgName("orders")->Arg(5)->Arg(50);
+}
@@ -0,0 +1,114 @@
+#include "pch.h"
+#include <set>
+#include <vector>
+#include "../../src/OptimusBot/FastRandom.h"
+#include "../../src/OptimusBot/PendingOrders.h"
+#include "../../src/OptimusBot/Utilities.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+using namespace OptimusBot::Utilities;
+
+namespace UtilitiesBenchmarks
+{
+	// Book of the given depth on each side around a 200 mid, in random order like the simulator's
+	IDvfSimulator::OrderBook MakeOrderBook(std::size_t depth)
+	{
+		FastRandom random{ 42 };
+		IDvfSimulator::OrderBook orderBook;
+		orderBook.reserve(2 * depth);
+		for (std::size_t i = 0; i < depth; i++)
+		{
+			orderBook.emplace_back(Random(100.0, 195.0, random), Random(0.1, 2.5, random));
+			orderBook.emplace_back(Random(205.0, 300.0, random), -Random(0.1, 2.5, random));
+		}
+		return orderBook;
+	}
+
+	// Orders resting away from a 200 mid, half bids and half asks, none of them filled by the best order used below
+	std::vector<BotOrder> MakeRestingOrders(std::size_t count)
+	{
+		std::vector<BotOrder> orders;
+		orders.reserve(count);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			const auto offset = 1.0 + 50.0 * static_cast<double>(i) / static_cast<double>(count);
+			if (i % 2 == 0)
+				orders.emplace_back(OrderSide::BID, static_cast<IDvfSimulator::OrderID>(i), Price{ 190.0 - offset }, Quantity{ 0.1 });
+			else
+				orders.emplace_back(OrderSide::ASK, static_cast<IDvfSimulator::OrderID>(i), Price{ 210.0 + offset }, Quantity{ 0.1 });
+		}
+		return orders;
+	}
+
+	void BM_ExtractBestOrder(benchmark::State& state)
+	{
+		const auto orderBook = MakeOrderBook(static_cast<std::size_t>(state.range(0)));
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(ExtractBestOrder(orderBook));
+
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(orderBook.size()));
+	}
+	BENCHMARK(BM_ExtractBestOrder)->RangeMultiplier(10)->Range(10, 100000);
+
+	// Scans the pending orders without filling any of them, the common case of a tick
+	void BM_EraseFilledOrders(benchmark::State& state)
+	{
+		const auto restingOrders = MakeRestingOrders(static_cast<std::size_t>(state.range(0)));
+		std::multiset<BotOrder> orders{ restingOrders.begin(), restingOrders.end() };
+		const BestOrder bestOrder{ Price{ 195.0 }, Price{ 205.0 } };
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(EraseFilledOrders(orders, bestOrder));
+	}
+	BENCHMARK(BM_EraseFilledOrders)->RangeMultiplier(10)->Range(10, 100000);
+
+	// Same as above through the store used by the bot
+	void BM_PendingOrdersEraseFilled(benchmark::State& state)
+	{
+		PendingOrders orders;
+		for (const auto& order : MakeRestingOrders(static_cast<std::size_t>(state.range(0))))
+			orders.Insert(order);
+		const BestOrder bestOrder{ Price{ 195.0 }, Price{ 205.0 } };
+		std::vector<BotOrder> filledOrders;
+
+		for (auto _ : state)
+		{
+			orders.EraseFilled(bestOrder, filledOrders);
+			benchmark::DoNotOptimize(filledOrders.data());
+		}
+	}
+	BENCHMARK(BM_PendingOrdersEraseFilled)->RangeMultiplier(10)->Range(10, 100000);
+
+	void BM_UpdateWallet(benchmark::State& state)
+	{
+		const auto filledOrders = MakeRestingOrders(static_cast<std::size_t>(state.range(0)));
+		Wallet wallet{ 10.0, 2000.0 };
+
+		for (auto _ : state)
+		{
+			UpdateWallet(wallet, filledOrders);
+			benchmark::DoNotOptimize(wallet);
+		}
+
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(filledOrders.size()));
+	}
+	BENCHMARK(BM_UpdateWallet)->RangeMultiplier(10)->Range(10, 100000);
+
+	// Builds the requests and hands them to a gateway accepting them all, isolating the strategy from the venue
+	void BM_PlacePrudentOrders(benchmark::State& state)
+	{
+		const Wallet wallet{ 10.0, 2000.0 };
+		const BestOrder bestOrder{ Price{ 195.0 }, Price{ 205.0 } };
+		const auto numberOfOrders = static_cast<int>(state.range(0));
+		IDvfSimulator::OrderID nextOrderId = 0;
+		const auto gateway = [&nextOrderId](double, double) { return std::optional<IDvfSimulator::OrderID>{ nextOrderId++ }; };
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(PlacePrudentOrders(wallet, bestOrder, numberOfOrders, gateway));
+
+		state.SetItemsProcessed(state.iterations() * 2 * numberOfOrders);
+	}
+	BENCHMARK(BM_PlacePrudentOrders)->RangeMultiplier(10)->Range(1, 1000);
+}
@@ -0,0 +1,16 @@
+#include "pch.h"
+#include "../../src/OptimusBot/Logger.h"
+
+// The bot logs its fills and assets, which would otherwise be measured as well
+int main(int argc, char** argv)
+{
+	OptimusBot::Logging::Logger::Instance().SetLevel(OptimusBot::Logging::Level::OFF);
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
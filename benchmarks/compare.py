@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""Compares two Google Benchmark JSON outputs, e.g. a run of OptimusBot.Benchmarks against the stored baseline.
+
+Usage: compare.py <baseline.json> <current.json> [--threshold 0.10] [--metric cpu_time|real_time]
+
+Prints the relative change of every benchmark present in both files and exits with status 1
+if any of them got slower than the threshold, so that the comparison can gate a pipeline.
+"""
+
+import argparse
+import json
+import sys
+
+# Google Benchmark reports times in the unit of each benchmark
+UNIT_TO_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path, metric):
+    """Maps the benchmark names to their time in nanoseconds, preferring the mean when repetitions were run."""
+    with open(path) as file:
+        benchmarks = json.load(file)["benchmarks"]
+
+    times = {}
+    for benchmark in benchmarks:
+        if benchmark.get("error_occurred"):
+            continue
+
+        run_type = benchmark.get("run_type", "iteration")
+        if run_type == "aggregate" and benchmark.get("aggregate_name") != "mean":
+            continue
+
+        name = benchmark.get("run_name", benchmark["name"])
+        if run_type == "iteration" and name in times:
+            continue  # Repetitions without aggregates: the first one is kept
+
+        times[name] = benchmark[metric] * UNIT_TO_NS[benchmark.get("time_unit", "ns")]
+
+    return times
+
+
+def format_ns(value):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if value >= scale:
+            return f"{value / scale:.2f} {unit}"
+    return f"{value:.1f} ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.10, help="relative slowdown reported as a regression (default: 0.10)")
+    parser.add_argument("--metric", choices=("cpu_time", "real_time"), default="cpu_time")
+    arguments = parser.parse_args()
+
+    baseline = load(arguments.baseline, arguments.metric)
+    current = load(arguments.current, arguments.metric)
+
+    names = [name for name in current if name in baseline]
+    width = max((len(name) for name in names), default=9)
+    print(f"{'Benchmark':<{width}}  {'Baseline':>12}  {'Current':>12}  {'Change':>8}")
+
+    regressions = []
+    for name in names:
+        change = current[name] / baseline[name] - 1.0 if baseline[name] > 0 else 0.0
+        flag = ""
+        if change > arguments.threshold:
+            flag = "  REGRESSION"
+            regressions.append(name)
+        elif change < -arguments.threshold:
+            flag = "  improvement"
+        print(f"{name:<{width}}  {format_ns(baseline[name]):>12}  {format_ns(current[name]):>12}  {change:>+8.1%}{flag}")
+
+    for name in sorted(set(baseline) - set(current)):
+        print(f"{name}: missing from the current run")
+    for name in sorted(set(current) - set(baseline)):
+        print(f"{name}: not in the baseline")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) slower than the baseline by more than {arguments.threshold:.0%}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,269 @@
+#include "pch.h"
+#include <algorithm>
+#include "AsyncOrderGateway.h"
+#include "Logger.h"
+
+using namespace OptimusBot::Types;
+
+
+OptimusBot::AsyncOrderGateway::AsyncOrderGateway(SimulatorPtr&& simulator, const AsyncGatewayConfig& config)
+    : m_Simulator{ std::move(simulator) }, m_Config{ config }
+{
+    const auto senders = std::max<std::size_t>(m_Config.MaxInFlight, 1);
+    m_Senders.reserve(senders);
+    for (std::size_t i = 0; i < senders; i++)
+        m_Senders.emplace_back([this]() { Send(); });
+
+    m_Watchdog = std::thread{ [this]() { Watch(); } };
+}
+
+
+OptimusBot::AsyncOrderGateway::~AsyncOrderGateway() noexcept
+{
+    {
+        const std::lock_guard<std::mutex> lock{ m_Mutex };
+        m_Stopping = true;
+
+        for (const auto& request : m_Queue)
+            Fail(*request);
+        m_Queue.clear();
+    }
+
+    m_RequestQueued.notify_all();
+    m_RequestProcessed.notify_all();
+    m_WatchUpdated.notify_all();
+
+    for (auto& sender : m_Senders)
+        sender.join();
+    m_Watchdog.join();
+}
+
+
+std::future<std::optional<IDvfSimulator::OrderID>> OptimusBot::AsyncOrderGateway::PlaceOrderAsync(double price, double amount)
+{
+    auto request = std::make_shared<Request>();
+    request->Price = price;
+    request->Amount = amount;
+
+    auto future = request->Placed.get_future();
+    Submit(std::move(request));
+    return future;
+}
+
+
+std::future<bool> OptimusBot::AsyncOrderGateway::CancelOrderAsync(OrderID oid)
+{
+    auto request = std::make_shared<Request>();
+    request->IsCancel = true;
+    request->Oid = oid;
+
+    auto future = request->Cancelled.get_future();
+    Submit(std::move(request));
+    return future;
+}
+
+
+IDvfSimulator::OrderBook OptimusBot::AsyncOrderGateway::GetOrderBook() noexcept
+{
+    const auto lock = LockSimulator();
+    return m_Simulator->GetOrderBook();
+}
+
+
+void OptimusBot::AsyncOrderGateway::GetOrderBook(OrderBook& orderBook) noexcept
+{
+    const auto lock = LockSimulator();
+    OptimusBot::GetOrderBook(*m_Simulator, orderBook);
+}
+
+
+std::optional<IDvfSimulator::OrderID> OptimusBot::AsyncOrderGateway::PlaceOrder(double price, double amount) noexcept
+{
+    return PlaceOrderAsync(price, amount).get();
+}
+
+
+bool OptimusBot::AsyncOrderGateway::CancelOrder(OrderID oid) noexcept
+{
+    return CancelOrderAsync(oid).get();
+}
+
+
+void OptimusBot::AsyncOrderGateway::PlaceOrders(const OrderRequest* requests, std::size_t count, std::optional<OrderID>* orderIds) noexcept
+{
+    // All the requests are sent before waiting for the first response, the responses being correlated by index
+    std::vector<std::future<std::optional<OrderID>>> responses;
+    responses.reserve(count);
+    for (std::size_t i = 0; i < count; i++)
+        responses.push_back(PlaceOrderAsync(requests[i].Price.ToDouble(), requests[i].Amount()));
+
+    for (std::size_t i = 0; i < count; i++)
+        orderIds[i] = responses[i].get();
+}
+
+
+void OptimusBot::AsyncOrderGateway::CancelOrders(const OrderID* orderIds, std::size_t count, bool* results) noexcept
+{
+    std::vector<std::future<bool>> responses;
+    responses.reserve(count);
+    for (std::size_t i = 0; i < count; i++)
+        responses.push_back(CancelOrderAsync(orderIds[i]));
+
+    for (std::size_t i = 0; i < count; i++)
+        results[i] = responses[i].get();
+}
+
+
+OptimusBot::AsyncOrderGateway::Statistics OptimusBot::AsyncOrderGateway::GetStatistics() const noexcept
+{
+    Statistics statistics;
+    statistics.Sent = m_Sent.load(std::memory_order_relaxed);
+    statistics.TimedOut = m_TimedOut.load(std::memory_order_relaxed);
+    statistics.OrphansCancelled = m_OrphansCancelled.load(std::memory_order_relaxed);
+    statistics.LateCancels = m_LateCancels.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+
+void OptimusBot::AsyncOrderGateway::Submit(std::shared_ptr<Request> request)
+{
+    {
+        std::unique_lock<std::mutex> lock{ m_Mutex };
+
+        // Back-pressure: the caller waits for a slot rather than queuing requests without bound
+        m_RequestProcessed.wait(lock, [this]() { return m_Stopping || m_Outstanding < std::max<std::size_t>(m_Config.MaxOutstanding, 1); });
+        if (m_Stopping)
+        {
+            Fail(*request);
+            return;
+        }
+
+        // The deadline includes the time spent queued
+        request->Deadline = Clock::now() + m_Config.Timeout;
+        m_Outstanding++;
+        m_Queue.push_back(request);
+        m_Watched.push_back(std::move(request));
+    }
+
+    m_RequestQueued.notify_one();
+    m_WatchUpdated.notify_one();
+}
+
+
+void OptimusBot::AsyncOrderGateway::Send()
+{
+    for (;;)
+    {
+        std::shared_ptr<Request> request;
+        {
+            std::unique_lock<std::mutex> lock{ m_Mutex };
+            m_RequestQueued.wait(lock, [this]() { return m_Stopping || !m_Queue.empty(); });
+            if (m_Queue.empty())
+                return;
+
+            request = std::move(m_Queue.front());
+            m_Queue.pop_front();
+        }
+
+        // A request which timed out while queued, or while waiting for the simulator, is not sent at all: its caller was already told it failed
+        if (!request->Resolved.load(std::memory_order_acquire))
+        {
+            const auto lock = LockSimulator();
+            if (!request->Resolved.load(std::memory_order_acquire))
+                Process(*request);
+        }
+
+        {
+            const std::lock_guard<std::mutex> lock{ m_Mutex };
+            m_Outstanding--;
+        }
+        m_RequestProcessed.notify_one();
+    }
+}
+
+
+void OptimusBot::AsyncOrderGateway::Process(Request& request)
+{
+    m_Sent.fetch_add(1, std::memory_order_relaxed);
+
+    if (request.IsCancel)
+    {
+        const auto cancelled = m_Simulator->CancelOrder(request.Oid);
+        if (!request.Resolved.exchange(true, std::memory_order_acq_rel))
+        {
+            request.Cancelled.set_value(cancelled);
+        }
+        else if (cancelled)
+        {
+            // The caller keeps the order pending although it left the market, and will never see it filled
+            m_LateCancels.fetch_add(1, std::memory_order_relaxed);
+            Logging::Warning("Order {} cancelled after its cancellation timed out", request.Oid);
+        }
+    }
+    else
+    {
+        const auto orderId = m_Simulator->PlaceOrder(request.Price, request.Amount);
+        if (!request.Resolved.exchange(true, std::memory_order_acq_rel))
+        {
+            request.Placed.set_value(orderId);
+        }
+        else if (orderId)
+        {
+            // Nobody knows about this order anymore, it would otherwise rest on the market unmanaged
+            m_Simulator->CancelOrder(orderId.value());
+            m_OrphansCancelled.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+
+void OptimusBot::AsyncOrderGateway::Watch()
+{
+    std::unique_lock<std::mutex> lock{ m_Mutex };
+
+    while (!m_Stopping)
+    {
+        while (!m_Watched.empty() && m_Watched.front()->Resolved.load(std::memory_order_acquire))
+            m_Watched.pop_front();
+
+        if (m_Watched.empty())
+        {
+            m_WatchUpdated.wait(lock);
+            continue;
+        }
+
+        const auto request = m_Watched.front();
+        if (Clock::now() < request->Deadline)
+        {
+            m_WatchUpdated.wait_until(lock, request->Deadline);
+            continue;
+        }
+
+        if (Fail(*request))
+            m_TimedOut.fetch_add(1, std::memory_order_relaxed);
+        m_Watched.pop_front();
+    }
+}
+
+
+bool OptimusBot::AsyncOrderGateway::Fail(Request& request)
+{
+    if (request.Resolved.exchange(true, std::memory_order_acq_rel))
+        return false;
+
+    if (request.IsCancel)
+        request.Cancelled.set_value(false);
+    else
+        request.Placed.set_value(std::nullopt);
+
+    return true;
+}
+
+
+std::unique_lock<std::mutex> OptimusBot::AsyncOrderGateway::LockSimulator() noexcept
+{
+    if (m_Config.MaxInFlight > 1)
+        return std::unique_lock<std::mutex>{};
+
+    return std::unique_lock<std::mutex>{ m_SimulatorMutex };
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "DvfSimulator.h"
+#include "SimulatorExtensions.h"
+#include "Types.h"
+
+namespace OptimusBot
+{
+    /// @brief Parameters of an AsyncOrderGateway
+    struct AsyncGatewayConfig
+    {
+        // Requests sent concurrently. With a single one, the calls to the simulator (GetOrderBook included) are serialized by the gateway.
+        // More than one requires a simulator tolerating concurrent calls, e.g. a LatencySimulator
+        std::size_t MaxInFlight{ 1 };
+
+        // Requests submitted and not processed yet, beyond which submitting blocks
+        std::size_t MaxOutstanding{ 256 };
+
+        // Time after which an unanswered request fails. An order placed after its request timed out is cancelled right away
+        std::chrono::steady_clock::duration Timeout{ std::chrono::seconds{ 1 } };
+    };
+
+    /// @brief IDvfSimulator decorator keeping many order requests in flight: each request is sent by one of a set of I/O threads,
+    /// its response being delivered through a future. The batches (e.g. placing the initial orders, or cancelling the remaining
+    /// ones at shutdown) are sent at once, costing a single round trip rather than one per order. GetOrderBook is forwarded as-is
+    class AsyncOrderGateway final : public IDvfSimulator, public IBufferedOrderBookSource, public IBatchOrderPlacer, public IBatchOrderCanceller
+    {
+    public:
+        /// @brief Counters describing the activity of the gateway
+        struct Statistics
+        {
+            std::uint64_t Sent{ 0 };
+            std::uint64_t TimedOut{ 0 };
+            std::uint64_t OrphansCancelled{ 0 };
+
+            // Cancellations which succeeded after being reported as failed on timeout
+            std::uint64_t LateCancels{ 0 };
+        };
+
+        /// @param simulator Simulator the requests are sent to
+        /// @param config Concurrency, back-pressure and timeout settings
+        AsyncOrderGateway(SimulatorPtr&& simulator, const AsyncGatewayConfig& config = AsyncGatewayConfig{});
+
+        /// @brief Fails the requests not sent yet, then waits for the ones in flight
+        ~AsyncOrderGateway() noexcept;
+
+        AsyncOrderGateway(const AsyncOrderGateway&) = delete;
+        AsyncOrderGateway& operator=(const AsyncOrderGateway&) = delete;
+
+        /// @brief Sends an order. Blocks while the gateway has too many outstanding requests. Thread-safe
+        /// @return Id of the order, or std::nullopt if it could not be placed in time
+        std::future<std::optional<OrderID>> PlaceOrderAsync(double price, double amount);
+
+        /// @brief Sends a cancellation. Blocks while the gateway has too many outstanding requests. Thread-safe
+        /// @return Whether the order was cancelled in time
+        std::future<bool> CancelOrderAsync(OrderID oid);
+
+        OrderBook GetOrderBook() noexcept override;
+
+        void GetOrderBook(OrderBook& orderBook) noexcept override;
+
+        std::optional<OrderID> PlaceOrder(double price, double amount) noexcept override;
+
+        bool CancelOrder(OrderID oid) noexcept override;
+
+        void PlaceOrders(const Types::OrderRequest* requests, std::size_t count, std::optional<OrderID>* orderIds) noexcept override;
+
+        void CancelOrders(const OrderID* orderIds, std::size_t count, bool* results) noexcept override;
+
+        Statistics GetStatistics() const noexcept;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Request
+        {
+            bool IsCancel{ false };
+            double Price{ 0.0 };
+            double Amount{ 0.0 };
+            OrderID Oid{ 0 };
+            Clock::time_point Deadline;
+
+            // Set by whoever resolves the request first: the I/O thread with the response, or the watchdog on timeout
+            std::atomic<bool> Resolved{ false };
+            std::promise<std::optional<OrderID>> Placed;
+            std::promise<bool> Cancelled;
+        };
+
+        void Submit(std::shared_ptr<Request> request);
+
+        /// @brief Loop of an I/O thread, sending the requests one at a time
+        void Send();
+
+        /// @brief Sends a request to the simulator and delivers the response, unless the request timed out meanwhile
+        void Process(Request& request);
+
+        /// @brief Loop of the watchdog thread, failing the requests whose deadline passed
+        void Watch();
+
+        /// @brief Delivers a failure if the request is not resolved yet
+        /// @return False if it was already resolved
+        static bool Fail(Request& request);
+
+        /// @brief Lock to hold while calling the simulator, only taken if a single request is in flight
+        std::unique_lock<std::mutex> LockSimulator() noexcept;
+
+        SimulatorPtr m_Simulator;
+        const AsyncGatewayConfig m_Config;
+        std::mutex m_SimulatorMutex;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_RequestQueued;
+        std::condition_variable m_RequestProcessed;
+        std::condition_variable m_WatchUpdated;
+        std::deque<std::shared_ptr<Request>> m_Queue;
+        std::size_t m_Outstanding{ 0 };
+        bool m_Stopping{ false };
+
+        // Requests in submission order, hence by deadline, the timeout being the same for all
+        std::deque<std::shared_ptr<Request>> m_Watched;
+
+        std::atomic<std::uint64_t> m_Sent{ 0 };
+        std::atomic<std::uint64_t> m_TimedOut{ 0 };
+        std::atomic<std::uint64_t> m_OrphansCancelled{ 0 };
+        std::atomic<std::uint64_t> m_LateCancels{ 0 };
+
+        std::vector<std::thread> m_Senders;
+        std::thread m_Watchdog;
+    };
+}
@@ -0,0 +1,111 @@
+#include "pch.h"
+#include <cmath>
+#include "Backtester.h"
+#include "Bot.h"
+#include "Clock.h"
+#include "Logger.h"
+
+using namespace OptimusBot::Types;
+
+
+namespace
+{
+    double Mid(const BestOrder& bestOrder) noexcept
+    {
+        return (bestOrder.Bid + bestOrder.Ask).ToDouble() / 2.0;
+    }
+
+    double Value(const Wallet& wallet, double price) noexcept
+    {
+        return wallet.ETH.ToDouble() * price + wallet.USD.ToDouble();
+    }
+}
+
+
+OptimusBot::Backtester::BacktestReport OptimusBot::Backtester::Run(std::unique_ptr<ISnapshotSource>&& source, const BacktestConfig& config)
+{
+    const auto wallStart = std::chrono::steady_clock::now();
+
+    BacktestReport report;
+    report.InitialWallet = Wallet{ config.InitialETH, config.InitialUSD };
+
+    VirtualClock clock;
+    const auto virtualStart = clock.Now();
+
+    // The Bot owns the simulator, which stays alive (and readable) as long as the Bot is
+    auto simulator = std::make_unique<ReplaySimulator>(std::move(source));
+    const auto& replay = *simulator;
+
+    {
+        std::optional<Logging::ScopedLevel> silencer;
+        if (config.Quiet)
+            silencer.emplace(Logging::Level::OFF);
+
+        Bot bot{ std::move(simulator), config.InitialETH, config.InitialUSD, clock };
+        bot.SetRiskLimits(config.Risk);
+        if (config.Requoting)
+            bot.EnableRequoting(config.Requoting.value());
+
+        const auto ordersEachSide = config.Requoting ? 0 : config.OrdersEachSide;
+        report.InitialOrdersPlaced = config.StrategySeed
+            ? bot.PlaceInitialOrders(ordersEachSide, config.Strategy, config.StrategySeed.value())
+            : bot.PlaceInitialOrders(ordersEachSide);
+        if (const auto initialBestOrder = replay.GetLastBestOrder())
+            report.InitialMid = Mid(initialBestOrder.value());
+
+        if (report.InitialOrdersPlaced)
+            bot.StartTradingSession();
+
+        report.FinalWallet = bot.GetWallet();
+        if (const auto finalBestOrder = replay.GetLastBestOrder())
+            report.FinalMid = Mid(finalBestOrder.value());
+
+        report.Statistics = replay.GetStatistics();
+    }
+
+    // The report is typically printed right after, once the session's logs are out (nothing to wait for if the logging is off)
+    if (Logging::Logger::Instance().GetLevel() != Logging::Level::OFF)
+        Logging::Logger::Instance().Flush();
+
+    const auto finalValue = Value(report.FinalWallet, report.FinalMid);
+    report.PnL = finalValue - Value(report.InitialWallet, report.InitialMid);
+    report.PnLVersusHolding = finalValue - Value(report.InitialWallet, report.FinalMid);
+    report.InventoryRisk = std::abs((report.FinalWallet.ETH - report.InitialWallet.ETH).ToDouble()) * report.FinalMid;
+
+    if (report.Statistics.OrdersPlaced > 0)
+        report.FillRate = static_cast<double>(report.Statistics.OrdersFilled) / report.Statistics.OrdersPlaced;
+
+    report.VirtualDuration = clock.Now() - virtualStart;
+    report.WallDuration = std::chrono::steady_clock::now() - wallStart;
+
+    return report;
+}
+
+
+void OptimusBot::Backtester::PrintReport(std::ostream& output, const BacktestReport& report)
+{
+    using Seconds = std::chrono::duration<double>;
+
+    if (!report.InitialOrdersPlaced)
+    {
+        output << "Backtest aborted: the initial orders could not be placed." << std::endl;
+        return;
+    }
+
+    const auto& statistics = report.Statistics;
+
+    output << "Backtest report" << std::endl;
+    output << "	Ticks replayed: " << statistics.Snapshots
+        << " (" << Seconds{ report.VirtualDuration }.count() << "s of market in "
+        << Seconds{ report.WallDuration }.count() << "s)" << std::endl;
+    output << "	Initial wallet: " << report.InitialWallet.ETH.ToDouble() << " ETH and " << report.InitialWallet.USD.ToDouble() << " USD"
+        << " (mid " << report.InitialMid << ")" << std::endl;
+    output << "	Final wallet: " << report.FinalWallet.ETH.ToDouble() << " ETH and " << report.FinalWallet.USD.ToDouble() << " USD"
+        << " (mid " << report.FinalMid << ")" << std::endl;
+    output << "	PnL: " << report.PnL << " USD (" << report.PnLVersusHolding << " USD versus holding)" << std::endl;
+    output << "	Inventory risk: " << report.InventoryRisk << " USD" << std::endl;
+    output << "	Orders: " << statistics.OrdersPlaced << " placed, " << statistics.OrdersRejected << " rejected, "
+        << statistics.OrdersFilled << " filled, " << statistics.OrdersCancelled << " cancelled"
+        << " (fill rate " << report.FillRate * 100.0 << "%)" << std::endl;
+    output << "	Filled volume: " << statistics.FilledBidVolume << " ETH bought, " << statistics.FilledAskVolume << " ETH sold" << std::endl;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include "ReplaySimulator.h"
+#include "Requoter.h"
+#include "RiskGate.h"
+#include "SnapshotSources.h"
+#include "Types.h"
+
+namespace OptimusBot::Backtester
+{
+    /// @brief Parameters of a backtest
+    struct BacktestConfig
+    {
+        double InitialETH{ 10.0 };
+        double InitialUSD{ 2000.0 };
+        int OrdersEachSide{ 5 };
+
+        Types::StrategyParameters Strategy;
+
+        // Seed of the generator drawing the order prices and volumes. Without it, they are drawn like the live bot's (not reproducible)
+        std::optional<std::uint64_t> StrategySeed;
+
+        // Quotes continuously rather than placing the prudent orders once: the first refresh places the quotes, the later ones requote
+        // them as the market moves, and the session lasts until the snapshots are exhausted. OrdersEachSide is then ignored
+        std::optional<RequoterConfig> Requoting;
+
+        // Pre-trade limits every order of the bot goes through
+        RiskLimits Risk;
+
+        // Silences the logging during the replay (the asset balances being printed every 30 virtual seconds).
+        // Backtests running in parallel should rather leave it off, the logging threshold being process-wide
+        bool Quiet{ true };
+    };
+
+    /// @brief Outcome of a backtest
+    struct BacktestReport
+    {
+        bool InitialOrdersPlaced{ false };
+
+        Types::Wallet InitialWallet{ 0.0, 0.0 };
+        Types::Wallet FinalWallet{ 0.0, 0.0 };
+
+        // Mid prices of the first and last replayed books, used to value the wallets
+        double InitialMid{ 0.0 };
+        double FinalMid{ 0.0 };
+
+        // Mark-to-market PnL of the session, and its excess over simply holding the initial wallet
+        double PnL{ 0.0 };
+        double PnLVersusHolding{ 0.0 };
+
+        // USD value, at the final mid, of the ETH bought or sold during the session: the exposure left to the market
+        double InventoryRisk{ 0.0 };
+
+        ReplaySimulator::Statistics Statistics;
+        double FillRate{ 0.0 };
+
+        // Time line covered by the replayed ticks, and time actually taken to replay them
+        std::chrono::steady_clock::duration VirtualDuration{ 0 };
+        std::chrono::steady_clock::duration WallDuration{ 0 };
+    };
+
+    /// @brief Runs a Bot trading session against the given snapshots on a virtual clock, each market refresh consuming one
+    /// snapshot. The session ends once all the orders are filled or the snapshots are exhausted
+    BacktestReport Run(std::unique_ptr<ISnapshotSource>&& source, const BacktestConfig& config);
+
+    void PrintReport(std::ostream& output, const BacktestReport& report);
+}
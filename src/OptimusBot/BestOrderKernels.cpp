@@ -0,0 +1,175 @@
+#include "pch.h"
+#include <limits>
+#include "BestOrderKernels.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define OPTIMUSBOT_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang require the instruction set to be enabled per function, MSVC allows any intrinsic
+#if defined(__GNUC__) || defined(__clang__)
+#define OPTIMUSBOT_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define OPTIMUSBOT_TARGET_AVX2
+#endif
+
+using namespace OptimusBot::BestOrderKernels;
+
+namespace
+{
+    constexpr auto infinity = std::numeric_limits<double>::infinity();
+
+    // The vectorized kernels read the [price, volume] pairs as a flat array of doubles
+    static_assert(sizeof(Level) == 2 * sizeof(double), "std::pair<double, double> is expected to be tightly packed");
+
+    void ScanScalarFrom(const Level* levels, std::size_t begin, std::size_t count, double& bestBid, double& bestAsk) noexcept
+    {
+        for (auto i = begin; i < count; i++)
+        {
+            const auto price = levels[i].first;
+            const auto volume = levels[i].second;
+            bestBid = volume > 0.0 && price > bestBid ? price : bestBid;
+            bestAsk = volume < 0.0 && price < bestAsk ? price : bestAsk;
+        }
+    }
+}
+
+
+void OptimusBot::BestOrderKernels::ScanScalar(const Level* levels, std::size_t count, double& bestBid, double& bestAsk) noexcept
+{
+    bestBid = -infinity;
+    bestAsk = infinity;
+    ScanScalarFrom(levels, 0, count, bestBid, bestAsk);
+}
+
+
+#ifdef OPTIMUSBOT_X86
+
+void OptimusBot::BestOrderKernels::ScanSse2(const Level* levels, std::size_t count, double& bestBid, double& bestAsk) noexcept
+{
+    const auto data = reinterpret_cast<const double*>(levels);
+    const auto zero = _mm_setzero_pd();
+    const auto noBid = _mm_set1_pd(-infinity);
+    const auto noAsk = _mm_set1_pd(infinity);
+
+    auto bids = noBid;
+    auto asks = noAsk;
+
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const auto first = _mm_loadu_pd(data + 2 * i);       // p0 v0
+        const auto second = _mm_loadu_pd(data + 2 * i + 2); // p1 v1
+        const auto prices = _mm_unpacklo_pd(first, second);  // p0 p1
+        const auto volumes = _mm_unpackhi_pd(first, second); // v0 v1
+
+        // No blend in SSE2: select the price or the neutral value with and/andnot/or
+        const auto isBid = _mm_cmpgt_pd(volumes, zero);
+        const auto isAsk = _mm_cmplt_pd(volumes, zero);
+        bids = _mm_max_pd(bids, _mm_or_pd(_mm_and_pd(isBid, prices), _mm_andnot_pd(isBid, noBid)));
+        asks = _mm_min_pd(asks, _mm_or_pd(_mm_and_pd(isAsk, prices), _mm_andnot_pd(isAsk, noAsk)));
+    }
+
+    bestBid = std::max(_mm_cvtsd_f64(bids), _mm_cvtsd_f64(_mm_unpackhi_pd(bids, bids)));
+    bestAsk = std::min(_mm_cvtsd_f64(asks), _mm_cvtsd_f64(_mm_unpackhi_pd(asks, asks)));
+    ScanScalarFrom(levels, i, count, bestBid, bestAsk);
+}
+
+
+OPTIMUSBOT_TARGET_AVX2
+void OptimusBot::BestOrderKernels::ScanAvx2(const Level* levels, std::size_t count, double& bestBid, double& bestAsk) noexcept
+{
+    const auto data = reinterpret_cast<const double*>(levels);
+    const auto zero = _mm256_setzero_pd();
+    const auto noBid = _mm256_set1_pd(-infinity);
+    const auto noAsk = _mm256_set1_pd(infinity);
+
+    // Two independent accumulators per side hide the latency of max/min
+    auto bids0 = noBid;
+    auto bids1 = noBid;
+    auto asks0 = noAsk;
+    auto asks1 = noAsk;
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const auto a = _mm256_loadu_pd(data + 2 * i);      // p0 v0 p1 v1
+        const auto b = _mm256_loadu_pd(data + 2 * i + 4);  // p2 v2 p3 v3
+        const auto c = _mm256_loadu_pd(data + 2 * i + 8);
+        const auto d = _mm256_loadu_pd(data + 2 * i + 12);
+
+        // The order of the lanes does not matter for a max/min reduction
+        const auto prices0 = _mm256_unpacklo_pd(a, b);     // p0 p2 p1 p3
+        const auto volumes0 = _mm256_unpackhi_pd(a, b);    // v0 v2 v1 v3
+        const auto prices1 = _mm256_unpacklo_pd(c, d);
+        const auto volumes1 = _mm256_unpackhi_pd(c, d);
+
+        bids0 = _mm256_max_pd(bids0, _mm256_blendv_pd(noBid, prices0, _mm256_cmp_pd(volumes0, zero, _CMP_GT_OQ)));
+        asks0 = _mm256_min_pd(asks0, _mm256_blendv_pd(noAsk, prices0, _mm256_cmp_pd(volumes0, zero, _CMP_LT_OQ)));
+        bids1 = _mm256_max_pd(bids1, _mm256_blendv_pd(noBid, prices1, _mm256_cmp_pd(volumes1, zero, _CMP_GT_OQ)));
+        asks1 = _mm256_min_pd(asks1, _mm256_blendv_pd(noAsk, prices1, _mm256_cmp_pd(volumes1, zero, _CMP_LT_OQ)));
+    }
+
+    const auto bids256 = _mm256_max_pd(bids0, bids1);
+    const auto asks256 = _mm256_min_pd(asks0, asks1);
+    const auto bids = _mm_max_pd(_mm256_castpd256_pd128(bids256), _mm256_extractf128_pd(bids256, 1));
+    const auto asks = _mm_min_pd(_mm256_castpd256_pd128(asks256), _mm256_extractf128_pd(asks256, 1));
+
+    bestBid = std::max(_mm_cvtsd_f64(bids), _mm_cvtsd_f64(_mm_unpackhi_pd(bids, bids)));
+    bestAsk = std::min(_mm_cvtsd_f64(asks), _mm_cvtsd_f64(_mm_unpackhi_pd(asks, asks)));
+    ScanScalarFrom(levels, i, count, bestBid, bestAsk);
+}
+
+
+bool OptimusBot::BestOrderKernels::IsAvx2Supported() noexcept
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // AVX and OSXSAVE flags, then the OS must save the YMM registers on context switches
+    __cpuid(info, 1);
+    const bool avx = (info[2] & (1 << 28)) != 0 && (info[2] & (1 << 27)) != 0;
+    if (!avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#else
+
+void OptimusBot::BestOrderKernels::ScanSse2(const Level* levels, std::size_t count, double& bestBid, double& bestAsk) noexcept
+{
+    ScanScalar(levels, count, bestBid, bestAsk);
+}
+
+
+void OptimusBot::BestOrderKernels::ScanAvx2(const Level* levels, std::size_t count, double& bestBid, double& bestAsk) noexcept
+{
+    ScanScalar(levels, count, bestBid, bestAsk);
+}
+
+
+bool OptimusBot::BestOrderKernels::IsAvx2Supported() noexcept
+{
+    return false;
+}
+
+#endif
+
+
+Kernel OptimusBot::BestOrderKernels::GetBestKernel() noexcept
+{
+    static const Kernel kernel = IsAvx2Supported() ? &ScanAvx2 : &ScanSse2;
+    return kernel;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+/// @brief Single-pass kernels scanning a raw order book for its best bid/ask, without copying or sorting it.
+/// A book is scanned as an array of [price, volume] pairs: the best bid is the highest price with a +ve volume and the best ask the lowest price with a -ve volume
+namespace OptimusBot::BestOrderKernels
+{
+    using Level = std::pair<double, double>;
+
+    /// @brief Signature shared by all the kernels
+    /// @param levels First [price, volume] pair of the book
+    /// @param count Number of pairs
+    /// @param bestBid Highest bid price found, -infinity if there is no bid
+    /// @param bestAsk Lowest ask price found, +infinity if there is no ask
+    using Kernel = void (*)(const Level* levels, std::size_t count, double& bestBid, double& bestAsk) noexcept;
+
+    /// @brief Portable implementation, always available
+    void ScanScalar(const Level* levels, std::size_t count, double& bestBid, double& bestAsk) noexcept;
+
+    /// @brief SSE2 implementation, processing two levels per instruction. Falls back to the scalar kernel on non-x86 targets
+    void ScanSse2(const Level* levels, std::size_t count, double& bestBid, double& bestAsk) noexcept;
+
+    /// @brief AVX2 implementation, processing four levels per instruction. Must only be called if IsAvx2Supported returns true
+    void ScanAvx2(const Level* levels, std::size_t count, double& bestBid, double& bestAsk) noexcept;
+
+    /// @brief Whether the CPU (and OS) running the app support AVX2
+    bool IsAvx2Supported() noexcept;
+
+    /// @brief Fastest kernel supported by the CPU running the app, detected once on first call
+    Kernel GetBestKernel() noexcept;
+}
@@ -0,0 +1,165 @@
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "BookAnalytics.h"
+
+using namespace OptimusBot::Types;
+
+namespace
+{
+    // Exact conversion of non-negative fixed-point units below 2^52 (e.g. 45M ETH, 45T USD) to double, without the scalar int64 conversion
+    // SSE2 and AVX2 lack: the units become the mantissa of 2^52 + units, from which 2^52 is subtracted
+    inline double UnitsToDouble(std::int64_t units) noexcept
+    {
+        constexpr double twoPower52 = 4503599627370496.0;
+        const auto bits = static_cast<std::uint64_t>(units) | 0x4330000000000000ull;
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value - twoPower52;
+    }
+
+    // Volume and notional, in units, of the last count levels of a side (its best ones). Four independent accumulators break the dependency
+    // between consecutive additions, letting the compiler keep them in SIMD lanes
+    void SumLevels(const Price* prices, const Quantity* volumes, std::size_t count, double& volume, double& notional) noexcept
+    {
+        double volumeSums[4]{};
+        double notionalSums[4]{};
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            for (std::size_t lane = 0; lane < 4; lane++)
+            {
+                const auto levelVolume = UnitsToDouble(volumes[i + lane].Units());
+                volumeSums[lane] += levelVolume;
+                notionalSums[lane] += UnitsToDouble(prices[i + lane].Units()) * levelVolume;
+            }
+        }
+
+        for (; i < count; i++)
+        {
+            const auto levelVolume = UnitsToDouble(volumes[i].Units());
+            volumeSums[0] += levelVolume;
+            notionalSums[0] += UnitsToDouble(prices[i].Units()) * levelVolume;
+        }
+
+        volume = (volumeSums[0] + volumeSums[1]) + (volumeSums[2] + volumeSums[3]);
+        notional = (notionalSums[0] + notionalSums[1]) + (notionalSums[2] + notionalSums[3]);
+    }
+
+    void SumSide(const OptimusBot::OrderBook& orderBook, OrderSide side, std::size_t levels, double& volume, double& notional) noexcept
+    {
+        const auto& prices = orderBook.GetPrices(side);
+        const auto count = std::min(levels, prices.size());
+        const auto first = prices.size() - count;
+        SumLevels(prices.data() + first, orderBook.GetVolumes(side).data() + first, count, volume, notional);
+
+        // Back from units to ETH and USD
+        volume /= static_cast<double>(Quantity::Scale);
+        notional /= static_cast<double>(Price::Scale) * static_cast<double>(Quantity::Scale);
+    }
+}
+
+
+OptimusBot::BookAnalytics::BookAnalytics(const BookAnalyticsConfig& config)
+    : m_Config{ config }, m_Window(std::max<std::size_t>(config.Window, 1))
+{
+}
+
+
+bool OptimusBot::BookAnalytics::Update(const OrderBook& orderBook) noexcept
+{
+    if (orderBook.Depth(OrderSide::BID) == 0 || orderBook.Depth(OrderSide::ASK) == 0)
+        return false;
+
+    const auto bid = orderBook.PriceAt(OrderSide::BID, 0).ToDouble();
+    const auto ask = orderBook.PriceAt(OrderSide::ASK, 0).ToDouble();
+    const auto bidVolume = orderBook.VolumeAt(OrderSide::BID, 0).ToDouble();
+    const auto askVolume = orderBook.VolumeAt(OrderSide::ASK, 0).ToDouble();
+
+    const auto previousMid = m_Features.Mid;
+    m_Features.Mid = 0.5 * (bid + ask);
+    m_Features.Spread = ask - bid;
+    m_Features.Microprice = (bid * askVolume + ask * bidVolume) / (bidVolume + askVolume);
+
+    double bidNotional, askNotional;
+    SumSide(orderBook, OrderSide::BID, m_Config.DepthLevels, m_Features.BidDepth, bidNotional);
+    SumSide(orderBook, OrderSide::ASK, m_Config.DepthLevels, m_Features.AskDepth, askNotional);
+
+    const auto depth = m_Features.BidDepth + m_Features.AskDepth;
+    const auto notional = bidNotional + askNotional;
+    m_Features.Imbalance = (m_Features.BidDepth - m_Features.AskDepth) / depth;
+    m_Features.BookVwap = notional / depth;
+
+    // The first tick has no return
+    const auto hasReturn = m_Features.Ticks > 0 && previousMid > 0.0;
+    const auto logReturn = hasReturn ? std::log(m_Features.Mid / previousMid) : 0.0;
+    m_Features.Ticks++;
+
+    // Slides the window by one tick: the oldest sample leaves the sums once the buffer is full
+    auto& slot = m_Window[m_Next];
+    if (m_Count == m_Window.size())
+    {
+        m_WindowNotional -= slot.Notional;
+        m_WindowVolume -= slot.Volume;
+        if (slot.HasReturn)
+        {
+            m_ReturnCount--;
+            m_ReturnSum -= slot.Return;
+            m_ReturnSquares -= slot.Return * slot.Return;
+        }
+    }
+    else
+    {
+        m_Count++;
+    }
+
+    slot = Sample{ notional, depth, logReturn, hasReturn };
+    m_WindowNotional += notional;
+    m_WindowVolume += depth;
+    if (hasReturn)
+    {
+        m_ReturnCount++;
+        m_ReturnSum += logReturn;
+        m_ReturnSquares += logReturn * logReturn;
+    }
+
+    m_Next = (m_Next + 1) % m_Window.size();
+    if (m_Next == 0)
+        RecomputeWindowSums();
+
+    m_Features.RollingVwap = m_WindowNotional / m_WindowVolume;
+
+    if (m_ReturnCount > 0)
+    {
+        const auto count = static_cast<double>(m_ReturnCount);
+        const auto mean = m_ReturnSum / count;
+        m_Features.Volatility = std::sqrt(std::max(m_ReturnSquares / count - mean * mean, 0.0));
+    }
+
+    return true;
+}
+
+
+void OptimusBot::BookAnalytics::RecomputeWindowSums() noexcept
+{
+    m_WindowNotional = 0.0;
+    m_WindowVolume = 0.0;
+    m_ReturnCount = 0;
+    m_ReturnSum = 0.0;
+    m_ReturnSquares = 0.0;
+
+    for (std::size_t i = 0; i < m_Count; i++)
+    {
+        const auto& sample = m_Window[i];
+        m_WindowNotional += sample.Notional;
+        m_WindowVolume += sample.Volume;
+        if (sample.HasReturn)
+        {
+            m_ReturnCount++;
+            m_ReturnSum += sample.Return;
+            m_ReturnSquares += sample.Return * sample.Return;
+        }
+    }
+}
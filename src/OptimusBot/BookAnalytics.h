@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "OrderBook.h"
+
+namespace OptimusBot
+{
+    /// @brief Parameters of a BookAnalytics
+    struct BookAnalyticsConfig
+    {
+        // Levels of each side accumulated into the depth, the imbalance and the VWAP of the book
+        std::size_t DepthLevels{ 10 };
+
+        // Number of ticks covered by the rolling VWAP and volatility
+        std::size_t Window{ 60 };
+    };
+
+    /// @brief Features of the order book at the last tick analysed. Prices are in USD and volumes in ETH
+    struct BookFeatures
+    {
+        // Number of books analysed so far. The features are meaningless while 0
+        std::uint64_t Ticks{ 0 };
+
+        double Mid{ 0.0 };
+        double Spread{ 0.0 };
+
+        // Mid weighted by the volume of the opposite best level, leaning towards the side likely to move next
+        double Microprice{ 0.0 };
+
+        // Volume resting on the best DepthLevels levels of each side
+        double BidDepth{ 0.0 };
+        double AskDepth{ 0.0 };
+
+        // (BidDepth - AskDepth) / (BidDepth + AskDepth), from -1 (only asks) to 1 (only bids)
+        double Imbalance{ 0.0 };
+
+        // Volume-weighted average price of the levels accumulated into the depth, at this tick and over the window.
+        // The market data carrying no trades, the resting volume stands for the traded one
+        double BookVwap{ 0.0 };
+        double RollingVwap{ 0.0 };
+
+        // Standard deviation of the mid's log-returns from a tick to the next, over the window
+        double Volatility{ 0.0 };
+    };
+
+    /// @brief Incremental order book analytics, updated once per tick for the strategies to use.
+    /// The levels are reduced straight from the contiguous arrays of the maintained book, and the rolling windows keep running sums
+    /// over a ring buffer of the last ticks, so that each update costs O(DepthLevels) whatever the window. Nothing is allocated after construction
+    class BookAnalytics final
+    {
+    public:
+        explicit BookAnalytics(const BookAnalyticsConfig& config = BookAnalyticsConfig{});
+
+        /// @brief Analyses the current book
+        /// @return False if a side of the book is empty, in which case the features are left unchanged
+        bool Update(const OrderBook& orderBook) noexcept;
+
+        const BookFeatures& GetFeatures() const noexcept
+        {
+            return m_Features;
+        }
+
+        const BookAnalyticsConfig& GetConfig() const noexcept
+        {
+            return m_Config;
+        }
+
+    private:
+        struct Sample
+        {
+            double Notional;
+            double Volume;
+
+            // Log-return of the mid since the previous tick, if there was one
+            double Return;
+            bool HasReturn;
+        };
+
+        /// @brief Recomputes the running sums from the samples, discarding the rounding errors accumulated by the updates
+        void RecomputeWindowSums() noexcept;
+
+        const BookAnalyticsConfig m_Config;
+        BookFeatures m_Features;
+
+        // Ring buffer of the last Window ticks and running sums over it
+        std::vector<Sample> m_Window;
+        std::size_t m_Next{ 0 };
+        std::size_t m_Count{ 0 };
+        double m_WindowNotional{ 0.0 };
+        double m_WindowVolume{ 0.0 };
+
+        // The first tick has no return, the returns of the window being counted apart from its ticks
+        std::size_t m_ReturnCount{ 0 };
+        double m_ReturnSum{ 0.0 };
+        double m_ReturnSquares{ 0.0 };
+    };
+}
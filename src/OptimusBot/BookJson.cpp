@@ -0,0 +1,268 @@
+#include "pch.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include "BookJson.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define OPTIMUSBOT_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+using namespace OptimusBot::BookJson;
+
+namespace
+{
+    bool IsWhitespace(char c) noexcept
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    bool IsNumberCharacter(char c) noexcept
+    {
+        return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+    }
+
+    unsigned CountTrailingZeros(unsigned mask) noexcept
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    }
+
+    // Compact payloads have no whitespace, so the first character is checked before scanning the indentation of pretty-printed ones
+    // sixteen characters at a time
+    const char* SkipWhitespace(const char* position, const char* end) noexcept
+    {
+        if (position == end || !IsWhitespace(*position))
+            return position;
+
+#ifdef OPTIMUSBOT_X86
+        const auto space = _mm_set1_epi8(' ');
+        const auto newLine = _mm_set1_epi8('\n');
+        const auto carriageReturn = _mm_set1_epi8('\r');
+        const auto tab = _mm_set1_epi8('\t');
+
+        while (end - position >= 16)
+        {
+            const auto characters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+            const auto whitespace = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(characters, space), _mm_cmpeq_epi8(characters, newLine)),
+                _mm_or_si128(_mm_cmpeq_epi8(characters, carriageReturn), _mm_cmpeq_epi8(characters, tab)));
+
+            const auto mask = static_cast<unsigned>(_mm_movemask_epi8(whitespace));
+            if (mask != 0xFFFF)
+                return position + CountTrailingZeros(~mask & 0xFFFF);
+
+            position += 16;
+        }
+#endif
+
+        while (position != end && IsWhitespace(*position))
+            position++;
+
+        return position;
+    }
+}
+
+
+ParseStatus OptimusBot::BookJson::StreamingParser::Feed(std::string_view& input, IDvfSimulator::OrderBook& orderBook)
+{
+    auto position = input.data();
+    const auto end = position + input.size();
+    auto status = ParseStatus::INCOMPLETE;
+
+    while (status == ParseStatus::INCOMPLETE && m_State != State::MALFORMED)
+    {
+        if (m_State == State::NUMBER)
+        {
+            if (!ParseNumber(position, end))
+                break;
+
+            m_State = State::NUMBER_END;
+            continue;
+        }
+
+        position = SkipWhitespace(position, end);
+        if (position == end)
+            break;
+
+        const auto character = *position++;
+        switch (m_State)
+        {
+        case State::BOOK_START:
+            orderBook.clear();
+            m_State = character == '[' ? State::FIRST_LEVEL_OR_BOOK_END : State::MALFORMED;
+            break;
+
+        case State::FIRST_LEVEL_OR_BOOK_END:
+        case State::LEVEL_START:
+            if (character == '[')
+            {
+                m_NumberCount = 0;
+                m_State = State::NUMBER;
+            }
+            else if (character == ']' && m_State == State::FIRST_LEVEL_OR_BOOK_END)
+            {
+                m_State = State::BOOK_START;
+                status = ParseStatus::COMPLETE;
+            }
+            else
+            {
+                m_State = State::MALFORMED;
+            }
+            break;
+
+        case State::NUMBER_END:
+            if (character == ',' && m_NumberCount < 3)
+            {
+                m_State = State::NUMBER;
+            }
+            else if (character == ']' && m_NumberCount >= 2)
+            {
+                try
+                {
+                    orderBook.emplace_back(m_Numbers[0], m_Numbers[m_NumberCount - 1]);
+                }
+                catch (...)
+                {
+                    Reset();
+                    throw;
+                }
+                m_State = State::LEVEL_END;
+            }
+            else
+            {
+                m_State = State::MALFORMED;
+            }
+            break;
+
+        case State::LEVEL_END:
+            if (character == ',')
+            {
+                m_State = State::LEVEL_START;
+            }
+            else if (character == ']')
+            {
+                m_State = State::BOOK_START;
+                status = ParseStatus::COMPLETE;
+            }
+            else
+            {
+                m_State = State::MALFORMED;
+            }
+            break;
+
+        default:
+            m_State = State::MALFORMED;
+            break;
+        }
+    }
+
+    input.remove_prefix(static_cast<std::size_t>(position - input.data()));
+    return m_State == State::MALFORMED ? ParseStatus::MALFORMED : status;
+}
+
+
+bool OptimusBot::BookJson::StreamingParser::ParseNumber(const char*& position, const char* end) noexcept
+{
+    if (m_PendingLength == 0)
+    {
+        position = SkipWhitespace(position, end);
+        if (position == end)
+            return false;
+
+        // Parsed in place unless the number may continue in the next chunk (a cut exponent being parsed as a shorter number)
+        double value;
+        const auto [numberEnd, error] = std::from_chars(position, end, value);
+        if (error == std::errc{} && numberEnd != end && !IsNumberCharacter(*numberEnd))
+        {
+            // std::from_chars accepts nan and inf, which are not JSON
+            if (!std::isfinite(value))
+            {
+                m_State = State::MALFORMED;
+                return false;
+            }
+
+            m_Numbers[m_NumberCount++] = value;
+            position = numberEnd;
+            return true;
+        }
+    }
+
+    // Beginning of the number, cut by the end of the previous chunk: its characters are gathered before being parsed
+    const auto numberEnd = std::find_if_not(position, end, IsNumberCharacter);
+    const auto length = static_cast<std::size_t>(numberEnd - position);
+    if (m_PendingLength + length > sizeof(m_PendingNumber))
+    {
+        m_State = State::MALFORMED;
+        return false;
+    }
+
+    std::memcpy(m_PendingNumber + m_PendingLength, position, length);
+    m_PendingLength += length;
+    position = numberEnd;
+    if (position == end)
+        return false;
+
+    double value;
+    const auto pendingEnd = m_PendingNumber + m_PendingLength;
+    const auto [parsedEnd, error] = std::from_chars(m_PendingNumber, pendingEnd, value);
+    m_PendingLength = 0;
+    if (error != std::errc{} || parsedEnd != pendingEnd || !std::isfinite(value))
+    {
+        m_State = State::MALFORMED;
+        return false;
+    }
+
+    m_Numbers[m_NumberCount++] = value;
+    return true;
+}
+
+
+void OptimusBot::BookJson::StreamingParser::Reset() noexcept
+{
+    m_State = State::BOOK_START;
+    m_NumberCount = 0;
+    m_PendingLength = 0;
+}
+
+
+bool OptimusBot::BookJson::Parse(std::string_view json, IDvfSimulator::OrderBook& orderBook)
+{
+    StreamingParser parser;
+    if (parser.Feed(json, orderBook) != ParseStatus::COMPLETE)
+        return false;
+
+    return SkipWhitespace(json.data(), json.data() + json.size()) == json.data() + json.size();
+}
+
+
+void OptimusBot::BookJson::Write(const IDvfSimulator::OrderBook& orderBook, std::string& json)
+{
+    json.clear();
+    json.push_back('[');
+
+    char number[32];
+    for (const auto& [price, volume] : orderBook)
+    {
+        if (json.size() > 1)
+            json.push_back(',');
+
+        json.push_back('[');
+        json.append(number, std::to_chars(number, number + sizeof(number), price).ptr);
+        json.push_back(',');
+        json.append(number, std::to_chars(number, number + sizeof(number), volume).ptr);
+        json.push_back(']');
+    }
+
+    json.push_back(']');
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include "DvfSimulator.h"
+
+/// @brief Reading and writing of the order book payload of https://api.deversifi.com/bfx/v2/book/tETHUSD/, a JSON array of
+/// [price, volume] levels (+ve volumes being bids, -ve asks). Levels are parsed straight into an IDvfSimulator::OrderBook,
+/// without building a document nor allocating once the book has reached its capacity
+namespace OptimusBot::BookJson
+{
+    enum class ParseStatus
+    {
+        // The payload continues in the next chunk
+        INCOMPLETE,
+        // A whole payload was parsed into the book
+        COMPLETE,
+        // The payload is not a JSON array of levels. Sticky until Reset
+        MALFORMED
+    };
+
+    /// @brief Incremental parser of a sequence of payloads received in chunks of any size, e.g. as they come off a socket.
+    /// Levels of three numbers ([price, count, volume], as returned by the Bitfinex API the payload is derived from) are accepted,
+    /// their volume being the last number
+    class StreamingParser final
+    {
+    public:
+        /// @brief Parses a chunk, stopping at the end of the payload in progress
+        /// @param input Chunk to parse, advanced past the characters consumed. Holds the remainder of the chunk when a payload completes
+        /// @param orderBook Book the levels are appended to, cleared at the start of each payload. Partially filled while INCOMPLETE.
+        /// Throws std::bad_alloc if it cannot grow, the parser being reset
+        ParseStatus Feed(std::string_view& input, IDvfSimulator::OrderBook& orderBook);
+
+        /// @brief Drops the payload in progress, e.g. after a MALFORMED one or a reconnection
+        void Reset() noexcept;
+
+    private:
+        enum class State
+        {
+            BOOK_START,
+            FIRST_LEVEL_OR_BOOK_END,
+            LEVEL_START,
+            NUMBER,
+            NUMBER_END,
+            LEVEL_END,
+            MALFORMED
+        };
+
+        /// @brief Parses the number in progress
+        /// @return False if the number continues in the next chunk or is malformed (the state telling them apart), e.g. not finite
+        bool ParseNumber(const char*& position, const char* end) noexcept;
+
+        State m_State{ State::BOOK_START };
+
+        // Numbers of the level in progress
+        double m_Numbers[3]{};
+        std::size_t m_NumberCount{ 0 };
+
+        // Beginning of a number cut by the end of a chunk
+        char m_PendingNumber[64]{};
+        std::size_t m_PendingLength{ 0 };
+    };
+
+    /// @brief Parses a whole payload, surrounding whitespace included
+    /// @param orderBook Output book, overwritten (its capacity being reused)
+    /// @return False if the payload is malformed or truncated. Throws std::bad_alloc if the book cannot grow
+    bool Parse(std::string_view json, IDvfSimulator::OrderBook& orderBook);
+
+    /// @brief Writes a book as a compact payload, each number in its shortest form parsed back to the same double
+    /// @param json Output payload, overwritten (its capacity being reused)
+    void Write(const IDvfSimulator::OrderBook& orderBook, std::string& json);
+}
@@ -1,39 +1,247 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+#include "BookAnalytics.h"
+#include "BotPolicies.h"
+#include "Clock.h"
 #include "DvfSimulator.h"
+#include "Journal.h"
+#include "OrderBook.h"
+#include "PendingOrders.h"
+#include "Requoter.h"
+#include "RiskGate.h"
+#include "Scheduler.h"
+#include "SimulatorExtensions.h"
 #include "Types.h"
 
 namespace OptimusBot 
 {
-    /// @brief Active object responsible for periodically polling the simulated market and keeping track of the assets hold
-    class Bot final
+    /// @brief Active object responsible for periodically polling the simulated market and keeping track of the assets hold.
+    /// On a market implementing IMarketEventSource, the bot subscribes to its events instead: the listener callbacks queue them from the
+    /// thread of the market and wake the trading session up, whose refresh processes the book and the fills one event at a time, rather
+    /// than inferring the fills from the best bid/ask pair of each poll.
+    /// The gateway to the market and the strategy are compile-time policies (see BotPolicies.h), and Clock the type of the time line
+    /// driving the scheduler: a deployment knowing its market and its clock builds a bot without virtual call left to the compiler to inline.
+    /// The members are defined in Bot.ipp, Bot being instantiated in Bot.cpp
+    template <typename Gateway, typename Strategy, typename Clock>
+    class BasicBot final : private IMarketEventListener
     {
+        static_assert(std::is_base_of_v<IClock, Clock>, "The clock drives the scheduler of the bot");
+
     public:
-        Bot(std::unique_ptr<IDvfSimulator>&& simulator, double initialETH, double initialUSD)
-            : m_Simulator{ std::move(simulator) }, m_Wallet{ initialETH , initialUSD }
+        /// @brief Callback notified of each order detected as filled
+        using FillObserver = std::function<void(const Types::BotOrder&)>;
+
+        /// @brief Default periods of the trading session steps
+        static constexpr std::chrono::seconds MarketRefreshInterval{ 5 };
+        static constexpr std::chrono::seconds AssetBalancesInterval{ 30 };
+
+        /// @param market Market the bot trades on, from which the gateway is built (e.g. a SimulatorPtr)
+        /// @param initialETH Initial ETH holdings
+        /// @param initialUSD Initial USD holdings
+        /// @param clock Time line of the trading session: the wall clock when live, a virtual clock for backtests. Must outlive the bot
+        template <typename Market>
+        BasicBot(Market&& market, double initialETH, double initialUSD, Clock& clock = SteadyClock::Instance())
+            : m_Gateway{ std::forward<Market>(market) }, m_Wallet{ initialETH, initialUSD }, m_RiskGate{ m_Wallet }, m_Scheduler{ clock }
         {
+            if (const auto eventSource = m_Gateway.GetEventSource())
+                eventSource->Subscribe(this);
         }
 
-        /// @brief Places initial, should be called before starting the Bot's "message loop"
+        /// @brief Unsubscribes from the events of the market, whose thread may still be pushing them
+        ~BasicBot() noexcept
+        {
+            if (const auto eventSource = m_Gateway.GetEventSource())
+                eventSource->Subscribe(nullptr);
+        }
+
+        BasicBot(const BasicBot&) = delete;
+        BasicBot& operator=(const BasicBot&) = delete;
+
+        /// @brief Places initial orders made by the strategy, should be called before starting the Bot's "message loop"
         /// @return False if the best bid/ask pair cannot be retrieved. True otherwise
         bool PlaceInitialOrders(int numberOfOrdersEachSide);
 
-        /// @brief Starts the trading session. Runs until all the pending orders are filled or an error occurs
+        /// @brief Same as above, the strategy being given tuned parameters and drawing its prices and volumes from a generator seeded with the given seed,
+        /// so that the orders placed on a given market are reproducible
+        bool PlaceInitialOrders(int numberOfOrdersEachSide, const Types::StrategyParameters& parameters, std::uint64_t seed);
+
+        /// @brief Replaces the limits of the risk gate every order goes through, by default only requiring the orders to be covered by the
+        /// assets hold. Should be called before placing the initial orders
+        void SetRiskLimits(const RiskLimits& limits)
+        {
+            m_RiskGate.SetLimits(limits);
+        }
+
+        /// @brief Journals the wallet and the lifecycle of the orders, so that a restarted bot resumes where it stopped. If the journal holds
+        /// the state of a previous session, it replaces the initial assets and pending orders, which are reconciled with the market before
+        /// trading resumes (see ReconcileRestoredOrders) rather than placed again. Should be called before placing the initial orders
+        /// @return False if the journal cannot be opened, the bot then running without it
+        bool OpenJournal(const std::string& path, const JournalConfig& config = JournalConfig{});
+
+        /// @brief Turns on continuous requoting: each market refresh then brings the pending orders to the quotes of the requoter, sending
+        /// only the cancellations and placements that changed. The session runs until an error occurs or it is stopped, rather than until
+        /// all the orders are filled. Should be called before starting the trading session
+        void EnableRequoting(const RequoterConfig& config);
+
+        /// @brief Turns on the analytics of the order book, updated on each market refresh and feeding the requoter's skew.
+        /// Should be called before starting the trading session
+        void EnableAnalytics(const BookAnalyticsConfig& config);
+
+        /// @brief Starts the trading session. Runs until all the pending orders are filled, an error occurs or the session is stopped.
+        /// Drives the steps below on the bot's own scheduler, blocking the calling thread
         void StartTradingSession();
 
+        /// @brief Session step: pulls the market state and processes the orders filled since the last refresh
+        /// @return False once the session should close: all the orders are filled (unless requoting) or the best bid/ask pair cannot be retrieved
+        bool RefreshMarket();
+
+        /// @brief Session step: prints the assets hold, the pending orders and the latencies of the tick stages
+        void PrintAssets() const;
+
+        /// @brief Session step: prints the final assets and cancels the orders still pending. Those failing to be cancelled, possibly filled
+        /// in the meantime, are kept pending (and journaled as such), for the next session to reconcile them with the market
+        void CloseSession();
+
+        /// @brief Wakes up the trading session and makes it close (cancelling the remaining orders). Can be called from any thread
+        void StopTradingSession();
+
+        /// @brief Sets the callback notified of the fills, e.g. to record them. Should be called before starting the trading session
+        void SetFillObserver(FillObserver observer)
+        {
+            m_FillObserver = std::move(observer);
+        }
+
+        /// @brief Assets currently hold. Not thread-safe, should not be called while a trading session is running on another thread
+        const Types::Wallet& GetWallet() const noexcept
+        {
+            return m_Wallet;
+        }
+
+        /// @brief Exposure of the open orders, as tracked by the risk gate. Same thread-safety as GetWallet
+        const RiskGate& GetRiskGate() const noexcept
+        {
+            return m_RiskGate;
+        }
+
+        /// @brief Number of orders still waiting to be filled. Same thread-safety as GetWallet
+        std::size_t GetPendingOrderCount() const noexcept
+        {
+            return m_PendingOrders.Size();
+        }
+
+        /// @brief Analytics of the order book, if enabled. Same thread-safety as GetWallet
+        const std::optional<BookAnalytics>& GetBookAnalytics() const noexcept
+        {
+            return m_Analytics;
+        }
+
 
     private:
-        // Simulator's lifetime is tied to the Bot
-        std::unique_ptr<IDvfSimulator> m_Simulator;
+        /// @brief Event pushed by the market: a fill, the cancellation of an order or a book change
+        using MarketEvent = std::variant<FillEvent, IDvfSimulator::OrderID, Types::LevelDelta>;
+
+        /// @brief Keeps the restored orders the market still knows, at their remaining volume (the difference being filled while the bot
+        /// was down), and drops the other ones, journaled as cancelled. On a market unable to look them up, they are all cancelled,
+        /// the strategy placing new orders
+        void ReconcileRestoredOrders(const std::vector<Types::BotOrder>& orders);
+
+        /// @brief Pulls the latest changes of the market into the maintained order book
+        /// @return The current best bid/ask pair, if both sides of the book are populated
+        std::optional<Types::BestOrder> RefreshOrderBook();
+
+        /// @brief Places the orders passing the risk gate, in a single round trip if the simulator supports batches
+        void PlaceOrders(const Types::OrderRequest* requests, std::size_t count);
+
+        /// @brief Cancels pending orders, in a single round trip if the simulator supports batches
+        /// @return Number of orders cancelled
+        std::size_t CancelOrders(const IDvfSimulator::OrderID* orderIds, std::size_t count);
+
+        /// @brief Sends the changes bringing the pending orders to the wanted quotes
+        void Requote(const Types::BestOrder& bestOrder);
+
+        /// @brief Makes the events journaled during the step durable, compacting the journal once it has grown enough
+        void CommitJournal();
+
+        /// @brief Stops tracking a pending order which left the market unfilled
+        /// @return False if the order was not pending anymore
+        bool ForgetCancelled(IDvfSimulator::OrderID orderId);
+
+        /// @brief Moves the assets of a fill, possibly partial, and shrinks or removes the pending order accordingly
+        void ProcessFill(const FillEvent& fill) noexcept;
+
+        /// @brief Queues an event pushed by the market, waking the trading session up if it was the first one queued. Called on the thread of the market
+        void Enqueue(const MarketEvent& event) noexcept;
+
+        void OnFill(const FillEvent& fill) noexcept override;
+
+        void OnCancel(IDvfSimulator::OrderID orderId) noexcept override;
+
+        void OnBookChange(const Types::LevelDelta& delta) noexcept override;
+
+        // Simulator's lifetime is tied to the Bot. On a market pushing its events, the book is maintained from the events rather than pulled
+        Gateway m_Gateway;
+
+        // Events pushed by the market since the last refresh, swapped with the ones being processed to reuse the capacity of both
+        std::mutex m_EventsMutex;
+        std::vector<MarketEvent> m_QueuedEvents;
+        std::vector<MarketEvent> m_DispatchedEvents;
+        Strategy m_Strategy;
+
+        // Market state, maintained incrementally from the deltas
+        OrderBook m_OrderBook;
+        std::vector<Types::LevelDelta> m_Deltas;
 
         // Keeps track of the number of ETH and USD currently hold
         Types::Wallet m_Wallet;
 
+        // Checks each order against the wallet above before it is sent, tracking the exposure of the open orders
+        RiskGate m_RiskGate;
+
+        // Write-ahead journal of the state above, if enabled
+        std::unique_ptr<Journal> m_Journal;
+
         // Orders still waiting to be filled
-        std::multiset<Types::BotOrder> m_PendingOrders;
+        PendingOrders m_PendingOrders;
+
+        // Orders filled during the last market refresh, kept as a member to reuse its capacity
+        std::vector<Types::BotOrder> m_FilledOrders;
+        FillObserver m_FillObserver;
+
+        // Features of the book, if enabled
+        std::optional<BookAnalytics> m_Analytics;
+
+        // Continuous quoting, if enabled
+        std::optional<Requoter> m_Requoter;
+        RequoteActions m_RequoteActions;
+
+        // Buffers of the order round trips, reused from a tick to the next
+        std::vector<Types::OrderRequest> m_Requests;
+        std::vector<Types::OrderRequest> m_GatedRequests;
+        std::vector<std::optional<IDvfSimulator::OrderID>> m_PlacedOrderIds;
+        std::unique_ptr<bool[]> m_CancelResults;
+        std::size_t m_CancelResultsCapacity{ 0 };
+
+        // Drives the periodic market refresh and asset printing of the trading session. The refresh is woken up by the events queued,
+        // from the thread of the market
+        BasicScheduler<Clock> m_Scheduler;
+        std::atomic<typename BasicScheduler<Clock>::TaskId> m_RefreshTask{ 0 };
     };
 
+    /// @brief Bot trading on any IDvfSimulator, through virtual calls
+    using Bot = BasicBot<SimulatorGateway, PrudentStrategy, IClock>;
+
+    extern template class BasicBot<SimulatorGateway, PrudentStrategy, IClock>;
 }
 
 
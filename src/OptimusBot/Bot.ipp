@@ -0,0 +1,533 @@
+#pragma once
+
+#include <algorithm>
+#include "Bot.h"
+#include "FastRandom.h"
+#include "Instrumentation.h"
+#include "Logger.h"
+#include "Scheduler.ipp"
+#include "Utilities.h"
+
+// Definitions of the members of BasicBot, included by the translation units instantiating a bot of their own policies.
+// The Bot over IDvfSimulator is instantiated once in Bot.cpp
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+bool OptimusBot::BasicBot<Gateway, Strategy, Clock>::PlaceInitialOrders(int numberOfOrdersEachSide)
+{
+    //Initial order book & best bid/ask pair
+    auto initialBestOrder = RefreshOrderBook();
+    if (!initialBestOrder)
+    {
+        Logging::Error("Failed to retrieve initial best bid/ask pair. Terminating application.");
+        return false;
+    }
+
+    OPTIMUSBOT_MEASURE(PLACE_ORDERS);
+    m_Strategy.MakeOrderRequests(m_Wallet, initialBestOrder.value(), numberOfOrdersEachSide, m_Requests);
+    PlaceOrders(m_Requests.data(), m_Requests.size());
+    CommitJournal();
+
+    return true;
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+bool OptimusBot::BasicBot<Gateway, Strategy, Clock>::PlaceInitialOrders(int numberOfOrdersEachSide, const Types::StrategyParameters& parameters, std::uint64_t seed)
+{
+    auto initialBestOrder = RefreshOrderBook();
+    if (!initialBestOrder)
+    {
+        Logging::Error("Failed to retrieve initial best bid/ask pair. Terminating application.");
+        return false;
+    }
+
+    FastRandom random{ seed };
+    OPTIMUSBOT_MEASURE(PLACE_ORDERS);
+    m_Strategy.MakeOrderRequests(m_Wallet, initialBestOrder.value(), numberOfOrdersEachSide, parameters, random, m_Requests);
+    PlaceOrders(m_Requests.data(), m_Requests.size());
+    CommitJournal();
+
+    return true;
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+bool OptimusBot::BasicBot<Gateway, Strategy, Clock>::OpenJournal(const std::string& path, const JournalConfig& config)
+{
+    auto journal = std::make_unique<Journal>(path, config);
+    if (!journal->IsOpen())
+    {
+        Logging::Error("Failed to open the journal {}, running without it.", path);
+        return false;
+    }
+
+    m_Journal = std::move(journal);
+    const auto& state = m_Journal->GetRecoveredState();
+    if (!state.Restored)
+    {
+        m_Journal->RecordWallet(m_Wallet);
+        CommitJournal();
+        return true;
+    }
+
+    m_Wallet = state.Wallet;
+    m_PendingOrders.Clear();
+    ReconcileRestoredOrders(state.PendingOrders);
+
+    m_RiskGate.ReleaseAll();
+    m_PendingOrders.ForEach([this](const Types::BotOrder& order) {
+        // The order rests on the market: its exposure is counted even over the limits, until it is filled or cancelled
+        const Types::OrderRequest request{ order.Side, order.Price, order.Volume };
+        const auto check = m_RiskGate.Check(request);
+        m_RiskGate.ForceReserve(request);
+        if (check != RiskCheck::PASSED)
+            Logging::Warning("\tRestored order {} exceeds the risk limits ({})", order.OrderId, GetRiskCheckName(check));
+    });
+
+    m_Journal->RecordWallet(m_Wallet);
+    CommitJournal();
+
+    Logging::Info("Restored {} pending orders and a wallet of {} ETH and {} USD from the journal ({} records replayed)",
+        m_PendingOrders.Size(), m_Wallet.ETH.ToDouble(), m_Wallet.USD.ToDouble(), state.RecordsReplayed);
+
+    return true;
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+void OptimusBot::BasicBot<Gateway, Strategy, Clock>::ReconcileRestoredOrders(const std::vector<Types::BotOrder>& orders)
+{
+    if (orders.empty())
+        return;
+
+    const auto orderLookup = m_Gateway.GetOrderLookup();
+    if (!orderLookup)
+    {
+        // Cancelling is the only way to tell whether the market knows the orders. Those it rejects were filled or never placed on it
+        std::vector<IDvfSimulator::OrderID> orderIds;
+        orderIds.reserve(orders.size());
+        for (const auto& order : orders)
+            orderIds.push_back(order.OrderId);
+
+        const auto results = std::make_unique<bool[]>(orderIds.size());
+        m_Gateway.CancelOrders(orderIds.data(), orderIds.size(), results.get());
+        for (std::size_t i = 0; i < orderIds.size(); i++)
+        {
+            if (!results[i])
+                Logging::Warning("\tRestored order {} is unknown to the market, dropped", orderIds[i]);
+            m_Journal->RecordCancelled(orderIds[i]);
+        }
+        return;
+    }
+
+    for (const auto& order : orders)
+    {
+        const auto remaining = orderLookup->GetRemaining(order.OrderId);
+        if (!remaining)
+        {
+            Logging::Warning("\tRestored order {} is not on the market anymore, dropped", order.OrderId);
+            m_Journal->RecordCancelled(order.OrderId);
+            continue;
+        }
+
+        const Types::BotOrder resting{ order.Side, order.OrderId, order.Price, std::min(remaining.value(), order.Volume) };
+        m_PendingOrders.Insert(resting);
+        if (resting.Volume == order.Volume)
+            continue;
+
+        // A partial fill is journaled as the fill of the order followed by the placement of what is left of it
+        m_FilledOrders.clear();
+        m_FilledOrders.emplace_back(order.Side, order.OrderId, order.Price, order.Volume - resting.Volume);
+        Utilities::UpdateWallet(m_Wallet, m_FilledOrders);
+        m_Journal->RecordFilled(order.OrderId);
+        m_Journal->RecordPlaced(resting);
+
+        if (m_FillObserver)
+            m_FillObserver(m_FilledOrders.front());
+    }
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+void OptimusBot::BasicBot<Gateway, Strategy, Clock>::EnableRequoting(const RequoterConfig& config)
+{
+    m_Requoter.emplace(config);
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+void OptimusBot::BasicBot<Gateway, Strategy, Clock>::EnableAnalytics(const BookAnalyticsConfig& config)
+{
+    m_Analytics.emplace(config);
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+void OptimusBot::BasicBot<Gateway, Strategy, Clock>::StartTradingSession()
+{
+    //"message loop", refresh the market state every 5 seconds & prints assets every 30s, sleeping in between.
+    // On a market pushing its events, the refresh is also woken up as soon as they are queued
+    m_RefreshTask = m_Scheduler.SchedulePeriodic(MarketRefreshInterval, [this]() {
+        if (!RefreshMarket())
+            m_Scheduler.Stop();
+    });
+
+    // Events queued before the task existed did not wake it up
+    if (m_Gateway.GetEventSource())
+        m_Scheduler.Wake(m_RefreshTask);
+
+    m_Scheduler.SchedulePeriodic(AssetBalancesInterval, [this]() {
+        PrintAssets();
+    });
+
+    if (m_Requoter || !m_PendingOrders.Empty())
+        m_Scheduler.Run();
+
+    CloseSession();
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+void OptimusBot::BasicBot<Gateway, Strategy, Clock>::StopTradingSession()
+{
+    m_Scheduler.Stop();
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+bool OptimusBot::BasicBot<Gateway, Strategy, Clock>::RefreshMarket()
+{
+    OPTIMUSBOT_MEASURE(TICK_TO_DECISION);
+
+    auto bestOrder = RefreshOrderBook();
+    if (!bestOrder)
+    {
+        Logging::Warning("Best bid/ask pair cannot be retrieved. Closing session.");
+        return false;
+    }
+
+    if (m_Analytics)
+    {
+        OPTIMUSBOT_MEASURE(ANALYTICS);
+        m_Analytics->Update(m_OrderBook);
+    }
+
+    // Pushed fills were processed as they were dispatched, polled ones are inferred from the best bid/ask pair
+    if (!m_Gateway.GetEventSource())
+    {
+        {
+            OPTIMUSBOT_MEASURE(ERASE_FILLED_ORDERS);
+            m_PendingOrders.EraseFilled(bestOrder.value(), m_FilledOrders);
+        }
+
+        {
+            OPTIMUSBOT_MEASURE(UPDATE_WALLET);
+            Utilities::UpdateWallet(m_Wallet, m_FilledOrders);
+            for (const auto& order : m_FilledOrders)
+                m_RiskGate.OnFilled(order);
+        }
+
+        if (m_Journal && !m_FilledOrders.empty())
+        {
+            for (const auto& order : m_FilledOrders)
+                m_Journal->RecordFilled(order.OrderId);
+            m_Journal->RecordWallet(m_Wallet);
+        }
+
+        if (m_FillObserver)
+        {
+            for (const auto& order : m_FilledOrders)
+                m_FillObserver(order);
+        }
+    }
+
+    if (m_Requoter)
+        Requote(bestOrder.value());
+
+    CommitJournal();
+
+    return m_Requoter.has_value() || !m_PendingOrders.Empty();
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+void OptimusBot::BasicBot<Gateway, Strategy, Clock>::PrintAssets() const
+{
+    Logging::Info("\tWallet composed of {} ETH and {} USD", m_Wallet.ETH.ToDouble(), m_Wallet.USD.ToDouble());
+
+    if (!m_PendingOrders.Empty())
+    {
+        Logging::Info("\tRemaining pending orders: ");
+        m_PendingOrders.ForEach([](const Types::BotOrder& order) {
+            Logging::Info("\t\t @ {} : {} {} (Id: {})", order.Price.ToDouble(), order.Volume.ToDouble(), order.Side == Types::OrderSide::BID ? "BID" : "ASK", order.OrderId);
+        });
+    }
+
+    Instrumentation::LogSummary();
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+void OptimusBot::BasicBot<Gateway, Strategy, Clock>::CloseSession()
+{
+    PrintAssets();
+
+    if (m_PendingOrders.Empty())
+        Logging::Info("All pending orders have been filled! Gracefully closing trading session.");
+    else
+    {
+        Logging::Warning("Something went wrong... Cancelling remaining pending orders and closing trading session.");
+
+        std::vector<IDvfSimulator::OrderID> orderIds;
+        orderIds.reserve(m_PendingOrders.Size());
+        m_PendingOrders.ForEach([&orderIds](const Types::BotOrder& order) {
+            orderIds.push_back(order.OrderId);
+        });
+
+        {
+            OPTIMUSBOT_MEASURE(CANCEL_ORDERS);
+            CancelOrders(orderIds.data(), orderIds.size());
+        }
+        CommitJournal();
+
+        // Still journaled as pending, for the next session to reconcile them with the market
+        m_PendingOrders.ForEach([](const Types::BotOrder& order) {
+            Logging::Warning("\tFailed to cancel order {}, kept pending", order.OrderId);
+        });
+    }
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+std::optional<OptimusBot::Types::BestOrder> OptimusBot::BasicBot<Gateway, Strategy, Clock>::RefreshOrderBook()
+{
+    {
+        OPTIMUSBOT_MEASURE(GET_ORDER_BOOK);
+        if (m_Gateway.GetEventSource())
+        {
+            // The events queued by the listener callbacks since the last refresh update the book and process the fills
+            {
+                const std::lock_guard<std::mutex> lock{ m_EventsMutex };
+                m_DispatchedEvents.swap(m_QueuedEvents);
+            }
+
+            for (const auto& event : m_DispatchedEvents)
+            {
+                if (const auto delta = std::get_if<Types::LevelDelta>(&event))
+                    m_OrderBook.Apply(*delta);
+                else if (const auto fill = std::get_if<FillEvent>(&event))
+                    ProcessFill(*fill);
+                else
+                    ForgetCancelled(std::get<IDvfSimulator::OrderID>(event));
+            }
+            m_DispatchedEvents.clear();
+        }
+        else
+        {
+            m_Deltas.clear();
+            m_Gateway.GetOrderBookDeltas(m_Deltas);
+            m_OrderBook.Apply(m_Deltas);
+        }
+    }
+
+    OPTIMUSBOT_MEASURE(BEST_ORDER);
+    return m_OrderBook.GetBestOrder();
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+void OptimusBot::BasicBot<Gateway, Strategy, Clock>::Requote(const Types::BestOrder& bestOrder)
+{
+    OPTIMUSBOT_MEASURE(REQUOTE);
+
+    m_Requoter->Diff(bestOrder, m_Wallet, m_PendingOrders, m_RequoteActions, m_Analytics ? &m_Analytics->GetFeatures() : nullptr);
+
+    // Cancellations first, the assets of the withdrawn orders covering the new ones
+    CancelOrders(m_RequoteActions.Cancels.data(), m_RequoteActions.Cancels.size());
+    PlaceOrders(m_RequoteActions.Places.data(), m_RequoteActions.Places.size());
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+void OptimusBot::BasicBot<Gateway, Strategy, Clock>::PlaceOrders(const Types::OrderRequest* requests, std::size_t count)
+{
+    m_GatedRequests.clear();
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const auto check = m_RiskGate.Reserve(requests[i]);
+        if (check == RiskCheck::PASSED)
+            m_GatedRequests.push_back(requests[i]);
+        else
+            Logging::Warning("\tOrder @ {} : {} {} rejected by the risk gate ({})", requests[i].Price.ToDouble(), requests[i].Volume.ToDouble(),
+                requests[i].Side == Types::OrderSide::BID ? "BID" : "ASK", GetRiskCheckName(check));
+    }
+
+    if (m_GatedRequests.empty())
+        return;
+
+    m_PlacedOrderIds.resize(m_GatedRequests.size());
+    m_Gateway.PlaceOrders(m_GatedRequests.data(), m_GatedRequests.size(), m_PlacedOrderIds.data());
+
+    for (std::size_t i = 0; i < m_GatedRequests.size(); i++)
+    {
+        const auto& request = m_GatedRequests[i];
+        if (!m_PlacedOrderIds[i])
+        {
+            m_RiskGate.Release(request.Side, request.Price, request.Volume);
+            continue;
+        }
+
+        // An id already pending cannot be tracked twice: the order is neither counted by the gate nor journaled
+        const Types::BotOrder order{ request.Side, m_PlacedOrderIds[i].value(), request.Price, request.Volume };
+        if (!m_PendingOrders.Insert(order))
+        {
+            Logging::Warning("\tOrder id {} returned twice by the market, not tracked", order.OrderId);
+            m_RiskGate.Release(request.Side, request.Price, request.Volume);
+            continue;
+        }
+
+        if (m_Journal)
+            m_Journal->RecordPlaced(order);
+    }
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+std::size_t OptimusBot::BasicBot<Gateway, Strategy, Clock>::CancelOrders(const IDvfSimulator::OrderID* orderIds, std::size_t count)
+{
+    if (count == 0)
+        return 0;
+
+    if (m_CancelResultsCapacity < count)
+    {
+        m_CancelResults = std::make_unique<bool[]>(count);
+        m_CancelResultsCapacity = count;
+    }
+
+    m_Gateway.CancelOrders(orderIds, count, m_CancelResults.get());
+
+    // An order failing to be cancelled may just have been filled, it is left to the fill detection.
+    // A market pushing its events has already reported the cancellations, the orders being forgotten then
+    std::size_t cancelled = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        if (!m_CancelResults[i])
+            continue;
+
+        ForgetCancelled(orderIds[i]);
+        cancelled++;
+    }
+
+    return cancelled;
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+bool OptimusBot::BasicBot<Gateway, Strategy, Clock>::ForgetCancelled(IDvfSimulator::OrderID orderId)
+{
+    const auto order = m_PendingOrders.Find(orderId);
+    if (!order)
+        return false;
+
+    m_RiskGate.Release(order->Side, order->Price, order->Volume);
+    m_PendingOrders.Erase(orderId);
+    if (m_Journal)
+        m_Journal->RecordCancelled(orderId);
+
+    return true;
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+void OptimusBot::BasicBot<Gateway, Strategy, Clock>::ProcessFill(const FillEvent& fill) noexcept
+{
+    const auto order = m_PendingOrders.Find(fill.OrderId);
+    if (!order)
+        return;
+
+    OPTIMUSBOT_MEASURE(UPDATE_WALLET);
+
+    // The order's own price, which a maker always trades at
+    const Types::BotOrder filled{ order->Side, order->OrderId, order->Price, std::min(fill.Volume, order->Volume) };
+    const Types::BotOrder remaining{ order->Side, order->OrderId, order->Price, order->Volume - filled.Volume };
+
+    const auto partial = remaining.Volume > Types::Quantity{};
+
+    m_PendingOrders.Erase(fill.OrderId);
+    if (partial)
+        m_PendingOrders.Insert(remaining);
+
+    m_FilledOrders.clear();
+    m_FilledOrders.push_back(filled);
+    Utilities::UpdateWallet(m_Wallet, m_FilledOrders);
+
+    // The order stays open, and counted as such by the gate, until what is left of it is filled or cancelled
+    if (partial)
+        m_RiskGate.OnPartialFill(filled);
+    else
+        m_RiskGate.OnFilled(filled);
+
+    // A partial fill is journaled as the fill of the order followed by the placement of what is left of it
+    if (m_Journal)
+    {
+        m_Journal->RecordFilled(fill.OrderId);
+        if (partial)
+            m_Journal->RecordPlaced(remaining);
+        m_Journal->RecordWallet(m_Wallet);
+    }
+
+    if (m_FillObserver)
+        m_FillObserver(filled);
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+void OptimusBot::BasicBot<Gateway, Strategy, Clock>::Enqueue(const MarketEvent& event) noexcept
+{
+    bool first;
+    {
+        const std::lock_guard<std::mutex> lock{ m_EventsMutex };
+        first = m_QueuedEvents.empty();
+        m_QueuedEvents.push_back(event);
+    }
+
+    // The next ones are processed by the refresh this one wakes up
+    if (first)
+        m_Scheduler.Wake(m_RefreshTask.load(std::memory_order_acquire));
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+void OptimusBot::BasicBot<Gateway, Strategy, Clock>::OnFill(const FillEvent& fill) noexcept
+{
+    Enqueue(fill);
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+void OptimusBot::BasicBot<Gateway, Strategy, Clock>::OnCancel(IDvfSimulator::OrderID orderId) noexcept
+{
+    Enqueue(orderId);
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+void OptimusBot::BasicBot<Gateway, Strategy, Clock>::OnBookChange(const Types::LevelDelta& delta) noexcept
+{
+    Enqueue(delta);
+}
+
+
+template <typename Gateway, typename Strategy, typename Clock>
+void OptimusBot::BasicBot<Gateway, Strategy, Clock>::CommitJournal()
+{
+    if (!m_Journal)
+        return;
+
+    if (!m_Journal->Commit())
+        Logging::Warning("Failed to commit the journal, the last events may be lost on a crash.");
+
+    if (m_Journal->GetRecordCount() >= m_Journal->GetConfig().CheckpointEvery && !m_Journal->Checkpoint(m_Wallet, m_PendingOrders))
+        Logging::Warning("Failed to checkpoint the journal.");
+}
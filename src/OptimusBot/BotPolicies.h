@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+#include "DvfSimulator.h"
+#include "FastRandom.h"
+#include "SimulatorExtensions.h"
+#include "SnapshotDeltaAdapter.h"
+#include "Types.h"
+#include "Utilities.h"
+
+/// @brief Compile-time policies of a BasicBot. A gateway connects the bot to its market, a strategy makes its initial orders:
+/// with its own parameters and randomness, and with the given parameters and generator, for reproducible sessions
+namespace OptimusBot
+{
+    /// @brief Gateway to any IDvfSimulator, whose optional capabilities are discovered once, when the gateway is built: each call goes
+    /// through the virtual functions of the simulator, the same binary trading on every kind of market
+    class SimulatorGateway final
+    {
+    public:
+        explicit SimulatorGateway(SimulatorPtr&& simulator)
+            : m_Simulator{ std::move(simulator) },
+            m_EventSource{ dynamic_cast<IMarketEventSource*>(m_Simulator.get()) },
+            m_DeltaSource{ dynamic_cast<IOrderBookDeltaSource*>(m_Simulator.get()) },
+            m_BufferedSource{ dynamic_cast<IBufferedOrderBookSource*>(m_Simulator.get()) },
+            m_BatchPlacer{ dynamic_cast<IBatchOrderPlacer*>(m_Simulator.get()) },
+            m_BatchCanceller{ dynamic_cast<IBatchOrderCanceller*>(m_Simulator.get()) },
+            m_OrderLookup{ dynamic_cast<IOrderLookup*>(m_Simulator.get()) }
+        {
+        }
+
+        /// @brief Market pushing its events, nullptr if the book is to be pulled
+        IMarketEventSource* GetEventSource() const noexcept
+        {
+            return m_EventSource;
+        }
+
+        /// @brief Market able to look its orders up, nullptr if it cannot
+        const IOrderLookup* GetOrderLookup() const noexcept
+        {
+            return m_OrderLookup;
+        }
+
+        void GetOrderBookDeltas(std::vector<Types::LevelDelta>& deltas) noexcept
+        {
+            if (m_DeltaSource)
+            {
+                m_DeltaSource->GetOrderBookDeltas(deltas);
+                return;
+            }
+
+            // Simulators unable to emit deltas are diffed snapshot to snapshot
+            if (m_BufferedSource)
+                m_BufferedSource->GetOrderBook(m_Snapshot);
+            else
+                m_Snapshot = m_Simulator->GetOrderBook();
+
+            m_SnapshotDiffer.Diff(m_Snapshot, deltas);
+        }
+
+        void PlaceOrders(const Types::OrderRequest* requests, std::size_t count, std::optional<IDvfSimulator::OrderID>* orderIds) noexcept
+        {
+            if (m_BatchPlacer)
+            {
+                m_BatchPlacer->PlaceOrders(requests, count, orderIds);
+                return;
+            }
+
+            for (std::size_t i = 0; i < count; i++)
+                orderIds[i] = m_Simulator->PlaceOrder(requests[i].Price.ToDouble(), requests[i].Amount());
+        }
+
+        void CancelOrders(const IDvfSimulator::OrderID* orderIds, std::size_t count, bool* results) noexcept
+        {
+            if (m_BatchCanceller)
+            {
+                m_BatchCanceller->CancelOrders(orderIds, count, results);
+                return;
+            }
+
+            for (std::size_t i = 0; i < count; i++)
+                results[i] = m_Simulator->CancelOrder(orderIds[i]);
+        }
+
+    private:
+        // Simulator's lifetime is tied to the gateway
+        SimulatorPtr m_Simulator;
+
+        // Last snapshot pulled by the gateway, diffed against the previous one
+        IDvfSimulator::OrderBook m_Snapshot;
+        SnapshotDiffer m_SnapshotDiffer;
+
+        // Capabilities of the simulator, nullptr for those it lacks
+        IMarketEventSource* m_EventSource;
+        IOrderBookDeltaSource* m_DeltaSource;
+        IBufferedOrderBookSource* m_BufferedSource;
+        IBatchOrderPlacer* m_BatchPlacer;
+        IBatchOrderCanceller* m_BatchCanceller;
+        IOrderLookup* m_OrderLookup;
+    };
+
+    /// @brief Gateway to a simulator of a type known at compile time: its capabilities are resolved by its base classes and every call
+    /// names the simulator's own function, bypassing the virtual dispatch, so that the compiler can inline the whole tick path.
+    /// A simulator derived from Simulator would have its overrides ignored: the type should be the exact type of the market
+    template <typename Simulator>
+    class DirectGateway final
+    {
+        static_assert(std::is_base_of_v<IDvfSimulator, Simulator>, "The gateway trades on an IDvfSimulator");
+
+        static constexpr bool HasEvents = std::is_base_of_v<IMarketEventSource, Simulator>;
+        static constexpr bool HasDeltas = std::is_base_of_v<IOrderBookDeltaSource, Simulator>;
+        static constexpr bool HasLookup = std::is_base_of_v<IOrderLookup, Simulator>;
+
+    public:
+        explicit DirectGateway(std::unique_ptr<Simulator>&& simulator) noexcept
+            : m_Simulator{ std::move(simulator) }
+        {
+        }
+
+        IMarketEventSource* GetEventSource() const noexcept
+        {
+            if constexpr (HasEvents)
+                return m_Simulator.get();
+            else
+                return nullptr;
+        }
+
+        const IOrderLookup* GetOrderLookup() const noexcept
+        {
+            if constexpr (HasLookup)
+                return m_Simulator.get();
+            else
+                return nullptr;
+        }
+
+        void GetOrderBookDeltas(std::vector<Types::LevelDelta>& deltas) noexcept
+        {
+            if constexpr (HasDeltas)
+            {
+                m_Simulator->Simulator::GetOrderBookDeltas(deltas);
+            }
+            else
+            {
+                if constexpr (std::is_base_of_v<IBufferedOrderBookSource, Simulator>)
+                    m_Simulator->Simulator::GetOrderBook(m_Snapshot);
+                else
+                    m_Snapshot = m_Simulator->Simulator::GetOrderBook();
+
+                m_SnapshotDiffer.Diff(m_Snapshot, deltas);
+            }
+        }
+
+        void PlaceOrders(const Types::OrderRequest* requests, std::size_t count, std::optional<IDvfSimulator::OrderID>* orderIds) noexcept
+        {
+            if constexpr (std::is_base_of_v<IBatchOrderPlacer, Simulator>)
+            {
+                m_Simulator->Simulator::PlaceOrders(requests, count, orderIds);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < count; i++)
+                    orderIds[i] = m_Simulator->Simulator::PlaceOrder(requests[i].Price.ToDouble(), requests[i].Amount());
+            }
+        }
+
+        void CancelOrders(const IDvfSimulator::OrderID* orderIds, std::size_t count, bool* results) noexcept
+        {
+            if constexpr (std::is_base_of_v<IBatchOrderCanceller, Simulator>)
+            {
+                m_Simulator->Simulator::CancelOrders(orderIds, count, results);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < count; i++)
+                    results[i] = m_Simulator->Simulator::CancelOrder(orderIds[i]);
+            }
+        }
+
+    private:
+        std::unique_ptr<Simulator> m_Simulator;
+
+        // Last snapshot pulled by the gateway, diffed against the previous one
+        IDvfSimulator::OrderBook m_Snapshot;
+        SnapshotDiffer m_SnapshotDiffer;
+    };
+
+    /// @brief Original "prudent" strategy, its prices and volumes being drawn from the global generator
+    class PrudentStrategy final
+    {
+    public:
+        void MakeOrderRequests(const Types::Wallet& wallet, const Types::BestOrder& bestOrder, int numberOfOrdersEachSide,
+            std::vector<Types::OrderRequest>& requests) noexcept
+        {
+            Utilities::MakePrudentOrderRequests(wallet, bestOrder, numberOfOrdersEachSide, requests);
+        }
+
+        void MakeOrderRequests(const Types::Wallet& wallet, const Types::BestOrder& bestOrder, int numberOfOrdersEachSide,
+            const Types::StrategyParameters& parameters, FastRandom& random, std::vector<Types::OrderRequest>& requests) noexcept
+        {
+            Utilities::MakePrudentOrderRequests(wallet, bestOrder, numberOfOrdersEachSide, parameters, random, requests);
+        }
+    };
+
+    /// @brief Prudent strategy with parameters fixed at compile time, e.g. the best ones found by the optimizer for a deployment,
+    /// given as a type holding them: struct Tuned { static constexpr Types::StrategyParameters Value{ 0.97, 1.03, 0.5 }; };
+    template <typename Parameters, std::uint64_t Seed = 0>
+    class TunedPrudentStrategy final
+    {
+    public:
+        static constexpr Types::StrategyParameters Value = Parameters::Value;
+
+        void MakeOrderRequests(const Types::Wallet& wallet, const Types::BestOrder& bestOrder, int numberOfOrdersEachSide,
+            std::vector<Types::OrderRequest>& requests) noexcept
+        {
+            Utilities::MakePrudentOrderRequests(wallet, bestOrder, numberOfOrdersEachSide, Value, m_Random, requests);
+        }
+
+        /// @brief Explicit parameters, e.g. those swept by the optimizer, take precedence over the compile-time ones
+        void MakeOrderRequests(const Types::Wallet& wallet, const Types::BestOrder& bestOrder, int numberOfOrdersEachSide,
+            const Types::StrategyParameters& parameters, FastRandom& random, std::vector<Types::OrderRequest>& requests) noexcept
+        {
+            Utilities::MakePrudentOrderRequests(wallet, bestOrder, numberOfOrdersEachSide, parameters, random, requests);
+        }
+
+    private:
+        FastRandom m_Random{ Seed };
+    };
+}
@@ -0,0 +1,151 @@
+#include "pch.h"
+#include <exception>
+#include "BotRuntime.h"
+#include "Logger.h"
+
+using namespace OptimusBot::Logging;
+
+
+OptimusBot::BotRuntime::BotRuntime(ThreadPool& pool, IClock& clock)
+    : m_Pool{ pool }, m_Scheduler{ clock }
+{
+}
+
+
+OptimusBot::BotRuntime::~BotRuntime() noexcept
+{
+    m_Scheduler.Stop();
+
+    std::unique_lock<std::mutex> lock{ m_StepsMutex };
+    m_StepsDone.wait(lock, [this]() { return m_PendingSteps == 0; });
+}
+
+
+OptimusBot::BotRuntime::BotId OptimusBot::BotRuntime::AddBot(std::unique_ptr<Bot>&& bot, std::chrono::steady_clock::duration marketRefreshInterval)
+{
+    auto hosted = std::make_unique<HostedBot>();
+    hosted->Instance = std::move(bot);
+    hosted->Id = m_Bots.size();
+
+    auto& hostedBot = *hosted;
+    m_Bots.push_back(std::move(hosted));
+    m_OpenSessions.fetch_add(1, std::memory_order_release);
+
+    // The scheduler thread only queues the steps, a refresh being skipped if the previous one is still queued or running
+    hostedBot.RefreshTask = m_Scheduler.SchedulePeriodic(marketRefreshInterval, [this, &hostedBot]() {
+        if (hostedBot.RefreshPending.exchange(true, std::memory_order_acq_rel))
+            return;
+
+        PostStep(hostedBot, [this, &hostedBot]() {
+            const auto open = hostedBot.Instance->RefreshMarket();
+            hostedBot.RefreshPending.store(false, std::memory_order_release);
+            return open;
+        });
+    });
+
+    hostedBot.PrintTask = m_Scheduler.SchedulePeriodic(Bot::AssetBalancesInterval, [this, &hostedBot]() {
+        PostStep(hostedBot, [&hostedBot]() {
+            hostedBot.Instance->PrintAssets();
+            return true;
+        });
+    });
+
+    return hostedBot.Id;
+}
+
+
+void OptimusBot::BotRuntime::Run()
+{
+    // Returns once every session closed itself (cancelling its tasks) or Stop is called
+    m_Scheduler.Run();
+
+    std::vector<std::future<void>> closings;
+    closings.reserve(m_Bots.size());
+    for (auto& bot : m_Bots)
+    {
+        closings.push_back(m_Pool.Submit([this, &bot]() {
+            const std::lock_guard<std::mutex> lock{ bot->Mutex };
+            Close(*bot);
+        }));
+    }
+
+    for (auto& closing : closings)
+        closing.wait();
+
+    // Steps queued before the closings return without doing anything, the sessions being closed
+    std::unique_lock<std::mutex> lock{ m_StepsMutex };
+    m_StepsDone.wait(lock, [this]() { return m_PendingSteps == 0; });
+}
+
+
+void OptimusBot::BotRuntime::Stop()
+{
+    m_Scheduler.Stop();
+}
+
+
+template <typename Step>
+void OptimusBot::BotRuntime::PostStep(HostedBot& bot, Step step)
+{
+    {
+        const std::lock_guard<std::mutex> lock{ m_StepsMutex };
+        m_PendingSteps++;
+    }
+
+    m_Pool.Post([this, &bot, step]() {
+        RunStep(bot, step);
+
+        const std::lock_guard<std::mutex> lock{ m_StepsMutex };
+        if (--m_PendingSteps == 0)
+            m_StepsDone.notify_all();
+    });
+}
+
+
+template <typename Step>
+void OptimusBot::BotRuntime::RunStep(HostedBot& bot, Step step) noexcept
+{
+    const std::lock_guard<std::mutex> lock{ bot.Mutex };
+    if (bot.Closed)
+        return;
+
+    try
+    {
+        if (!step())
+            Close(bot);
+    }
+    catch (const std::exception& exception)
+    {
+        Error("Bot {} failed: {}", bot.Id, exception.what());
+        m_FailedSessions.fetch_add(1, std::memory_order_release);
+        Close(bot);
+    }
+    catch (...)
+    {
+        Error("Bot {} failed with an unknown exception", bot.Id);
+        m_FailedSessions.fetch_add(1, std::memory_order_release);
+        Close(bot);
+    }
+}
+
+
+void OptimusBot::BotRuntime::Close(HostedBot& bot) noexcept
+{
+    if (bot.Closed)
+        return;
+
+    bot.Closed = true;
+    m_Scheduler.Cancel(bot.RefreshTask);
+    m_Scheduler.Cancel(bot.PrintTask);
+
+    try
+    {
+        bot.Instance->CloseSession();
+    }
+    catch (...)
+    {
+        Error("Bot {} failed to close its session, its orders may not all be cancelled", bot.Id);
+    }
+
+    m_OpenSessions.fetch_sub(1, std::memory_order_acq_rel);
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Bot.h"
+#include "Clock.h"
+#include "Scheduler.h"
+#include "ThreadPool.h"
+
+namespace OptimusBot
+{
+    /// @brief Hosts many bots in the same process: a single scheduler thread triggers the session steps of every bot,
+    /// which are executed on a thread pool. The steps of a given bot never run concurrently, and a bot failing (throwing)
+    /// is closed without affecting the others
+    class BotRuntime final
+    {
+    public:
+        using BotId = std::size_t;
+
+        /// @param pool Pool executing the session steps. Must outlive the runtime
+        /// @param clock Time line of the sessions. Must outlive the runtime
+        explicit BotRuntime(ThreadPool& pool, IClock& clock = SteadyClock::Instance());
+
+        /// @brief Waits for the steps still running, without closing the sessions
+        ~BotRuntime() noexcept;
+
+        BotRuntime(const BotRuntime&) = delete;
+        BotRuntime& operator=(const BotRuntime&) = delete;
+
+        /// @brief Adds a bot, whose initial orders are already placed, and schedules its session. Should be called before Run
+        /// @param marketRefreshInterval Period of the bot's market refresh
+        /// @return Id of the bot
+        BotId AddBot(std::unique_ptr<Bot>&& bot, std::chrono::steady_clock::duration marketRefreshInterval = Bot::MarketRefreshInterval);
+
+        /// @brief Runs the sessions until they are all closed or Stop is called, then closes the remaining ones (cancelling their orders)
+        void Run();
+
+        /// @brief Makes Run close all the sessions and return. Can be called from any thread
+        void Stop();
+
+        std::size_t GetBotCount() const noexcept
+        {
+            return m_Bots.size();
+        }
+
+        /// @brief Number of sessions not closed yet
+        std::size_t GetOpenSessionCount() const noexcept
+        {
+            return m_OpenSessions.load(std::memory_order_acquire);
+        }
+
+        /// @brief Number of sessions closed because of an exception
+        std::size_t GetFailedSessionCount() const noexcept
+        {
+            return m_FailedSessions.load(std::memory_order_acquire);
+        }
+
+        /// @brief Bot hosted. Not thread-safe, should not be called while Run is executing
+        const Bot& GetBot(BotId id) const noexcept
+        {
+            return *m_Bots[id]->Instance;
+        }
+
+    private:
+        struct HostedBot
+        {
+            std::unique_ptr<Bot> Instance;
+            BotId Id;
+            Scheduler::TaskId RefreshTask{ 0 };
+            Scheduler::TaskId PrintTask{ 0 };
+
+            // Serializes the steps of the bot, set while a market refresh is queued or running so that overrunning ones are skipped
+            std::mutex Mutex;
+            std::atomic<bool> RefreshPending{ false };
+            bool Closed{ false };
+        };
+
+        /// @brief Queues a step of the bot on the pool, keeping track of it until executed
+        template <typename Step>
+        void PostStep(HostedBot& bot, Step step);
+
+        /// @brief Runs a step of the bot, closing its session if the step fails or returns false. Locks the bot
+        template <typename Step>
+        void RunStep(HostedBot& bot, Step step) noexcept;
+
+        /// @brief Closes the session of the bot, if not closed yet. The bot must be locked
+        void Close(HostedBot& bot) noexcept;
+
+        ThreadPool& m_Pool;
+        Scheduler m_Scheduler;
+
+        std::vector<std::unique_ptr<HostedBot>> m_Bots;
+        std::atomic<std::size_t> m_OpenSessions{ 0 };
+        std::atomic<std::size_t> m_FailedSessions{ 0 };
+
+        // Steps queued or running, waited for before the runtime returns from Run or is destroyed
+        std::mutex m_StepsMutex;
+        std::condition_variable m_StepsDone;
+        std::size_t m_PendingSteps{ 0 };
+    };
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace OptimusBot
+{
+    /// @brief Source of time for the components waiting on deadlines, allowing backtests to run on a virtual time line
+    class IClock
+    {
+    public:
+        using TimePoint = std::chrono::steady_clock::time_point;
+
+        virtual ~IClock() noexcept = default;
+
+        /// @brief Current time
+        virtual TimePoint Now() const noexcept = 0;
+
+        /// @brief Blocks until the deadline is reached or the condition variable is notified. Spurious returns are allowed
+        /// @param wakeUp Condition variable notified to wake the caller up early
+        /// @param lock Lock held by the caller, released while waiting
+        /// @param deadline Time to wait for
+        virtual void WaitUntil(std::condition_variable& wakeUp, std::unique_lock<std::mutex>& lock, TimePoint deadline) = 0;
+    };
+
+    /// @brief Wall clock, based on std::chrono::steady_clock
+    class SteadyClock final : public IClock
+    {
+    public:
+        /// @brief Shared instance, the clock being stateless
+        static SteadyClock& Instance() noexcept
+        {
+            static SteadyClock instance;
+            return instance;
+        }
+
+        TimePoint Now() const noexcept override
+        {
+            return std::chrono::steady_clock::now();
+        }
+
+        void WaitUntil(std::condition_variable& wakeUp, std::unique_lock<std::mutex>& lock, TimePoint deadline) override
+        {
+            wakeUp.wait_until(lock, deadline);
+        }
+    };
+
+    /// @brief Virtual clock, only moving forward when waited on or explicitly advanced: waiting never blocks, it jumps to the deadline
+    class VirtualClock final : public IClock
+    {
+    public:
+        explicit VirtualClock(TimePoint start = TimePoint{}) noexcept
+            : m_Now{ start.time_since_epoch().count() }
+        {
+        }
+
+        TimePoint Now() const noexcept override
+        {
+            return TimePoint{ TimePoint::duration{ m_Now.load(std::memory_order_acquire) } };
+        }
+
+        void WaitUntil(std::condition_variable&, std::unique_lock<std::mutex>&, TimePoint deadline) override
+        {
+            AdvanceTo(deadline);
+        }
+
+        /// @brief Moves the clock forward to the given time. Has no effect if that time is in the past
+        void AdvanceTo(TimePoint time) noexcept
+        {
+            auto now = m_Now.load(std::memory_order_relaxed);
+            const auto target = time.time_since_epoch().count();
+            while (now < target && !m_Now.compare_exchange_weak(now, target, std::memory_order_acq_rel))
+            {
+            }
+        }
+
+    private:
+        std::atomic<TimePoint::rep> m_Now;
+    };
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace OptimusBot
+{
+    /// @brief Seedable xoshiro256** pseudo-random generator: a few cycles per number, no shared state, fully reproducible.
+    /// Satisfies UniformRandomBitGenerator, so it can also drive the std distributions
+    class FastRandom final
+    {
+    public:
+        using result_type = std::uint64_t;
+
+        explicit FastRandom(std::uint64_t seed) noexcept
+        {
+            // The state is expanded from the seed with splitmix64, as recommended by the xoshiro authors
+            for (auto& word : m_State)
+            {
+                seed += 0x9E3779B97F4A7C15ull;
+                auto z = seed;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                word = z ^ (z >> 31);
+            }
+        }
+
+        static constexpr result_type min() noexcept
+        {
+            return 0;
+        }
+
+        static constexpr result_type max() noexcept
+        {
+            return std::numeric_limits<result_type>::max();
+        }
+
+        result_type operator()() noexcept
+        {
+            const auto result = RotateLeft(m_State[1] * 5, 7) * 9;
+            const auto t = m_State[1] << 17;
+
+            m_State[2] ^= m_State[0];
+            m_State[3] ^= m_State[1];
+            m_State[1] ^= m_State[2];
+            m_State[0] ^= m_State[3];
+            m_State[2] ^= t;
+            m_State[3] = RotateLeft(m_State[3], 45);
+
+            return result;
+        }
+
+        /// @brief Uniform double within [0, 1)
+        double NextDouble() noexcept
+        {
+            return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+        }
+
+        /// @brief Uniform double within [min, max)
+        double NextDouble(double min, double max) noexcept
+        {
+            return min + (max - min) * NextDouble();
+        }
+
+        /// @brief Standard normal deviate (Marsaglia polar method, the second deviate of each pair being cached)
+        double NextNormal() noexcept
+        {
+            if (m_HasSpareNormal)
+            {
+                m_HasSpareNormal = false;
+                return m_SpareNormal;
+            }
+
+            double u, v, s;
+            do
+            {
+                u = 2.0 * NextDouble() - 1.0;
+                v = 2.0 * NextDouble() - 1.0;
+                s = u * u + v * v;
+            } while (s >= 1.0 || s == 0.0);
+
+            const auto factor = std::sqrt(-2.0 * std::log(s) / s);
+            m_SpareNormal = v * factor;
+            m_HasSpareNormal = true;
+
+            return u * factor;
+        }
+
+    private:
+        static std::uint64_t RotateLeft(std::uint64_t x, int k) noexcept
+        {
+            return (x << k) | (x >> (64 - k));
+        }
+
+        std::uint64_t m_State[4];
+        double m_SpareNormal{ 0.0 };
+        bool m_HasSpareNormal{ false };
+    };
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+
+namespace OptimusBot
+{
+    /// @brief Strongly typed fixed-point number, stored as an integer count of 1/Scale units: the arithmetic and comparisons are exact
+    /// integer operations, and values of different tags (e.g. prices and quantities) do not mix.
+    /// Doubles are converted explicitly, rounded to the nearest unit, at the boundary with the simulators
+    /// @tparam Tag Empty type telling the quantities apart
+    /// @tparam UnitsPerOne Number of units in 1.0, e.g. 100 for cents
+    template <typename Tag, std::int64_t UnitsPerOne>
+    class FixedPoint final
+    {
+    public:
+        static_assert(UnitsPerOne > 0, "The scale of a fixed-point number must be positive");
+
+        static constexpr std::int64_t Scale = UnitsPerOne;
+
+        constexpr FixedPoint() noexcept = default;
+
+        explicit FixedPoint(double value) noexcept
+            : m_Units{ static_cast<std::int64_t>(std::llround(value * static_cast<double>(Scale))) }
+        {
+        }
+
+        static constexpr FixedPoint FromUnits(std::int64_t units) noexcept
+        {
+            FixedPoint value;
+            value.m_Units = units;
+            return value;
+        }
+
+        constexpr std::int64_t Units() const noexcept
+        {
+            return m_Units;
+        }
+
+        constexpr double ToDouble() const noexcept
+        {
+            return static_cast<double>(m_Units) / static_cast<double>(Scale);
+        }
+
+        constexpr FixedPoint& operator+=(FixedPoint other) noexcept
+        {
+            m_Units += other.m_Units;
+            return *this;
+        }
+
+        constexpr FixedPoint& operator-=(FixedPoint other) noexcept
+        {
+            m_Units -= other.m_Units;
+            return *this;
+        }
+
+        friend constexpr FixedPoint operator+(FixedPoint lhs, FixedPoint rhs) noexcept { return FromUnits(lhs.m_Units + rhs.m_Units); }
+        friend constexpr FixedPoint operator-(FixedPoint lhs, FixedPoint rhs) noexcept { return FromUnits(lhs.m_Units - rhs.m_Units); }
+        friend constexpr FixedPoint operator-(FixedPoint value) noexcept { return FromUnits(-value.m_Units); }
+        friend constexpr FixedPoint operator*(FixedPoint value, std::int64_t factor) noexcept { return FromUnits(value.m_Units * factor); }
+        friend constexpr FixedPoint operator*(std::int64_t factor, FixedPoint value) noexcept { return FromUnits(value.m_Units * factor); }
+
+        friend constexpr bool operator==(FixedPoint lhs, FixedPoint rhs) noexcept { return lhs.m_Units == rhs.m_Units; }
+        friend constexpr bool operator!=(FixedPoint lhs, FixedPoint rhs) noexcept { return lhs.m_Units != rhs.m_Units; }
+        friend constexpr bool operator<(FixedPoint lhs, FixedPoint rhs) noexcept { return lhs.m_Units < rhs.m_Units; }
+        friend constexpr bool operator<=(FixedPoint lhs, FixedPoint rhs) noexcept { return lhs.m_Units <= rhs.m_Units; }
+        friend constexpr bool operator>(FixedPoint lhs, FixedPoint rhs) noexcept { return lhs.m_Units > rhs.m_Units; }
+        friend constexpr bool operator>=(FixedPoint lhs, FixedPoint rhs) noexcept { return lhs.m_Units >= rhs.m_Units; }
+
+        friend std::ostream& operator<<(std::ostream& output, FixedPoint value)
+        {
+            return output << value.ToDouble();
+        }
+
+    private:
+        std::int64_t m_Units{ 0 };
+    };
+}
@@ -0,0 +1,75 @@
+#include "pch.h"
+#include <array>
+#include "Instrumentation.h"
+#include "Logger.h"
+
+namespace
+{
+    constexpr auto stageCount = static_cast<std::size_t>(OptimusBot::Instrumentation::Stage::COUNT);
+
+    std::array<OptimusBot::LatencyHistogram, stageCount>& GetHistograms() noexcept
+    {
+        static std::array<OptimusBot::LatencyHistogram, stageCount> histograms;
+        return histograms;
+    }
+}
+
+
+const char* OptimusBot::Instrumentation::GetStageName(Stage stage) noexcept
+{
+    switch (stage)
+    {
+    case Stage::GET_ORDER_BOOK:
+        return "GetOrderBook";
+    case Stage::BEST_ORDER:
+        return "BestOrder";
+    case Stage::ERASE_FILLED_ORDERS:
+        return "EraseFilledOrders";
+    case Stage::UPDATE_WALLET:
+        return "UpdateWallet";
+    case Stage::PLACE_ORDERS:
+        return "PlaceOrders";
+    case Stage::CANCEL_ORDERS:
+        return "CancelOrders";
+    case Stage::REQUOTE:
+        return "Requote";
+    case Stage::ANALYTICS:
+        return "Analytics";
+    case Stage::TICK_TO_DECISION:
+        return "TickToDecision";
+    default:
+        return "Unknown";
+    }
+}
+
+
+OptimusBot::LatencyHistogram& OptimusBot::Instrumentation::GetHistogram(Stage stage) noexcept
+{
+    return GetHistograms()[static_cast<std::size_t>(stage)];
+}
+
+
+void OptimusBot::Instrumentation::LogSummary() noexcept
+{
+    // The percentiles are computed by walking the histograms, not worth it when nothing is logged
+    if (!Logging::Logger::Instance().IsEnabled(Logging::Level::INFO))
+        return;
+
+    for (std::size_t i = 0; i < stageCount; i++)
+    {
+        const auto stage = static_cast<Stage>(i);
+        const auto& histogram = GetHistogram(stage);
+        if (histogram.GetCount() == 0)
+            continue;
+
+        Logging::Info("\t{} latency (ns): p50 {}, p99 {}, p99.9 {}, max {} over {} samples", GetStageName(stage),
+            histogram.GetPercentile(50.0), histogram.GetPercentile(99.0), histogram.GetPercentile(99.9), histogram.GetMax(), histogram.GetCount());
+    }
+}
+
+
+void OptimusBot::Instrumentation::Reset() noexcept
+{
+    for (auto& histogram : GetHistograms())
+        histogram.Reset();
+}
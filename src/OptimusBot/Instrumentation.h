@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include "LatencyHistogram.h"
+
+// Latency instrumentation of the hot path, compiled in unless OPTIMUSBOT_INSTRUMENTATION is defined to 0
+#ifndef OPTIMUSBOT_INSTRUMENTATION
+#define OPTIMUSBOT_INSTRUMENTATION 1
+#endif
+
+/// @brief Per-stage latencies of the trading session, recorded into process-wide histograms
+namespace OptimusBot::Instrumentation
+{
+    /// @brief Stages of a tick measured by the bot
+    enum class Stage
+    {
+        GET_ORDER_BOOK,      // Pulling the market state from the simulator
+        BEST_ORDER,          // Extracting the best bid/ask pair from the maintained book
+        ERASE_FILLED_ORDERS,
+        UPDATE_WALLET,
+        PLACE_ORDERS,        // Placing the initial orders, in a single batch if possible
+        CANCEL_ORDERS,       // Cancelling the remaining orders at shutdown
+        REQUOTE,             // Diffing the wanted quotes against the pending orders and sending the changes
+        ANALYTICS,           // Updating the features of the book
+        TICK_TO_DECISION,    // Whole market refresh, from the pull to the processing of the fills
+        COUNT
+    };
+
+    const char* GetStageName(Stage stage) noexcept;
+
+    /// @brief Histogram of a stage, shared by all the bots of the process
+    LatencyHistogram& GetHistogram(Stage stage) noexcept;
+
+    /// @brief Logs the p50/p99/p99.9/max latencies of the stages measured so far
+    void LogSummary() noexcept;
+
+    /// @brief Forgets the latencies measured so far
+    void Reset() noexcept;
+
+    /// @brief Records the time elapsed between its construction and its destruction into the histogram of a stage
+    class ScopedTimer final
+    {
+    public:
+        explicit ScopedTimer(Stage stage) noexcept
+            : m_Histogram{ GetHistogram(stage) }, m_Start{ std::chrono::steady_clock::now() }
+        {
+        }
+
+        ~ScopedTimer() noexcept
+        {
+            const auto elapsed = std::chrono::steady_clock::now() - m_Start;
+            m_Histogram.Record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        LatencyHistogram& m_Histogram;
+        const std::chrono::steady_clock::time_point m_Start;
+    };
+}
+
+#define OPTIMUSBOT_CONCATENATE_(a, b) a##b
+#define OPTIMUSBOT_CONCATENATE(a, b) OPTIMUSBOT_CONCATENATE_(a, b)
+
+/// @brief Measures the rest of the enclosing scope as the given stage (e.g. OPTIMUSBOT_MEASURE(UPDATE_WALLET)). Expands to nothing if
+/// the instrumentation is compiled out
+#if OPTIMUSBOT_INSTRUMENTATION
+#define OPTIMUSBOT_MEASURE(stage) \
+    const ::OptimusBot::Instrumentation::ScopedTimer OPTIMUSBOT_CONCATENATE(optimusBotTimer, __LINE__){ ::OptimusBot::Instrumentation::Stage::stage }
+#else
+#define OPTIMUSBOT_MEASURE(stage) static_cast<void>(0)
+#endif
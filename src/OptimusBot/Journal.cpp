@@ -0,0 +1,422 @@
+#include "pch.h"
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include "Journal.h"
+#include "MappedFile.h"
+#include "PendingOrders.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace OptimusBot::Types;
+
+namespace
+{
+    // Layout of a log record, whose checksum covers the bytes following it. The zeroed end of the log never passes the checksum
+    struct Record
+    {
+        std::uint32_t Checksum;
+        std::uint32_t Sequence;
+        std::uint32_t OrderId;
+        std::uint8_t Type;
+        std::uint8_t Side;
+        std::uint16_t Reserved;
+        std::int64_t First;
+        std::int64_t Second;
+    };
+
+    struct SnapshotHeader
+    {
+        std::uint32_t Magic;
+        std::uint32_t Version;
+        std::uint32_t LastSequence;
+        std::uint32_t OrderCount;
+        std::int64_t ETH;
+        std::int64_t USD;
+    };
+
+    struct SnapshotOrder
+    {
+        std::uint32_t OrderId;
+        std::uint8_t Side;
+        std::uint8_t Reserved[3];
+        std::int64_t Price;
+        std::int64_t Volume;
+    };
+
+    constexpr std::uint32_t SnapshotMagic = 0x534A424F; // "OBJS"
+    constexpr std::uint32_t SnapshotVersion = 1;
+
+    static_assert(sizeof(Record) == 32, "Log records are expected to be tightly packed");
+    static_assert(sizeof(SnapshotHeader) == 32 && sizeof(SnapshotOrder) == 24, "Snapshot entries are expected to be tightly packed");
+
+    // FNV-1a, enough to tell a torn or zeroed record from a written one
+    std::uint32_t Checksum(const std::uint8_t* data, std::size_t size) noexcept
+    {
+        std::uint32_t hash = 2166136261u;
+        for (std::size_t i = 0; i < size; i++)
+            hash = (hash ^ data[i]) * 16777619u;
+
+        return hash;
+    }
+
+    std::uint32_t Checksum(const Record& record) noexcept
+    {
+        const auto bytes = reinterpret_cast<const std::uint8_t*>(&record);
+        return Checksum(bytes + sizeof(record.Checksum), sizeof(Record) - sizeof(record.Checksum));
+    }
+
+    // Writes the file aside then renames it over the previous one, so that a crash leaves either version whole
+    bool WriteFileAtomically(const std::string& path, const std::vector<std::uint8_t>& content, bool sync) noexcept
+    {
+        const auto temporaryPath = path + ".tmp";
+#ifdef _WIN32
+        const auto file = CreateFileA(temporaryPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        DWORD written = 0;
+        auto succeeded = WriteFile(file, content.data(), static_cast<DWORD>(content.size()), &written, nullptr) && written == content.size();
+        if (succeeded && sync)
+            succeeded = FlushFileBuffers(file) != 0;
+        CloseHandle(file);
+
+        return succeeded && MoveFileExA(temporaryPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+        const auto file = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (file < 0)
+            return false;
+
+        auto succeeded = write(file, content.data(), content.size()) == static_cast<ssize_t>(content.size());
+        if (succeeded && sync)
+            succeeded = fsync(file) == 0;
+        close(file);
+
+        return succeeded && std::rename(temporaryPath.c_str(), path.c_str()) == 0;
+#endif
+    }
+}
+
+
+OptimusBot::Journal::Journal(const std::string& path, const JournalConfig& config)
+    : m_Path{ path }, m_Config{ config }
+{
+#ifdef _WIN32
+    const auto file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+    m_File = file;
+
+    LARGE_INTEGER fileSize;
+    const auto size = GetFileSizeEx(file, &fileSize) ? static_cast<std::size_t>(fileSize.QuadPart) : 0;
+#else
+    m_File = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (m_File < 0)
+        return;
+
+    struct stat status;
+    const auto size = fstat(m_File, &status) == 0 ? static_cast<std::size_t>(status.st_size) : 0;
+#endif
+
+    // Whole segments, so that records never straddle the end of the mapping
+    const auto segments = std::max<std::size_t>(1, (size + m_Config.SegmentSize - 1) / m_Config.SegmentSize);
+    if (Map(segments * m_Config.SegmentSize))
+        Recover();
+}
+
+
+OptimusBot::Journal::~Journal() noexcept
+{
+    Unmap();
+#ifdef _WIN32
+    if (m_File)
+        CloseHandle(m_File);
+#else
+    if (m_File >= 0)
+        close(m_File);
+#endif
+}
+
+
+void OptimusBot::Journal::RecordWallet(const Wallet& wallet) noexcept
+{
+    Append(RecordType::WALLET, OrderSide::BID, 0, wallet.ETH.Units(), wallet.USD.Units());
+}
+
+
+void OptimusBot::Journal::RecordPlaced(const BotOrder& order) noexcept
+{
+    Append(RecordType::PLACED, order.Side, order.OrderId, order.Price.Units(), order.Volume.Units());
+}
+
+
+void OptimusBot::Journal::RecordFilled(IDvfSimulator::OrderID orderId) noexcept
+{
+    Append(RecordType::FILLED, OrderSide::BID, orderId, 0, 0);
+}
+
+
+void OptimusBot::Journal::RecordCancelled(IDvfSimulator::OrderID orderId) noexcept
+{
+    Append(RecordType::CANCELLED, OrderSide::BID, orderId, 0, 0);
+}
+
+
+bool OptimusBot::Journal::Commit() noexcept
+{
+    if (!IsOpen())
+        return false;
+
+    if (m_CommittedOffset == m_WriteOffset)
+        return true;
+
+    auto succeeded = true;
+    if (m_Config.Sync)
+    {
+        // Flushes the pages holding the new records only
+        constexpr std::size_t pageSize = 4096;
+        const auto begin = m_CommittedOffset / pageSize * pageSize;
+#ifdef _WIN32
+        succeeded = FlushViewOfFile(m_Data + begin, m_WriteOffset - begin) && FlushFileBuffers(m_File);
+#else
+        succeeded = msync(m_Data + begin, m_WriteOffset - begin, MS_SYNC) == 0;
+#endif
+    }
+
+    if (succeeded)
+        m_CommittedOffset = m_WriteOffset;
+
+    return succeeded;
+}
+
+
+bool OptimusBot::Journal::Checkpoint(const Wallet& wallet, const PendingOrders& pendingOrders)
+{
+    if (!IsOpen())
+        return false;
+
+    SnapshotHeader header{};
+    header.Magic = SnapshotMagic;
+    header.Version = SnapshotVersion;
+    header.LastSequence = m_NextSequence - 1;
+    header.OrderCount = static_cast<std::uint32_t>(pendingOrders.Size());
+    header.ETH = wallet.ETH.Units();
+    header.USD = wallet.USD.Units();
+
+    std::vector<std::uint8_t> content(sizeof(SnapshotHeader) + pendingOrders.Size() * sizeof(SnapshotOrder) + sizeof(std::uint32_t));
+    std::memcpy(content.data(), &header, sizeof(header));
+
+    auto position = content.data() + sizeof(header);
+    pendingOrders.ForEach([&position](const BotOrder& order) {
+        SnapshotOrder entry{};
+        entry.OrderId = order.OrderId;
+        entry.Side = static_cast<std::uint8_t>(order.Side);
+        entry.Price = order.Price.Units();
+        entry.Volume = order.Volume.Units();
+        std::memcpy(position, &entry, sizeof(entry));
+        position += sizeof(entry);
+    });
+
+    const auto checksum = Checksum(content.data(), content.size() - sizeof(std::uint32_t));
+    std::memcpy(position, &checksum, sizeof(checksum));
+
+    if (!WriteFileAtomically(m_Path + ".snapshot", content, m_Config.Sync))
+        return false;
+
+    // The records left in the log are older than the snapshot: they are skipped, then overwritten
+    m_WriteOffset = 0;
+    m_CommittedOffset = 0;
+
+    return true;
+}
+
+
+void OptimusBot::Journal::Append(RecordType type, OrderSide side, IDvfSimulator::OrderID orderId, std::int64_t first, std::int64_t second) noexcept
+{
+    if (!IsOpen())
+        return;
+
+    if (m_WriteOffset + RecordSize > m_Size && !Map(m_Size + m_Config.SegmentSize))
+        return;
+
+    Record record{};
+    record.Sequence = m_NextSequence++;
+    record.OrderId = orderId;
+    record.Type = static_cast<std::uint8_t>(type);
+    record.Side = static_cast<std::uint8_t>(side);
+    record.First = first;
+    record.Second = second;
+    record.Checksum = Checksum(record);
+
+    std::memcpy(m_Data + m_WriteOffset, &record, sizeof(record));
+    m_WriteOffset += RecordSize;
+}
+
+
+void OptimusBot::Journal::Recover()
+{
+    std::uint32_t lastSequence = 0;
+    std::unordered_map<IDvfSimulator::OrderID, BotOrder> orders;
+
+    const MappedFile snapshot{ m_Path + ".snapshot" };
+    SnapshotHeader header{};
+    if (snapshot.IsOpen() && snapshot.Size() >= sizeof(header) + sizeof(std::uint32_t))
+    {
+        std::memcpy(&header, snapshot.Data(), sizeof(header));
+
+        std::uint32_t checksum = 0;
+        const auto expectedSize = sizeof(header) + std::size_t{ header.OrderCount } * sizeof(SnapshotOrder) + sizeof(checksum);
+        auto valid = header.Magic == SnapshotMagic && header.Version == SnapshotVersion && snapshot.Size() == expectedSize;
+        if (valid)
+        {
+            std::memcpy(&checksum, snapshot.Data() + expectedSize - sizeof(checksum), sizeof(checksum));
+            valid = checksum == Checksum(snapshot.Data(), expectedSize - sizeof(checksum));
+        }
+
+        if (valid)
+        {
+            lastSequence = header.LastSequence;
+            m_RecoveredState.Restored = true;
+            m_RecoveredState.Wallet.ETH = Quantity::FromUnits(header.ETH);
+            m_RecoveredState.Wallet.USD = Notional::FromUnits(header.USD);
+
+            for (std::uint32_t i = 0; i < header.OrderCount; i++)
+            {
+                SnapshotOrder entry;
+                std::memcpy(&entry, snapshot.Data() + sizeof(header) + i * sizeof(entry), sizeof(entry));
+                orders.emplace(entry.OrderId, BotOrder{ static_cast<OrderSide>(entry.Side), entry.OrderId, Price::FromUnits(entry.Price), Quantity::FromUnits(entry.Volume) });
+            }
+        }
+    }
+
+    // Replays the run of consecutive records, the ones not newer than the snapshot being already part of it
+    std::size_t offset = 0;
+    std::uint32_t previousSequence = 0;
+    for (; offset + RecordSize <= m_Size; offset += RecordSize)
+    {
+        Record record;
+        std::memcpy(&record, m_Data + offset, sizeof(record));
+        if (record.Checksum != Checksum(record) || (offset > 0 && record.Sequence != previousSequence + 1))
+            break;
+
+        previousSequence = record.Sequence;
+        if (record.Sequence <= lastSequence)
+            continue;
+
+        switch (static_cast<RecordType>(record.Type))
+        {
+        case RecordType::WALLET:
+            m_RecoveredState.Wallet.ETH = Quantity::FromUnits(record.First);
+            m_RecoveredState.Wallet.USD = Notional::FromUnits(record.Second);
+            break;
+        case RecordType::PLACED:
+            orders.emplace(record.OrderId, BotOrder{ static_cast<OrderSide>(record.Side), record.OrderId, Price::FromUnits(record.First), Quantity::FromUnits(record.Second) });
+            break;
+        case RecordType::FILLED:
+        case RecordType::CANCELLED:
+            orders.erase(record.OrderId);
+            break;
+        }
+
+        m_RecoveredState.Restored = true;
+        m_RecoveredState.RecordsReplayed++;
+    }
+
+    m_RecoveredState.PendingOrders.reserve(orders.size());
+    for (const auto& [orderId, order] : orders)
+        m_RecoveredState.PendingOrders.push_back(order);
+
+    // New records follow the replayed ones, or start the log over if it only held records older than the snapshot
+    if (previousSequence > lastSequence)
+    {
+        m_WriteOffset = offset;
+        m_NextSequence = previousSequence + 1;
+    }
+    else
+    {
+        m_WriteOffset = 0;
+        m_NextSequence = lastSequence + 1;
+    }
+
+    // Erases the valid records left beyond, which the next ones could otherwise chain to (e.g. after a torn record)
+    auto erased = false;
+    for (auto tail = m_WriteOffset; tail + RecordSize <= m_Size; tail += RecordSize)
+    {
+        Record record;
+        std::memcpy(&record, m_Data + tail, sizeof(record));
+        if (record.Checksum == Checksum(record))
+        {
+            std::memset(m_Data + tail, 0, RecordSize);
+            erased = true;
+        }
+    }
+
+    m_CommittedOffset = m_WriteOffset;
+    if (erased && m_Config.Sync)
+    {
+#ifdef _WIN32
+        FlushViewOfFile(m_Data, m_Size);
+        FlushFileBuffers(m_File);
+#else
+        msync(m_Data, m_Size, MS_SYNC);
+#endif
+    }
+}
+
+
+bool OptimusBot::Journal::Map(std::size_t size) noexcept
+{
+    Unmap();
+
+#ifdef _WIN32
+    // Mapping a file beyond its end extends it, zero-filled
+    const auto mapping = CreateFileMappingA(m_File, nullptr, PAGE_READWRITE, static_cast<DWORD>(static_cast<std::uint64_t>(size) >> 32), static_cast<DWORD>(size), nullptr);
+    if (!mapping)
+        return false;
+
+    const auto view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+    CloseHandle(mapping);
+    if (!view)
+        return false;
+#else
+    struct stat status;
+    if (fstat(m_File, &status) != 0)
+        return false;
+
+    // Extending the file zero-fills it
+    if (static_cast<std::size_t>(status.st_size) < size && ftruncate(m_File, static_cast<off_t>(size)) != 0)
+        return false;
+
+    const auto view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_File, 0);
+    if (view == MAP_FAILED)
+        return false;
+#endif
+
+    m_Data = static_cast<std::uint8_t*>(view);
+    m_Size = size;
+    return true;
+}
+
+
+void OptimusBot::Journal::Unmap() noexcept
+{
+    if (!m_Data)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_Data);
+#else
+    munmap(m_Data, m_Size);
+#endif
+    m_Data = nullptr;
+    m_Size = 0;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "DvfSimulator.h"
+#include "Types.h"
+
+namespace OptimusBot
+{
+    class PendingOrders;
+
+    /// @brief Parameters of a Journal
+    struct JournalConfig
+    {
+        // Number of bytes the log grows by when full
+        std::size_t SegmentSize{ 1024 * 1024 };
+
+        // Number of records after which the bot compacts the log into a snapshot
+        std::size_t CheckpointEvery{ 4096 };
+
+        // Whether commits and snapshots are flushed to the disk. Without it, they only survive the process, not the machine
+        bool Sync{ true };
+    };
+
+    /// @brief State of the bot found in a journal when it is opened
+    struct JournalState
+    {
+        // False if the journal was empty, e.g. on a first start
+        bool Restored{ false };
+
+        Types::Wallet Wallet;
+        std::vector<Types::BotOrder> PendingOrders;
+
+        // Number of log records applied on top of the snapshot
+        std::size_t RecordsReplayed{ 0 };
+    };
+
+    /// @brief Crash-safe write-ahead journal of the wallet and of the lifecycle of the orders, from which the bot restarts where it stopped.
+    /// Events are appended as fixed-size checksummed records to a memory-mapped log ("<path>"), and made durable once per tick by Commit,
+    /// all the events of the tick sharing a single flush. Checkpoint compacts the log into a snapshot ("<path>.snapshot") of the state,
+    /// written aside then renamed over the previous one, after which the log starts over.
+    /// Records are numbered: when the journal is opened, the log records following the snapshot are replayed up to the first torn or stale one
+    class Journal final
+    {
+    public:
+        /// @param path Log to open, created if it does not exist. The state it holds is available from GetRecoveredState
+        explicit Journal(const std::string& path, const JournalConfig& config = JournalConfig{});
+
+        /// @brief Unmaps the log, without committing the records appended since the last commit
+        ~Journal() noexcept;
+
+        Journal(const Journal&) = delete;
+        Journal& operator=(const Journal&) = delete;
+
+        /// @brief Whether the log could be opened and mapped. Nothing is journaled otherwise
+        bool IsOpen() const noexcept
+        {
+            return m_Data != nullptr;
+        }
+
+        /// @brief State rebuilt from the snapshot and the log when the journal was opened
+        const JournalState& GetRecoveredState() const noexcept
+        {
+            return m_RecoveredState;
+        }
+
+        /// @brief Appends the assets hold, replacing the previous ones
+        void RecordWallet(const Types::Wallet& wallet) noexcept;
+
+        /// @brief Appends an order placed on the market
+        void RecordPlaced(const Types::BotOrder& order) noexcept;
+
+        /// @brief Appends the fill of a pending order
+        void RecordFilled(IDvfSimulator::OrderID orderId) noexcept;
+
+        /// @brief Appends the cancellation of a pending order
+        void RecordCancelled(IDvfSimulator::OrderID orderId) noexcept;
+
+        /// @brief Makes the records appended since the last commit durable
+        /// @return False if they could not be flushed
+        bool Commit() noexcept;
+
+        /// @brief Replaces the snapshot with the given state, which must include every record appended so far, and starts the log over
+        /// @return False if the snapshot could not be written, in which case the log is kept
+        bool Checkpoint(const Types::Wallet& wallet, const PendingOrders& pendingOrders);
+
+        /// @brief Number of records appended to the log since the last checkpoint, replayed ones included
+        std::size_t GetRecordCount() const noexcept
+        {
+            return m_WriteOffset / RecordSize;
+        }
+
+        const JournalConfig& GetConfig() const noexcept
+        {
+            return m_Config;
+        }
+
+    private:
+        static constexpr std::size_t RecordSize = 32;
+
+        enum class RecordType : std::uint8_t
+        {
+            WALLET = 1,
+            PLACED,
+            FILLED,
+            CANCELLED
+        };
+
+        void Append(RecordType type, Types::OrderSide side, IDvfSimulator::OrderID orderId, std::int64_t first, std::int64_t second) noexcept;
+
+        /// @brief Loads the snapshot and replays the log on top of it
+        void Recover();
+
+        /// @brief Maps the log with the given size, extending the file if needed
+        bool Map(std::size_t size) noexcept;
+        void Unmap() noexcept;
+
+        std::string m_Path;
+        JournalConfig m_Config;
+        JournalState m_RecoveredState;
+
+#ifdef _WIN32
+        void* m_File{ nullptr };
+#else
+        int m_File{ -1 };
+#endif
+        std::uint8_t* m_Data{ nullptr };
+        std::size_t m_Size{ 0 };
+
+        std::size_t m_WriteOffset{ 0 };
+        std::size_t m_CommittedOffset{ 0 };
+        std::uint32_t m_NextSequence{ 1 };
+    };
+}
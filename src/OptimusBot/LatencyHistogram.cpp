@@ -0,0 +1,72 @@
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include "LatencyHistogram.h"
+
+
+OptimusBot::LatencyHistogram::LatencyHistogram() noexcept
+{
+    for (auto& count : m_Counts)
+        count.store(0, std::memory_order_relaxed);
+}
+
+
+std::uint64_t OptimusBot::LatencyHistogram::GetMin() const noexcept
+{
+    const auto min = m_Min.load(std::memory_order_relaxed);
+    return min == std::numeric_limits<std::uint64_t>::max() ? 0 : min;
+}
+
+
+double OptimusBot::LatencyHistogram::GetMean() const noexcept
+{
+    const auto count = GetCount();
+    return count == 0 ? 0.0 : static_cast<double>(m_Sum.load(std::memory_order_relaxed)) / count;
+}
+
+
+std::uint64_t OptimusBot::LatencyHistogram::GetPercentile(double percentile) const noexcept
+{
+    const auto total = GetCount();
+    if (total == 0)
+        return 0;
+
+    // Rank of the value looked for, the first one for percentile 0
+    const auto clamped = std::clamp(percentile, 0.0, 100.0);
+    const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * total)));
+
+    std::uint64_t cumulated = 0;
+    for (std::size_t i = 0; i < bucketCount; i++)
+    {
+        cumulated += m_Counts[i].load(std::memory_order_relaxed);
+        if (cumulated >= rank)
+            return std::min(GetHighestValue(i), GetMax());
+    }
+
+    // Counts recorded concurrently with the walk
+    return GetMax();
+}
+
+
+void OptimusBot::LatencyHistogram::Reset() noexcept
+{
+    for (auto& count : m_Counts)
+        count.store(0, std::memory_order_relaxed);
+
+    m_Count.store(0, std::memory_order_relaxed);
+    m_Sum.store(0, std::memory_order_relaxed);
+    m_Min.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+    m_Max.store(0, std::memory_order_relaxed);
+}
+
+
+std::uint64_t OptimusBot::LatencyHistogram::GetHighestValue(std::size_t index) noexcept
+{
+    if (index < subBucketCount)
+        return index;
+
+    const auto shift = (index - subBucketCount) / subBucketHalfCount + 1;
+    const auto subBucket = (index - subBucketCount) % subBucketHalfCount + subBucketHalfCount;
+
+    return ((static_cast<std::uint64_t>(subBucket) + 1) << shift) - 1;
+}
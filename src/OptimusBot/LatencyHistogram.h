@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace OptimusBot
+{
+    /// @brief HDR-style histogram of latencies in nanoseconds: values below 128 are counted exactly, larger ones in buckets
+    /// 1/64th of their power of two wide (under 1.6% of error). Recording is lock-free and wait-free, a few relaxed atomic
+    /// increments, so that a histogram can be shared by the threads of the hot path. Values above about 4.9 hours are clamped
+    class LatencyHistogram final
+    {
+    public:
+        static constexpr std::uint64_t MaxTrackableValue = (std::uint64_t{ 1 } << 44) - 1;
+
+        LatencyHistogram() noexcept;
+
+        LatencyHistogram(const LatencyHistogram&) = delete;
+        LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+        /// @brief Records a latency. Thread-safe
+        void Record(std::uint64_t nanoseconds) noexcept
+        {
+            const auto value = nanoseconds < MaxTrackableValue ? nanoseconds : MaxTrackableValue;
+
+            m_Counts[GetIndex(value)].fetch_add(1, std::memory_order_relaxed);
+            m_Count.fetch_add(1, std::memory_order_relaxed);
+            m_Sum.fetch_add(value, std::memory_order_relaxed);
+
+            auto min = m_Min.load(std::memory_order_relaxed);
+            while (value < min && !m_Min.compare_exchange_weak(min, value, std::memory_order_relaxed))
+            {
+            }
+
+            auto max = m_Max.load(std::memory_order_relaxed);
+            while (value > max && !m_Max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        std::uint64_t GetCount() const noexcept
+        {
+            return m_Count.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Smallest value recorded, 0 if none
+        std::uint64_t GetMin() const noexcept;
+
+        /// @brief Largest value recorded, 0 if none
+        std::uint64_t GetMax() const noexcept
+        {
+            return m_Max.load(std::memory_order_relaxed);
+        }
+
+        double GetMean() const noexcept;
+
+        /// @brief Value below which the given percentage of the recorded values fall, up to the bucket precision. 0 if none recorded
+        /// @param percentile Within [0, 100]
+        std::uint64_t GetPercentile(double percentile) const noexcept;
+
+        /// @brief Forgets the recorded values. Values recorded concurrently may or may not be kept
+        void Reset() noexcept;
+
+    private:
+        static constexpr unsigned subBucketBits = 7;
+        static constexpr std::size_t subBucketCount = std::size_t{ 1 } << subBucketBits;
+        static constexpr std::size_t subBucketHalfCount = subBucketCount / 2;
+        static constexpr std::size_t bucketCount = subBucketCount + (44 - subBucketBits) * subBucketHalfCount;
+
+        static std::size_t GetIndex(std::uint64_t value) noexcept
+        {
+            if (value < subBucketCount)
+                return static_cast<std::size_t>(value);
+
+            // Values sharing their 7 most significant bits share a bucket
+            const auto shift = MostSignificantBit(value) - (subBucketBits - 1);
+            return subBucketCount + (shift - 1) * subBucketHalfCount + static_cast<std::size_t>((value >> shift) - subBucketHalfCount);
+        }
+
+        /// @brief Largest value counted in the bucket
+        static std::uint64_t GetHighestValue(std::size_t index) noexcept;
+
+        static unsigned MostSignificantBit(std::uint64_t value) noexcept
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanReverse64(&index, value);
+            return static_cast<unsigned>(index);
+#else
+            return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#endif
+        }
+
+        std::array<std::atomic<std::uint64_t>, bucketCount> m_Counts;
+        std::atomic<std::uint64_t> m_Count{ 0 };
+        std::atomic<std::uint64_t> m_Sum{ 0 };
+        std::atomic<std::uint64_t> m_Min{ std::numeric_limits<std::uint64_t>::max() };
+        std::atomic<std::uint64_t> m_Max{ 0 };
+    };
+}
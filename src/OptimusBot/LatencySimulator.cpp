@@ -0,0 +1,37 @@
+#include "pch.h"
+#include <thread>
+#include "LatencySimulator.h"
+
+
+template <typename Call>
+auto OptimusBot::LatencySimulator::RoundTrip(Call&& call) noexcept
+{
+    std::this_thread::sleep_for(m_RoundTrip / 2);
+
+    auto result = [this, &call]() {
+        const std::lock_guard<std::mutex> lock{ m_Mutex };
+        return call(*m_Simulator);
+    }();
+
+    std::this_thread::sleep_for(m_RoundTrip - m_RoundTrip / 2);
+
+    return result;
+}
+
+
+IDvfSimulator::OrderBook OptimusBot::LatencySimulator::GetOrderBook() noexcept
+{
+    return RoundTrip([](IDvfSimulator& simulator) { return simulator.GetOrderBook(); });
+}
+
+
+std::optional<IDvfSimulator::OrderID> OptimusBot::LatencySimulator::PlaceOrder(double price, double amount) noexcept
+{
+    return RoundTrip([price, amount](IDvfSimulator& simulator) { return simulator.PlaceOrder(price, amount); });
+}
+
+
+bool OptimusBot::LatencySimulator::CancelOrder(OrderID oid) noexcept
+{
+    return RoundTrip([oid](IDvfSimulator& simulator) { return simulator.CancelOrder(oid); });
+}
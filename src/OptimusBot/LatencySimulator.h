@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include "DvfSimulator.h"
+#include "SimulatorExtensions.h"
+
+namespace OptimusBot
+{
+    /// @brief IDvfSimulator decorator standing in for a remote venue: every call pays a network round trip, half of it before the
+    /// wrapped simulator is called and half after. Calls are thread-safe, concurrent ones overlapping their latency while the wrapped
+    /// simulator is called by a single thread at a time, like a venue processing requests sequentially
+    class LatencySimulator final : public IDvfSimulator
+    {
+    public:
+        /// @param simulator Simulator actually called
+        /// @param roundTrip Latency added to each call
+        LatencySimulator(SimulatorPtr&& simulator, std::chrono::steady_clock::duration roundTrip) noexcept
+            : m_Simulator{ std::move(simulator) }, m_RoundTrip{ roundTrip }
+        {
+        }
+
+        OrderBook GetOrderBook() noexcept override;
+
+        std::optional<OrderID> PlaceOrder(double price, double amount) noexcept override;
+
+        bool CancelOrder(OrderID oid) noexcept override;
+
+    private:
+        template <typename Call>
+        auto RoundTrip(Call&& call) noexcept;
+
+        SimulatorPtr m_Simulator;
+        const std::chrono::steady_clock::duration m_RoundTrip;
+        std::mutex m_Mutex;
+    };
+}
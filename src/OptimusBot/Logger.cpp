@@ -0,0 +1,441 @@
+#include "pch.h"
+#include <cstdio>
+#include <cstring>
+#include "Logger.h"
+
+using namespace OptimusBot::Logging;
+
+
+namespace
+{
+    constexpr std::size_t ringCapacity = 1024;
+    constexpr char binaryLogMagic[4] = { 'O', 'B', 'L', 'G' };
+    constexpr auto droppedRecordsFormat = "{} log records dropped, the logging rings being full";
+
+    const char* ToString(Level level) noexcept
+    {
+        switch (level)
+        {
+        case Level::DEBUG: return "DEBUG";
+        case Level::INFO: return "INFO ";
+        case Level::WARNING: return "WARN ";
+        case Level::ERROR: return "ERROR";
+        default: return "     ";
+        }
+    }
+
+    template <typename T>
+    void Append(std::string& output, const char* format, T value)
+    {
+        char buffer[32];
+        const auto length = std::snprintf(buffer, sizeof(buffer), format, value);
+        if (length > 0)
+            output.append(buffer, static_cast<std::size_t>(length));
+    }
+
+    // "HH:MM:SS.uuuuuu" UTC, computed without the non thread-safe C time functions
+    void AppendTime(std::string& output, std::int64_t time)
+    {
+        const auto microseconds = (time / 1000) % 1000000;
+        const auto secondsOfDay = (time / 1000000000) % 86400;
+        char buffer[24];
+        const auto length = std::snprintf(buffer, sizeof(buffer), "%02d:%02d:%02d.%06d",
+            static_cast<int>(secondsOfDay / 3600), static_cast<int>(secondsOfDay / 60 % 60), static_cast<int>(secondsOfDay % 60), static_cast<int>(microseconds));
+        output.append(buffer, static_cast<std::size_t>(length));
+    }
+
+    template <typename T>
+    void Put(std::vector<char>& buffer, T value)
+    {
+        for (std::size_t i = 0; i < sizeof(T); i++)
+            buffer.push_back(static_cast<char>(static_cast<std::uint64_t>(value) >> (8 * i)));
+    }
+
+    template <typename T>
+    bool Get(std::istream& input, T& value)
+    {
+        unsigned char bytes[sizeof(T)];
+        if (!input.read(reinterpret_cast<char*>(bytes), sizeof(T)))
+            return false;
+
+        std::uint64_t raw = 0;
+        for (std::size_t i = 0; i < sizeof(T); i++)
+            raw |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+        value = static_cast<T>(raw);
+        return true;
+    }
+}
+
+
+void OptimusBot::Logging::Record::AppendText(std::string& output) const
+{
+    std::size_t argument = 0;
+    for (auto character = Format; *character; character++)
+    {
+        if (character[0] != '{' || character[1] != '}' || argument == ArgumentCount)
+        {
+            output.push_back(*character);
+            continue;
+        }
+
+        switch (Types[argument])
+        {
+        case ArgumentType::BOOL: output.append(Values[argument] ? "true" : "false"); break;
+        case ArgumentType::CHAR: output.push_back(static_cast<char>(Values[argument])); break;
+        case ArgumentType::INT: Append(output, "%lld", static_cast<long long>(Values[argument])); break;
+        case ArgumentType::UINT: Append(output, "%llu", static_cast<unsigned long long>(Values[argument])); break;
+        case ArgumentType::DOUBLE: Append(output, "%g", GetDouble(argument)); break; // Same as the default std::ostream formatting
+        case ArgumentType::STRING: output.append(GetString(argument)); break;
+        }
+
+        argument++;
+        character++;
+    }
+}
+
+
+double OptimusBot::Logging::Record::GetDouble(std::size_t index) const noexcept
+{
+    double value;
+    std::memcpy(&value, &Values[index], sizeof(value));
+    return value;
+}
+
+
+std::string_view OptimusBot::Logging::Record::GetString(std::size_t index) const noexcept
+{
+    return { Text + (Values[index] >> 32), static_cast<std::size_t>(Values[index] & 0xFFFFFFFF) };
+}
+
+
+void OptimusBot::Logging::Record::Add(ArgumentType type, std::uint64_t value) noexcept
+{
+    if (ArgumentCount == maxArguments)
+        return;
+
+    Types[ArgumentCount] = type;
+    Values[ArgumentCount] = value;
+    ArgumentCount++;
+}
+
+
+void OptimusBot::Logging::Record::AddDouble(double value) noexcept
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    Add(ArgumentType::DOUBLE, bits);
+}
+
+
+void OptimusBot::Logging::Record::AddString(std::string_view value) noexcept
+{
+    const auto length = std::min(value.size(), textCapacity - TextSize);
+    std::memcpy(Text + TextSize, value.data(), length);
+    Add(ArgumentType::STRING, static_cast<std::uint64_t>(TextSize) << 32 | length);
+    TextSize = static_cast<std::uint8_t>(TextSize + length);
+}
+
+
+void OptimusBot::Logging::TextSink::Write(const Record& record)
+{
+    m_Line.clear();
+    AppendTime(m_Line, record.Time);
+    m_Line.push_back(' ');
+    m_Line.append(ToString(record.Severity));
+    m_Line.push_back(' ');
+    record.AppendText(m_Line);
+    m_Line.push_back('\n');
+
+    m_Output.write(m_Line.data(), static_cast<std::streamsize>(m_Line.size()));
+}
+
+
+void OptimusBot::Logging::TextSink::Flush()
+{
+    m_Output.flush();
+}
+
+
+void OptimusBot::Logging::BinarySink::Write(const Record& record)
+{
+    if (m_Buffer.empty() && m_File.tellp() == 0)
+        m_Buffer.insert(m_Buffer.end(), std::begin(binaryLogMagic), std::end(binaryLogMagic));
+
+    const auto formatLength = std::strlen(record.Format);
+    Put(m_Buffer, static_cast<std::uint8_t>(record.Severity));
+    Put(m_Buffer, record.Time);
+    Put(m_Buffer, static_cast<std::uint16_t>(formatLength));
+    m_Buffer.insert(m_Buffer.end(), record.Format, record.Format + static_cast<std::uint16_t>(formatLength));
+    Put(m_Buffer, record.ArgumentCount);
+
+    for (std::size_t i = 0; i < record.ArgumentCount; i++)
+    {
+        Put(m_Buffer, static_cast<std::uint8_t>(record.Types[i]));
+        if (record.Types[i] == ArgumentType::STRING)
+        {
+            const auto text = record.GetString(i);
+            Put(m_Buffer, static_cast<std::uint8_t>(text.size()));
+            m_Buffer.insert(m_Buffer.end(), text.begin(), text.end());
+        }
+        else
+            Put(m_Buffer, record.Values[i]);
+    }
+}
+
+
+void OptimusBot::Logging::BinarySink::Flush()
+{
+    m_File.write(m_Buffer.data(), static_cast<std::streamsize>(m_Buffer.size()));
+    m_File.flush();
+    m_Buffer.clear();
+}
+
+
+bool OptimusBot::Logging::DecodeBinaryLog(std::istream& input, std::ostream& output)
+{
+    char magic[sizeof(binaryLogMagic)];
+    if (!input.read(magic, sizeof(magic)))
+        return input.gcount() == 0; // An empty log is valid
+    if (std::memcmp(magic, binaryLogMagic, sizeof(magic)) != 0)
+        return false;
+
+    TextSink sink{ output };
+    std::string format, text;
+    Record record;
+
+    std::uint8_t level;
+    while (Get(input, level))
+    {
+        std::uint16_t formatLength;
+        if (!Get(input, record.Time) || !Get(input, formatLength))
+            return false;
+
+        format.resize(formatLength);
+        std::uint8_t argumentCount;
+        if (!input.read(format.data(), formatLength) || !Get(input, argumentCount))
+            return false;
+
+        record.Severity = static_cast<Level>(level);
+        record.Format = format.c_str();
+        record.ArgumentCount = 0;
+        record.TextSize = 0;
+
+        for (std::size_t i = 0; i < argumentCount; i++)
+        {
+            std::uint8_t type;
+            std::uint64_t value;
+            if (!Get(input, type))
+                return false;
+
+            if (static_cast<ArgumentType>(type) == ArgumentType::STRING)
+            {
+                std::uint8_t length;
+                text.resize(Get(input, length) ? length : 0);
+                if (!input.read(text.data(), text.size()))
+                    return false;
+                record.Add(std::string_view{ text });
+                continue;
+            }
+
+            if (!Get(input, value))
+                return false;
+
+            switch (static_cast<ArgumentType>(type))
+            {
+            case ArgumentType::BOOL: record.Add(value != 0); break;
+            case ArgumentType::CHAR: record.Add(static_cast<char>(value)); break;
+            case ArgumentType::INT: record.Add(static_cast<std::int64_t>(value)); break;
+            case ArgumentType::UINT: record.Add(value); break;
+            case ArgumentType::DOUBLE:
+            {
+                double number;
+                std::memcpy(&number, &value, sizeof(number));
+                record.Add(number);
+                break;
+            }
+            default: return false;
+            }
+        }
+
+        sink.Write(record);
+    }
+
+    sink.Flush();
+    return input.eof() && input.gcount() == 0;
+}
+
+
+OptimusBot::Logging::Logger& OptimusBot::Logging::Logger::Instance()
+{
+    static Logger instance;
+    return instance;
+}
+
+
+OptimusBot::Logging::Logger::Logger()
+    : m_Sink{ std::make_unique<TextSink>(std::cout) }
+{
+    m_Consumer = std::thread{ [this]() { Consume(); } };
+}
+
+
+OptimusBot::Logging::Logger::~Logger() noexcept
+{
+    {
+        const std::lock_guard<std::mutex> lock{ m_ConsumerMutex };
+        m_Stopping = true;
+    }
+    m_WakeUp.notify_one();
+    m_Consumer.join();
+}
+
+
+void OptimusBot::Logging::Logger::SetSink(std::unique_ptr<ILogSink>&& sink)
+{
+    Flush();
+
+    const std::lock_guard<std::mutex> lock{ m_ConsumerMutex };
+    m_Sink = std::move(sink);
+}
+
+
+void OptimusBot::Logging::Logger::Flush()
+{
+    std::unique_lock<std::mutex> lock{ m_ConsumerMutex };
+    const auto request = ++m_FlushRequests;
+    m_WakeUp.notify_one();
+    m_Flushed.wait(lock, [this, request]() { return m_FlushesCompleted >= request; });
+}
+
+
+OptimusBot::Logging::Logger::ThreadRing& OptimusBot::Logging::Logger::GetThreadRing()
+{
+    // Registered on the first log call of each thread, and flagged when the thread exits
+    struct Registration
+    {
+        std::shared_ptr<ThreadRing> Ring;
+
+        ~Registration()
+        {
+            Ring->Abandoned.store(true, std::memory_order_release);
+        }
+    };
+
+    thread_local const Registration registration{ [this]() {
+        auto ring = std::make_shared<ThreadRing>(ringCapacity);
+        const std::lock_guard<std::mutex> lock{ m_RingsMutex };
+        m_Rings.push_back(ring);
+        return ring;
+    }() };
+
+    return *registration.Ring;
+}
+
+
+Record* OptimusBot::Logging::Logger::Claim(ThreadRing& ring) noexcept
+{
+    if (const auto record = ring.Ring.TryClaim())
+        return record;
+
+    if (m_Policy.load(std::memory_order_relaxed) == OverflowPolicy::DROP)
+    {
+        ring.Dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Record* record;
+    while (!(record = ring.Ring.TryClaim()))
+    {
+        m_WakeUp.notify_one();
+        std::this_thread::yield();
+    }
+    return record;
+}
+
+
+std::int64_t OptimusBot::Logging::Logger::Now() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+
+void OptimusBot::Logging::Logger::Consume()
+{
+    using namespace std::chrono_literals;
+
+    // Records are consumed in passes over all the rings, a flush request being completed by the first full pass started after it
+    std::unique_lock<std::mutex> lock{ m_ConsumerMutex };
+    while (true)
+    {
+        const auto requests = m_FlushRequests;
+        const auto stopping = m_Stopping;
+
+        const auto idle = Drain();
+
+        if (m_FlushesCompleted < requests)
+        {
+            m_FlushesCompleted = requests;
+            m_Flushed.notify_all();
+        }
+
+        if (stopping)
+            return;
+
+        // Log calls do not notify, so that they never pay for a system call: the rings are polled instead
+        if (idle)
+            m_WakeUp.wait_for(lock, 1ms);
+    }
+}
+
+
+bool OptimusBot::Logging::Logger::Drain()
+{
+    m_Batch.clear();
+    std::uint64_t dropped = 0;
+
+    {
+        const std::lock_guard<std::mutex> lock{ m_RingsMutex };
+        for (auto it = m_Rings.begin(); it != m_Rings.end();)
+        {
+            auto& ring = **it;
+
+            // Checked before draining: an abandoned ring will not receive any other record
+            const auto abandoned = ring.Abandoned.load(std::memory_order_acquire);
+
+            while (const auto record = ring.Ring.Front())
+            {
+                m_Batch.push_back(*record);
+                ring.Ring.Pop();
+            }
+            dropped += ring.Dropped.exchange(0, std::memory_order_relaxed);
+
+            it = abandoned ? m_Rings.erase(it) : it + 1;
+        }
+    }
+
+    if (m_Batch.empty() && dropped == 0)
+        return true;
+
+    // Each ring is ordered, the records of different threads being interleaved by time
+    std::stable_sort(m_Batch.begin(), m_Batch.end(), [](const Record& left, const Record& right) { return left.Time < right.Time; });
+
+    for (const auto& record : m_Batch)
+        m_Sink->Write(record);
+
+    if (dropped > 0)
+    {
+        m_DroppedCount.fetch_add(dropped, std::memory_order_relaxed);
+
+        Record record;
+        record.Time = Now();
+        record.Format = droppedRecordsFormat;
+        record.Severity = Level::WARNING;
+        record.ArgumentCount = 0;
+        record.TextSize = 0;
+        record.Add(dropped);
+        m_Sink->Write(record);
+    }
+
+    m_Sink->Flush();
+    return false;
+}
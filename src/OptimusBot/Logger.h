@@ -0,0 +1,313 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "SpscRing.h"
+
+/// @brief Asynchronous logging: a log call only copies its arguments into a ring owned by the calling thread,
+/// the formatting and writing being done by a background thread
+namespace OptimusBot::Logging
+{
+    enum class Level : std::uint8_t
+    {
+        DEBUG,
+        INFO,
+        WARNING,
+        ERROR,
+        OFF //Threshold only, disabling all logging
+    };
+
+    //What a log call does when the ring of its thread is full
+    enum class OverflowPolicy
+    {
+        DROP, //The record is discarded and counted, the number of records dropped being logged later on
+        BLOCK //The call waits for the background thread to make room
+    };
+
+    enum class ArgumentType : std::uint8_t
+    {
+        BOOL,
+        CHAR,
+        INT,
+        UINT,
+        DOUBLE,
+        STRING
+    };
+
+    //Log call captured without formatting: its format string must be a literal, the arguments are copied.
+    //Mutable object, filled in place within a ring slot
+    struct Record
+    {
+        static constexpr std::size_t maxArguments = 8;
+        static constexpr std::size_t textCapacity = 96;
+
+        std::int64_t Time; //Nanoseconds since the epoch of the system clock
+        const char* Format;
+        Level Severity;
+        std::uint8_t ArgumentCount;
+        std::uint8_t TextSize;
+        ArgumentType Types[maxArguments];
+        std::uint64_t Values[maxArguments]; //Raw bits of the numbers, offset and length in Text of the strings
+        char Text[textCapacity]; //Contents of the string arguments, truncated if too long
+
+        template <typename T>
+        void Add(const T& value) noexcept
+        {
+            if constexpr (std::is_same_v<T, bool>)
+                Add(ArgumentType::BOOL, value ? 1 : 0);
+            else if constexpr (std::is_same_v<T, char>)
+                Add(ArgumentType::CHAR, static_cast<unsigned char>(value));
+            else if constexpr (std::is_enum_v<T>)
+                Add(static_cast<std::underlying_type_t<T>>(value));
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+                Add(ArgumentType::INT, static_cast<std::uint64_t>(static_cast<std::int64_t>(value)));
+            else if constexpr (std::is_integral_v<T>)
+                Add(ArgumentType::UINT, static_cast<std::uint64_t>(value));
+            else if constexpr (std::is_floating_point_v<T>)
+                AddDouble(static_cast<double>(value));
+            else
+                AddString(std::string_view{ value });
+        }
+
+        /// @brief Appends the record, formatted as text, to the given string: "{}" placeholders are replaced by the arguments in order
+        void AppendText(std::string& output) const;
+
+        double GetDouble(std::size_t index) const noexcept;
+
+        std::string_view GetString(std::size_t index) const noexcept;
+
+    private:
+        void Add(ArgumentType type, std::uint64_t value) noexcept;
+
+        void AddDouble(double value) noexcept;
+
+        void AddString(std::string_view value) noexcept;
+    };
+
+    /// @brief Destination of the records, only called from the background thread
+    class ILogSink
+    {
+    public:
+        virtual ~ILogSink() noexcept = default;
+
+        virtual void Write(const Record& record) = 0;
+
+        /// @brief Called after each batch of records
+        virtual void Flush() = 0;
+    };
+
+    /// @brief Writes the records as text lines, prefixed with their UTC time and level
+    class TextSink final : public ILogSink
+    {
+    public:
+        /// @param output Stream to write to. Must outlive the sink
+        explicit TextSink(std::ostream& output) noexcept
+            : m_Output{ output }
+        {
+        }
+
+        void Write(const Record& record) override;
+
+        void Flush() override;
+
+    private:
+        std::ostream& m_Output;
+        std::string m_Line;
+    };
+
+    /// @brief Writes the records in a compact binary form, the formatting being deferred until decoded by DecodeBinaryLog
+    class BinarySink final : public ILogSink
+    {
+    public:
+        /// @param path File to write, overwritten if it exists
+        explicit BinarySink(const std::string& path)
+            : m_File{ path, std::ios::binary | std::ios::trunc }
+        {
+        }
+
+        void Write(const Record& record) override;
+
+        void Flush() override;
+
+    private:
+        std::ofstream m_File;
+        std::vector<char> m_Buffer;
+    };
+
+    /// @brief Converts a log written by a BinarySink to the text written by a TextSink
+    /// @return False if the input is truncated or corrupted, the records before that point being converted
+    bool DecodeBinaryLog(std::istream& input, std::ostream& output);
+
+    /// @brief Process-wide logger, writing to the console by default
+    class Logger final
+    {
+    public:
+        static Logger& Instance();
+
+        ~Logger() noexcept;
+
+        Logger(const Logger&) = delete;
+        Logger& operator=(const Logger&) = delete;
+
+        bool IsEnabled(Level level) const noexcept
+        {
+            return level >= m_Level.load(std::memory_order_relaxed);
+        }
+
+        void SetLevel(Level level) noexcept
+        {
+            m_Level.store(level, std::memory_order_relaxed);
+        }
+
+        Level GetLevel() const noexcept
+        {
+            return m_Level.load(std::memory_order_relaxed);
+        }
+
+        void SetOverflowPolicy(OverflowPolicy policy) noexcept
+        {
+            m_Policy.store(policy, std::memory_order_relaxed);
+        }
+
+        /// @brief Replaces the destination of the records, after writing the pending ones to the current destination
+        void SetSink(std::unique_ptr<ILogSink>&& sink);
+
+        /// @brief Blocks until every record logged before the call is written
+        void Flush();
+
+        /// @brief Number of records discarded because the ring of their thread was full
+        std::uint64_t GetDroppedCount() const noexcept
+        {
+            return m_DroppedCount.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Logs a record. Only copies the arguments, costing tens of nanoseconds
+        /// @param format String literal, in which each "{}" is replaced by the next argument
+        /// @param args Numbers, characters, booleans, enumerations or strings, the latter being truncated if too long
+        template <typename... Args>
+        void Log(Level level, const char* format, const Args&... args) noexcept
+        {
+            static_assert(sizeof...(Args) <= Record::maxArguments, "Too many arguments for a log record");
+
+            if (!IsEnabled(level))
+                return;
+
+            auto& ring = GetThreadRing();
+            auto record = Claim(ring);
+            if (!record)
+                return;
+
+            record->Time = Now();
+            record->Format = format;
+            record->Severity = level;
+            record->ArgumentCount = 0;
+            record->TextSize = 0;
+            (record->Add(args), ...);
+
+            ring.Ring.Publish();
+        }
+
+    private:
+        struct ThreadRing
+        {
+            explicit ThreadRing(std::size_t capacity)
+                : Ring{ capacity }
+            {
+            }
+
+            SpscRing<Record> Ring;
+            std::atomic<std::uint64_t> Dropped{ 0 };
+            std::atomic<bool> Abandoned{ false }; //Set once its thread exits, the ring being released when drained
+        };
+
+        Logger();
+
+        ThreadRing& GetThreadRing();
+
+        Record* Claim(ThreadRing& ring) noexcept;
+
+        static std::int64_t Now() noexcept;
+
+        void Consume();
+
+        /// @return True if no record was pending
+        bool Drain();
+
+        std::atomic<Level> m_Level{ Level::INFO };
+        std::atomic<OverflowPolicy> m_Policy{ OverflowPolicy::DROP };
+        std::atomic<std::uint64_t> m_DroppedCount{ 0 };
+
+        // Rings of the threads which logged, registered on their first log call
+        std::mutex m_RingsMutex;
+        std::vector<std::shared_ptr<ThreadRing>> m_Rings;
+
+        // Background thread state, the sink being guarded by the same mutex
+        std::mutex m_ConsumerMutex;
+        std::condition_variable m_WakeUp;
+        std::condition_variable m_Flushed;
+        std::unique_ptr<ILogSink> m_Sink;
+        std::vector<Record> m_Batch;
+        std::uint64_t m_FlushRequests{ 0 };
+        std::uint64_t m_FlushesCompleted{ 0 };
+        bool m_Stopping{ false };
+        std::thread m_Consumer;
+    };
+
+    /// @brief Sets the logging threshold for the lifetime of the object, then restores the previous one.
+    /// The threshold being process-wide, the scopes should not overlap across threads
+    class ScopedLevel final
+    {
+    public:
+        explicit ScopedLevel(Level level) noexcept
+            : m_Previous{ Logger::Instance().GetLevel() }
+        {
+            Logger::Instance().SetLevel(level);
+        }
+
+        ~ScopedLevel() noexcept
+        {
+            Logger::Instance().SetLevel(m_Previous);
+        }
+
+        ScopedLevel(const ScopedLevel&) = delete;
+        ScopedLevel& operator=(const ScopedLevel&) = delete;
+
+    private:
+        Level m_Previous;
+    };
+
+    template <typename... Args>
+    void Debug(const char* format, const Args&... args) noexcept
+    {
+        Logger::Instance().Log(Level::DEBUG, format, args...);
+    }
+
+    template <typename... Args>
+    void Info(const char* format, const Args&... args) noexcept
+    {
+        Logger::Instance().Log(Level::INFO, format, args...);
+    }
+
+    template <typename... Args>
+    void Warning(const char* format, const Args&... args) noexcept
+    {
+        Logger::Instance().Log(Level::WARNING, format, args...);
+    }
+
+    template <typename... Args>
+    void Error(const char* format, const Args&... args) noexcept
+    {
+        Logger::Instance().Log(Level::ERROR, format, args...);
+    }
+}
@@ -0,0 +1,100 @@
+#include "pch.h"
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+OptimusBot::MappedFile::MappedFile(const std::string& path) noexcept
+{
+#ifdef _WIN32
+    const auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    {
+        // The view keeps the file mapped once the handles are closed
+        if (const auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr))
+        {
+            if (const auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0))
+            {
+                m_Data = static_cast<const std::uint8_t*>(view);
+                m_Size = static_cast<std::size_t>(size.QuadPart);
+            }
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    const auto file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        return;
+
+    // The mapping stays valid once the descriptor is closed
+    struct stat status;
+    if (fstat(file, &status) == 0 && status.st_size > 0)
+    {
+        const auto size = static_cast<std::size_t>(status.st_size);
+        const auto view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (view != MAP_FAILED)
+        {
+            m_Data = static_cast<const std::uint8_t*>(view);
+            m_Size = size;
+        }
+    }
+    close(file);
+#endif
+}
+
+
+OptimusBot::MappedFile::~MappedFile() noexcept
+{
+    Close();
+}
+
+
+OptimusBot::MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_Data{ other.m_Data }, m_Size{ other.m_Size }
+{
+    other.m_Data = nullptr;
+    other.m_Size = 0;
+}
+
+
+OptimusBot::MappedFile& OptimusBot::MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+        std::swap(m_Data, other.m_Data);
+        std::swap(m_Size, other.m_Size);
+    }
+
+    return *this;
+}
+
+
+void OptimusBot::MappedFile::Close() noexcept
+{
+    if (!m_Data)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_Data);
+#else
+    munmap(const_cast<std::uint8_t*>(m_Data), m_Size);
+#endif
+
+    m_Data = nullptr;
+    m_Size = 0;
+}
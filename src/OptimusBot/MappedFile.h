@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace OptimusBot
+{
+    /// @brief Read-only memory mapping of a whole file, giving direct access to its bytes without copying them
+    class MappedFile final
+    {
+    public:
+        /// @param path File to map. If it cannot be mapped (missing, empty...), the mapping is simply closed
+        explicit MappedFile(const std::string& path) noexcept;
+
+        ~MappedFile() noexcept;
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool IsOpen() const noexcept
+        {
+            return m_Data != nullptr;
+        }
+
+        const std::uint8_t* Data() const noexcept
+        {
+            return m_Data;
+        }
+
+        std::size_t Size() const noexcept
+        {
+            return m_Size;
+        }
+
+    private:
+        void Close() noexcept;
+
+        const std::uint8_t* m_Data{ nullptr };
+        std::size_t m_Size{ 0 };
+    };
+}
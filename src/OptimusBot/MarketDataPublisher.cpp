@@ -0,0 +1,123 @@
+#include "pch.h"
+#include <algorithm>
+#include <functional>
+#include "MarketDataPublisher.h"
+
+using namespace OptimusBot::Types;
+
+
+namespace
+{
+    // Sorts the best levels of a side to the front and copies them into the snapshot
+    template <typename IsBetter>
+    std::uint32_t CopyBestLevels(std::vector<OptimusBot::BookLevel>& levels, std::array<OptimusBot::BookLevel, OptimusBot::MarketDataSnapshot::MaxLevelsEachSide>& output, IsBetter isBetter)
+    {
+        const auto count = std::min(levels.size(), output.size());
+        std::partial_sort(levels.begin(), levels.begin() + count, levels.end(), [&isBetter](const auto& lhs, const auto& rhs) {
+            return isBetter(lhs.Price, rhs.Price);
+        });
+        std::copy(levels.begin(), levels.begin() + count, output.begin());
+
+        return static_cast<std::uint32_t>(count);
+    }
+}
+
+OptimusBot::MarketDataPublisher::MarketDataPublisher(SimulatorPtr&& simulator)
+    : m_Simulator{ std::move(simulator) }
+{
+    m_Bids.reserve(MarketDataSnapshot::MaxLevelsEachSide);
+    m_Asks.reserve(MarketDataSnapshot::MaxLevelsEachSide);
+}
+
+
+bool OptimusBot::MarketDataPublisher::Publish() noexcept
+{
+    {
+        std::lock_guard lock{ m_SimulatorMutex };
+        OptimusBot::GetOrderBook(*m_Simulator, m_OrderBook);
+    }
+
+    m_Bids.clear();
+    m_Asks.clear();
+    for (const auto& [price, volume] : m_OrderBook)
+    {
+        if (volume > 0.0)
+            m_Bids.push_back(BookLevel{ price, volume });
+        else if (volume < 0.0)
+            m_Asks.push_back(BookLevel{ price, -volume });
+    }
+
+    m_Staging.Version = m_Snapshot.GetVersion() + 1;
+    m_Staging.BidCount = CopyBestLevels(m_Bids, m_Staging.Bids, std::greater<double>{});
+    m_Staging.AskCount = CopyBestLevels(m_Asks, m_Staging.Asks, std::less<double>{});
+
+    TopOfBook topOfBook;
+    topOfBook.Version = m_Staging.Version;
+    topOfBook.HasBid = m_Staging.BidCount > 0;
+    topOfBook.HasAsk = m_Staging.AskCount > 0;
+    if (topOfBook.HasBid)
+    {
+        topOfBook.BidPrice = Price{ m_Staging.Bids[0].Price };
+        topOfBook.BidVolume = Quantity{ m_Staging.Bids[0].Volume };
+    }
+    if (topOfBook.HasAsk)
+    {
+        topOfBook.AskPrice = Price{ m_Staging.Asks[0].Price };
+        topOfBook.AskVolume = Quantity{ m_Staging.Asks[0].Volume };
+    }
+
+    m_Snapshot.Store(m_Staging);
+    m_TopOfBook.Store(topOfBook);
+
+    return topOfBook.HasBid && topOfBook.HasAsk;
+}
+
+
+std::optional<IDvfSimulator::OrderID> OptimusBot::MarketDataPublisher::PlaceOrder(double price, double amount) noexcept
+{
+    std::lock_guard lock{ m_SimulatorMutex };
+    return m_Simulator->PlaceOrder(price, amount);
+}
+
+
+void OptimusBot::MarketDataPublisher::PlaceOrders(const OrderRequest* requests, std::size_t count, std::optional<IDvfSimulator::OrderID>* orderIds) noexcept
+{
+    std::lock_guard lock{ m_SimulatorMutex };
+    OptimusBot::PlaceOrders(*m_Simulator, requests, count, orderIds);
+}
+
+
+bool OptimusBot::MarketDataPublisher::CancelOrder(IDvfSimulator::OrderID oid) noexcept
+{
+    std::lock_guard lock{ m_SimulatorMutex };
+    return m_Simulator->CancelOrder(oid);
+}
+
+
+void OptimusBot::MarketDataPublisher::CancelOrders(const IDvfSimulator::OrderID* orderIds, std::size_t count, bool* results) noexcept
+{
+    std::lock_guard lock{ m_SimulatorMutex };
+    OptimusBot::CancelOrders(*m_Simulator, orderIds, count, results);
+}
+
+
+IDvfSimulator::OrderBook OptimusBot::MarketDataSubscriber::GetOrderBook() noexcept
+{
+    OrderBook orderBook;
+    GetOrderBook(orderBook);
+    return orderBook;
+}
+
+
+void OptimusBot::MarketDataSubscriber::GetOrderBook(OrderBook& orderBook) noexcept
+{
+    // A bot refreshing faster than the market is published reads the same book again, without copying it
+    if (m_Snapshot.Version == 0 || m_Publisher.GetVersion() != m_Snapshot.Version)
+        m_Publisher.GetSnapshot(m_Snapshot);
+
+    orderBook.clear();
+    for (std::uint32_t i = 0; i < m_Snapshot.BidCount; i++)
+        orderBook.emplace_back(m_Snapshot.Bids[i].Price, m_Snapshot.Bids[i].Volume);
+    for (std::uint32_t i = 0; i < m_Snapshot.AskCount; i++)
+        orderBook.emplace_back(m_Snapshot.Asks[i].Price, -m_Snapshot.Asks[i].Volume);
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include "DvfSimulator.h"
+#include "SeqLock.h"
+#include "SimulatorExtensions.h"
+#include "Types.h"
+
+namespace OptimusBot
+{
+    /// @brief Price level of a published book, as returned by the market (volumes are positive on both sides)
+    struct BookLevel
+    {
+        double Price{ 0.0 };
+        double Volume{ 0.0 };
+    };
+
+    /// @brief Depth of the market at a given publication, each side sorted from the best price outwards
+    struct MarketDataSnapshot
+    {
+        static constexpr std::size_t MaxLevelsEachSide = 64;
+
+        // Publication number, 0 before the first one
+        std::uint64_t Version{ 0 };
+
+        std::uint32_t BidCount{ 0 };
+        std::uint32_t AskCount{ 0 };
+        std::array<BookLevel, MaxLevelsEachSide> Bids;
+        std::array<BookLevel, MaxLevelsEachSide> Asks;
+    };
+
+    /// @brief Best levels of the market at a given publication, small enough to be read on every tick
+    struct TopOfBook
+    {
+        std::uint64_t Version{ 0 };
+
+        bool HasBid{ false };
+        bool HasAsk{ false };
+        Types::Price BidPrice;
+        Types::Quantity BidVolume;
+        Types::Price AskPrice;
+        Types::Quantity AskVolume;
+
+        /// @brief Best bid/ask pair, if both sides of the book are populated
+        std::optional<Types::BestOrder> GetBestOrder() const noexcept
+        {
+            if (!HasBid || !HasAsk)
+                return std::nullopt;
+
+            return Types::BestOrder{ BidPrice, AskPrice };
+        }
+    };
+
+    /// @brief Polls the order book of a market once and publishes it to any number of readers, e.g. the bots trading on that market.
+    /// Publishing goes through sequence locks: readers never lock nor wait for the writer, and copy the top of book or the depth into
+    /// their own buffers. The orders of the readers are forwarded to the same market, serialized with the polling
+    class MarketDataPublisher final
+    {
+    public:
+        /// @param simulator Market polled and receiving the orders
+        explicit MarketDataPublisher(SimulatorPtr&& simulator);
+
+        MarketDataPublisher(const MarketDataPublisher&) = delete;
+        MarketDataPublisher& operator=(const MarketDataPublisher&) = delete;
+
+        /// @brief Single writer: polls the market and publishes its book, keeping the best MaxLevelsEachSide levels of each side
+        /// @return False if a side of the book is empty (the book is published either way)
+        bool Publish() noexcept;
+
+        /// @brief Any thread: latest best levels published
+        TopOfBook GetTopOfBook() const noexcept
+        {
+            return m_TopOfBook.Load();
+        }
+
+        /// @brief Any thread: latest depth published
+        /// @param snapshot Output snapshot, overwritten
+        void GetSnapshot(MarketDataSnapshot& snapshot) const noexcept
+        {
+            m_Snapshot.Load(snapshot);
+        }
+
+        /// @brief Any thread: number of publications so far, to skip copying a snapshot already read
+        std::uint64_t GetVersion() const noexcept
+        {
+            return m_Snapshot.GetVersion();
+        }
+
+        /// @brief Any thread: forwards an order to the market
+        std::optional<IDvfSimulator::OrderID> PlaceOrder(double price, double amount) noexcept;
+
+        /// @brief Any thread: forwards a batch of orders to the market, in a single round trip if it supports batches
+        void PlaceOrders(const Types::OrderRequest* requests, std::size_t count, std::optional<IDvfSimulator::OrderID>* orderIds) noexcept;
+
+        /// @brief Any thread: forwards a cancellation to the market
+        bool CancelOrder(IDvfSimulator::OrderID oid) noexcept;
+
+        /// @brief Any thread: forwards a batch of cancellations to the market, in a single round trip if it supports batches
+        void CancelOrders(const IDvfSimulator::OrderID* orderIds, std::size_t count, bool* results) noexcept;
+
+    private:
+        // Serializes the calls to the market, which is not thread-safe. Never taken by the readers of the book
+        std::mutex m_SimulatorMutex;
+        SimulatorPtr m_Simulator;
+
+        // Writer buffers, reused from a publication to the next
+        IDvfSimulator::OrderBook m_OrderBook;
+        std::vector<BookLevel> m_Bids;
+        std::vector<BookLevel> m_Asks;
+        MarketDataSnapshot m_Staging;
+
+        SeqLock<MarketDataSnapshot> m_Snapshot;
+        SeqLock<TopOfBook> m_TopOfBook;
+    };
+
+    /// @brief Market seen by a single bot: the book is read from a shared publisher rather than requested from the market,
+    /// and the orders are forwarded to the market through the publisher
+    class MarketDataSubscriber final : public IDvfSimulator, public IBufferedOrderBookSource, public IBatchOrderPlacer, public IBatchOrderCanceller
+    {
+    public:
+        /// @param publisher Publisher of the market, which must outlive the subscriber
+        explicit MarketDataSubscriber(MarketDataPublisher& publisher) noexcept
+            : m_Publisher{ publisher }
+        {
+        }
+
+        OrderBook GetOrderBook() noexcept override;
+
+        /// @brief Latest book published, copied only when a new one was published since the previous call
+        void GetOrderBook(OrderBook& orderBook) noexcept override;
+
+        std::optional<OrderID> PlaceOrder(double price, double amount) noexcept override
+        {
+            return m_Publisher.PlaceOrder(price, amount);
+        }
+
+        bool CancelOrder(OrderID oid) noexcept override
+        {
+            return m_Publisher.CancelOrder(oid);
+        }
+
+        void PlaceOrders(const Types::OrderRequest* requests, std::size_t count, std::optional<OrderID>* orderIds) noexcept override
+        {
+            m_Publisher.PlaceOrders(requests, count, orderIds);
+        }
+
+        void CancelOrders(const OrderID* orderIds, std::size_t count, bool* results) noexcept override
+        {
+            m_Publisher.CancelOrders(orderIds, count, results);
+        }
+
+    private:
+        MarketDataPublisher& m_Publisher;
+        MarketDataSnapshot m_Snapshot;
+    };
+}
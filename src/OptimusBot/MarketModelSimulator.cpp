@@ -0,0 +1,132 @@
+#include "pch.h"
+#include <cmath>
+#include "MarketModelSimulator.h"
+
+
+OptimusBot::MarketModelSimulator::MarketModelSimulator(const MarketModelConfig& config, std::unique_ptr<IPriceProcess>&& priceProcess) noexcept
+    : m_Config{ config }, m_PriceProcess{ std::move(priceProcess) }, m_Random{ config.Seed }, m_Mid{ config.InitialMid }
+{
+    UpdateBestPrices();
+}
+
+
+IDvfSimulator::OrderBook OptimusBot::MarketModelSimulator::GetOrderBook() noexcept
+{
+    OrderBook orderBook;
+    GetOrderBook(orderBook);
+    return orderBook;
+}
+
+
+void OptimusBot::MarketModelSimulator::GetOrderBook(OrderBook& orderBook) noexcept
+{
+    m_Mid = m_PriceProcess->Next(m_Mid, m_Random);
+    UpdateBestPrices();
+    FillOrders();
+
+    orderBook.clear();
+    orderBook.reserve(2 * m_Config.Depth + m_Bids.size() + m_Asks.size());
+
+    // Bids by ascending price, the placed orders being merged in
+    auto placedBid = m_Bids.begin();
+    for (auto level = m_Config.Depth; level > 0; --level)
+    {
+        const auto price = m_BestBid - static_cast<double>(level - 1) * m_Config.LevelSpacing;
+
+        for (; placedBid != m_Bids.end() && placedBid->Price < price; ++placedBid)
+            orderBook.emplace_back(placedBid->Price, placedBid->Amount);
+
+        orderBook.emplace_back(price, RandomVolume());
+    }
+
+    for (; placedBid != m_Bids.end(); ++placedBid)
+        orderBook.emplace_back(placedBid->Price, placedBid->Amount);
+
+    // Then asks by ascending price
+    auto placedAsk = m_Asks.rbegin();
+    for (std::size_t level = 0; level < m_Config.Depth; ++level)
+    {
+        const auto price = m_BestAsk + static_cast<double>(level) * m_Config.LevelSpacing;
+
+        for (; placedAsk != m_Asks.rend() && placedAsk->Price < price; ++placedAsk)
+            orderBook.emplace_back(placedAsk->Price, placedAsk->Amount);
+
+        orderBook.emplace_back(price, -RandomVolume());
+    }
+
+    for (; placedAsk != m_Asks.rend(); ++placedAsk)
+        orderBook.emplace_back(placedAsk->Price, placedAsk->Amount);
+}
+
+
+std::optional<IDvfSimulator::OrderID> OptimusBot::MarketModelSimulator::PlaceOrder(double price, double amount) noexcept
+{
+    // Post-only: an order which would be filled immediately fails to place
+    if (amount == 0.0
+        || (amount > 0.0 && price >= m_BestAsk)
+        || (amount < 0.0 && price <= m_BestBid))
+        return {};
+
+    const Order order{ m_NextOid++, price, amount };
+
+    if (amount > 0.0)
+    {
+        const auto it = std::upper_bound(m_Bids.begin(), m_Bids.end(), price,
+            [](double value, const Order& other) { return value < other.Price; });
+        m_Bids.insert(it, order);
+    }
+    else
+    {
+        const auto it = std::upper_bound(m_Asks.begin(), m_Asks.end(), price,
+            [](double value, const Order& other) { return value > other.Price; });
+        m_Asks.insert(it, order);
+    }
+
+    return order.Oid;
+}
+
+
+bool OptimusBot::MarketModelSimulator::CancelOrder(OrderID oid) noexcept
+{
+    for (auto* orders : { &m_Bids, &m_Asks })
+    {
+        const auto it = std::find_if(orders->begin(), orders->end(), [oid](const Order& order) { return order.Oid == oid; });
+        if (it != orders->end())
+        {
+            orders->erase(it);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void OptimusBot::MarketModelSimulator::UpdateBestPrices() noexcept
+{
+    // Keeps the deepest generated bid level strictly positive
+    const auto minimumMid = 0.5 * m_Config.Spread + static_cast<double>(m_Config.Depth + 1) * m_Config.LevelSpacing;
+    m_Mid = std::max(m_Mid, minimumMid);
+
+    m_BestBid = std::floor((m_Mid - 0.5 * m_Config.Spread) / m_Config.TickSize) * m_Config.TickSize;
+    m_BestAsk = std::ceil((m_Mid + 0.5 * m_Config.Spread) / m_Config.TickSize) * m_Config.TickSize;
+
+    if (m_BestAsk <= m_BestBid)
+        m_BestAsk = m_BestBid + m_Config.TickSize;
+}
+
+
+void OptimusBot::MarketModelSimulator::FillOrders() noexcept
+{
+    while (!m_Bids.empty() && m_Bids.back().Price > m_BestBid)
+        m_Bids.pop_back();
+
+    while (!m_Asks.empty() && m_Asks.back().Price < m_BestAsk)
+        m_Asks.pop_back();
+}
+
+
+double OptimusBot::MarketModelSimulator::RandomVolume() noexcept
+{
+    return std::round(m_Random.NextDouble(m_Config.MinVolume, m_Config.MaxVolume) * 100.0) / 100.0;
+}
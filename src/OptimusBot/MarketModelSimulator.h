@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "DvfSimulator.h"
+#include "FastRandom.h"
+#include "PriceProcesses.h"
+#include "SimulatorExtensions.h"
+
+namespace OptimusBot
+{
+    /// @brief Parameters of a MarketModelSimulator
+    struct MarketModelConfig
+    {
+        // Two simulators built with the same seed and process generate the same market
+        std::uint64_t Seed{ 0 };
+
+        double InitialMid{ 205.0 };
+        double Spread{ 10.0 };
+        double TickSize{ 0.01 };
+
+        // Number of levels generated on each side of the book, and price distance between them
+        std::size_t Depth{ 10 };
+        double LevelSpacing{ 5.0 };
+
+        // Range of the volumes generated for each level
+        double MinVolume{ 0.25 };
+        double MaxVolume{ 2.5 };
+    };
+
+    /// @brief High-speed IDvfSimulator for research and stress tests: the mid price follows a pluggable price process,
+    /// all the randomness comes from a seeded generator and nothing is written to the console.
+    /// Like DvfSimulator, the orders placed are filled as soon as the market moves through them and are part of the returned book
+    class MarketModelSimulator final : public IDvfSimulator, public IBufferedOrderBookSource
+    {
+    public:
+        /// @param config Parameters of the simulated market
+        /// @param priceProcess Process driving the mid price, advanced once per snapshot
+        MarketModelSimulator(const MarketModelConfig& config, std::unique_ptr<IPriceProcess>&& priceProcess) noexcept;
+
+        OrderBook GetOrderBook() noexcept override;
+
+        /// @brief Same as GetOrderBook, reusing the capacity of the given book rather than allocating a new one
+        void GetOrderBook(OrderBook& orderBook) noexcept override;
+
+        std::optional<OrderID> PlaceOrder(double price, double amount) noexcept override;
+
+        bool CancelOrder(OrderID oid) noexcept override;
+
+        double GetBestBid() const noexcept
+        {
+            return m_BestBid;
+        }
+
+        double GetBestAsk() const noexcept
+        {
+            return m_BestAsk;
+        }
+
+    private:
+        struct Order
+        {
+            OrderID Oid;
+            double Price;
+            double Amount;
+        };
+
+        void UpdateBestPrices() noexcept;
+
+        void FillOrders() noexcept;
+
+        double RandomVolume() noexcept;
+
+        const MarketModelConfig m_Config;
+        std::unique_ptr<IPriceProcess> m_PriceProcess;
+        FastRandom m_Random;
+
+        double m_Mid;
+        double m_BestBid{ 0.0 };
+        double m_BestAsk{ 0.0 };
+
+        // Bids by ascending price and asks by descending price, so that fills are popped from the back
+        std::vector<Order> m_Bids;
+        std::vector<Order> m_Asks;
+
+        OrderID m_NextOid{ 1 };
+    };
+}
@@ -0,0 +1,307 @@
+#include "pch.h"
+#include "MatchingEngine.h"
+
+using namespace OptimusBot::Types;
+
+
+OptimusBot::MatchingEngine::MatchingEngine(const MatchingEngineConfig& config)
+    : m_MinUnits{ Price{ config.MinPrice }.Units() }
+{
+    const auto levelCount = std::max<std::int64_t>(Price{ config.MaxPrice }.Units() - m_MinUnits + 1, 1);
+    m_Levels.resize(static_cast<std::size_t>(levelCount));
+    m_Occupied.resize(static_cast<std::size_t>((levelCount + 63) / 64));
+    m_Nodes.reserve(config.InitialCapacity);
+    m_BestAsk = LevelCount();
+}
+
+
+OptimusBot::MatchingEngine::SubmitResult OptimusBot::MatchingEngine::Submit(OrderSide side, Price price, Quantity volume, OrderType type, std::vector<Trade>& trades)
+{
+    SubmitResult result;
+
+    const auto tick = price.Units() - m_MinUnits;
+    if (tick < 0 || tick >= LevelCount() || volume <= Quantity{})
+        return result;
+
+    const auto crosses = side == OrderSide::BID ? m_BestAsk <= tick : m_BestBid >= tick;
+    if (crosses && type == OrderType::POST_ONLY)
+        return result;
+
+    result.Accepted = true;
+
+    // The node is taken upfront, so that the trades carry the handle of the taker
+    const auto node = AllocateNode();
+    const auto handle = MakeHandle(node, m_Nodes[node].Generation);
+
+    auto left = volume.Units();
+    if (crosses)
+    {
+        try
+        {
+            left = Match(side, tick, left, handle, trades);
+        }
+        catch (...)
+        {
+            FreeNode(node);
+            throw;
+        }
+    }
+
+    result.Filled = Quantity::FromUnits(volume.Units() - left);
+
+    if (left == 0 || type == OrderType::IMMEDIATE_OR_CANCEL)
+    {
+        FreeNode(node);
+        return result;
+    }
+
+    auto& resting = m_Nodes[node];
+    resting.Volume = left;
+    resting.Tick = tick;
+    Link(node);
+
+    if (side == OrderSide::BID)
+        m_BestBid = std::max(m_BestBid, tick);
+    else
+        m_BestAsk = std::min(m_BestAsk, tick);
+
+    result.Resting = handle;
+    return result;
+}
+
+
+bool OptimusBot::MatchingEngine::Cancel(OrderHandle handle) noexcept
+{
+    if (!FindNode(handle))
+        return false;
+
+    const auto node = static_cast<std::uint32_t>(handle);
+    const auto tick = m_Nodes[node].Tick;
+    Unlink(node);
+    FreeNode(node);
+
+    if (m_Levels[static_cast<std::size_t>(tick)].Head == noNode)
+    {
+        if (tick == m_BestBid)
+            m_BestBid = FindBelow(tick - 1);
+        else if (tick == m_BestAsk)
+            m_BestAsk = FindAbove(tick + 1);
+    }
+
+    return true;
+}
+
+
+std::optional<Quantity> OptimusBot::MatchingEngine::GetRemaining(OrderHandle handle) const noexcept
+{
+    const auto node = FindNode(handle);
+    return node ? std::optional<Quantity>{ Quantity::FromUnits(node->Volume) } : std::nullopt;
+}
+
+
+std::optional<Price> OptimusBot::MatchingEngine::GetBestBid() const noexcept
+{
+    return m_BestBid >= 0 ? std::optional<Price>{ ToPrice(m_BestBid) } : std::nullopt;
+}
+
+
+std::optional<Price> OptimusBot::MatchingEngine::GetBestAsk() const noexcept
+{
+    return m_BestAsk < LevelCount() ? std::optional<Price>{ ToPrice(m_BestAsk) } : std::nullopt;
+}
+
+
+Quantity OptimusBot::MatchingEngine::GetVolumeAt(Price price) const noexcept
+{
+    const auto tick = price.Units() - m_MinUnits;
+    if (tick < 0 || tick >= LevelCount())
+        return Quantity{};
+
+    return Quantity::FromUnits(m_Levels[static_cast<std::size_t>(tick)].Volume);
+}
+
+
+const OptimusBot::MatchingEngine::Node* OptimusBot::MatchingEngine::FindNode(OrderHandle handle) const noexcept
+{
+    const auto index = static_cast<std::uint32_t>(handle);
+    if (index >= m_Nodes.size())
+        return nullptr;
+
+    const auto& node = m_Nodes[index];
+    return node.Resting && node.Generation == static_cast<std::uint32_t>(handle >> 32) ? &node : nullptr;
+}
+
+
+std::uint32_t OptimusBot::MatchingEngine::AllocateNode()
+{
+    std::uint32_t node;
+    if (m_FreeNodes != noNode)
+    {
+        node = m_FreeNodes;
+        m_FreeNodes = m_Nodes[node].Next;
+    }
+    else
+    {
+        node = static_cast<std::uint32_t>(m_Nodes.size());
+        m_Nodes.emplace_back();
+    }
+
+    // Generations start at 1, so that no handle is 0
+    auto& allocated = m_Nodes[node];
+    allocated.Generation++;
+    if (allocated.Generation == 0)
+        allocated.Generation = 1;
+
+    allocated.Previous = noNode;
+    allocated.Next = noNode;
+    return node;
+}
+
+
+void OptimusBot::MatchingEngine::FreeNode(std::uint32_t node) noexcept
+{
+    auto& freed = m_Nodes[node];
+    freed.Resting = false;
+    freed.Next = m_FreeNodes;
+    m_FreeNodes = node;
+}
+
+
+void OptimusBot::MatchingEngine::Link(std::uint32_t node) noexcept
+{
+    auto& linked = m_Nodes[node];
+    auto& level = m_Levels[static_cast<std::size_t>(linked.Tick)];
+
+    linked.Resting = true;
+    linked.Previous = level.Tail;
+    linked.Next = noNode;
+
+    if (level.Tail != noNode)
+        m_Nodes[level.Tail].Next = node;
+    else
+    {
+        level.Head = node;
+        SetOccupied(linked.Tick, true);
+    }
+
+    level.Tail = node;
+    level.Volume += linked.Volume;
+    m_OrderCount++;
+}
+
+
+void OptimusBot::MatchingEngine::Unlink(std::uint32_t node) noexcept
+{
+    auto& unlinked = m_Nodes[node];
+    auto& level = m_Levels[static_cast<std::size_t>(unlinked.Tick)];
+
+    if (unlinked.Previous != noNode)
+        m_Nodes[unlinked.Previous].Next = unlinked.Next;
+    else
+        level.Head = unlinked.Next;
+
+    if (unlinked.Next != noNode)
+        m_Nodes[unlinked.Next].Previous = unlinked.Previous;
+    else
+        level.Tail = unlinked.Previous;
+
+    level.Volume -= unlinked.Volume;
+    if (level.Head == noNode)
+        SetOccupied(unlinked.Tick, false);
+
+    unlinked.Resting = false;
+    m_OrderCount--;
+}
+
+
+std::int64_t OptimusBot::MatchingEngine::Match(OrderSide side, std::int64_t limitTick, std::int64_t volume, OrderHandle taker, std::vector<Trade>& trades)
+{
+    const auto isBid = side == OrderSide::BID;
+
+    while (volume > 0)
+    {
+        // An empty side ends the loop too, its best tick being out of the range
+        const auto tick = isBid ? m_BestAsk : m_BestBid;
+        if (isBid ? tick > limitTick : tick < limitTick)
+            break;
+
+        auto& level = m_Levels[static_cast<std::size_t>(tick)];
+        while (volume > 0 && level.Head != noNode)
+        {
+            const auto makerNode = level.Head;
+            auto& maker = m_Nodes[makerNode];
+            const auto traded = std::min(volume, maker.Volume);
+
+            trades.push_back({ MakeHandle(makerNode, maker.Generation), taker, side, ToPrice(tick), Quantity::FromUnits(traded) });
+            volume -= traded;
+
+            if (traded == maker.Volume)
+            {
+                Unlink(makerNode);
+                FreeNode(makerNode);
+            }
+            else
+            {
+                maker.Volume -= traded;
+                level.Volume -= traded;
+            }
+        }
+
+        // The level is exhausted, the next one of the side becomes the best
+        if (level.Head == noNode)
+        {
+            if (isBid)
+                m_BestAsk = FindAbove(tick + 1);
+            else
+                m_BestBid = FindBelow(tick - 1);
+        }
+    }
+
+    return volume;
+}
+
+
+std::int64_t OptimusBot::MatchingEngine::FindAbove(std::int64_t tick) const noexcept
+{
+    if (tick >= LevelCount())
+        return LevelCount();
+
+    auto word = static_cast<std::size_t>(tick / 64);
+    auto bits = m_Occupied[word] & (~std::uint64_t{ 0 } << (tick % 64));
+
+    while (bits == 0)
+    {
+        if (++word == m_Occupied.size())
+            return LevelCount();
+        bits = m_Occupied[word];
+    }
+
+    return static_cast<std::int64_t>(word * 64 + LowestBit(bits));
+}
+
+
+std::int64_t OptimusBot::MatchingEngine::FindBelow(std::int64_t tick) const noexcept
+{
+    if (tick < 0)
+        return -1;
+
+    auto word = static_cast<std::size_t>(tick / 64);
+    auto bits = m_Occupied[word] & (~std::uint64_t{ 0 } >> (63 - tick % 64));
+
+    while (bits == 0)
+    {
+        if (word-- == 0)
+            return -1;
+        bits = m_Occupied[word];
+    }
+
+    return static_cast<std::int64_t>(word * 64 + HighestBit(bits));
+}
+
+
+void OptimusBot::MatchingEngine::SetOccupied(std::int64_t tick, bool occupied) noexcept
+{
+    const auto mask = std::uint64_t{ 1 } << (tick % 64);
+    auto& word = m_Occupied[static_cast<std::size_t>(tick / 64)];
+    word = occupied ? word | mask : word & ~mask;
+}
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "DvfSimulator.h"
+#include "Types.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace OptimusBot
+{
+    /// @brief Parameters of a MatchingEngine
+    struct MatchingEngineConfig
+    {
+        // Range of the prices accepted, a level being stored for every cent of it
+        double MinPrice{ 0.01 };
+        double MaxPrice{ 1000.0 };
+
+        // Orders the pool is sized for upfront, growing beyond if needed
+        std::size_t InitialCapacity{ 1 << 16 };
+    };
+
+    /// @brief How the part of an order which is not matched right away is handled
+    enum class OrderType
+    {
+        LIMIT,                  // Rests in the book
+        POST_ONLY,              // Rejected if it would match on arrival, rests otherwise
+        IMMEDIATE_OR_CANCEL,    // Dropped
+    };
+
+    /// @brief Limit order book matching by price-time priority, with partial fills.
+    /// Each cent of the price range has its level, a FIFO queue of intrusive order nodes, stored contiguously and found by index;
+    /// a bitmap of the non-empty levels finds the next best price 64 levels at a time. Nodes come from a pool recycled through
+    /// a free list, and the handle of an order encodes its node, so that cancelling costs O(1) with no lookup table.
+    /// Not thread-safe
+    class MatchingEngine final
+    {
+    public:
+        /// @brief Identifies an order resting in the book: its node and the generation of that node, so that the handle of a
+        /// filled or cancelled order never refers to the order reusing its node. Never 0
+        using OrderHandle = std::uint64_t;
+
+        /// @brief Match between an incoming order and a resting one, at the price of the resting one
+        struct Trade
+        {
+            OrderHandle Maker;
+            OrderHandle Taker;
+            Types::OrderSide TakerSide;
+            Types::Price Price;
+            Types::Quantity Volume;
+        };
+
+        /// @brief Outcome of a submission
+        struct SubmitResult
+        {
+            // False if the order was rejected: out of the price range, not positive, or crossing while post-only
+            bool Accepted{ false };
+
+            // Handle of the part left resting in the book, if any
+            std::optional<OrderHandle> Resting;
+
+            Types::Quantity Filled;
+        };
+
+        explicit MatchingEngine(const MatchingEngineConfig& config = MatchingEngineConfig{});
+
+        MatchingEngine(const MatchingEngine&) = delete;
+        MatchingEngine& operator=(const MatchingEngine&) = delete;
+
+        /// @brief Matches an order against the opposite side of the book, then handles the rest according to its type
+        /// @param trades Output buffer, the trades of the order being appended to it. If appending throws, the exception propagates,
+        /// the trades appended until then having been executed and the rest of the order being dropped
+        SubmitResult Submit(Types::OrderSide side, Types::Price price, Types::Quantity volume, OrderType type, std::vector<Trade>& trades);
+
+        /// @brief Removes a resting order
+        /// @return False if the order is not resting anymore (filled or cancelled)
+        bool Cancel(OrderHandle handle) noexcept;
+
+        /// @brief Volume left of a resting order, std::nullopt if it is not resting anymore
+        std::optional<Types::Quantity> GetRemaining(OrderHandle handle) const noexcept;
+
+        std::optional<Types::Price> GetBestBid() const noexcept;
+
+        std::optional<Types::Price> GetBestAsk() const noexcept;
+
+        /// @brief Total volume resting at a price, 0 if out of the price range
+        Types::Quantity GetVolumeAt(Types::Price price) const noexcept;
+
+        /// @brief Number of orders resting in the book
+        std::size_t GetOrderCount() const noexcept
+        {
+            return m_OrderCount;
+        }
+
+        /// @brief Visits the non-empty levels of a side from the best price outwards, with their total volume
+        /// @param maxLevels Number of levels visited at most
+        template <typename Visitor>
+        void ForEachLevel(Types::OrderSide side, std::size_t maxLevels, Visitor&& visitor) const
+        {
+            if (side == Types::OrderSide::BID)
+            {
+                for (auto tick = m_BestBid; tick >= 0 && maxLevels > 0; tick = FindBelow(tick - 1), maxLevels--)
+                    visitor(ToPrice(tick), Types::Quantity::FromUnits(m_Levels[static_cast<std::size_t>(tick)].Volume));
+            }
+            else
+            {
+                for (auto tick = m_BestAsk; tick < LevelCount() && maxLevels > 0; tick = FindAbove(tick + 1), maxLevels--)
+                    visitor(ToPrice(tick), Types::Quantity::FromUnits(m_Levels[static_cast<std::size_t>(tick)].Volume));
+            }
+        }
+
+    private:
+        static constexpr std::uint32_t noNode = 0xFFFFFFFF;
+
+        // FIFO queue of the orders resting at a price
+        struct Level
+        {
+            std::uint32_t Head{ noNode };
+            std::uint32_t Tail{ noNode };
+            std::int64_t Volume{ 0 };
+        };
+
+        // Resting order, linked to its neighbours in the queue of its level. Free nodes are chained through Next
+        struct Node
+        {
+            std::int64_t Volume{ 0 };
+            std::int64_t Tick{ 0 };
+            std::uint32_t Previous{ noNode };
+            std::uint32_t Next{ noNode };
+            std::uint32_t Generation{ 0 };
+            bool Resting{ false };
+        };
+
+        std::int64_t LevelCount() const noexcept
+        {
+            return static_cast<std::int64_t>(m_Levels.size());
+        }
+
+        Types::Price ToPrice(std::int64_t tick) const noexcept
+        {
+            return Types::Price::FromUnits(m_MinUnits + tick);
+        }
+
+        static OrderHandle MakeHandle(std::uint32_t node, std::uint32_t generation) noexcept
+        {
+            return (static_cast<OrderHandle>(generation) << 32) | node;
+        }
+
+        // Node of a resting order, nullptr if the handle is stale
+        const Node* FindNode(OrderHandle handle) const noexcept;
+
+        std::uint32_t AllocateNode();
+
+        void FreeNode(std::uint32_t node) noexcept;
+
+        void Link(std::uint32_t node) noexcept;
+
+        void Unlink(std::uint32_t node) noexcept;
+
+        // Matches against the levels of the opposite side up to the limit price, returning the volume left.
+        // Each trade is appended before it is executed, so that the book stays consistent if appending throws
+        std::int64_t Match(Types::OrderSide side, std::int64_t limitTick, std::int64_t volume, OrderHandle taker, std::vector<Trade>& trades);
+
+        // Nearest non-empty level at or above/below the given one, LevelCount()/-1 if none
+        std::int64_t FindAbove(std::int64_t tick) const noexcept;
+        std::int64_t FindBelow(std::int64_t tick) const noexcept;
+
+        void SetOccupied(std::int64_t tick, bool occupied) noexcept;
+
+        static unsigned LowestBit(std::uint64_t value) noexcept
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward64(&index, value);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+        }
+
+        static unsigned HighestBit(std::uint64_t value) noexcept
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanReverse64(&index, value);
+            return static_cast<unsigned>(index);
+#else
+            return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#endif
+        }
+
+        const std::int64_t m_MinUnits;
+
+        std::vector<Level> m_Levels;
+        std::vector<std::uint64_t> m_Occupied;
+
+        std::vector<Node> m_Nodes;
+        std::uint32_t m_FreeNodes{ noNode };
+        std::size_t m_OrderCount{ 0 };
+
+        // Ticks of the best levels, -1 and LevelCount() when a side is empty
+        std::int64_t m_BestBid{ -1 };
+        std::int64_t m_BestAsk;
+    };
+}
@@ -0,0 +1,169 @@
+#include "pch.h"
+#include <cmath>
+#include "MatchingEngineSimulator.h"
+
+using namespace OptimusBot::Types;
+
+
+OptimusBot::MatchingEngineSimulator::MatchingEngineSimulator(const MatchingSimulatorConfig& config, std::unique_ptr<IPriceProcess>&& priceProcess)
+    : m_Config{ config }, m_PriceProcess{ std::move(priceProcess) }, m_Random{ config.Seed }, m_Mid{ config.InitialMid }, m_Engine{ config.Engine }
+{
+    m_Background.reserve(2 * config.InitialOrders);
+
+    for (std::size_t i = 0; i < config.InitialOrders; i++)
+    {
+        const auto side = i % 2 ? OrderSide::ASK : OrderSide::BID;
+        const auto distance = m_Config.HalfSpread + m_Random.NextDouble(0.0, m_Config.MaxDistance);
+        SubmitBackground(side, side == OrderSide::BID ? m_Mid - distance : m_Mid + distance, OrderType::LIMIT);
+    }
+
+    m_Trades.clear();
+}
+
+
+IDvfSimulator::OrderBook OptimusBot::MatchingEngineSimulator::GetOrderBook() noexcept
+{
+    OrderBook orderBook;
+    GetOrderBook(orderBook);
+    return orderBook;
+}
+
+
+void OptimusBot::MatchingEngineSimulator::GetOrderBook(OrderBook& orderBook) noexcept
+{
+    // Keeps the flow within the price range of the engine
+    const auto lowest = m_Config.Engine.MinPrice + m_Config.HalfSpread + m_Config.MaxDistance;
+    const auto highest = m_Config.Engine.MaxPrice - m_Config.HalfSpread - m_Config.MaxDistance;
+    m_Mid = std::clamp(m_PriceProcess->Next(m_Mid, m_Random), lowest, std::max(lowest, highest));
+
+    m_Trades.clear();
+    for (std::size_t i = 0; i < m_Config.EventsPerSnapshot; i++)
+    {
+        const auto event = m_Random.NextDouble();
+        const auto side = m_Random.NextDouble() < 0.5 ? OrderSide::BID : OrderSide::ASK;
+        const auto direction = side == OrderSide::BID ? 1.0 : -1.0;
+
+        if (event < m_Config.CancelRatio)
+            CancelBackground();
+        else if (event < m_Config.CancelRatio + m_Config.MarketableRatio)
+            SubmitBackground(side, m_Mid + direction * m_Config.MaxDistance, OrderType::IMMEDIATE_OR_CANCEL);
+        else
+            SubmitBackground(side, m_Mid - direction * (m_Config.HalfSpread + m_Random.NextDouble(0.0, m_Config.MaxDistance)), OrderType::LIMIT);
+    }
+
+    ProcessTrades();
+    m_Statistics.Snapshots++;
+
+    orderBook.clear();
+    m_Engine.ForEachLevel(OrderSide::BID, m_Config.Depth, [&orderBook](Price price, Quantity volume) {
+        orderBook.emplace_back(price.ToDouble(), volume.ToDouble());
+    });
+    m_Engine.ForEachLevel(OrderSide::ASK, m_Config.Depth, [&orderBook](Price price, Quantity volume) {
+        orderBook.emplace_back(price.ToDouble(), -volume.ToDouble());
+    });
+}
+
+
+std::optional<IDvfSimulator::OrderID> OptimusBot::MatchingEngineSimulator::PlaceOrder(double price, double amount) noexcept
+{
+    const auto side = amount > 0.0 ? OrderSide::BID : OrderSide::ASK;
+    std::vector<MatchingEngine::Trade> noTrades;
+
+    // Post-only: an order which would be filled immediately fails to place
+    const auto result = m_Engine.Submit(side, Price{ price }, Quantity{ std::abs(amount) }, OrderType::POST_ONLY, noTrades);
+    if (!result.Resting)
+        return {};
+
+    const auto oid = m_NextOid++;
+    m_BotOrders.emplace(oid, result.Resting.value());
+    m_BotHandles.emplace(result.Resting.value(), oid);
+
+    return oid;
+}
+
+
+bool OptimusBot::MatchingEngineSimulator::CancelOrder(OrderID oid) noexcept
+{
+    const auto it = m_BotOrders.find(oid);
+    if (it == m_BotOrders.end())
+        return false;
+
+    const auto cancelled = m_Engine.Cancel(it->second);
+    m_BotHandles.erase(it->second);
+    m_BotOrders.erase(it);
+
+    return cancelled;
+}
+
+
+std::optional<Quantity> OptimusBot::MatchingEngineSimulator::GetRemaining(OrderID oid) const noexcept
+{
+    const auto it = m_BotOrders.find(oid);
+    return it != m_BotOrders.end() ? m_Engine.GetRemaining(it->second) : std::nullopt;
+}
+
+
+void OptimusBot::MatchingEngineSimulator::SubmitBackground(OrderSide side, double price, OrderType type)
+{
+    const auto volume = std::round(m_Random.NextDouble(m_Config.MinVolume, m_Config.MaxVolume) * 100.0) / 100.0;
+
+    const auto result = m_Engine.Submit(side, Price{ price }, Quantity{ volume }, type, m_Trades);
+    m_Statistics.OrdersSubmitted++;
+
+    if (result.Resting)
+        m_Background.push_back(result.Resting.value());
+}
+
+
+void OptimusBot::MatchingEngineSimulator::CancelBackground()
+{
+    if (m_Background.empty())
+        return;
+
+    // Swap and pop: which order is cancelled does not matter, as long as it is random
+    const auto index = static_cast<std::size_t>(m_Random() % m_Background.size());
+    const auto handle = m_Background[index];
+    m_Background[index] = m_Background.back();
+    m_Background.pop_back();
+
+    if (m_Engine.Cancel(handle))
+        m_Statistics.OrdersCancelled++;
+
+    // Handles of filled orders pile up otherwise
+    if (m_Background.size() > 2 * m_Engine.GetOrderCount() + 1024)
+    {
+        m_Background.erase(std::remove_if(m_Background.begin(), m_Background.end(),
+            [this](MatchingEngine::OrderHandle background) { return !m_Engine.GetRemaining(background); }), m_Background.end());
+    }
+}
+
+
+void OptimusBot::MatchingEngineSimulator::ProcessTrades()
+{
+    for (const auto& trade : m_Trades)
+    {
+        m_Statistics.Trades++;
+        m_Statistics.TradedVolume += trade.Volume.ToDouble();
+
+        if (m_BotHandles.count(trade.Maker))
+        {
+            m_Statistics.BotTrades++;
+            m_Statistics.BotFilledVolume += trade.Volume.ToDouble();
+        }
+    }
+
+    // Once all the trades are accounted, as an order may have traded several times
+    if (m_BotHandles.empty())
+        return;
+
+    for (const auto& trade : m_Trades)
+    {
+        const auto bot = m_BotHandles.find(trade.Maker);
+        if (bot != m_BotHandles.end() && !m_Engine.GetRemaining(trade.Maker))
+        {
+            m_Statistics.BotOrdersFilled++;
+            m_BotOrders.erase(bot->second);
+            m_BotHandles.erase(bot);
+        }
+    }
+}
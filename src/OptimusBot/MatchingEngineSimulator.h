@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "DvfSimulator.h"
+#include "FastRandom.h"
+#include "MatchingEngine.h"
+#include "PriceProcesses.h"
+#include "SimulatorExtensions.h"
+
+namespace OptimusBot
+{
+    /// @brief Parameters of a MatchingEngineSimulator
+    struct MatchingSimulatorConfig
+    {
+        // Two simulators built with the same seed and process generate the same market
+        std::uint64_t Seed{ 0 };
+
+        double InitialMid{ 205.0 };
+
+        // Book of the matching engine, which must cover the prices the mid can reach
+        MatchingEngineConfig Engine;
+
+        // Orders of the other participants, resting on the book before the first snapshot
+        std::size_t InitialOrders{ 1000 };
+
+        // Order flow generated on each snapshot, split between cancellations of resting orders, marketable orders taking
+        // liquidity (immediate-or-cancel) and limit orders providing it
+        std::size_t EventsPerSnapshot{ 100 };
+        double CancelRatio{ 0.4 };
+        double MarketableRatio{ 0.1 };
+
+        // Limit orders are priced within [HalfSpread, HalfSpread + MaxDistance] of the mid, marketable ones reach MaxDistance through it
+        double HalfSpread{ 0.05 };
+        double MaxDistance{ 5.0 };
+
+        // Range of the volumes of the generated orders
+        double MinVolume{ 0.25 };
+        double MaxVolume{ 2.5 };
+
+        // Levels of each side returned by GetOrderBook
+        std::size_t Depth{ 10 };
+    };
+
+    /// @brief IDvfSimulator backed by a MatchingEngine, for realistic load tests: the other participants submit and cancel orders
+    /// around a mid following a pluggable price process, and the orders of the bot are filled, possibly partially, when the
+    /// flow trades through them, by price-time priority. The orders of the bot are post-only, like on the other simulators
+    class MatchingEngineSimulator final : public IDvfSimulator, public IBufferedOrderBookSource, public IOrderLookup
+    {
+    public:
+        /// @brief Counters describing the activity of the market
+        struct Statistics
+        {
+            std::uint64_t Snapshots{ 0 };
+            std::uint64_t OrdersSubmitted{ 0 };
+            std::uint64_t OrdersCancelled{ 0 };
+            std::uint64_t Trades{ 0 };
+            double TradedVolume{ 0.0 };
+
+            // Trades against the orders of the bot, and orders of the bot filled completely
+            std::uint64_t BotTrades{ 0 };
+            std::uint64_t BotOrdersFilled{ 0 };
+            double BotFilledVolume{ 0.0 };
+        };
+
+        /// @param config Parameters of the simulated market
+        /// @param priceProcess Process driving the mid price, advanced once per snapshot
+        MatchingEngineSimulator(const MatchingSimulatorConfig& config, std::unique_ptr<IPriceProcess>&& priceProcess);
+
+        /// @brief Advances the market by a snapshot's worth of order flow, then returns the aggregated levels of the book
+        OrderBook GetOrderBook() noexcept override;
+
+        /// @brief Same as GetOrderBook, reusing the capacity of the given book rather than allocating a new one
+        void GetOrderBook(OrderBook& orderBook) noexcept override;
+
+        std::optional<OrderID> PlaceOrder(double price, double amount) noexcept override;
+
+        bool CancelOrder(OrderID oid) noexcept override;
+
+        /// @brief Volume left of an order of the bot, std::nullopt once it is filled or cancelled
+        std::optional<Types::Quantity> GetRemaining(OrderID oid) const noexcept override;
+
+        /// @brief Trades of the last snapshot
+        const std::vector<MatchingEngine::Trade>& GetLastTrades() const noexcept
+        {
+            return m_Trades;
+        }
+
+        const Statistics& GetStatistics() const noexcept
+        {
+            return m_Statistics;
+        }
+
+        const MatchingEngine& GetEngine() const noexcept
+        {
+            return m_Engine;
+        }
+
+        double GetMid() const noexcept
+        {
+            return m_Mid;
+        }
+
+    private:
+        // Submits an order of the other participants, remembering it if it rests
+        void SubmitBackground(Types::OrderSide side, double price, OrderType type);
+
+        void CancelBackground();
+
+        // Accounts the trades of the last snapshot, forgetting the orders of the bot filled completely
+        void ProcessTrades();
+
+        const MatchingSimulatorConfig m_Config;
+        std::unique_ptr<IPriceProcess> m_PriceProcess;
+        FastRandom m_Random;
+        double m_Mid;
+
+        MatchingEngine m_Engine;
+        std::vector<MatchingEngine::Trade> m_Trades;
+
+        // Resting orders of the other participants, some of them possibly filled since, purged once they outnumber the live ones
+        std::vector<MatchingEngine::OrderHandle> m_Background;
+
+        std::unordered_map<OrderID, MatchingEngine::OrderHandle> m_BotOrders;
+        std::unordered_map<MatchingEngine::OrderHandle, OrderID> m_BotHandles;
+        OrderID m_NextOid{ 1 };
+
+        Statistics m_Statistics;
+    };
+}
@@ -0,0 +1,96 @@
+#include "pch.h"
+#include <functional>
+#include <numeric>
+#include "OrderBook.h"
+
+using namespace OptimusBot::Types;
+
+
+void OptimusBot::OrderBook::Apply(const LevelDelta& delta) noexcept
+{
+    const bool isBid = delta.Side == OrderSide::BID;
+    auto& ladder = isBid ? m_Bids : m_Asks;
+    auto& prices = ladder.Prices;
+    auto& volumes = ladder.Volumes;
+
+    const auto it = isBid
+        ? std::lower_bound(prices.begin(), prices.end(), delta.Price)
+        : std::lower_bound(prices.begin(), prices.end(), delta.Price, std::greater<Price>{});
+    const auto index = it - prices.begin();
+    const bool exists = it != prices.end() && *it == delta.Price;
+
+    if (delta.Action == LevelAction::REMOVE || delta.Volume <= Quantity{})
+    {
+        if (exists)
+        {
+            prices.erase(it);
+            volumes.erase(volumes.begin() + index);
+        }
+        return;
+    }
+
+    // ADD and CHANGE are handled alike, so that a missed delta does not corrupt the book
+    if (exists)
+    {
+        volumes[index] = delta.Volume;
+    }
+    else
+    {
+        prices.insert(it, delta.Price);
+        volumes.insert(volumes.begin() + index, delta.Volume);
+    }
+}
+
+
+void OptimusBot::OrderBook::Apply(const std::vector<LevelDelta>& deltas) noexcept
+{
+    for (const auto& delta : deltas)
+        Apply(delta);
+}
+
+
+void OptimusBot::OrderBook::Clear() noexcept
+{
+    m_Bids.Prices.clear();
+    m_Bids.Volumes.clear();
+    m_Asks.Prices.clear();
+    m_Asks.Volumes.clear();
+}
+
+
+std::optional<BestOrder> OptimusBot::OrderBook::GetBestOrder() const noexcept
+{
+    if (m_Bids.Prices.empty() || m_Asks.Prices.empty())
+        return {};
+
+    return BestOrder{ m_Bids.Prices.back(), m_Asks.Prices.back() };
+}
+
+
+std::size_t OptimusBot::OrderBook::Depth(OrderSide side) const noexcept
+{
+    return GetLadder(side).Prices.size();
+}
+
+
+Price OptimusBot::OrderBook::PriceAt(OrderSide side, std::size_t level) const noexcept
+{
+    const auto& prices = GetLadder(side).Prices;
+    return prices[prices.size() - 1 - level];
+}
+
+
+Quantity OptimusBot::OrderBook::VolumeAt(OrderSide side, std::size_t level) const noexcept
+{
+    const auto& volumes = GetLadder(side).Volumes;
+    return volumes[volumes.size() - 1 - level];
+}
+
+
+Quantity OptimusBot::OrderBook::CumulativeVolume(OrderSide side, std::size_t levels) const noexcept
+{
+    const auto& volumes = GetLadder(side).Volumes;
+    const auto count = std::min(levels, volumes.size());
+
+    return std::accumulate(volumes.end() - count, volumes.end(), Quantity{});
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+#include "DvfSimulator.h"
+#include "Types.h"
+
+namespace OptimusBot
+{
+    /// @brief L2 order book maintained incrementally from price level deltas.
+    /// Each side is kept as sorted flat arrays of prices and volumes, the best level being stored last so that
+    /// the frequent changes close to the top of the book only move a few elements
+    class OrderBook final
+    {
+    public:
+        /// @brief Applies a single price level change. A level whose volume drops to zero is removed
+        void Apply(const Types::LevelDelta& delta) noexcept;
+
+        /// @brief Applies a sequence of price level changes, in order
+        void Apply(const std::vector<Types::LevelDelta>& deltas) noexcept;
+
+        /// @brief Removes all the price levels
+        void Clear() noexcept;
+
+        /// @brief Best bid/ask pair, in constant time
+        /// @return An empty optional if either side of the book is empty
+        std::optional<Types::BestOrder> GetBestOrder() const noexcept;
+
+        /// @brief Number of price levels on one side of the book
+        std::size_t Depth(Types::OrderSide side) const noexcept;
+
+        /// @brief Price of a level, 0 being the best level of that side. The index must be smaller than Depth(side)
+        Types::Price PriceAt(Types::OrderSide side, std::size_t level) const noexcept;
+
+        /// @brief Volume of a level, 0 being the best level of that side. The index must be smaller than Depth(side)
+        Types::Quantity VolumeAt(Types::OrderSide side, std::size_t level) const noexcept;
+
+        /// @brief Total volume resting on the best levels of one side
+        /// @param levels Number of levels to accumulate, clamped to the depth of the side
+        Types::Quantity CumulativeVolume(Types::OrderSide side, std::size_t levels) const noexcept;
+
+        /// @brief Prices of one side as a contiguous array, the best level being last, e.g. for vectorized reductions.
+        /// Invalidated by Apply and Clear
+        const std::vector<Types::Price>& GetPrices(Types::OrderSide side) const noexcept
+        {
+            return GetLadder(side).Prices;
+        }
+
+        /// @brief Volumes of one side, parallel to GetPrices
+        const std::vector<Types::Quantity>& GetVolumes(Types::OrderSide side) const noexcept
+        {
+            return GetLadder(side).Volumes;
+        }
+
+    private:
+        // Bids are sorted by ascending prices and asks by descending prices: the best level is always last.
+        // The fixed-point prices are searched with integer comparisons
+        struct Ladder
+        {
+            std::vector<Types::Price> Prices;
+            std::vector<Types::Quantity> Volumes;
+        };
+
+        const Ladder& GetLadder(Types::OrderSide side) const noexcept
+        {
+            return side == Types::OrderSide::BID ? m_Bids : m_Asks;
+        }
+
+        Ladder m_Bids;
+        Ladder m_Asks;
+    };
+}
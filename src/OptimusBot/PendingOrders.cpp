@@ -0,0 +1,111 @@
+#include "pch.h"
+#include "PendingOrders.h"
+
+using namespace OptimusBot::Types;
+
+
+bool OptimusBot::PendingOrders::Insert(const BotOrder& order)
+{
+    const auto sequence = m_NextSequence++;
+    if (!m_Index.emplace(order.OrderId, IndexEntry{ order, sequence }).second)
+        return false;
+
+    const LadderEntry entry{ order.Price, order.OrderId, sequence };
+
+    // Inserted after the orders of the same price, which would be filled at the same time anyway
+    if (order.Side == OrderSide::BID)
+    {
+        const auto it = std::upper_bound(m_Bids.begin(), m_Bids.end(), entry,
+            [](const LadderEntry& lhs, const LadderEntry& rhs) { return lhs.Price < rhs.Price; });
+        m_Bids.insert(it, entry);
+    }
+    else
+    {
+        const auto it = std::upper_bound(m_Asks.begin(), m_Asks.end(), entry,
+            [](const LadderEntry& lhs, const LadderEntry& rhs) { return lhs.Price > rhs.Price; });
+        m_Asks.insert(it, entry);
+    }
+
+    return true;
+}
+
+
+const BotOrder* OptimusBot::PendingOrders::Find(IDvfSimulator::OrderID orderId) const noexcept
+{
+    const auto it = m_Index.find(orderId);
+    return it != m_Index.end() ? &it->second.Order : nullptr;
+}
+
+
+bool OptimusBot::PendingOrders::Erase(IDvfSimulator::OrderID orderId)
+{
+    if (m_Index.erase(orderId) == 0)
+        return false;
+
+    // The ladder entry is left in place and skipped later on
+    m_StaleEntries++;
+    CompactIfNeeded();
+
+    return true;
+}
+
+
+void OptimusBot::PendingOrders::EraseFilled(const BestOrder& bestOrder, std::vector<BotOrder>& filledOrders)
+{
+    filledOrders.clear();
+
+    PopFilled(m_Bids, [&bestOrder](Price price) { return price > bestOrder.Bid; }, filledOrders);
+    PopFilled(m_Asks, [&bestOrder](Price price) { return price < bestOrder.Ask; }, filledOrders);
+}
+
+
+void OptimusBot::PendingOrders::Clear() noexcept
+{
+    m_Bids.clear();
+    m_Asks.clear();
+    m_Index.clear();
+    m_StaleEntries = 0;
+}
+
+
+const BotOrder* OptimusBot::PendingOrders::FindLive(const LadderEntry& entry) const noexcept
+{
+    const auto it = m_Index.find(entry.OrderId);
+    return it != m_Index.end() && it->second.Sequence == entry.Sequence ? &it->second.Order : nullptr;
+}
+
+
+template <typename IsFilled>
+void OptimusBot::PendingOrders::PopFilled(std::vector<LadderEntry>& ladder, IsFilled isFilled, std::vector<BotOrder>& filledOrders)
+{
+    while (!ladder.empty() && isFilled(ladder.back().Price))
+    {
+        const auto& entry = ladder.back();
+
+        const auto it = m_Index.find(entry.OrderId);
+        if (it != m_Index.end() && it->second.Sequence == entry.Sequence)
+        {
+            filledOrders.push_back(it->second.Order);
+            m_Index.erase(it);
+        }
+        else
+        {
+            m_StaleEntries--;
+        }
+
+        ladder.pop_back();
+    }
+}
+
+
+void OptimusBot::PendingOrders::CompactIfNeeded()
+{
+    constexpr std::size_t minStaleEntries = 64;
+    if (m_StaleEntries < minStaleEntries || m_StaleEntries < m_Index.size())
+        return;
+
+    const auto isStale = [this](const LadderEntry& entry) { return FindLive(entry) == nullptr; };
+    m_Bids.erase(std::remove_if(m_Bids.begin(), m_Bids.end(), isStale), m_Bids.end());
+    m_Asks.erase(std::remove_if(m_Asks.begin(), m_Asks.end(), isStale), m_Asks.end());
+    m_StaleEntries = 0;
+}
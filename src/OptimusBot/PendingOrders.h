@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+#include "DvfSimulator.h"
+#include "Types.h"
+
+namespace OptimusBot
+{
+    /// @brief Store of the orders placed by the bot and still waiting to be filled.
+    /// Bids and asks are kept in separate price-sorted ladders, ordered so that the orders filled by a market move always form
+    /// a contiguous run at the end of a ladder: detecting fills costs O(k) for k filled orders, whatever the number of resting orders.
+    /// A hash index by order id provides O(1) lookup and erasure, erased orders being lazily purged from the ladders.
+    /// The nodes of the index come from a pool owned by the store, so that placing and filling orders in a long session recycles them
+    /// rather than going through the heap each time
+    class PendingOrders final
+    {
+    public:
+        /// @brief Adds an order to the store
+        /// @return False if an order with the same id is already pending, in which case the store is left unchanged
+        bool Insert(const Types::BotOrder& order);
+
+        /// @brief Looks up a pending order by id
+        /// @return The order, or nullptr if no such order is pending. The pointer is invalidated by any non-const call
+        const Types::BotOrder* Find(IDvfSimulator::OrderID orderId) const noexcept;
+
+        /// @brief Removes a pending order, e.g. after it has been cancelled
+        /// @return False if no such order is pending
+        bool Erase(IDvfSimulator::OrderID orderId);
+
+        /// @brief Removes the orders filled by the market: bids priced above the best bid and asks priced below the best ask
+        /// @param bestOrder Pair of current best bid/ask
+        /// @param filledOrders Output buffer, cleared then filled with the removed orders
+        void EraseFilled(const Types::BestOrder& bestOrder, std::vector<Types::BotOrder>& filledOrders);
+
+        /// @brief Removes all the pending orders
+        void Clear() noexcept;
+
+        /// @brief Number of pending orders
+        std::size_t Size() const noexcept
+        {
+            return m_Index.size();
+        }
+
+        bool Empty() const noexcept
+        {
+            return m_Index.empty();
+        }
+
+        /// @brief Visits the pending orders, bids then asks, by ascending price
+        template <typename Visitor>
+        void ForEach(Visitor&& visitor) const
+        {
+            for (auto it = m_Bids.begin(); it != m_Bids.end(); ++it)
+                if (const auto order = FindLive(*it))
+                    visitor(*order);
+
+            for (auto it = m_Asks.rbegin(); it != m_Asks.rend(); ++it)
+                if (const auto order = FindLive(*it))
+                    visitor(*order);
+        }
+
+    private:
+        // Position of an order in a ladder. The sequence number tells a live entry from a stale one left by Erase
+        struct LadderEntry
+        {
+            Types::Price Price;
+            IDvfSimulator::OrderID OrderId;
+            std::uint64_t Sequence;
+        };
+
+        struct IndexEntry
+        {
+            Types::BotOrder Order;
+            std::uint64_t Sequence;
+        };
+
+        const Types::BotOrder* FindLive(const LadderEntry& entry) const noexcept;
+
+        // Pops the filled run at the end of a ladder
+        template <typename IsFilled>
+        void PopFilled(std::vector<LadderEntry>& ladder, IsFilled isFilled, std::vector<Types::BotOrder>& filledOrders);
+
+        // Purges the stale entries once they outnumber the live ones
+        void CompactIfNeeded();
+
+        // Bids by ascending price, asks by descending price: the orders filled first are always last
+        std::vector<LadderEntry> m_Bids;
+        std::vector<LadderEntry> m_Asks;
+
+        // Declared before the index, which must be destroyed first
+        std::pmr::unsynchronized_pool_resource m_IndexPool;
+        std::pmr::unordered_map<IDvfSimulator::OrderID, IndexEntry> m_Index{ &m_IndexPool };
+
+        std::uint64_t m_NextSequence{ 0 };
+        std::size_t m_StaleEntries{ 0 };
+    };
+}
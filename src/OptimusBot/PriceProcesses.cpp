@@ -0,0 +1,59 @@
+#include "pch.h"
+#include <cmath>
+#include "PriceProcesses.h"
+
+
+double OptimusBot::RandomWalkProcess::Next(double price, FastRandom& random) noexcept
+{
+    if (random.NextDouble() < m_StayProbability)
+        return price;
+
+    return price + random.NextDouble(-m_MaxStep, m_MaxStep);
+}
+
+
+OptimusBot::GbmProcess::GbmProcess(double drift, double volatility, double timeStep) noexcept
+    : m_DriftTerm{ (drift - 0.5 * volatility * volatility) * timeStep }, m_DiffusionTerm{ volatility * std::sqrt(timeStep) }
+{
+}
+
+
+double OptimusBot::GbmProcess::Next(double price, FastRandom& random) noexcept
+{
+    return price * std::exp(m_DriftTerm + m_DiffusionTerm * random.NextNormal());
+}
+
+
+OptimusBot::JumpDiffusionProcess::JumpDiffusionProcess(double drift, double volatility, double jumpIntensity, double jumpMean, double jumpVolatility, double timeStep) noexcept
+    : m_DriftTerm{ (drift - 0.5 * volatility * volatility) * timeStep }, m_DiffusionTerm{ volatility * std::sqrt(timeStep) },
+    m_JumpProbability{ 1.0 - std::exp(-jumpIntensity * timeStep) }, m_JumpMean{ jumpMean }, m_JumpVolatility{ jumpVolatility }
+{
+}
+
+
+double OptimusBot::JumpDiffusionProcess::Next(double price, FastRandom& random) noexcept
+{
+    auto exponent = m_DriftTerm + m_DiffusionTerm * random.NextNormal();
+
+    // Steps are assumed short enough for at most one jump to occur per step
+    if (random.NextDouble() < m_JumpProbability)
+        exponent += m_JumpMean + m_JumpVolatility * random.NextNormal();
+
+    return price * std::exp(exponent);
+}
+
+
+OptimusBot::MeanRevertingProcess::MeanRevertingProcess(double mean, double reversionSpeed, double volatility, double timeStep) noexcept
+    : m_Mean{ mean }, m_Decay{ std::exp(-reversionSpeed * timeStep) },
+    // Exact discretization of the process, degenerating into a Brownian motion without reversion
+    m_DiffusionTerm{ reversionSpeed > 0.0
+        ? volatility * std::sqrt((1.0 - std::exp(-2.0 * reversionSpeed * timeStep)) / (2.0 * reversionSpeed))
+        : volatility * std::sqrt(timeStep) }
+{
+}
+
+
+double OptimusBot::MeanRevertingProcess::Next(double price, FastRandom& random) noexcept
+{
+    return m_Mean + (price - m_Mean) * m_Decay + m_DiffusionTerm * random.NextNormal();
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "FastRandom.h"
+
+namespace OptimusBot
+{
+    /// @brief Stochastic process driving the mid price of a simulated market, advanced one step per order book snapshot
+    class IPriceProcess
+    {
+    public:
+        virtual ~IPriceProcess() noexcept = default;
+
+        /// @brief Computes the price after one step
+        /// @param price Price before the step
+        /// @param random Generator owned by the simulator, making the whole path reproducible from its seed
+        virtual double Next(double price, FastRandom& random) noexcept = 0;
+    };
+
+    /// @brief Arithmetic random walk: the price stays put or moves by a uniform step, like DvfSimulator
+    class RandomWalkProcess final : public IPriceProcess
+    {
+    public:
+        /// @param maxStep Largest absolute move per step
+        /// @param stayProbability Probability that the price does not move during a step
+        RandomWalkProcess(double maxStep, double stayProbability) noexcept
+            : m_MaxStep{ maxStep }, m_StayProbability{ stayProbability }
+        {
+        }
+
+        double Next(double price, FastRandom& random) noexcept override;
+
+    private:
+        const double m_MaxStep;
+        const double m_StayProbability;
+    };
+
+    /// @brief Geometric Brownian motion: log-normal returns with constant drift and volatility
+    class GbmProcess final : public IPriceProcess
+    {
+    public:
+        /// @param drift Annualized drift
+        /// @param volatility Annualized volatility
+        /// @param timeStep Duration of a step, in years
+        GbmProcess(double drift, double volatility, double timeStep) noexcept;
+
+        double Next(double price, FastRandom& random) noexcept override;
+
+    private:
+        // Constant part of the exponent and scale of the random part, precomputed once
+        const double m_DriftTerm;
+        const double m_DiffusionTerm;
+    };
+
+    /// @brief Merton jump-diffusion: a GBM on which log-normally distributed jumps occur as a Poisson process
+    class JumpDiffusionProcess final : public IPriceProcess
+    {
+    public:
+        /// @param drift Annualized drift
+        /// @param volatility Annualized volatility of the diffusion
+        /// @param jumpIntensity Expected number of jumps per year
+        /// @param jumpMean Mean of the log jump size
+        /// @param jumpVolatility Standard deviation of the log jump size
+        /// @param timeStep Duration of a step, in years
+        JumpDiffusionProcess(double drift, double volatility, double jumpIntensity, double jumpMean, double jumpVolatility, double timeStep) noexcept;
+
+        double Next(double price, FastRandom& random) noexcept override;
+
+    private:
+        const double m_DriftTerm;
+        const double m_DiffusionTerm;
+        const double m_JumpProbability;
+        const double m_JumpMean;
+        const double m_JumpVolatility;
+    };
+
+    /// @brief Ornstein-Uhlenbeck process: the price is pulled back towards a long-term mean
+    class MeanRevertingProcess final : public IPriceProcess
+    {
+    public:
+        /// @param mean Long-term mean of the price
+        /// @param reversionSpeed Speed at which the price reverts to the mean, per year
+        /// @param volatility Absolute volatility, in price units per square root of year
+        /// @param timeStep Duration of a step, in years
+        MeanRevertingProcess(double mean, double reversionSpeed, double volatility, double timeStep) noexcept;
+
+        double Next(double price, FastRandom& random) noexcept override;
+
+    private:
+        const double m_Mean;
+        const double m_Decay;
+        const double m_DiffusionTerm;
+    };
+}
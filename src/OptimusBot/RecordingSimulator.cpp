@@ -0,0 +1,38 @@
+#include "pch.h"
+#include "RecordingSimulator.h"
+
+
+OptimusBot::RecordingSimulator::RecordingSimulator(SimulatorPtr&& simulator, const std::string& path, IClock& clock, const TickFile::WriterConfig& config)
+    : m_Simulator{ std::move(simulator) }, m_Clock{ clock }, m_Writer{ path, config }
+{
+}
+
+
+IDvfSimulator::OrderBook OptimusBot::RecordingSimulator::GetOrderBook() noexcept
+{
+    auto orderBook = m_Simulator->GetOrderBook();
+    m_Writer.WriteSnapshot(m_Clock.Now(), orderBook);
+    return orderBook;
+}
+
+
+std::optional<IDvfSimulator::OrderID> OptimusBot::RecordingSimulator::PlaceOrder(double price, double amount) noexcept
+{
+    const auto orderId = m_Simulator->PlaceOrder(price, amount);
+    m_Writer.WritePlaceOrder(m_Clock.Now(), price, amount, orderId);
+    return orderId;
+}
+
+
+bool OptimusBot::RecordingSimulator::CancelOrder(OrderID oid) noexcept
+{
+    const auto success = m_Simulator->CancelOrder(oid);
+    m_Writer.WriteCancelOrder(m_Clock.Now(), oid, success);
+    return success;
+}
+
+
+void OptimusBot::RecordingSimulator::RecordFill(const Types::BotOrder& order) noexcept
+{
+    m_Writer.WriteFill(m_Clock.Now(), order);
+}
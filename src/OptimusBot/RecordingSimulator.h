@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include "Clock.h"
+#include "DvfSimulator.h"
+#include "SimulatorExtensions.h"
+#include "TickFile.h"
+#include "Types.h"
+
+namespace OptimusBot
+{
+    /// @brief IDvfSimulator decorator recording every snapshot returned and every order placed or cancelled through it to a tick file.
+    /// The fills being inferred by the bot, they are recorded when reported through RecordFill
+    class RecordingSimulator final : public IDvfSimulator
+    {
+    public:
+        /// @param simulator Simulator actually called
+        /// @param path Recording to write, overwritten if it exists
+        /// @param clock Clock timestamping the events. Must outlive the simulator
+        /// @param config Precision and block size of the recording
+        RecordingSimulator(SimulatorPtr&& simulator, const std::string& path, IClock& clock = SteadyClock::Instance(),
+            const TickFile::WriterConfig& config = TickFile::WriterConfig{});
+
+        OrderBook GetOrderBook() noexcept override;
+
+        std::optional<OrderID> PlaceOrder(double price, double amount) noexcept override;
+
+        bool CancelOrder(OrderID oid) noexcept override;
+
+        void RecordFill(const Types::BotOrder& order) noexcept;
+
+        /// @brief Whether the recording could be created. Calls are forwarded either way
+        bool IsRecording() const noexcept
+        {
+            return m_Writer.IsOpen();
+        }
+
+    private:
+        SimulatorPtr m_Simulator;
+        IClock& m_Clock;
+        TickFile::TickWriter m_Writer;
+    };
+}
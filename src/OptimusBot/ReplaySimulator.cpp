@@ -0,0 +1,101 @@
+#include "pch.h"
+#include "ReplaySimulator.h"
+#include "Utilities.h"
+
+using namespace OptimusBot::Types;
+
+
+IDvfSimulator::OrderBook OptimusBot::ReplaySimulator::GetOrderBook() noexcept
+{
+    OrderBook orderBook;
+    GetOrderBook(orderBook);
+    return orderBook;
+}
+
+
+void OptimusBot::ReplaySimulator::GetOrderBook(OrderBook& orderBook) noexcept
+{
+    orderBook.clear();
+    if (!m_Source->Next(m_Snapshot))
+        return;
+
+    m_Statistics.Snapshots++;
+
+    if (const auto bestOrder = Utilities::ExtractBestOrder(m_Snapshot))
+    {
+        m_HasBestOrder = true;
+        m_BestBid = bestOrder.value().Bid.ToDouble();
+        m_BestAsk = bestOrder.value().Ask.ToDouble();
+        FillOrders();
+    }
+
+    // Like DvfSimulator, the resting orders are part of the returned book
+    orderBook.reserve(m_Snapshot.size() + m_Orders.size());
+    orderBook.insert(orderBook.end(), m_Snapshot.begin(), m_Snapshot.end());
+    for (const auto& order : m_Orders)
+        orderBook.emplace_back(order.Price, order.Amount);
+}
+
+
+std::optional<IDvfSimulator::OrderID> OptimusBot::ReplaySimulator::PlaceOrder(double price, double amount) noexcept
+{
+    // Post-only, against the last replayed market
+    if (!m_HasBestOrder
+        || amount == 0.0
+        || (amount > 0.0 && price >= m_BestAsk)
+        || (amount < 0.0 && price <= m_BestBid))
+    {
+        m_Statistics.OrdersRejected++;
+        return {};
+    }
+
+    m_Orders.push_back({ m_NextOid, price, amount });
+    m_Statistics.OrdersPlaced++;
+
+    return m_NextOid++;
+}
+
+
+bool OptimusBot::ReplaySimulator::CancelOrder(OrderID oid) noexcept
+{
+    const auto it = std::find_if(m_Orders.begin(), m_Orders.end(), [oid](const Order& order) { return order.Oid == oid; });
+    if (it == m_Orders.end())
+        return false;
+
+    m_Orders.erase(it);
+    m_Statistics.OrdersCancelled++;
+
+    return true;
+}
+
+
+std::optional<BestOrder> OptimusBot::ReplaySimulator::GetLastBestOrder() const noexcept
+{
+    if (!m_HasBestOrder)
+        return {};
+
+    return BestOrder{ Price{ m_BestBid }, Price{ m_BestAsk } };
+}
+
+
+void OptimusBot::ReplaySimulator::FillOrders() noexcept
+{
+    const auto isFilled = [this](const Order& order) {
+        return (order.Amount > 0.0 && order.Price > m_BestBid)
+            || (order.Amount < 0.0 && order.Price < m_BestAsk);
+    };
+
+    for (const auto& order : m_Orders)
+    {
+        if (!isFilled(order))
+            continue;
+
+        m_Statistics.OrdersFilled++;
+        if (order.Amount > 0.0)
+            m_Statistics.FilledBidVolume += order.Amount;
+        else
+            m_Statistics.FilledAskVolume -= order.Amount;
+    }
+
+    m_Orders.erase(std::remove_if(m_Orders.begin(), m_Orders.end(), isFilled), m_Orders.end());
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "DvfSimulator.h"
+#include "SimulatorExtensions.h"
+#include "SnapshotSources.h"
+#include "Types.h"
+
+namespace OptimusBot
+{
+    /// @brief IDvfSimulator replaying recorded or generated snapshots, one per GetOrderBook call, and simulating the fills of the
+    /// orders placed against them: a bid is filled once priced above the replayed best bid, an ask once priced below the best ask.
+    /// Once the snapshots are exhausted, an empty book is returned
+    class ReplaySimulator final : public IDvfSimulator, public IBufferedOrderBookSource
+    {
+    public:
+        /// @brief Counters describing the activity of the session
+        struct Statistics
+        {
+            std::size_t Snapshots{ 0 };
+            std::size_t OrdersPlaced{ 0 };
+            std::size_t OrdersRejected{ 0 };
+            std::size_t OrdersCancelled{ 0 };
+            std::size_t OrdersFilled{ 0 };
+            double FilledBidVolume{ 0.0 };
+            double FilledAskVolume{ 0.0 };
+        };
+
+        explicit ReplaySimulator(std::unique_ptr<ISnapshotSource>&& source) noexcept
+            : m_Source{ std::move(source) }
+        {
+        }
+
+        OrderBook GetOrderBook() noexcept override;
+
+        /// @brief Same as GetOrderBook, reusing the capacity of the given book rather than allocating a new one
+        void GetOrderBook(OrderBook& orderBook) noexcept override;
+
+        std::optional<OrderID> PlaceOrder(double price, double amount) noexcept override;
+
+        bool CancelOrder(OrderID oid) noexcept override;
+
+        const Statistics& GetStatistics() const noexcept
+        {
+            return m_Statistics;
+        }
+
+        /// @brief Best bid/ask pair of the last replayed snapshot having both sides populated
+        std::optional<Types::BestOrder> GetLastBestOrder() const noexcept;
+
+    private:
+        struct Order
+        {
+            OrderID Oid;
+            double Price;
+            double Amount;
+        };
+
+        void FillOrders() noexcept;
+
+        std::unique_ptr<ISnapshotSource> m_Source;
+
+        OrderBook m_Snapshot;
+        bool m_HasBestOrder{ false };
+        double m_BestBid{ 0.0 };
+        double m_BestAsk{ 0.0 };
+
+        std::vector<Order> m_Orders;
+        OrderID m_NextOid{ 1 };
+
+        Statistics m_Statistics;
+    };
+}
@@ -0,0 +1,202 @@
+#include "pch.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include "Requoter.h"
+
+using namespace OptimusBot::Types;
+
+namespace
+{
+    // Distance of a price to the touch, positive on the passive side of the book
+    std::int64_t DistanceToTouch(OrderSide side, Price best, Price price) noexcept
+    {
+        return side == OrderSide::BID ? (best - price).Units() : (price - best).Units();
+    }
+
+    // Takes up to limit elements from the front of both sources, alternating between them
+    template <typename T, typename Emit>
+    std::size_t Interleave(const std::vector<T>& first, const std::vector<T>& second, std::size_t limit, Emit&& emit)
+    {
+        std::size_t taken = 0;
+        for (std::size_t i = 0; taken < limit && (i < first.size() || i < second.size()); i++)
+        {
+            if (i < first.size() && taken < limit)
+            {
+                emit(first[i]);
+                taken++;
+            }
+
+            if (i < second.size() && taken < limit)
+            {
+                emit(second[i]);
+                taken++;
+            }
+        }
+
+        return taken;
+    }
+
+    // Volume of each of count new quotes, the wanted one as long as the assets left for them cover it
+    Quantity FitVolume(Quantity wanted, double available, std::size_t count) noexcept
+    {
+        if (count == 0 || available <= 0.0)
+            return Quantity{};
+
+        return std::min(wanted, Quantity{ available / static_cast<double>(count) });
+    }
+}
+
+
+void OptimusBot::Requoter::Diff(const BestOrder& bestOrder, const Wallet& wallet, const PendingOrders& pendingOrders, RequoteActions& actions,
+    const BookFeatures* features)
+{
+    actions.Clear();
+
+    // Sized like the prudent strategy, the quotes of a side never exceeding the share of the assets they would consume
+    const auto levels = std::max(m_Config.LevelsEachSide, 0);
+    const auto bidVolume = levels > 0 ? Quantity{ m_Config.Sizing * wallet.USD.ToDouble() / (bestOrder.Bid.ToDouble() * levels) } : Quantity{};
+    const auto askVolume = levels > 0 ? Quantity{ m_Config.Sizing * wallet.ETH.ToDouble() / levels } : Quantity{};
+
+    // The ladders follow the microprice: pressure on a side shifts both of them in the direction the market is likely to move
+    auto bid = bestOrder.Bid;
+    auto ask = bestOrder.Ask;
+    if (features && features->Ticks > 0 && m_Config.MicropriceSkew != 0.0)
+    {
+        const auto shift = m_Config.MicropriceSkew * (features->Microprice - features->Mid);
+        bid = Price{ bid.ToDouble() + shift };
+        ask = Price{ ask.ToDouble() + shift };
+    }
+
+    MakeLadder(OrderSide::BID, bid, bidVolume, m_BidPrices);
+    MakeLadder(OrderSide::ASK, ask, askVolume, m_AskPrices);
+
+    // Pending bids are visited by ascending price, i.e. from the outside in, the asks from the touch outwards
+    m_LiveBids.clear();
+    m_LiveAsks.clear();
+    auto freeETH = wallet.ETH;
+    auto freeUSD = wallet.USD;
+    pendingOrders.ForEach([this, &freeETH, &freeUSD](const BotOrder& order) {
+        if (order.Side == OrderSide::BID)
+        {
+            m_LiveBids.push_back(&order);
+            freeUSD -= order.Price * order.Volume;
+        }
+        else
+        {
+            m_LiveAsks.push_back(&order);
+            freeETH -= order.Volume;
+        }
+    });
+    std::reverse(m_LiveBids.begin(), m_LiveBids.end());
+
+    m_BidCancels.clear();
+    m_AskCancels.clear();
+    m_BidQuotes.clear();
+    m_AskQuotes.clear();
+    DiffSide(OrderSide::BID, bid, bidVolume, m_BidPrices, m_LiveBids, m_BidCancels, m_BidQuotes, actions.Kept);
+    DiffSide(OrderSide::ASK, ask, askVolume, m_AskPrices, m_LiveAsks, m_AskCancels, m_AskQuotes, actions.Kept);
+
+    // The cancellations are sent first, their assets covering the new quotes along with those not committed yet
+    for (const auto* order : m_BidCancels)
+        freeUSD += order->Price * order->Volume;
+    for (const auto* order : m_AskCancels)
+        freeETH += order->Volume;
+
+    // The innermost bid being the dearest, sizing all the bids at its price keeps them within the USD left
+    const auto bidPlaceVolume = FitVolume(bidVolume, freeUSD.ToDouble() / bid.ToDouble(), m_BidQuotes.size());
+    const auto askPlaceVolume = FitVolume(askVolume, freeETH.ToDouble(), m_AskQuotes.size());
+
+    m_BidPlaces.clear();
+    m_AskPlaces.clear();
+    if (bidPlaceVolume > Quantity{})
+    {
+        for (const auto price : m_BidQuotes)
+            m_BidPlaces.emplace_back(OrderSide::BID, price, bidPlaceVolume);
+    }
+
+    if (askPlaceVolume > Quantity{})
+    {
+        for (const auto price : m_AskQuotes)
+            m_AskPlaces.emplace_back(OrderSide::ASK, price, askPlaceVolume);
+    }
+
+    const auto total = m_BidCancels.size() + m_AskCancels.size() + m_BidPlaces.size() + m_AskPlaces.size();
+    auto budget = m_Config.MaxActionsPerTick > 0 ? std::min(m_Config.MaxActionsPerTick, total) : total;
+
+    budget -= Interleave(m_BidCancels, m_AskCancels, budget, [&actions](const BotOrder* order) {
+        actions.Cancels.push_back(order->OrderId);
+    });
+
+    Interleave(m_BidPlaces, m_AskPlaces, budget, [&actions](const OrderRequest& request) {
+        actions.Places.push_back(request);
+    });
+
+    actions.Deferred = total - actions.Cancels.size() - actions.Places.size();
+}
+
+
+void OptimusBot::Requoter::MakeLadder(OrderSide side, Price best, Quantity volume, std::vector<Price>& prices) const
+{
+    prices.clear();
+    if (volume <= Quantity{})
+        return;
+
+    const auto direction = side == OrderSide::BID ? -1.0 : 1.0;
+    for (int level = 0; level < m_Config.LevelsEachSide; level++)
+    {
+        const Price price{ best.ToDouble() * (1.0 + direction * (m_Config.FirstLevelOffset + level * m_Config.LevelSpacing)) };
+
+        // Levels rounding to the same cent collapse into a single quote
+        if (price <= Price{} || (!prices.empty() && price == prices.back()))
+            continue;
+
+        prices.push_back(price);
+    }
+}
+
+
+void OptimusBot::Requoter::DiffSide(OrderSide side, Price best, Quantity volume, const std::vector<Price>& prices,
+    const std::vector<const BotOrder*>& live, std::vector<const BotOrder*>& cancels, std::vector<Price>& quotes, std::size_t& kept) const
+{
+    // Both sequences go from the touch outwards: an order nearer to the touch than the quote it is compared to matches no later quote
+    std::size_t quote = 0;
+    std::size_t order = 0;
+    while (quote < prices.size() && order < live.size())
+    {
+        const auto wanted = DistanceToTouch(side, best, prices[quote]);
+        const auto actual = DistanceToTouch(side, best, live[order]->Price);
+        const auto tolerance = Price{ prices[quote].ToDouble() * m_Config.Tolerance }.Units();
+
+        if (std::abs(actual - wanted) <= tolerance)
+        {
+            // An order partially filled below the wanted volume is topped up by replacing it at the price wanted
+            if (live[order]->Volume.ToDouble() >= volume.ToDouble() * (1.0 - m_Config.VolumeTolerance))
+            {
+                kept++;
+            }
+            else
+            {
+                cancels.push_back(live[order]);
+                quotes.push_back(prices[quote]);
+            }
+
+            quote++;
+            order++;
+        }
+        else if (actual < wanted)
+        {
+            cancels.push_back(live[order++]);
+        }
+        else
+        {
+            quotes.push_back(prices[quote++]);
+        }
+    }
+
+    for (; order < live.size(); order++)
+        cancels.push_back(live[order]);
+
+    for (; quote < prices.size(); quote++)
+        quotes.push_back(prices[quote]);
+}
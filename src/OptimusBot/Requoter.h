@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "BookAnalytics.h"
+#include "DvfSimulator.h"
+#include "PendingOrders.h"
+#include "Types.h"
+
+namespace OptimusBot
+{
+    /// @brief Parameters of a Requoter
+    struct RequoterConfig
+    {
+        // Quotes wanted on each side of the book
+        int LevelsEachSide{ 5 };
+
+        // Distance of the innermost quote to the best bid/ask, then between consecutive quotes, as fractions of the best price
+        double FirstLevelOffset{ 0.005 };
+        double LevelSpacing{ 0.005 };
+
+        // Share of the assets hold covered by the quotes of each side in total: the ETH for the asks, the USD for the bids
+        double Sizing{ 0.5 };
+
+        // A pending order priced within this fraction of a wanted quote is kept as-is, preserving its queue position
+        double Tolerance{ 0.002 };
+
+        // A pending order whose remaining volume falls short of the wanted one by more than this fraction, e.g. after partial fills,
+        // is replaced rather than kept
+        double VolumeTolerance{ 0.2 };
+
+        // Cancellations and placements sent per tick, the others waiting for the next ticks. No limit if 0
+        std::size_t MaxActionsPerTick{ 10 };
+
+        // Share of the microprice's distance to the mid both ladders are shifted by, when book features are available. None if 0
+        double MicropriceSkew{ 0.0 };
+    };
+
+    /// @brief Changes bringing the pending orders to the wanted quotes
+    struct RequoteActions
+    {
+        std::vector<IDvfSimulator::OrderID> Cancels;
+        std::vector<Types::OrderRequest> Places;
+
+        // Wanted quotes already covered by a pending order
+        std::size_t Kept{ 0 };
+
+        // Changes left out by the rate limit, to be sent on the next ticks
+        std::size_t Deferred{ 0 };
+
+        void Clear() noexcept
+        {
+            Cancels.clear();
+            Places.clear();
+            Kept = 0;
+            Deferred = 0;
+        }
+    };
+
+    /// @brief Continuous quoting strategy: on each book update, computes a ladder of quotes around the best bid/ask pair and diffs it
+    /// against the pending orders, emitting the fewest cancellations and placements. Both sides are walked from the touch outwards,
+    /// a pending order close enough to a wanted quote being kept, so that a small market move costs a couple of messages rather than
+    /// replacing the whole ladder. The new quotes are sized from the assets not committed yet to the pending orders, so that the risk
+    /// gate accepts them. The buffers are reused from a tick to the next
+    class Requoter final
+    {
+    public:
+        explicit Requoter(const RequoterConfig& config = RequoterConfig{}) noexcept
+            : m_Config{ config }
+        {
+        }
+
+        const RequoterConfig& GetConfig() const noexcept
+        {
+            return m_Config;
+        }
+
+        /// @brief Computes the changes to send for the current market
+        /// @param bestOrder Current best bid/ask pair
+        /// @param wallet Assets currently hold, sizing the ladder. The new quotes are capped by what the pending orders leave of them
+        /// @param pendingOrders Orders currently resting on the market
+        /// @param actions Output, cleared then filled with the changes. Over the rate limit, cancellations go first as they withdraw
+        /// quotes the market moved away from, then the sides alternate from the touch outwards
+        /// @param features Analytics of the current book, if any, skewing the quotes towards the microprice
+        void Diff(const Types::BestOrder& bestOrder, const Types::Wallet& wallet, const PendingOrders& pendingOrders, RequoteActions& actions,
+            const BookFeatures* features = nullptr);
+
+    private:
+        // Quotes wanted on a side, from the touch outwards
+        void MakeLadder(Types::OrderSide side, Types::Price best, Types::Quantity volume, std::vector<Types::Price>& prices) const;
+
+        // Matches the wanted quotes of a side against its pending orders, both sorted from the touch outwards, giving the orders to
+        // cancel and the prices to quote
+        void DiffSide(Types::OrderSide side, Types::Price best, Types::Quantity volume, const std::vector<Types::Price>& prices,
+            const std::vector<const Types::BotOrder*>& live, std::vector<const Types::BotOrder*>& cancels, std::vector<Types::Price>& quotes,
+            std::size_t& kept) const;
+
+        const RequoterConfig m_Config;
+
+        std::vector<Types::Price> m_BidPrices;
+        std::vector<Types::Price> m_AskPrices;
+        std::vector<const Types::BotOrder*> m_LiveBids;
+        std::vector<const Types::BotOrder*> m_LiveAsks;
+        std::vector<const Types::BotOrder*> m_BidCancels;
+        std::vector<const Types::BotOrder*> m_AskCancels;
+        std::vector<Types::Price> m_BidQuotes;
+        std::vector<Types::Price> m_AskQuotes;
+        std::vector<Types::OrderRequest> m_BidPlaces;
+        std::vector<Types::OrderRequest> m_AskPlaces;
+    };
+}
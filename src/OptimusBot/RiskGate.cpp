@@ -0,0 +1,164 @@
+#include "pch.h"
+#include "RiskGate.h"
+
+using namespace OptimusBot::Types;
+
+namespace
+{
+    template <typename FixedPointType>
+    std::optional<FixedPointType> ToFixedPoint(const std::optional<double>& value) noexcept
+    {
+        return value ? std::optional<FixedPointType>{ FixedPointType{ value.value() } } : std::nullopt;
+    }
+}
+
+
+const char* OptimusBot::GetRiskCheckName(RiskCheck check) noexcept
+{
+    switch (check)
+    {
+    case RiskCheck::PASSED:
+        return "Passed";
+    case RiskCheck::ETH_NOT_COVERED:
+        return "ETH not covered";
+    case RiskCheck::USD_NOT_COVERED:
+        return "USD not covered";
+    case RiskCheck::ORDER_NOTIONAL_LIMIT:
+        return "Order notional limit";
+    case RiskCheck::OPEN_NOTIONAL_LIMIT:
+        return "Open notional limit";
+    case RiskCheck::OPEN_ORDERS_LIMIT:
+        return "Open orders limit";
+    case RiskCheck::POSITION_LIMIT:
+        return "Position limit";
+    default:
+        return "Unknown";
+    }
+}
+
+
+OptimusBot::RiskGate::RiskGate(const Wallet& wallet, const RiskLimits& limits) noexcept
+    : m_Wallet{ wallet }
+{
+    SetLimits(limits);
+}
+
+
+void OptimusBot::RiskGate::SetLimits(const RiskLimits& limits) noexcept
+{
+    m_RequireCoverage = limits.RequireCoverage;
+    m_MaxOrderNotional = ToFixedPoint<Notional>(limits.MaxOrderNotional);
+    m_MaxOpenNotional = ToFixedPoint<Notional>(limits.MaxOpenNotional);
+    m_MaxOpenOrders = limits.MaxOpenOrders;
+    m_MaxPosition = ToFixedPoint<Quantity>(limits.MaxPosition);
+    m_MinPosition = ToFixedPoint<Quantity>(limits.MinPosition);
+}
+
+
+OptimusBot::RiskCheck OptimusBot::RiskGate::Check(const OrderRequest& request) const noexcept
+{
+    const auto notional = request.Price * request.Volume;
+    const auto isBid = request.Side == OrderSide::BID;
+
+    if (m_RequireCoverage)
+    {
+        if (isBid && m_CommittedUSD + notional > m_Wallet.USD)
+            return RiskCheck::USD_NOT_COVERED;
+        if (!isBid && m_CommittedETH + request.Volume > m_Wallet.ETH)
+            return RiskCheck::ETH_NOT_COVERED;
+    }
+
+    if (m_MaxOrderNotional && notional > m_MaxOrderNotional.value())
+        return RiskCheck::ORDER_NOTIONAL_LIMIT;
+
+    if (m_MaxOpenNotional && GetOpenNotional() + notional > m_MaxOpenNotional.value())
+        return RiskCheck::OPEN_NOTIONAL_LIMIT;
+
+    if (m_MaxOpenOrders && m_OpenOrders >= m_MaxOpenOrders.value())
+        return RiskCheck::OPEN_ORDERS_LIMIT;
+
+    // Worst case of the side the order is on: all the open orders of that side filled, this one included
+    if (isBid && m_MaxPosition && m_Wallet.ETH + m_OpenBidVolume + request.Volume > m_MaxPosition.value())
+        return RiskCheck::POSITION_LIMIT;
+    if (!isBid && m_MinPosition && m_Wallet.ETH - m_CommittedETH - request.Volume < m_MinPosition.value())
+        return RiskCheck::POSITION_LIMIT;
+
+    return RiskCheck::PASSED;
+}
+
+
+OptimusBot::RiskCheck OptimusBot::RiskGate::Reserve(const OrderRequest& request) noexcept
+{
+    const auto check = Check(request);
+    if (check != RiskCheck::PASSED)
+    {
+        m_Rejected++;
+        return check;
+    }
+
+    ForceReserve(request);
+    return check;
+}
+
+
+void OptimusBot::RiskGate::ForceReserve(const OrderRequest& request) noexcept
+{
+    if (request.Side == OrderSide::BID)
+    {
+        m_CommittedUSD += request.Price * request.Volume;
+        m_OpenBidVolume += request.Volume;
+    }
+    else
+    {
+        m_CommittedETH += request.Volume;
+        m_OpenAskNotional += request.Price * request.Volume;
+    }
+
+    m_OpenOrders++;
+}
+
+
+void OptimusBot::RiskGate::Release(OrderSide side, Price price, Quantity volume) noexcept
+{
+    ReleaseExposure(side, price, volume);
+
+    if (m_OpenOrders > 0)
+        m_OpenOrders--;
+}
+
+
+void OptimusBot::RiskGate::ReleaseAll() noexcept
+{
+    m_CommittedETH = Quantity{};
+    m_CommittedUSD = Notional{};
+    m_OpenBidVolume = Quantity{};
+    m_OpenAskNotional = Notional{};
+    m_OpenOrders = 0;
+}
+
+
+void OptimusBot::RiskGate::OnFilled(const BotOrder& order) noexcept
+{
+    Release(order.Side, order.Price, order.Volume);
+}
+
+
+void OptimusBot::RiskGate::OnPartialFill(const BotOrder& order) noexcept
+{
+    ReleaseExposure(order.Side, order.Price, order.Volume);
+}
+
+
+void OptimusBot::RiskGate::ReleaseExposure(OrderSide side, Price price, Quantity volume) noexcept
+{
+    if (side == OrderSide::BID)
+    {
+        m_CommittedUSD -= price * volume;
+        m_OpenBidVolume -= volume;
+    }
+    else
+    {
+        m_CommittedETH -= volume;
+        m_OpenAskNotional -= price * volume;
+    }
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include "DvfSimulator.h"
+#include "Types.h"
+
+namespace OptimusBot
+{
+    /// @brief Pre-trade limits of a RiskGate. A limit left unset is not enforced
+    struct RiskLimits
+    {
+        // Orders must be covered by the assets not committed yet to the open orders: asks by the ETH hold, bids by the USD hold
+        bool RequireCoverage{ true };
+
+        // Largest notional of a single order, in USD
+        std::optional<double> MaxOrderNotional;
+
+        // Largest notional of all the open orders together, in USD
+        std::optional<double> MaxOpenNotional;
+
+        std::optional<std::size_t> MaxOpenOrders;
+
+        // Bounds of the ETH position reached if all the open bids, or all the open asks, were filled
+        std::optional<double> MaxPosition;
+        std::optional<double> MinPosition;
+    };
+
+    /// @brief Outcome of a pre-trade check
+    enum class RiskCheck
+    {
+        PASSED,
+        ETH_NOT_COVERED,
+        USD_NOT_COVERED,
+        ORDER_NOTIONAL_LIMIT,
+        OPEN_NOTIONAL_LIMIT,
+        OPEN_ORDERS_LIMIT,
+        POSITION_LIMIT,
+    };
+
+    const char* GetRiskCheckName(RiskCheck check) noexcept;
+
+    /// @brief Pre-trade risk gate: keeps running totals of the exposure of the open orders, updated on each placement, cancellation
+    /// and fill, so that checking an order costs a few integer comparisons whatever the number of open orders. The assets are read
+    /// from the wallet of the owner, which moves them on each fill.
+    /// The totals are fixed-point, hence exact: releasing what was reserved always brings them back to where they were
+    class RiskGate final
+    {
+    public:
+        /// @param wallet Assets hold, moved by the owner of the gate. Must outlive the gate
+        /// @param limits Limits enforced on the orders
+        explicit RiskGate(const Types::Wallet& wallet, const RiskLimits& limits = RiskLimits{}) noexcept;
+
+        // The wallet is referenced, not copied
+        RiskGate(Types::Wallet&&, const RiskLimits& = RiskLimits{}) = delete;
+
+        /// @brief Replaces the limits enforced on the next orders, the open ones staying counted
+        void SetLimits(const RiskLimits& limits) noexcept;
+
+        /// @brief Checks an order against the limits, given the orders already open
+        RiskCheck Check(const Types::OrderRequest& request) const noexcept;
+
+        /// @brief Checks an order and, if it passes, counts it as open right away, so that the next orders of a batch are checked against it.
+        /// Should be followed by a Release if the order ends up not being placed
+        RiskCheck Reserve(const Types::OrderRequest& request) noexcept;
+
+        /// @brief Counts an order as open without checking it, for an order already resting on the market whatever the limits,
+        /// e.g. restored from a journal: the gate must account for its exposure, which then holds the next orders back
+        void ForceReserve(const Types::OrderRequest& request) noexcept;
+
+        /// @brief Stops counting an open order: cancelled, rejected by the venue or never sent
+        void Release(Types::OrderSide side, Types::Price price, Types::Quantity volume) noexcept;
+
+        /// @brief Stops counting all the open orders, e.g. before counting those restored from a journal
+        void ReleaseAll() noexcept;
+
+        /// @brief Stops counting a filled order as open. The wallet is expected to hold the assets it moved
+        void OnFilled(const Types::BotOrder& order) noexcept;
+
+        /// @brief Stops counting the filled part of an order, whose remaining volume stays open. Same expectation as OnFilled
+        /// @param order Order with the volume filled
+        void OnPartialFill(const Types::BotOrder& order) noexcept;
+
+        /// @brief ETH committed to the open asks
+        Types::Quantity GetCommittedETH() const noexcept
+        {
+            return m_CommittedETH;
+        }
+
+        /// @brief USD committed to the open bids
+        Types::Notional GetCommittedUSD() const noexcept
+        {
+            return m_CommittedUSD;
+        }
+
+        /// @brief Notional of all the open orders
+        Types::Notional GetOpenNotional() const noexcept
+        {
+            return m_CommittedUSD + m_OpenAskNotional;
+        }
+
+        std::size_t GetOpenOrderCount() const noexcept
+        {
+            return m_OpenOrders;
+        }
+
+        /// @brief Number of orders which did not pass the checks of Reserve
+        std::uint64_t GetRejectedCount() const noexcept
+        {
+            return m_Rejected;
+        }
+
+    private:
+        // Removes the exposure of a volume of an open order
+        void ReleaseExposure(Types::OrderSide side, Types::Price price, Types::Quantity volume) noexcept;
+
+        bool m_RequireCoverage;
+        std::optional<Types::Notional> m_MaxOrderNotional;
+        std::optional<Types::Notional> m_MaxOpenNotional;
+        std::optional<std::size_t> m_MaxOpenOrders;
+        std::optional<Types::Quantity> m_MaxPosition;
+        std::optional<Types::Quantity> m_MinPosition;
+
+        const Types::Wallet& m_Wallet;
+
+        // Open asks commit their volume of ETH, open bids their notional of USD
+        Types::Quantity m_CommittedETH;
+        Types::Notional m_CommittedUSD;
+        Types::Quantity m_OpenBidVolume;
+        Types::Notional m_OpenAskNotional;
+        std::size_t m_OpenOrders{ 0 };
+
+        std::uint64_t m_Rejected{ 0 };
+    };
+}
@@ -0,0 +1,5 @@
+#include "pch.h"
+#include "Scheduler.ipp"
+
+// The scheduler on any IClock, shared by the bots, the runtime hosting them and the market feeds
+template class OptimusBot::BasicScheduler<OptimusBot::IClock>;
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "Clock.h"
+
+namespace OptimusBot
+{
+    /// @brief Deadline-driven scheduler executing periodic tasks on the thread calling Run.
+    /// Deadlines are kept in a min-heap and the thread sleeps on a condition variable until the earliest one is due, or until a task is woken up.
+    /// Time is provided by TimeSource, an IClock: on a VirtualClock, Run jumps from deadline to deadline without ever sleeping.
+    /// A final clock type (e.g. SteadyClock) rather than IClock leaves no virtual call to the scheduler.
+    /// The members are defined in Scheduler.ipp, the Scheduler over IClock being instantiated in Scheduler.cpp
+    template <typename TimeSource>
+    class BasicScheduler final
+    {
+        static_assert(std::is_base_of_v<IClock, TimeSource>, "The scheduler waits on an IClock");
+
+    public:
+        using Clock = std::chrono::steady_clock;
+        using TaskId = std::uint64_t;
+        using Task = std::function<void()>;
+
+        /// @param clock Source of time, which must outlive the scheduler
+        explicit BasicScheduler(TimeSource& clock = SteadyClock::Instance()) noexcept
+            : m_Clock{ clock }
+        {
+        }
+
+        /// @brief Registers a task executed every interval, the first execution happening one interval from now. Thread-safe
+        /// @param interval Period of the task, must be strictly positive
+        /// @param task Callable to execute, may itself call Schedule/Cancel/Wake/Stop
+        /// @return Id of the task, to be used for cancellation
+        TaskId SchedulePeriodic(Clock::duration interval, Task task);
+
+        /// @brief Cancels a task, which will not be executed anymore (a task currently executing is allowed to complete). Thread-safe
+        /// @return False if no such task is registered
+        bool Cancel(TaskId id);
+
+        /// @brief Makes a task due right away, e.g. when the events it processes arrive, its period restarting from that execution.
+        /// A task woken up while it executes is executed again as soon as it completes. Thread-safe
+        /// @return False if no such task is registered
+        bool Wake(TaskId id);
+
+        /// @brief Executes the tasks when they are due, sleeping in between. Returns once Stop is called or when no task remains
+        void Run();
+
+        /// @brief Wakes up Run and makes it return as soon as the task currently executing (if any) completes. Thread-safe
+        void Stop();
+
+    private:
+        struct Deadline
+        {
+            Clock::time_point Time;
+            TaskId Id;
+
+            // Inverted to turn the std heap functions into a min-heap
+            bool operator < (const Deadline& other) const noexcept
+            {
+                return Time > other.Time;
+            }
+        };
+
+        struct PeriodicTask
+        {
+            Clock::duration Interval;
+            Task Callable;
+
+            // Deadline of the next execution, any other deadline of the task in the heap being stale
+            Clock::time_point Next;
+            bool Cancelled;
+            bool Woken;
+        };
+
+        TimeSource& m_Clock;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_WakeUp;
+
+        // Cancelled tasks are erased from the map, their stale deadlines being skipped when popped
+        std::unordered_map<TaskId, PeriodicTask> m_Tasks;
+        std::vector<Deadline> m_Deadlines;
+
+        TaskId m_NextId{ 1 };
+        TaskId m_RunningId{ 0 };
+        bool m_Stopped{ false };
+    };
+
+    /// @brief Scheduler on any IClock, through virtual calls
+    using Scheduler = BasicScheduler<IClock>;
+
+    extern template class BasicScheduler<IClock>;
+}
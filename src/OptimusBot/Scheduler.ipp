@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include "Scheduler.h"
+
+// Definitions of the members of BasicScheduler, included by the translation units instantiating a scheduler of their own clock.
+// The Scheduler over IClock is instantiated once in Scheduler.cpp
+
+
+template <typename TimeSource>
+typename OptimusBot::BasicScheduler<TimeSource>::TaskId OptimusBot::BasicScheduler<TimeSource>::SchedulePeriodic(Clock::duration interval, Task task)
+{
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    const auto id = m_NextId++;
+    const auto next = m_Clock.Now() + interval;
+    m_Tasks.emplace(id, PeriodicTask{ interval, std::move(task), next, false, false });
+
+    m_Deadlines.push_back({ next, id });
+    std::push_heap(m_Deadlines.begin(), m_Deadlines.end());
+
+    // The new deadline may be earlier than the one Run is currently sleeping on
+    m_WakeUp.notify_one();
+
+    return id;
+}
+
+
+template <typename TimeSource>
+bool OptimusBot::BasicScheduler<TimeSource>::Cancel(TaskId id)
+{
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    const auto it = m_Tasks.find(id);
+    if (it == m_Tasks.end())
+        return false;
+
+    // The running task is referenced by Run, which erases it once completed
+    if (id == m_RunningId)
+        it->second.Cancelled = true;
+    else
+        m_Tasks.erase(it);
+
+    m_WakeUp.notify_one();
+    return true;
+}
+
+
+template <typename TimeSource>
+bool OptimusBot::BasicScheduler<TimeSource>::Wake(TaskId id)
+{
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    const auto it = m_Tasks.find(id);
+    if (it == m_Tasks.end())
+        return false;
+
+    // Its next deadline is computed by Run once it completes
+    if (id == m_RunningId)
+    {
+        it->second.Woken = true;
+        return true;
+    }
+
+    const auto now = m_Clock.Now();
+    if (it->second.Next <= now)
+        return true;
+
+    // The previous deadline is left in the heap, as a stale one
+    it->second.Next = now;
+    m_Deadlines.push_back({ now, id });
+    std::push_heap(m_Deadlines.begin(), m_Deadlines.end());
+
+    m_WakeUp.notify_one();
+    return true;
+}
+
+
+template <typename TimeSource>
+void OptimusBot::BasicScheduler<TimeSource>::Run()
+{
+    std::unique_lock<std::mutex> lock{ m_Mutex };
+
+    while (!m_Stopped && !m_Tasks.empty())
+    {
+        const auto deadline = m_Deadlines.front();
+
+        const auto it = m_Tasks.find(deadline.Id);
+        if (it == m_Tasks.end() || it->second.Next != deadline.Time)
+        {
+            //stale deadline of a cancelled or woken up task
+            std::pop_heap(m_Deadlines.begin(), m_Deadlines.end());
+            m_Deadlines.pop_back();
+            continue;
+        }
+
+        if (m_Clock.Now() < deadline.Time)
+        {
+            // Sleeps until due, or until woken up by Schedule/Cancel/Wake/Stop, the state being re-evaluated in both cases
+            m_Clock.WaitUntil(m_WakeUp, lock, deadline.Time);
+            continue;
+        }
+
+        std::pop_heap(m_Deadlines.begin(), m_Deadlines.end());
+        m_Deadlines.pop_back();
+
+        // References to unordered_map elements remain valid on insertion, and erasure is deferred while running
+        auto& task = it->second;
+        m_RunningId = deadline.Id;
+        task.Woken = false;
+
+        lock.unlock();
+        task.Callable();
+        lock.lock();
+
+        m_RunningId = 0;
+
+        if (task.Cancelled)
+        {
+            m_Tasks.erase(deadline.Id);
+            continue;
+        }
+
+        // Keeps a drift-free period, unless the task overran in which case the missed executions are skipped
+        const auto now = m_Clock.Now();
+        auto next = deadline.Time + task.Interval;
+        if (task.Woken)
+            next = now;
+        else if (next <= now)
+            next = now + task.Interval;
+
+        task.Next = next;
+        m_Deadlines.push_back({ next, deadline.Id });
+        std::push_heap(m_Deadlines.begin(), m_Deadlines.end());
+    }
+}
+
+
+template <typename TimeSource>
+void OptimusBot::BasicScheduler<TimeSource>::Stop()
+{
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+    m_Stopped = true;
+    m_WakeUp.notify_all();
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace OptimusBot
+{
+    /// @brief Single-writer/multi-reader sequence lock over a value: the writer never waits, and readers copy the value without locking,
+    /// retrying when a write overlapped their copy. The value is stored as atomic words so that overlapping copies are not data races
+    template <typename T>
+    class SeqLock final
+    {
+    public:
+        static_assert(std::is_trivially_copyable_v<T>, "The value of a sequence lock is copied word by word");
+        static_assert(std::is_default_constructible_v<T>, "Readers copy the value into a default-constructed one");
+
+        SeqLock() noexcept
+        {
+            Store(T{});
+            m_Sequence.store(0, std::memory_order_relaxed);
+        }
+
+        SeqLock(const SeqLock&) = delete;
+        SeqLock& operator=(const SeqLock&) = delete;
+
+        /// @brief Writer only: replaces the value
+        void Store(const T& value) noexcept
+        {
+            Words words{};
+            std::memcpy(words.data(), static_cast<const void*>(&value), sizeof(T));
+
+            // An odd sequence marks a write in progress, the fence keeping the word stores after it
+            const auto sequence = m_Sequence.load(std::memory_order_relaxed);
+            m_Sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            for (std::size_t i = 0; i < WordCount; i++)
+                m_Words[i].store(words[i], std::memory_order_relaxed);
+
+            m_Sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        /// @brief Any thread: consistent copy of the latest value stored
+        void Load(T& value) const noexcept
+        {
+            Words words;
+            for (;;)
+            {
+                const auto before = m_Sequence.load(std::memory_order_acquire);
+                if (before & 1)
+                    continue;
+
+                for (std::size_t i = 0; i < WordCount; i++)
+                    words[i] = m_Words[i].load(std::memory_order_relaxed);
+
+                // Keeps the word loads before the second read of the sequence
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_Sequence.load(std::memory_order_relaxed) == before)
+                    break;
+            }
+
+            std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+        }
+
+        T Load() const noexcept
+        {
+            T value;
+            Load(value);
+            return value;
+        }
+
+        /// @brief Any thread: number of values stored so far, to skip copying a value already read
+        std::uint64_t GetVersion() const noexcept
+        {
+            return m_Sequence.load(std::memory_order_acquire) / 2;
+        }
+
+    private:
+        static constexpr std::size_t WordCount = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+        using Words = std::array<std::uint64_t, WordCount>;
+
+        // Readers poll the sequence, kept away from the words the writer stores
+        alignas(64) std::atomic<std::uint64_t> m_Sequence{ 0 };
+        alignas(64) std::array<std::atomic<std::uint64_t>, WordCount> m_Words;
+    };
+}
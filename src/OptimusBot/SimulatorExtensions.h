@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+#include "DvfSimulator.h"
+#include "Types.h"
+
+/// @brief Optional capabilities a market simulator can implement on top of IDvfSimulator.
+/// The Bot discovers them at runtime (dynamic_cast) and falls back to the plain IDvfSimulator API otherwise
+namespace OptimusBot
+{
+    /// @brief Deleter of a simulator owned through IDvfSimulator, which lacks a virtual destructor (its file being provided as-is):
+    /// it remembers the actual type of the simulator, so that its destructor runs (e.g. joining the threads of an AsyncOrderGateway)
+    class SimulatorDeleter final
+    {
+    public:
+        /// @brief Deleter of an empty pointer
+        SimulatorDeleter() noexcept = default;
+
+        /// @brief Implicit, so that the std::unique_ptr returned by std::make_unique converts to a SimulatorPtr
+        template <typename Simulator>
+        SimulatorDeleter(std::default_delete<Simulator>) noexcept
+            : m_Delete{ [](IDvfSimulator* simulator) { delete static_cast<Simulator*>(simulator); } }
+        {
+            static_assert(!std::is_same_v<Simulator, IDvfSimulator>, "The actual type of the simulator is required to delete it");
+        }
+
+        void operator()(IDvfSimulator* simulator) const noexcept
+        {
+            m_Delete(simulator);
+        }
+
+    private:
+        void (*m_Delete)(IDvfSimulator*) { nullptr };
+    };
+
+    /// @brief Owning pointer to a simulator, to be built from a std::unique_ptr to its actual type
+    using SimulatorPtr = std::unique_ptr<IDvfSimulator, SimulatorDeleter>;
+
+    /// @brief Source of incremental order book updates, as a sequence of price level changes
+    class IOrderBookDeltaSource
+    {
+    public:
+        virtual ~IOrderBookDeltaSource() noexcept = default;
+
+        /// @brief Appends the price level changes which occurred since the previous call. The first call describes the whole book as ADD deltas
+        /// @param deltas Output buffer, appended to (not cleared) to allow reusing its capacity
+        virtual void GetOrderBookDeltas(std::vector<Types::LevelDelta>& deltas) noexcept = 0;
+    };
+
+
+    /// @brief Provider of the order book into a caller-owned buffer, whose capacity is reused rather than allocating a new book per call
+    class IBufferedOrderBookSource
+    {
+    public:
+        virtual ~IBufferedOrderBookSource() noexcept = default;
+
+        /// @brief Same as IDvfSimulator::GetOrderBook
+        /// @param orderBook Output book, overwritten
+        virtual void GetOrderBook(IDvfSimulator::OrderBook& orderBook) noexcept = 0;
+    };
+
+    /// @brief Submitter of many orders in a single round trip
+    class IBatchOrderPlacer
+    {
+    public:
+        virtual ~IBatchOrderPlacer() noexcept = default;
+
+        /// @brief Places a batch of orders
+        /// @param requests First of the orders to place
+        /// @param count Number of orders
+        /// @param orderIds Output array of count elements, receiving the id of each order or std::nullopt if it could not be placed
+        virtual void PlaceOrders(const Types::OrderRequest* requests, std::size_t count, std::optional<IDvfSimulator::OrderID>* orderIds) noexcept = 0;
+    };
+
+    /// @brief Canceller of many orders in a single round trip
+    class IBatchOrderCanceller
+    {
+    public:
+        virtual ~IBatchOrderCanceller() noexcept = default;
+
+        /// @brief Cancels a batch of orders
+        /// @param orderIds First of the ids of the orders to cancel
+        /// @param count Number of orders
+        /// @param results Output array of count elements, receiving whether each order was cancelled
+        virtual void CancelOrders(const IDvfSimulator::OrderID* orderIds, std::size_t count, bool* results) noexcept = 0;
+    };
+
+    /// @brief Market able to tell which orders still rest on it, e.g. to reconcile the orders of a bot restarted from its journal
+    class IOrderLookup
+    {
+    public:
+        virtual ~IOrderLookup() noexcept = default;
+
+        /// @brief Volume left of an order, std::nullopt if the market does not know it, or not anymore (filled or cancelled)
+        virtual std::optional<Types::Quantity> GetRemaining(IDvfSimulator::OrderID oid) const noexcept = 0;
+    };
+
+    /// @brief Fill of an order, possibly partial, at the price of the order
+    struct FillEvent
+    {
+        IDvfSimulator::OrderID OrderId;
+        Types::OrderSide Side;
+        Types::Price Price;
+        Types::Quantity Volume;
+
+        // Volume of the order still resting, 0 once it is completely filled
+        Types::Quantity Remaining;
+    };
+
+    /// @brief Receiver of the events of an IMarketEventSource. Called on the thread of the source, possibly holding its locks: each call
+    /// should return quickly, e.g. queuing the event for the thread of the listener, and must not call back into the source
+    class IMarketEventListener
+    {
+    public:
+        virtual ~IMarketEventListener() noexcept = default;
+
+        /// @brief An order of the listener traded
+        virtual void OnFill(const FillEvent& fill) noexcept = 0;
+
+        /// @brief An order of the listener left the market unfilled, whether the listener or the venue cancelled it
+        virtual void OnCancel(IDvfSimulator::OrderID orderId) noexcept = 0;
+
+        /// @brief A price level of the book changed, the delta holding its new total volume
+        virtual void OnBookChange(const Types::LevelDelta& delta) noexcept = 0;
+    };
+
+    /// @brief Market pushing its events to a listener as they happen, so that the fills are known exactly and right away rather than
+    /// inferred from the books polled. Events are delivered one at a time, as soon as they occur: on the thread of the market for its
+    /// own flow (e.g. reading the connection to the venue), and on the thread of the IDvfSimulator call causing them (e.g. a cancellation)
+    class IMarketEventSource
+    {
+    public:
+        virtual ~IMarketEventSource() noexcept = default;
+
+        /// @brief Replaces the listener of the events, none if nullptr. The whole book is delivered to the new listener as ADD changes.
+        /// Once it returns, the previous listener is not called anymore
+        virtual void Subscribe(IMarketEventListener* listener) noexcept = 0;
+    };
+
+    /// @brief Gets the order book into the given buffer, without allocating if the simulator implements IBufferedOrderBookSource
+    inline void GetOrderBook(IDvfSimulator& simulator, IDvfSimulator::OrderBook& orderBook) noexcept
+    {
+        if (const auto bufferedSource = dynamic_cast<IBufferedOrderBookSource*>(&simulator))
+        {
+            bufferedSource->GetOrderBook(orderBook);
+            return;
+        }
+
+        orderBook = simulator.GetOrderBook();
+    }
+
+    /// @brief Places a batch of orders, in a single call if the simulator implements IBatchOrderPlacer, one call per order otherwise
+    inline void PlaceOrders(IDvfSimulator& simulator, const Types::OrderRequest* requests, std::size_t count, std::optional<IDvfSimulator::OrderID>* orderIds) noexcept
+    {
+        if (const auto batchPlacer = dynamic_cast<IBatchOrderPlacer*>(&simulator))
+        {
+            batchPlacer->PlaceOrders(requests, count, orderIds);
+            return;
+        }
+
+        for (std::size_t i = 0; i < count; i++)
+            orderIds[i] = simulator.PlaceOrder(requests[i].Price.ToDouble(), requests[i].Amount());
+    }
+
+    /// @brief Cancels a batch of orders, in a single call if the simulator implements IBatchOrderCanceller, one call per order otherwise
+    inline void CancelOrders(IDvfSimulator& simulator, const IDvfSimulator::OrderID* orderIds, std::size_t count, bool* results) noexcept
+    {
+        if (const auto batchCanceller = dynamic_cast<IBatchOrderCanceller*>(&simulator))
+        {
+            batchCanceller->CancelOrders(orderIds, count, results);
+            return;
+        }
+
+        for (std::size_t i = 0; i < count; i++)
+            results[i] = simulator.CancelOrder(orderIds[i]);
+    }
+}
@@ -0,0 +1,87 @@
+#include "pch.h"
+#include "SnapshotDeltaAdapter.h"
+
+using namespace OptimusBot::Types;
+
+
+namespace
+{
+    // Sorts the levels by price and merges the ones sharing the same price (e.g. the bot's own orders and the market's)
+    void Aggregate(std::vector<std::pair<Price, Quantity>>& levels) noexcept
+    {
+        std::sort(levels.begin(), levels.end());
+
+        std::size_t last = 0;
+        for (std::size_t i = 1; i < levels.size(); i++)
+        {
+            if (levels[i].first == levels[last].first)
+                levels[last].second += levels[i].second;
+            else
+                levels[++last] = levels[i];
+        }
+
+        if (!levels.empty())
+            levels.resize(last + 1);
+    }
+}
+
+
+void OptimusBot::SnapshotDeltaAdapter::GetOrderBookDeltas(std::vector<LevelDelta>& deltas) noexcept
+{
+    GetOrderBook(m_Simulator, m_Snapshot);
+    m_Differ.Diff(m_Snapshot, deltas);
+}
+
+
+void OptimusBot::SnapshotDiffer::Diff(const IDvfSimulator::OrderBook& snapshot, std::vector<LevelDelta>& deltas) noexcept
+{
+    m_CurrentBids.clear();
+    m_CurrentAsks.clear();
+
+    for (const auto& [price, volume] : snapshot)
+    {
+        if (volume > 0.0)
+            m_CurrentBids.emplace_back(Price{ price }, Quantity{ volume });
+        else if (volume < 0.0)
+            m_CurrentAsks.emplace_back(Price{ price }, Quantity{ -volume });
+    }
+
+    Aggregate(m_CurrentBids);
+    Aggregate(m_CurrentAsks);
+
+    DiffSide(OrderSide::BID, m_PreviousBids, m_CurrentBids, deltas);
+    DiffSide(OrderSide::ASK, m_PreviousAsks, m_CurrentAsks, deltas);
+
+    // The current snapshot becomes the reference, the old buffers being recycled for the next one
+    std::swap(m_PreviousBids, m_CurrentBids);
+    std::swap(m_PreviousAsks, m_CurrentAsks);
+}
+
+
+void OptimusBot::SnapshotDiffer::DiffSide(OrderSide side, const Levels& previous, const Levels& current, std::vector<LevelDelta>& deltas) noexcept
+{
+    // Both inputs are sorted by price: a single merge pass finds the removed, added and changed levels
+    std::size_t i = 0;
+    std::size_t j = 0;
+
+    while (i < previous.size() || j < current.size())
+    {
+        if (j == current.size() || (i < previous.size() && previous[i].first < current[j].first))
+        {
+            deltas.emplace_back(side, LevelAction::REMOVE, previous[i].first, Quantity{});
+            i++;
+        }
+        else if (i == previous.size() || current[j].first < previous[i].first)
+        {
+            deltas.emplace_back(side, LevelAction::ADD, current[j].first, current[j].second);
+            j++;
+        }
+        else
+        {
+            if (previous[i].second != current[j].second)
+                deltas.emplace_back(side, LevelAction::CHANGE, current[j].first, current[j].second);
+            i++;
+            j++;
+        }
+    }
+}
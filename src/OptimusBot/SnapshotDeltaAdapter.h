@@ -0,0 +1,56 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+#include "DvfSimulator.h"
+#include "SimulatorExtensions.h"
+#include "Types.h"
+
+namespace OptimusBot
+{
+    /// @brief Turns consecutive full snapshots, pulled by its owner, into price level deltas.
+    /// The previous snapshot is kept aggregated by price and sorted, the new one being diffed against it
+    class SnapshotDiffer final
+    {
+    public:
+        /// @brief Appends the differences between the given snapshot and the previous one, which is then replaced.
+        /// The prices and volumes are converted to fixed point, the levels whose price rounds to the same tick being merged
+        /// @param snapshot Order book, as returned by the market simulator: +ve volumes for bids, -ve for asks, in any order
+        /// @param deltas Output buffer, appended to
+        void Diff(const IDvfSimulator::OrderBook& snapshot, std::vector<Types::LevelDelta>& deltas) noexcept;
+
+    private:
+        // Price/volume pairs of one side, sorted by ascending prices with a single entry per price
+        using Levels = std::vector<std::pair<Types::Price, Types::Quantity>>;
+
+        static void DiffSide(Types::OrderSide side, const Levels& previous, const Levels& current, std::vector<Types::LevelDelta>& deltas) noexcept;
+
+        Levels m_PreviousBids;
+        Levels m_PreviousAsks;
+
+        // Reused between calls to avoid reallocating on every snapshot
+        Levels m_CurrentBids;
+        Levels m_CurrentAsks;
+    };
+
+    /// @brief Turns the consecutive full snapshots of a simulator, which cannot emit deltas itself, into price level deltas
+    class SnapshotDeltaAdapter final : public IOrderBookDeltaSource
+    {
+    public:
+        /// @param simulator Source of the snapshots, which must outlive the adapter
+        explicit SnapshotDeltaAdapter(IDvfSimulator& simulator) noexcept
+            : m_Simulator{ simulator }
+        {
+        }
+
+        /// @brief Polls a full snapshot from the simulator (into a reused buffer if possible) and appends its differences with the previous one
+        void GetOrderBookDeltas(std::vector<Types::LevelDelta>& deltas) noexcept override;
+
+    private:
+        IDvfSimulator& m_Simulator;
+
+        // Last snapshot polled, reused between calls if the simulator implements IBufferedOrderBookSource
+        IDvfSimulator::OrderBook m_Snapshot;
+        SnapshotDiffer m_Differ;
+    };
+}
@@ -0,0 +1,88 @@
+#include "pch.h"
+#include <sstream>
+#include "SnapshotSources.h"
+
+
+bool OptimusBot::SimulatorSnapshotSource::Next(IDvfSimulator::OrderBook& orderBook)
+{
+    if (m_Remaining == 0)
+        return false;
+
+    m_Remaining--;
+    GetOrderBook(*m_Simulator, orderBook);
+    return true;
+}
+
+
+bool OptimusBot::TextSnapshotSource::Next(IDvfSimulator::OrderBook& orderBook)
+{
+    if (!std::getline(m_File, m_Line))
+        return false;
+
+    orderBook.clear();
+
+    std::istringstream stream{ m_Line };
+    double price, volume;
+    while (stream >> price >> volume)
+        orderBook.emplace_back(price, volume);
+
+    return true;
+}
+
+
+void OptimusBot::TextSnapshotSource::Write(std::ostream& output, const IDvfSimulator::OrderBook& orderBook)
+{
+    // Enough digits for the prices and volumes to be read back unchanged in practice, restoring the caller's settings afterwards
+    const auto precision = output.precision(15);
+
+    auto separator = "";
+    for (const auto& [price, volume] : orderBook)
+    {
+        output << separator << price << ' ' << volume;
+        separator = " ";
+    }
+
+    output << '\n';
+    output.precision(precision);
+}
+
+
+bool OptimusBot::JsonSnapshotSource::Next(IDvfSimulator::OrderBook& orderBook)
+{
+    for (;;)
+    {
+        if (m_Input.empty())
+        {
+            m_File.read(m_Chunk.data(), static_cast<std::streamsize>(m_Chunk.size()));
+            if (m_File.gcount() <= 0)
+                return false;
+
+            m_Input = std::string_view{ m_Chunk.data(), static_cast<std::size_t>(m_File.gcount()) };
+        }
+
+        switch (m_Parser.Feed(m_Input, orderBook))
+        {
+        case BookJson::ParseStatus::COMPLETE:
+            return true;
+        case BookJson::ParseStatus::MALFORMED:
+            return false;
+        case BookJson::ParseStatus::INCOMPLETE:
+            break;
+        }
+    }
+}
+
+
+bool OptimusBot::TickFileSnapshotSource::Next(IDvfSimulator::OrderBook& orderBook)
+{
+    while (m_Reader.Next(m_Event))
+    {
+        if (m_Event.Type == TickFile::EventType::SNAPSHOT)
+        {
+            orderBook = *m_Event.OrderBook;
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "BookJson.h"
+#include "DvfSimulator.h"
+#include "SimulatorExtensions.h"
+#include "TickFile.h"
+
+namespace OptimusBot
+{
+    /// @brief Sequence of order book snapshots replayed by a backtest
+    class ISnapshotSource
+    {
+    public:
+        virtual ~ISnapshotSource() noexcept = default;
+
+        /// @brief Reads the next snapshot
+        /// @param orderBook Output book, overwritten (its capacity being reused)
+        /// @return False once the sequence is exhausted
+        virtual bool Next(IDvfSimulator::OrderBook& orderBook) = 0;
+    };
+
+    /// @brief Generates snapshots by polling a simulator, e.g. a MarketModelSimulator
+    class SimulatorSnapshotSource final : public ISnapshotSource
+    {
+    public:
+        /// @param simulator Simulator generating the market
+        /// @param count Number of snapshots to generate
+        SimulatorSnapshotSource(SimulatorPtr&& simulator, std::size_t count) noexcept
+            : m_Simulator{ std::move(simulator) }, m_Remaining{ count }
+        {
+        }
+
+        bool Next(IDvfSimulator::OrderBook& orderBook) override;
+
+    private:
+        SimulatorPtr m_Simulator;
+        std::size_t m_Remaining;
+    };
+
+    /// @brief Reads snapshots recorded in a text file, one snapshot per line as space-separated "price volume" pairs
+    class TextSnapshotSource final : public ISnapshotSource
+    {
+    public:
+        /// @param path File to read. If it cannot be opened, the source is simply empty
+        explicit TextSnapshotSource(const std::string& path)
+            : m_File{ path }
+        {
+        }
+
+        bool Next(IDvfSimulator::OrderBook& orderBook) override;
+
+        /// @brief Writes a snapshot in the format read by this class
+        static void Write(std::ostream& output, const IDvfSimulator::OrderBook& orderBook);
+
+    private:
+        std::ifstream m_File;
+        std::string m_Line;
+    };
+
+    /// @brief Reads snapshots saved as Deversifi order book payloads, one JSON array of levels after the other.
+    /// The file is read in fixed-size chunks fed to a streaming parser, as the responses of the API would be
+    class JsonSnapshotSource final : public ISnapshotSource
+    {
+    public:
+        /// @param path File to read. If it cannot be opened, the source is simply empty
+        /// @param chunkSize Number of bytes read at once
+        explicit JsonSnapshotSource(const std::string& path, std::size_t chunkSize = 64 * 1024)
+            : m_File{ path, std::ios::binary }, m_Chunk(chunkSize)
+        {
+        }
+
+        /// @return False once the file is exhausted or a malformed payload is met
+        bool Next(IDvfSimulator::OrderBook& orderBook) override;
+
+    private:
+        std::ifstream m_File;
+        std::vector<char> m_Chunk;
+        std::string_view m_Input;
+        BookJson::StreamingParser m_Parser;
+    };
+
+    /// @brief Reads the snapshots of a binary recording made by a RecordingSimulator, skipping the order events
+    class TickFileSnapshotSource final : public ISnapshotSource
+    {
+    public:
+        /// @param path Recording to read. If it is not a valid recording, the source is simply empty
+        explicit TickFileSnapshotSource(const std::string& path) noexcept
+            : m_Reader{ path }
+        {
+        }
+
+        bool Next(IDvfSimulator::OrderBook& orderBook) override;
+
+    private:
+        TickFile::TickReader m_Reader;
+        TickFile::Event m_Event;
+    };
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace OptimusBot
+{
+    /// @brief Bounded lock-free queue between exactly one producer thread and one consumer thread.
+    /// Slots are filled and read in place, the producer claiming a slot then publishing it once written
+    template <typename T>
+    class SpscRing final
+    {
+    public:
+        /// @param capacity Minimum number of slots, rounded up to a power of two
+        explicit SpscRing(std::size_t capacity)
+            : m_Slots(RoundUpToPowerOfTwo(capacity)), m_Mask{ m_Slots.size() - 1 }
+        {
+        }
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        /// @brief Producer only: slot to write the next element into, or nullptr if the ring is full
+        T* TryClaim() noexcept
+        {
+            const auto tail = m_Tail.load(std::memory_order_relaxed);
+            if (tail - m_CachedHead > m_Mask)
+            {
+                // Only reloading the consumer's index when the ring looks full keeps its cache line from bouncing
+                m_CachedHead = m_Head.load(std::memory_order_acquire);
+                if (tail - m_CachedHead > m_Mask)
+                    return nullptr;
+            }
+
+            return &m_Slots[tail & m_Mask];
+        }
+
+        /// @brief Producer only: makes the claimed slot visible to the consumer
+        void Publish() noexcept
+        {
+            m_Tail.store(m_Tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        /// @brief Consumer only: oldest element, or nullptr if the ring is empty
+        const T* Front() noexcept
+        {
+            const auto head = m_Head.load(std::memory_order_relaxed);
+            if (head == m_CachedTail)
+            {
+                m_CachedTail = m_Tail.load(std::memory_order_acquire);
+                if (head == m_CachedTail)
+                    return nullptr;
+            }
+
+            return &m_Slots[head & m_Mask];
+        }
+
+        /// @brief Consumer only: releases the element returned by Front
+        void Pop() noexcept
+        {
+            m_Head.store(m_Head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        bool Empty() const noexcept
+        {
+            return m_Head.load(std::memory_order_acquire) == m_Tail.load(std::memory_order_acquire);
+        }
+
+    private:
+        static std::size_t RoundUpToPowerOfTwo(std::size_t value) noexcept
+        {
+            std::size_t result = 1;
+            while (result < value)
+                result <<= 1;
+            return result;
+        }
+
+        // Keeps the indices written by each side on separate cache lines
+        static constexpr std::size_t cacheLineSize = 64;
+
+        std::vector<T> m_Slots;
+        const std::size_t m_Mask;
+
+        alignas(cacheLineSize) std::atomic<std::size_t> m_Head{ 0 };
+        std::size_t m_CachedTail{ 0 };
+
+        alignas(cacheLineSize) std::atomic<std::size_t> m_Tail{ 0 };
+        std::size_t m_CachedHead{ 0 };
+    };
+}
@@ -0,0 +1,308 @@
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <iomanip>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include "Backtester.h"
+#include "Logger.h"
+#include "MarketModelSimulator.h"
+#include "PriceProcesses.h"
+#include "StrategyOptimizer.h"
+
+using namespace OptimusBot::Types;
+
+
+namespace
+{
+    // Outcome of a single backtest, as needed by the ranking
+    struct RunOutcome
+    {
+        bool Completed{ false };
+        double PnL{ 0.0 };
+        double PnLVersusHolding{ 0.0 };
+        double FillRate{ 0.0 };
+        double InventoryRisk{ 0.0 };
+    };
+
+    /// @brief Derives independent seeds from the sweep's seed (splitmix64 finalizer)
+    std::uint64_t MixSeed(std::uint64_t seed, std::uint64_t stream) noexcept
+    {
+        auto z = seed + 0x9E3779B97F4A7C15ull * (stream + 1);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    OptimusBot::Optimizer::CandidateResult Aggregate(const OptimusBot::Optimizer::Candidate& candidate, const RunOutcome* outcomes, std::size_t count)
+    {
+        OptimusBot::Optimizer::CandidateResult result;
+        result.Parameters = candidate;
+        result.Runs = count;
+        result.WorstPnL = std::numeric_limits<double>::infinity();
+
+        std::size_t completed = 0;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            const auto& outcome = outcomes[i];
+            if (!outcome.Completed)
+                continue;
+
+            completed++;
+            result.MeanPnL += outcome.PnL;
+            result.MeanPnLVersusHolding += outcome.PnLVersusHolding;
+            result.MeanFillRate += outcome.FillRate;
+            result.MeanInventoryRisk += outcome.InventoryRisk;
+            result.WorstPnL = std::min(result.WorstPnL, outcome.PnL);
+        }
+
+        result.AbortedRuns = count - completed;
+        if (completed == 0)
+        {
+            result.WorstPnL = 0.0;
+            return result;
+        }
+
+        result.MeanPnL /= completed;
+        result.MeanPnLVersusHolding /= completed;
+        result.MeanFillRate /= completed;
+        result.MeanInventoryRisk /= completed;
+
+        auto variance = 0.0;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            if (outcomes[i].Completed)
+                variance += (outcomes[i].PnL - result.MeanPnL) * (outcomes[i].PnL - result.MeanPnL);
+        }
+        result.PnLStdDev = std::sqrt(variance / completed);
+
+        return result;
+    }
+}
+
+
+std::vector<double> OptimusBot::Optimizer::ParameterRange::Values() const
+{
+    if (Step <= 0.0 || Max <= Min)
+        return { Min };
+
+    // Computed from the index rather than accumulated, the tolerance keeping Max when it is a multiple of the step
+    const auto count = static_cast<std::size_t>(std::floor((Max - Min) / Step + 1e-9)) + 1;
+
+    std::vector<double> values;
+    values.reserve(count);
+    for (std::size_t i = 0; i < count; i++)
+        values.push_back(Min + Step * i);
+
+    return values;
+}
+
+
+std::unique_ptr<OptimusBot::ISnapshotSource> OptimusBot::Optimizer::GenerateDay(std::uint64_t seed)
+{
+    constexpr std::size_t ticksPerDay = 24 * 60 * 60 / 5;
+
+    MarketModelConfig config;
+    config.Seed = seed;
+
+    return std::make_unique<SimulatorSnapshotSource>(
+        std::make_unique<MarketModelSimulator>(config, std::make_unique<RandomWalkProcess>(1.0, 1.0 / 3.0)), ticksPerDay);
+}
+
+
+std::vector<OptimusBot::Optimizer::Candidate> OptimusBot::Optimizer::MakeCandidates(const OptimizerConfig& config)
+{
+    std::vector<Candidate> candidates;
+
+    for (const auto orders : config.OrdersEachSide.Values())
+        for (const auto bidBand : config.BidBand.Values())
+            for (const auto askBand : config.AskBand.Values())
+                for (const auto sizing : config.Sizing.Values())
+                    for (const auto eth : config.InitialETH.Values())
+                        for (const auto usd : config.InitialUSD.Values())
+                        {
+                            Candidate candidate;
+                            candidate.OrdersEachSide = static_cast<int>(std::lround(orders));
+                            candidate.Strategy.BidBand = bidBand;
+                            candidate.Strategy.AskBand = askBand;
+                            candidate.Strategy.Sizing = sizing;
+                            candidate.InitialETH = eth;
+                            candidate.InitialUSD = usd;
+                            candidates.push_back(candidate);
+                        }
+
+    return candidates;
+}
+
+
+OptimusBot::Optimizer::OptimizerReport OptimusBot::Optimizer::Run(const OptimizerConfig& config, ThreadPool& pool)
+{
+    const auto wallStart = std::chrono::steady_clock::now();
+
+    const auto candidates = MakeCandidates(config);
+    const auto scenarios = config.Scenarios;
+
+    // Each backtest writes its own slot, so that the outcome does not depend on the order in which they complete
+    std::vector<RunOutcome> outcomes(candidates.size() * scenarios);
+    std::vector<std::future<void>> runs;
+    runs.reserve(outcomes.size());
+
+    {
+        // Set once for the whole sweep: the backtests leave the process-wide threshold alone
+        const Logging::ScopedLevel silencer{ Logging::Level::OFF };
+
+        for (std::size_t c = 0; c < candidates.size(); c++)
+        {
+            for (std::size_t s = 0; s < scenarios; s++)
+            {
+                runs.push_back(pool.Submit([&config, &candidate = candidates[c], &outcome = outcomes[c * scenarios + s], s]() {
+                    // The candidates share the markets and the random draws of each scenario, only their parameters differ
+                    Backtester::BacktestConfig backtestConfig;
+                    backtestConfig.InitialETH = candidate.InitialETH;
+                    backtestConfig.InitialUSD = candidate.InitialUSD;
+                    backtestConfig.OrdersEachSide = candidate.OrdersEachSide;
+                    backtestConfig.Strategy = candidate.Strategy;
+                    backtestConfig.StrategySeed = MixSeed(config.Seed, 2 * s + 1);
+                    backtestConfig.Quiet = false;
+
+                    const auto report = Backtester::Run(config.MakeMarket(MixSeed(config.Seed, 2 * s)), backtestConfig);
+
+                    outcome.Completed = report.InitialOrdersPlaced;
+                    outcome.PnL = report.PnL;
+                    outcome.PnLVersusHolding = report.PnLVersusHolding;
+                    outcome.FillRate = report.FillRate;
+                    outcome.InventoryRisk = report.InventoryRisk;
+                }));
+            }
+        }
+
+        // Every backtest is waited for before rethrowing a failure, as they refer to the outcomes
+        for (auto& run : runs)
+            run.wait();
+        for (auto& run : runs)
+            run.get();
+    }
+
+    OptimizerReport report;
+    report.Backtests = outcomes.size();
+    report.Ranking.reserve(candidates.size());
+
+    for (std::size_t c = 0; c < candidates.size(); c++)
+        report.Ranking.push_back(Aggregate(candidates[c], outcomes.data() + c * scenarios, scenarios));
+
+    // Stable, so that ties keep the grid order
+    std::stable_sort(report.Ranking.begin(), report.Ranking.end(), [](const CandidateResult& lhs, const CandidateResult& rhs) {
+        return lhs.MeanPnLVersusHolding > rhs.MeanPnLVersusHolding;
+    });
+
+    report.WallDuration = std::chrono::steady_clock::now() - wallStart;
+
+    return report;
+}
+
+
+void OptimusBot::Optimizer::PrintReport(std::ostream& output, const OptimizerReport& report, std::size_t maxRows)
+{
+    using Seconds = std::chrono::duration<double>;
+
+    output << "Optimizer report: " << report.Ranking.size() << " candidates, " << report.Backtests << " backtests in "
+        << Seconds{ report.WallDuration }.count() << "s" << std::endl;
+
+    const auto flags = output.flags();
+    const auto precision = output.precision(2);
+    output << std::fixed;
+
+    output << std::setw(5) << "Rank" << std::setw(8) << "Orders" << std::setw(8) << "Bid" << std::setw(8) << "Ask"
+        << std::setw(8) << "Sizing" << std::setw(8) << "ETH" << std::setw(10) << "USD"
+        << std::setw(12) << "PnL" << std::setw(10) << "StdDev" << std::setw(12) << "Worst" << std::setw(12) << "vs Hold"
+        << std::setw(8) << "Fill%" << std::setw(12) << "Inventory" << std::setw(9) << "Aborted" << std::endl;
+
+    const auto rows = std::min(maxRows, report.Ranking.size());
+    for (std::size_t i = 0; i < rows; i++)
+    {
+        const auto& result = report.Ranking[i];
+        const auto& parameters = result.Parameters;
+
+        output << std::setw(5) << i + 1 << std::setw(8) << parameters.OrdersEachSide
+            << std::setw(8) << parameters.Strategy.BidBand << std::setw(8) << parameters.Strategy.AskBand
+            << std::setw(8) << parameters.Strategy.Sizing << std::setw(8) << parameters.InitialETH << std::setw(10) << parameters.InitialUSD
+            << std::setw(12) << result.MeanPnL << std::setw(10) << result.PnLStdDev << std::setw(12) << result.WorstPnL
+            << std::setw(12) << result.MeanPnLVersusHolding << std::setw(8) << result.MeanFillRate * 100.0
+            << std::setw(12) << result.MeanInventoryRisk << std::setw(9) << result.AbortedRuns << std::endl;
+    }
+
+    output.flags(flags);
+    output.precision(precision);
+}
+
+
+bool OptimusBot::Optimizer::ParseRange(const std::string& text, ParameterRange& range)
+{
+    std::istringstream stream{ text };
+    ParameterRange parsed;
+
+    if (!(stream >> parsed.Min))
+        return false;
+
+    parsed.Max = parsed.Min;
+    char separator;
+    if (stream >> separator)
+    {
+        if (separator != ':' || !(stream >> parsed.Max))
+            return false;
+
+        if (stream >> separator && (separator != ':' || !(stream >> parsed.Step)))
+            return false;
+    }
+
+    // Nothing should follow the range
+    if (stream.peek() != std::char_traits<char>::eof() || parsed.Max < parsed.Min)
+        return false;
+
+    range = parsed;
+    return true;
+}
+
+
+bool OptimusBot::Optimizer::ParseArgument(const std::string& argument, OptimizerConfig& config)
+{
+    const auto equal = argument.find('=');
+    if (equal == std::string::npos)
+        return false;
+
+    const auto name = argument.substr(0, equal);
+    const auto value = argument.substr(equal + 1);
+
+    if (name == "scenarios" || name == "seed")
+    {
+        std::istringstream stream{ value };
+        std::uint64_t number;
+        if (!(stream >> number) || !stream.eof())
+            return false;
+
+        if (name == "scenarios")
+            config.Scenarios = static_cast<std::size_t>(number);
+        else
+            config.Seed = number;
+
+        return true;
+    }
+
+    ParameterRange* range = nullptr;
+    if (name == "orders")
+        range = &config.OrdersEachSide;
+    else if (name == "bid")
+        range = &config.BidBand;
+    else if (name == "ask")
+        range = &config.AskBand;
+    else if (name == "sizing")
+        range = &config.Sizing;
+    else if (name == "eth")
+        range = &config.InitialETH;
+    else if (name == "usd")
+        range = &config.InitialUSD;
+
+    return range && ParseRange(value, *range);
+}
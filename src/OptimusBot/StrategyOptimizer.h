@@ -0,0 +1,107 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "SnapshotSources.h"
+#include "ThreadPool.h"
+#include "Types.h"
+
+namespace OptimusBot::Optimizer
+{
+    /// @brief Values taken by a parameter during a sweep: from Min to Max (included) by Step. A single value if Step is not positive
+    struct ParameterRange
+    {
+        double Min{ 0.0 };
+        double Max{ 0.0 };
+        double Step{ 0.0 };
+
+        std::vector<double> Values() const;
+    };
+
+    /// @brief Builds the snapshots of a market from its seed
+    using MarketFactory = std::function<std::unique_ptr<ISnapshotSource>(std::uint64_t seed)>;
+
+    /// @brief A day of 5-second ticks generated by a MarketModelSimulator, moving like DvfSimulator's market
+    std::unique_ptr<ISnapshotSource> GenerateDay(std::uint64_t seed);
+
+    /// @brief Parameters of a sweep, each candidate of the grid being backtested on the same markets
+    struct OptimizerConfig
+    {
+        // Grid of the candidates, defaulting to the original strategy and wallet
+        ParameterRange OrdersEachSide{ 5.0, 5.0, 0.0 };
+        ParameterRange BidBand{ 0.95, 0.95, 0.0 };
+        ParameterRange AskBand{ 1.05, 1.05, 0.0 };
+        ParameterRange Sizing{ 1.0, 1.0, 0.0 };
+        ParameterRange InitialETH{ 10.0, 10.0, 0.0 };
+        ParameterRange InitialUSD{ 2000.0, 2000.0, 0.0 };
+
+        // Number of markets each candidate is backtested on
+        std::size_t Scenarios{ 16 };
+
+        // The markets and the orders drawn are derived from it, so that a sweep is reproducible whatever the number of threads
+        std::uint64_t Seed{ 0 };
+
+        MarketFactory MakeMarket{ GenerateDay };
+    };
+
+    /// @brief Point of the grid
+    struct Candidate
+    {
+        int OrdersEachSide{ 5 };
+        Types::StrategyParameters Strategy;
+        double InitialETH{ 10.0 };
+        double InitialUSD{ 2000.0 };
+    };
+
+    /// @brief Outcome of a candidate, averaged over the scenarios
+    struct CandidateResult
+    {
+        Candidate Parameters;
+
+        // Backtests run, and those aborted because the initial orders could not be placed (not part of the averages)
+        std::size_t Runs{ 0 };
+        std::size_t AbortedRuns{ 0 };
+
+        double MeanPnL{ 0.0 };
+        double PnLStdDev{ 0.0 };
+        double WorstPnL{ 0.0 };
+        double MeanPnLVersusHolding{ 0.0 };
+        double MeanFillRate{ 0.0 };
+        double MeanInventoryRisk{ 0.0 };
+    };
+
+    /// @brief Outcome of a sweep
+    struct OptimizerReport
+    {
+        // Best first, by mean PnL versus holding: unlike the PnL, it does not grow with the ETH hold when the market goes up
+        std::vector<CandidateResult> Ranking;
+
+        std::size_t Backtests{ 0 };
+        std::chrono::steady_clock::duration WallDuration{ 0 };
+    };
+
+    /// @brief Enumerates the grid of the sweep
+    std::vector<Candidate> MakeCandidates(const OptimizerConfig& config);
+
+    /// @brief Backtests every candidate on every scenario, in parallel on the pool. The logging is turned off meanwhile
+    OptimizerReport Run(const OptimizerConfig& config, ThreadPool& pool);
+
+    /// @brief Prints the ranking as a table
+    /// @param maxRows Number of candidates printed, the best ones
+    void PrintReport(std::ostream& output, const OptimizerReport& report, std::size_t maxRows);
+
+    /// @brief Parses a range written as "min", "min:max" or "min:max:step"
+    /// @return False if the text is not a valid range, leaving the range unchanged
+    bool ParseRange(const std::string& text, ParameterRange& range);
+
+    /// @brief Applies a "name=value" argument of the optimize mode to the config. The ranges are named orders, bid, ask, sizing, eth and usd,
+    /// the other settings scenarios and seed
+    /// @return False if the argument is unknown or malformed
+    bool ParseArgument(const std::string& argument, OptimizerConfig& config);
+}
@@ -0,0 +1,280 @@
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "StreamingMarketSimulator.h"
+
+using namespace OptimusBot::Types;
+
+
+OptimusBot::StreamingMarketSimulator::StreamingMarketSimulator(const MatchingSimulatorConfig& config, std::unique_ptr<IPriceProcess>&& priceProcess)
+    : m_Config{ config }, m_PriceProcess{ std::move(priceProcess) }, m_Random{ config.Seed }, m_Mid{ config.InitialMid }, m_Engine{ config.Engine }
+{
+    m_Background.reserve(2 * config.InitialOrders);
+
+    // No subscriber yet: the initial book is delivered on subscription
+    for (std::size_t i = 0; i < config.InitialOrders; i++)
+    {
+        const auto side = i % 2 ? OrderSide::ASK : OrderSide::BID;
+        const auto distance = m_Config.HalfSpread + m_Random.NextDouble(0.0, m_Config.MaxDistance);
+        SubmitBackground(side, side == OrderSide::BID ? m_Mid - distance : m_Mid + distance, OrderType::LIMIT);
+    }
+}
+
+
+OptimusBot::StreamingMarketSimulator::~StreamingMarketSimulator() noexcept
+{
+    Stop();
+}
+
+
+void OptimusBot::StreamingMarketSimulator::Start(std::chrono::steady_clock::duration interval)
+{
+    {
+        const std::lock_guard<std::mutex> lock{ m_Mutex };
+        if (m_Started)
+            return;
+        m_Started = true;
+    }
+
+    m_Flow.SchedulePeriodic(interval, [this]() { GenerateFlow(); });
+    m_FlowThread = std::thread{ [this]() { m_Flow.Run(); } };
+}
+
+
+void OptimusBot::StreamingMarketSimulator::Stop() noexcept
+{
+    if (!m_FlowThread.joinable())
+        return;
+
+    m_Flow.Stop();
+    m_FlowThread.join();
+}
+
+
+std::size_t OptimusBot::StreamingMarketSimulator::GenerateFlow() noexcept
+{
+    const std::lock_guard<std::mutex> lock{ m_Mutex };
+    return GenerateFlowLocked();
+}
+
+
+IDvfSimulator::OrderBook OptimusBot::StreamingMarketSimulator::GetOrderBook() noexcept
+{
+    OrderBook orderBook;
+    GetOrderBook(orderBook);
+    return orderBook;
+}
+
+
+void OptimusBot::StreamingMarketSimulator::GetOrderBook(OrderBook& orderBook) noexcept
+{
+    const std::lock_guard<std::mutex> lock{ m_Mutex };
+    if (!m_Started)
+        GenerateFlowLocked();
+
+    orderBook.clear();
+    m_Engine.ForEachLevel(OrderSide::BID, m_Config.Depth, [&orderBook](Price price, Quantity volume) {
+        orderBook.emplace_back(price.ToDouble(), volume.ToDouble());
+    });
+    m_Engine.ForEachLevel(OrderSide::ASK, m_Config.Depth, [&orderBook](Price price, Quantity volume) {
+        orderBook.emplace_back(price.ToDouble(), -volume.ToDouble());
+    });
+}
+
+
+std::optional<IDvfSimulator::OrderID> OptimusBot::StreamingMarketSimulator::PlaceOrder(double price, double amount) noexcept
+{
+    const auto side = amount > 0.0 ? OrderSide::BID : OrderSide::ASK;
+    const Price limit{ price };
+
+    const std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    // Post-only: an order which would be filled immediately fails to place
+    m_Trades.clear();
+    const auto result = m_Engine.Submit(side, limit, Quantity{ std::abs(amount) }, OrderType::POST_ONLY, m_Trades);
+    if (!result.Resting)
+        return {};
+
+    const auto oid = m_NextOid++;
+    m_SubscriberOrders.emplace(oid, RestingOrder{ result.Resting.value(), side, limit });
+    m_SubscriberHandles.emplace(result.Resting.value(), oid);
+    PublishLevel(side, limit);
+
+    return oid;
+}
+
+
+bool OptimusBot::StreamingMarketSimulator::CancelOrder(OrderID oid) noexcept
+{
+    const std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    const auto it = m_SubscriberOrders.find(oid);
+    if (it == m_SubscriberOrders.end())
+        return false;
+
+    const auto order = it->second;
+    m_SubscriberHandles.erase(order.Handle);
+    m_SubscriberOrders.erase(it);
+
+    if (!m_Engine.Cancel(order.Handle))
+        return false;
+
+    if (m_Listener)
+    {
+        m_Listener->OnCancel(oid);
+        m_Statistics.Cancels++;
+    }
+    PublishLevel(order.Side, order.Price);
+
+    return true;
+}
+
+
+void OptimusBot::StreamingMarketSimulator::Subscribe(IMarketEventListener* listener) noexcept
+{
+    const std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    m_Listener = listener;
+    if (!m_Listener)
+        return;
+
+    for (const auto side : { OrderSide::BID, OrderSide::ASK })
+    {
+        m_Engine.ForEachLevel(side, std::numeric_limits<std::size_t>::max(), [this, side](Price price, Quantity volume) {
+            m_Listener->OnBookChange(LevelDelta{ side, LevelAction::ADD, price, volume });
+            m_Statistics.BookChanges++;
+        });
+    }
+}
+
+
+std::optional<Quantity> OptimusBot::StreamingMarketSimulator::GetRemaining(OrderID oid) const noexcept
+{
+    const std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    const auto it = m_SubscriberOrders.find(oid);
+    return it != m_SubscriberOrders.end() ? m_Engine.GetRemaining(it->second.Handle) : std::nullopt;
+}
+
+
+std::size_t OptimusBot::StreamingMarketSimulator::GenerateFlowLocked() noexcept
+{
+    const auto delivered = GetEventCount();
+
+    // Keeps the flow within the price range of the engine
+    const auto lowest = m_Config.Engine.MinPrice + m_Config.HalfSpread + m_Config.MaxDistance;
+    const auto highest = m_Config.Engine.MaxPrice - m_Config.HalfSpread - m_Config.MaxDistance;
+    m_Mid = std::clamp(m_PriceProcess->Next(m_Mid, m_Random), lowest, std::max(lowest, highest));
+
+    for (std::size_t i = 0; i < m_Config.EventsPerSnapshot; i++)
+    {
+        const auto event = m_Random.NextDouble();
+        const auto side = m_Random.NextDouble() < 0.5 ? OrderSide::BID : OrderSide::ASK;
+        const auto direction = side == OrderSide::BID ? 1.0 : -1.0;
+
+        if (event < m_Config.CancelRatio)
+            CancelBackground();
+        else if (event < m_Config.CancelRatio + m_Config.MarketableRatio)
+            SubmitBackground(side, m_Mid + direction * m_Config.MaxDistance, OrderType::IMMEDIATE_OR_CANCEL);
+        else
+            SubmitBackground(side, m_Mid - direction * (m_Config.HalfSpread + m_Random.NextDouble(0.0, m_Config.MaxDistance)), OrderType::LIMIT);
+    }
+
+    m_Statistics.Batches++;
+    return GetEventCount() - delivered;
+}
+
+
+void OptimusBot::StreamingMarketSimulator::SubmitBackground(OrderSide side, double price, OrderType type)
+{
+    const auto volume = std::round(m_Random.NextDouble(m_Config.MinVolume, m_Config.MaxVolume) * 100.0) / 100.0;
+    const Price limit{ price };
+
+    m_Trades.clear();
+    const auto result = m_Engine.Submit(side, limit, Quantity{ volume }, type, m_Trades);
+    PublishTrades();
+
+    if (result.Resting)
+    {
+        m_Background.push_back(RestingOrder{ result.Resting.value(), side, limit });
+        PublishLevel(side, limit);
+    }
+}
+
+
+void OptimusBot::StreamingMarketSimulator::CancelBackground()
+{
+    if (m_Background.empty())
+        return;
+
+    // Swap and pop: which order is cancelled does not matter, as long as it is random
+    const auto index = static_cast<std::size_t>(m_Random() % m_Background.size());
+    const auto order = m_Background[index];
+    m_Background[index] = m_Background.back();
+    m_Background.pop_back();
+
+    if (m_Engine.Cancel(order.Handle))
+        PublishLevel(order.Side, order.Price);
+
+    // Handles of filled orders pile up otherwise
+    if (m_Background.size() > 2 * m_Engine.GetOrderCount() + 1024)
+    {
+        m_Background.erase(std::remove_if(m_Background.begin(), m_Background.end(),
+            [this](const RestingOrder& background) { return !m_Engine.GetRemaining(background.Handle); }), m_Background.end());
+    }
+}
+
+
+void OptimusBot::StreamingMarketSimulator::PublishTrades()
+{
+    if (m_Trades.empty())
+        return;
+
+    const auto makerSide = m_Trades.front().TakerSide == OrderSide::BID ? OrderSide::ASK : OrderSide::BID;
+
+    if (!m_SubscriberHandles.empty())
+    {
+        for (const auto& trade : m_Trades)
+        {
+            const auto subscriber = m_SubscriberHandles.find(trade.Maker);
+            if (subscriber == m_SubscriberHandles.end())
+                continue;
+
+            const auto oid = subscriber->second;
+            const auto remaining = m_Engine.GetRemaining(trade.Maker);
+            if (!remaining)
+            {
+                m_SubscriberOrders.erase(oid);
+                m_SubscriberHandles.erase(subscriber);
+            }
+
+            if (m_Listener)
+            {
+                m_Listener->OnFill(FillEvent{ oid, makerSide, trade.Price, trade.Volume, remaining.value_or(Quantity{}) });
+                m_Statistics.Fills++;
+            }
+        }
+    }
+
+    // The trades walk the levels from the best price outwards: each level consumed is delivered once
+    for (std::size_t i = 0; i < m_Trades.size(); i++)
+    {
+        if (i + 1 == m_Trades.size() || m_Trades[i + 1].Price != m_Trades[i].Price)
+            PublishLevel(makerSide, m_Trades[i].Price);
+    }
+}
+
+
+void OptimusBot::StreamingMarketSimulator::PublishLevel(OrderSide side, Price price)
+{
+    if (!m_Listener)
+        return;
+
+    // A level consumed by a taker which rests at its price has changed side: it is empty on the side of the makers
+    const auto best = side == OrderSide::BID ? m_Engine.GetBestBid() : m_Engine.GetBestAsk();
+    const bool onSide = best && (side == OrderSide::BID ? price <= best.value() : price >= best.value());
+    const auto volume = onSide ? m_Engine.GetVolumeAt(price) : Quantity{};
+    m_Listener->OnBookChange(LevelDelta{ side, volume > Quantity{} ? LevelAction::CHANGE : LevelAction::REMOVE, price, volume });
+    m_Statistics.BookChanges++;
+}
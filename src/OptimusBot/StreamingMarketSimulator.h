@@ -0,0 +1,144 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "DvfSimulator.h"
+#include "FastRandom.h"
+#include "MatchingEngine.h"
+#include "MatchingEngineSimulator.h"
+#include "PriceProcesses.h"
+#include "Scheduler.h"
+#include "SimulatorExtensions.h"
+
+namespace OptimusBot
+{
+    /// @brief Market backed by a MatchingEngine, like a MatchingEngineSimulator, which pushes its events to a subscriber as they happen:
+    /// the fills of the orders of the subscriber, partial ones included, their cancellations and the change of every price level touched
+    /// by the order flow. Each batch of flow is made of EventsPerSnapshot orders of the other participants, the mid following the price
+    /// process, the events of each order being delivered before the next one is generated. Once started, the flow runs on a thread of
+    /// its own, like a venue trading whether the bot looks or not. Otherwise it is generated on demand by GenerateFlow, e.g. by tests
+    /// and benchmarks, and by each GetOrderBook, so that a bot polling it through IDvfSimulator alone still sees the market move.
+    /// All the calls are thread-safe, the events being delivered under the lock of the simulator
+    class StreamingMarketSimulator final : public IDvfSimulator, public IBufferedOrderBookSource, public IMarketEventSource, public IOrderLookup
+    {
+    public:
+        /// @brief Counters of the events delivered
+        struct Statistics
+        {
+            std::uint64_t Batches{ 0 };
+            std::uint64_t Fills{ 0 };
+            std::uint64_t Cancels{ 0 };
+            std::uint64_t BookChanges{ 0 };
+        };
+
+        /// @param config Parameters of the simulated market, EventsPerSnapshot being the order flow generated per batch
+        /// @param priceProcess Process driving the mid price, advanced once per batch
+        StreamingMarketSimulator(const MatchingSimulatorConfig& config, std::unique_ptr<IPriceProcess>&& priceProcess);
+
+        /// @brief Stops the flow, if started
+        ~StreamingMarketSimulator() noexcept;
+
+        StreamingMarketSimulator(const StreamingMarketSimulator&) = delete;
+        StreamingMarketSimulator& operator=(const StreamingMarketSimulator&) = delete;
+
+        /// @brief Starts generating the order flow on a thread of its own, a batch every interval. Has no effect if already started
+        void Start(std::chrono::steady_clock::duration interval);
+
+        /// @brief Stops the flow started by Start, waiting for the batch being generated. The flow cannot be started again
+        void Stop() noexcept;
+
+        /// @brief Generates a batch of order flow, delivering its events as they occur
+        /// @return Number of events delivered
+        std::size_t GenerateFlow() noexcept;
+
+        /// @brief Returns the aggregated levels of the book, generating a batch of flow first unless the flow is started
+        OrderBook GetOrderBook() noexcept override;
+
+        /// @brief Same as GetOrderBook, reusing the capacity of the given book rather than allocating a new one
+        void GetOrderBook(OrderBook& orderBook) noexcept override;
+
+        std::optional<OrderID> PlaceOrder(double price, double amount) noexcept override;
+
+        bool CancelOrder(OrderID oid) noexcept override;
+
+        void Subscribe(IMarketEventListener* listener) noexcept override;
+
+        /// @brief Volume left of an order of the subscriber, std::nullopt once it is filled or cancelled
+        std::optional<Types::Quantity> GetRemaining(OrderID oid) const noexcept override;
+
+        /// @brief Counters of the events, the engine and the mid below are not thread-safe: they should not be read while the flow is started
+        const Statistics& GetStatistics() const noexcept
+        {
+            return m_Statistics;
+        }
+
+        const MatchingEngine& GetEngine() const noexcept
+        {
+            return m_Engine;
+        }
+
+        double GetMid() const noexcept
+        {
+            return m_Mid;
+        }
+
+    private:
+        struct RestingOrder
+        {
+            MatchingEngine::OrderHandle Handle;
+            Types::OrderSide Side;
+            Types::Price Price;
+        };
+
+        // Same as GenerateFlow, the lock being held
+        std::size_t GenerateFlowLocked() noexcept;
+
+        // Submits an order of the other participants, remembering it if it rests, and delivers its events
+        void SubmitBackground(Types::OrderSide side, double price, OrderType type);
+
+        void CancelBackground();
+
+        // Delivers the fills of the subscriber and the changes of the levels consumed by the trades of the last submission
+        void PublishTrades();
+
+        // Delivers the current volume of a level
+        void PublishLevel(Types::OrderSide side, Types::Price price);
+
+        std::size_t GetEventCount() const noexcept
+        {
+            return m_Statistics.Fills + m_Statistics.Cancels + m_Statistics.BookChanges;
+        }
+
+        const MatchingSimulatorConfig m_Config;
+        std::unique_ptr<IPriceProcess> m_PriceProcess;
+        FastRandom m_Random;
+        double m_Mid;
+
+        MatchingEngine m_Engine;
+        std::vector<MatchingEngine::Trade> m_Trades;
+
+        // Resting orders of the other participants, some of them possibly filled since, purged once they outnumber the live ones
+        std::vector<RestingOrder> m_Background;
+
+        std::unordered_map<OrderID, RestingOrder> m_SubscriberOrders;
+        std::unordered_map<MatchingEngine::OrderHandle, OrderID> m_SubscriberHandles;
+        OrderID m_NextOid{ 1 };
+
+        IMarketEventListener* m_Listener{ nullptr };
+        Statistics m_Statistics;
+
+        // Serializes the flow and the calls of the subscriber
+        mutable std::mutex m_Mutex;
+
+        // Timer of the flow once started, run by its own thread
+        Scheduler m_Flow;
+        std::thread m_FlowThread;
+        bool m_Started{ false };
+    };
+}
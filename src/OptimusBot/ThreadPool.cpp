@@ -0,0 +1,144 @@
+#include "pch.h"
+#include <exception>
+#include "Logger.h"
+#include "ThreadPool.h"
+
+
+namespace
+{
+    // Identifies the pool and worker the current thread belongs to, if any
+    thread_local const OptimusBot::ThreadPool* currentPool = nullptr;
+    thread_local std::size_t currentWorker = 0;
+}
+
+
+OptimusBot::ThreadPool::ThreadPool(std::size_t threadCount)
+{
+    threadCount = std::max<std::size_t>(threadCount, 1);
+
+    for (std::size_t i = 0; i < threadCount; i++)
+        m_Workers.push_back(std::make_unique<Worker>());
+
+    for (std::size_t i = 0; i < threadCount; i++)
+        m_Threads.emplace_back([this, i]() { Work(i); });
+}
+
+
+OptimusBot::ThreadPool::~ThreadPool() noexcept
+{
+    {
+        const std::lock_guard<std::mutex> lock{ m_WakeMutex };
+        m_Stopping = true;
+    }
+    m_WakeUp.notify_all();
+
+    for (auto& thread : m_Threads)
+        thread.join();
+}
+
+
+void OptimusBot::ThreadPool::Post(Task task)
+{
+    const auto index = currentPool == this ? currentWorker : m_NextWorker.fetch_add(1, std::memory_order_relaxed) % m_Workers.size();
+
+    m_Unfinished.fetch_add(1, std::memory_order_relaxed);
+    {
+        auto& worker = *m_Workers[index];
+        const std::lock_guard<std::mutex> lock{ worker.Mutex };
+        worker.Tasks.push_back(std::move(task));
+    }
+
+    // Taking the mutex orders the increment with the workers checking it before sleeping, so that none misses the task
+    m_Queued.fetch_add(1, std::memory_order_release);
+    {
+        const std::lock_guard<std::mutex> lock{ m_WakeMutex };
+    }
+    m_WakeUp.notify_one();
+}
+
+
+void OptimusBot::ThreadPool::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock{ m_WakeMutex };
+    m_Idle.wait(lock, [this]() { return m_Unfinished.load(std::memory_order_acquire) == 0; });
+}
+
+
+void OptimusBot::ThreadPool::Work(std::size_t index)
+{
+    currentPool = this;
+    currentWorker = index;
+
+    Task task;
+    while (true)
+    {
+        if (TryPop(index, task) || TrySteal(index, task))
+        {
+            m_Queued.fetch_sub(1, std::memory_order_relaxed);
+            Execute(task);
+            task = nullptr;
+
+            if (m_Unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                const std::lock_guard<std::mutex> lock{ m_WakeMutex };
+                m_Idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock{ m_WakeMutex };
+        m_WakeUp.wait(lock, [this]() { return m_Stopping || m_Queued.load(std::memory_order_acquire) > 0; });
+        if (m_Stopping && m_Queued.load(std::memory_order_acquire) == 0)
+            return;
+    }
+}
+
+
+bool OptimusBot::ThreadPool::TryPop(std::size_t index, Task& task)
+{
+    auto& worker = *m_Workers[index];
+    const std::lock_guard<std::mutex> lock{ worker.Mutex };
+    if (worker.Tasks.empty())
+        return false;
+
+    task = std::move(worker.Tasks.back());
+    worker.Tasks.pop_back();
+    return true;
+}
+
+
+bool OptimusBot::ThreadPool::TrySteal(std::size_t index, Task& task)
+{
+    for (std::size_t offset = 1; offset < m_Workers.size(); offset++)
+    {
+        auto& victim = *m_Workers[(index + offset) % m_Workers.size()];
+
+        // Skips a queue being used rather than waiting for it
+        std::unique_lock<std::mutex> lock{ victim.Mutex, std::try_to_lock };
+        if (!lock.owns_lock() || victim.Tasks.empty())
+            continue;
+
+        task = std::move(victim.Tasks.front());
+        victim.Tasks.pop_front();
+        return true;
+    }
+
+    return false;
+}
+
+
+void OptimusBot::ThreadPool::Execute(Task& task) noexcept
+{
+    try
+    {
+        task();
+    }
+    catch (const std::exception& exception)
+    {
+        Logging::Error("Task failed on the thread pool: {}", exception.what());
+    }
+    catch (...)
+    {
+        Logging::Error("Task failed on the thread pool with an unknown exception");
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace OptimusBot
+{
+    /// @brief Fixed set of worker threads, each owning a task queue. A worker runs the tasks of its own queue newest first
+    /// (tasks submitted from a task are likely to touch warm data) and steals the oldest tasks of the other queues when its own is empty.
+    /// Tasks submitted from outside the pool are spread over the queues in turn
+    class ThreadPool final
+    {
+    public:
+        using Task = std::function<void()>;
+
+        /// @param threadCount Number of workers, defaulting to the number of hardware threads
+        explicit ThreadPool(std::size_t threadCount = std::thread::hardware_concurrency());
+
+        /// @brief Runs the tasks still queued, then joins the workers
+        ~ThreadPool() noexcept;
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        std::size_t GetThreadCount() const noexcept
+        {
+            return m_Workers.size();
+        }
+
+        /// @brief Queues a task whose result is not needed. An exception escaping the task is logged and swallowed. Thread-safe
+        void Post(Task task);
+
+        /// @brief Queues a task, its result (or exception) being delivered through the returned future. Thread-safe
+        template <typename Function>
+        std::future<std::invoke_result_t<Function>> Submit(Function&& function)
+        {
+            // std::function requires a copyable callable, which std::packaged_task is not
+            auto task = std::make_shared<std::packaged_task<std::invoke_result_t<Function>()>>(std::forward<Function>(function));
+            auto future = task->get_future();
+            Post([task]() { (*task)(); });
+            return future;
+        }
+
+        /// @brief Blocks until every task queued has been executed, including the tasks they queued themselves
+        void WaitIdle();
+
+    private:
+        struct Worker
+        {
+            std::mutex Mutex;
+            std::deque<Task> Tasks;
+        };
+
+        void Work(std::size_t index);
+
+        bool TryPop(std::size_t index, Task& task);
+
+        bool TrySteal(std::size_t index, Task& task);
+
+        void Execute(Task& task) noexcept;
+
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+        std::vector<std::thread> m_Threads;
+        std::atomic<std::size_t> m_NextWorker{ 0 };
+
+        // Tasks queued, and queued or running, the workers sleeping while the former is 0
+        std::atomic<std::size_t> m_Queued{ 0 };
+        std::atomic<std::size_t> m_Unfinished{ 0 };
+
+        std::mutex m_WakeMutex;
+        std::condition_variable m_WakeUp;
+        std::condition_variable m_Idle;
+        bool m_Stopping{ false };
+    };
+}
@@ -0,0 +1,485 @@
+#include "pch.h"
+#include <array>
+#include <cmath>
+#include "TickFile.h"
+
+using namespace OptimusBot::TickFile;
+
+
+namespace
+{
+    constexpr std::uint32_t fileMagic = 0x4B54424F; // "OBTK"
+    constexpr std::uint32_t blockMagic = 0x4B4C4254; // "TBLK"
+    constexpr std::uint8_t version = 1;
+
+    constexpr std::size_t fileHeaderSize = 8;
+    constexpr std::size_t blockHeaderSize = 32;
+
+    constexpr std::array<std::uint32_t, 256> MakeCrcTable() noexcept
+    {
+        std::array<std::uint32_t, 256> table{};
+        for (std::uint32_t i = 0; i < 256; i++)
+        {
+            auto crc = i;
+            for (int bit = 0; bit < 8; bit++)
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+            table[i] = crc;
+        }
+        return table;
+    }
+
+    constexpr auto crcTable = MakeCrcTable();
+
+    // CRC-32 (IEEE), as used by zip/png
+    std::uint32_t Crc32(const std::uint8_t* data, std::size_t size) noexcept
+    {
+        auto crc = 0xFFFFFFFFu;
+        for (std::size_t i = 0; i < size; i++)
+            crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    std::uint64_t ZigZag(std::int64_t value) noexcept
+    {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    std::int64_t UnZigZag(std::uint64_t value) noexcept
+    {
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    template <typename T>
+    void PutLittleEndian(std::uint8_t* output, T value) noexcept
+    {
+        for (std::size_t i = 0; i < sizeof(T); i++)
+            output[i] = static_cast<std::uint8_t>(static_cast<std::uint64_t>(value) >> (8 * i));
+    }
+
+    template <typename T>
+    T GetLittleEndian(const std::uint8_t* input) noexcept
+    {
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < sizeof(T); i++)
+            value |= static_cast<std::uint64_t>(input[i]) << (8 * i);
+        return static_cast<T>(value);
+    }
+
+    double Scale(std::uint8_t decimals) noexcept
+    {
+        return std::pow(10.0, decimals);
+    }
+
+    std::int64_t ToFixed(double value, double scale) noexcept
+    {
+        return std::llround(value * scale);
+    }
+
+    std::int64_t Ticks(OptimusBot::IClock::TimePoint time) noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    }
+
+    OptimusBot::IClock::TimePoint FromTicks(std::int64_t ticks) noexcept
+    {
+        return OptimusBot::IClock::TimePoint{ std::chrono::duration_cast<OptimusBot::IClock::TimePoint::duration>(std::chrono::nanoseconds{ ticks }) };
+    }
+}
+
+
+OptimusBot::TickFile::TickWriter::TickWriter(const std::string& path, const WriterConfig& config)
+    : m_Config{ config }, m_PriceScale{ Scale(config.PriceDecimals) }, m_VolumeScale{ Scale(config.VolumeDecimals) },
+    m_File{ path, std::ios::binary | std::ios::trunc }
+{
+    m_Payload.reserve(m_Config.BlockSize + 1024);
+
+    std::uint8_t header[fileHeaderSize];
+    PutLittleEndian(header, fileMagic);
+    header[4] = version;
+    header[5] = m_Config.PriceDecimals;
+    header[6] = m_Config.VolumeDecimals;
+    header[7] = 0;
+    m_File.write(reinterpret_cast<const char*>(header), sizeof(header));
+}
+
+
+OptimusBot::TickFile::TickWriter::~TickWriter() noexcept
+{
+    Flush();
+}
+
+
+void OptimusBot::TickFile::TickWriter::WriteSnapshot(IClock::TimePoint time, const IDvfSimulator::OrderBook& orderBook)
+{
+    BeginEvent(EventType::SNAPSHOT, time);
+    WriteVarint(orderBook.size());
+
+    // Each level is encoded relatively to the same level of the previous snapshot, which changes little from one tick to the next.
+    // As a side of the book tends to shift as a whole, a price is predicted to move like the previous level of the snapshot did.
+    // Prices of levels without such a reference are encoded relatively to the previous level of the book
+    std::int64_t previousPrice = 0;
+    std::int64_t previousMove = 0;
+    for (std::size_t i = 0; i < orderBook.size(); i++)
+    {
+        const auto price = ToFixed(orderBook[i].first, m_PriceScale);
+        const auto volume = ToFixed(orderBook[i].second, m_VolumeScale);
+
+        if (i < m_PreviousLevels.size())
+        {
+            const auto move = price - m_PreviousLevels[i].first;
+            WriteSigned(move - previousMove);
+            WriteSigned(volume - m_PreviousLevels[i].second);
+            m_PreviousLevels[i] = { price, volume };
+            previousMove = move;
+        }
+        else
+        {
+            WriteSigned(price - previousPrice);
+            WriteSigned(volume);
+            m_PreviousLevels.emplace_back(price, volume);
+        }
+
+        previousPrice = price;
+    }
+    m_PreviousLevels.resize(orderBook.size());
+
+    m_SnapshotCount++;
+    EndEvent();
+}
+
+
+void OptimusBot::TickFile::TickWriter::WritePlaceOrder(IClock::TimePoint time, double price, double amount, std::optional<IDvfSimulator::OrderID> orderId)
+{
+    BeginEvent(EventType::PLACE_ORDER, time);
+    WriteSigned(ToFixed(price, m_PriceScale));
+    WriteSigned(ToFixed(amount, m_VolumeScale));
+    WriteVarint(orderId ? std::uint64_t{ orderId.value() } + 1 : 0);
+    EndEvent();
+}
+
+
+void OptimusBot::TickFile::TickWriter::WriteCancelOrder(IClock::TimePoint time, IDvfSimulator::OrderID orderId, bool success)
+{
+    BeginEvent(EventType::CANCEL_ORDER, time);
+    WriteVarint(orderId);
+    m_Payload.push_back(success ? 1 : 0);
+    EndEvent();
+}
+
+
+void OptimusBot::TickFile::TickWriter::WriteFill(IClock::TimePoint time, const Types::BotOrder& order)
+{
+    BeginEvent(EventType::FILL, time);
+    WriteVarint(order.OrderId);
+    WriteSigned(ToFixed(order.Price.ToDouble(), m_PriceScale));
+    WriteSigned(ToFixed(order.Side == Types::OrderSide::BID ? order.Volume.ToDouble() : -order.Volume.ToDouble(), m_VolumeScale));
+    EndEvent();
+}
+
+
+void OptimusBot::TickFile::TickWriter::Flush()
+{
+    if (m_EventCount == 0)
+        return;
+
+    std::uint8_t header[blockHeaderSize];
+    PutLittleEndian(header, blockMagic);
+    PutLittleEndian(header + 4, static_cast<std::uint32_t>(m_Payload.size()));
+    PutLittleEndian(header + 8, m_EventCount);
+    PutLittleEndian(header + 12, Crc32(m_Payload.data(), m_Payload.size()));
+    PutLittleEndian(header + 16, m_FirstTime);
+    PutLittleEndian(header + 24, m_LastTime);
+
+    m_File.write(reinterpret_cast<const char*>(header), sizeof(header));
+    m_File.write(reinterpret_cast<const char*>(m_Payload.data()), m_Payload.size());
+    m_File.flush();
+
+    // The next block starts with a keyframe
+    m_Payload.clear();
+    m_EventCount = 0;
+    m_SnapshotCount = 0;
+    m_PreviousLevels.clear();
+}
+
+
+void OptimusBot::TickFile::TickWriter::BeginEvent(EventType type, IClock::TimePoint time)
+{
+    const auto ticks = Ticks(time);
+    if (m_EventCount == 0)
+        m_FirstTime = m_LastTime = ticks;
+
+    m_Payload.push_back(static_cast<std::uint8_t>(type));
+    WriteSigned(ticks - m_LastTime);
+    m_LastTime = ticks;
+}
+
+
+void OptimusBot::TickFile::TickWriter::EndEvent()
+{
+    m_EventCount++;
+
+    if (m_Payload.size() >= m_Config.BlockSize || m_SnapshotCount >= m_Config.SnapshotsPerBlock)
+        Flush();
+}
+
+
+void OptimusBot::TickFile::TickWriter::WriteVarint(std::uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        m_Payload.push_back(static_cast<std::uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    m_Payload.push_back(static_cast<std::uint8_t>(value));
+}
+
+
+void OptimusBot::TickFile::TickWriter::WriteSigned(std::int64_t value)
+{
+    WriteVarint(ZigZag(value));
+}
+
+
+OptimusBot::TickFile::TickReader::TickReader(const std::string& path) noexcept
+    : m_File{ path }
+{
+    const auto data = m_File.Data();
+    const auto size = m_File.Size();
+
+    if (size < fileHeaderSize || GetLittleEndian<std::uint32_t>(data) != fileMagic || data[4] != version)
+        return;
+
+    m_Valid = true;
+    m_PriceScale = Scale(data[5]);
+    m_VolumeScale = Scale(data[6]);
+
+    // Index the blocks, stopping at a truncated tail (e.g. the writer was killed while writing it)
+    auto offset = fileHeaderSize;
+    while (size - offset >= blockHeaderSize)
+    {
+        const auto header = data + offset;
+        if (GetLittleEndian<std::uint32_t>(header) != blockMagic)
+            break;
+
+        const auto payloadSize = GetLittleEndian<std::uint32_t>(header + 4);
+        if (size - offset - blockHeaderSize < payloadSize)
+            break;
+
+        m_Blocks.push_back({ offset, payloadSize,
+            GetLittleEndian<std::uint32_t>(header + 8),
+            GetLittleEndian<std::uint32_t>(header + 12),
+            GetLittleEndian<std::int64_t>(header + 16),
+            GetLittleEndian<std::int64_t>(header + 24) });
+
+        offset += blockHeaderSize + payloadSize;
+    }
+
+    Rewind();
+}
+
+
+std::optional<std::pair<OptimusBot::IClock::TimePoint, OptimusBot::IClock::TimePoint>> OptimusBot::TickFile::TickReader::GetTimeRange() const noexcept
+{
+    if (m_Blocks.empty())
+        return {};
+
+    return std::make_pair(FromTicks(m_Blocks.front().FirstTime), FromTicks(m_Blocks.back().LastTime));
+}
+
+
+bool OptimusBot::TickFile::TickReader::Next(Event& event) noexcept
+{
+    if (m_HasPendingEvent)
+    {
+        event = m_PendingEvent;
+        m_HasPendingEvent = false;
+        return true;
+    }
+
+    while (m_RemainingEvents == 0)
+    {
+        if (m_Corrupted || m_NextBlock == m_Blocks.size() || !EnterBlock())
+            return false;
+    }
+
+    if (m_Position == m_End)
+    {
+        m_Corrupted = true;
+        return false;
+    }
+
+    const auto type = static_cast<EventType>(*m_Position++);
+
+    std::int64_t timeDelta;
+    if (!ReadSigned(timeDelta))
+        return false;
+
+    m_Time += timeDelta;
+    event.Type = type;
+    event.Time = FromTicks(m_Time);
+    event.OrderBook = nullptr;
+    event.OrderId.reset();
+
+    std::uint64_t unsignedValue;
+    std::int64_t price, amount;
+    switch (type)
+    {
+    case EventType::SNAPSHOT:
+    {
+        if (!ReadVarint(unsignedValue) || unsignedValue > static_cast<std::uint64_t>(m_End - m_Position))
+        {
+            m_Corrupted = true;
+            return false;
+        }
+
+        const auto size = static_cast<std::size_t>(unsignedValue);
+        const auto previousSize = m_Levels.size();
+        m_Levels.resize(size);
+
+        std::int64_t previousPrice = 0;
+        std::int64_t previousMove = 0;
+        for (std::size_t i = 0; i < size; i++)
+        {
+            if (!ReadSigned(price) || !ReadSigned(amount))
+                return false;
+
+            auto& level = m_Levels[i];
+            if (i < previousSize)
+            {
+                previousMove += price;
+                level = { level.first + previousMove, level.second + amount };
+            }
+            else
+                level = { previousPrice + price, amount };
+
+            previousPrice = level.first;
+        }
+
+        m_OrderBook.clear();
+        for (const auto& [fixedPrice, fixedVolume] : m_Levels)
+            m_OrderBook.emplace_back(fixedPrice / m_PriceScale, fixedVolume / m_VolumeScale);
+
+        event.OrderBook = &m_OrderBook;
+        break;
+    }
+    case EventType::PLACE_ORDER:
+        if (!ReadSigned(price) || !ReadSigned(amount) || !ReadVarint(unsignedValue))
+            return false;
+
+        event.Price = price / m_PriceScale;
+        event.Amount = amount / m_VolumeScale;
+        if (unsignedValue != 0)
+            event.OrderId = static_cast<IDvfSimulator::OrderID>(unsignedValue - 1);
+        break;
+
+    case EventType::CANCEL_ORDER:
+        if (!ReadVarint(unsignedValue) || m_Position == m_End)
+        {
+            m_Corrupted = true;
+            return false;
+        }
+
+        event.OrderId = static_cast<IDvfSimulator::OrderID>(unsignedValue);
+        event.Success = *m_Position++ != 0;
+        break;
+
+    case EventType::FILL:
+        if (!ReadVarint(unsignedValue) || !ReadSigned(price) || !ReadSigned(amount))
+            return false;
+
+        event.OrderId = static_cast<IDvfSimulator::OrderID>(unsignedValue);
+        event.Price = price / m_PriceScale;
+        event.Amount = amount / m_VolumeScale;
+        break;
+
+    default:
+        m_Corrupted = true;
+        return false;
+    }
+
+    m_RemainingEvents--;
+    return true;
+}
+
+
+void OptimusBot::TickFile::TickReader::Seek(IClock::TimePoint time) noexcept
+{
+    Rewind();
+
+    // Last block starting before that time, the events preceding it within the block being skipped
+    const auto ticks = Ticks(time);
+    const auto it = std::lower_bound(m_Blocks.begin(), m_Blocks.end(), ticks, [](const Block& block, std::int64_t value) { return block.FirstTime < value; });
+    if (it != m_Blocks.begin())
+        m_NextBlock = static_cast<std::size_t>(it - m_Blocks.begin()) - 1;
+
+    // The first event at or after that time is kept aside, to be returned by the next call to Next
+    Event event;
+    while (Next(event))
+    {
+        if (event.Time >= time)
+        {
+            m_PendingEvent = event;
+            m_HasPendingEvent = true;
+            return;
+        }
+    }
+}
+
+
+void OptimusBot::TickFile::TickReader::Rewind() noexcept
+{
+    m_NextBlock = 0;
+    m_Position = m_End = nullptr;
+    m_RemainingEvents = 0;
+    m_Corrupted = false;
+    m_HasPendingEvent = false;
+}
+
+
+bool OptimusBot::TickFile::TickReader::EnterBlock() noexcept
+{
+    const auto& block = m_Blocks[m_NextBlock++];
+    const auto payload = m_File.Data() + block.Offset + blockHeaderSize;
+
+    if (Crc32(payload, block.PayloadSize) != block.Checksum)
+    {
+        m_Corrupted = true;
+        return false;
+    }
+
+    // Blocks are self-contained: the first snapshot is a keyframe and times restart from the block's first time
+    m_Position = payload;
+    m_End = payload + block.PayloadSize;
+    m_RemainingEvents = block.EventCount;
+    m_Time = block.FirstTime;
+    m_Levels.clear();
+
+    return true;
+}
+
+
+bool OptimusBot::TickFile::TickReader::ReadVarint(std::uint64_t& value) noexcept
+{
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && m_Position != m_End; shift += 7)
+    {
+        const auto byte = *m_Position++;
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    m_Corrupted = true;
+    return false;
+}
+
+
+bool OptimusBot::TickFile::TickReader::ReadSigned(std::int64_t& value) noexcept
+{
+    std::uint64_t zigZag;
+    if (!ReadVarint(zigZag))
+        return false;
+
+    value = UnZigZag(zigZag);
+    return true;
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+#include "Clock.h"
+#include "DvfSimulator.h"
+#include "MappedFile.h"
+#include "Types.h"
+
+/// @brief Compact binary recording of the order books seen and the orders sent by the bot.
+/// A file is a header followed by self-contained blocks, each starting with a header holding its size, checksum and time range.
+/// The first snapshot of each block is a keyframe, the following ones being encoded relatively to the previous snapshot.
+/// Prices and volumes are stored as fixed-point integers (with the number of decimals given in the file header), as zigzag varints
+namespace OptimusBot::TickFile
+{
+    enum class EventType : std::uint8_t
+    {
+        SNAPSHOT,
+        PLACE_ORDER,
+        CANCEL_ORDER,
+        FILL
+    };
+
+    //Mutable object, overwritten by each event read
+    struct Event
+    {
+        EventType Type{ EventType::SNAPSHOT };
+        IClock::TimePoint Time;
+
+        // SNAPSHOT: book decoded in a buffer owned by the reader, valid until the next event is read
+        const IDvfSimulator::OrderBook* OrderBook{ nullptr };
+
+        // PLACE_ORDER, FILL: price and amount (+ve for a bid, -ve for an ask)
+        double Price{ 0.0 };
+        double Amount{ 0.0 };
+
+        // PLACE_ORDER: id returned, if placed. CANCEL_ORDER, FILL: id of the order
+        std::optional<IDvfSimulator::OrderID> OrderId;
+
+        // CANCEL_ORDER: whether the cancellation succeeded
+        bool Success{ false };
+    };
+
+    /// @brief Parameters of a TickWriter
+    struct WriterConfig
+    {
+        // Precision of the prices and volumes recorded, values being rounded to that many decimals
+        std::uint8_t PriceDecimals{ 6 };
+        std::uint8_t VolumeDecimals{ 8 };
+
+        // A block is written once it reaches either limit, the next snapshot being a keyframe
+        std::size_t BlockSize{ 64 * 1024 };
+        std::size_t SnapshotsPerBlock{ 1024 };
+    };
+
+    /// @brief Appends events to a new recording. Events are buffered until their block is complete: the events of an
+    /// incomplete block are lost if the process is killed
+    class TickWriter final
+    {
+    public:
+        /// @param path File to write, overwritten if it exists
+        explicit TickWriter(const std::string& path, const WriterConfig& config = WriterConfig{});
+
+        ~TickWriter() noexcept;
+
+        TickWriter(const TickWriter&) = delete;
+        TickWriter& operator=(const TickWriter&) = delete;
+
+        bool IsOpen() const noexcept
+        {
+            return m_File.is_open() && m_File.good();
+        }
+
+        void WriteSnapshot(IClock::TimePoint time, const IDvfSimulator::OrderBook& orderBook);
+
+        void WritePlaceOrder(IClock::TimePoint time, double price, double amount, std::optional<IDvfSimulator::OrderID> orderId);
+
+        void WriteCancelOrder(IClock::TimePoint time, IDvfSimulator::OrderID orderId, bool success);
+
+        void WriteFill(IClock::TimePoint time, const Types::BotOrder& order);
+
+        /// @brief Writes the current block, even if incomplete
+        void Flush();
+
+    private:
+        void BeginEvent(EventType type, IClock::TimePoint time);
+
+        void EndEvent();
+
+        void WriteVarint(std::uint64_t value);
+
+        void WriteSigned(std::int64_t value);
+
+        const WriterConfig m_Config;
+        const double m_PriceScale;
+        const double m_VolumeScale;
+
+        std::ofstream m_File;
+
+        // Block being built
+        std::vector<std::uint8_t> m_Payload;
+        std::uint32_t m_EventCount{ 0 };
+        std::size_t m_SnapshotCount{ 0 };
+        std::int64_t m_FirstTime{ 0 };
+        std::int64_t m_LastTime{ 0 };
+
+        // Previous snapshot of the block, as fixed-point (price, volume) pairs
+        std::vector<std::pair<std::int64_t, std::int64_t>> m_PreviousLevels;
+    };
+
+    /// @brief Reads a recording through a memory mapping, decoding the events straight from the mapped bytes.
+    /// Reading stops at the first truncated or corrupted block
+    class TickReader final
+    {
+    public:
+        /// @param path File to read. If it is not a valid recording, the reader is simply empty
+        explicit TickReader(const std::string& path) noexcept;
+
+        /// @brief Whether the file starts with a valid recording header
+        bool IsValid() const noexcept
+        {
+            return m_Valid;
+        }
+
+        std::size_t GetBlockCount() const noexcept
+        {
+            return m_Blocks.size();
+        }
+
+        /// @brief Time range covered by the recording, if not empty
+        std::optional<std::pair<IClock::TimePoint, IClock::TimePoint>> GetTimeRange() const noexcept;
+
+        /// @brief Reads the next event
+        /// @return False at the end of the recording, or on a corrupted block
+        bool Next(Event& event) noexcept;
+
+        /// @brief Positions the reader on the first event recorded at or after the given time, using the block index
+        void Seek(IClock::TimePoint time) noexcept;
+
+        /// @brief Positions the reader on the first event
+        void Rewind() noexcept;
+
+    private:
+        struct Block
+        {
+            std::size_t Offset;
+            std::uint32_t PayloadSize;
+            std::uint32_t EventCount;
+            std::uint32_t Checksum;
+            std::int64_t FirstTime;
+            std::int64_t LastTime;
+        };
+
+        /// @brief Verifies the checksum of the next block and positions the reader on its first event
+        bool EnterBlock() noexcept;
+
+        bool ReadVarint(std::uint64_t& value) noexcept;
+
+        bool ReadSigned(std::int64_t& value) noexcept;
+
+        MappedFile m_File;
+        bool m_Valid{ false };
+        double m_PriceScale{ 1.0 };
+        double m_VolumeScale{ 1.0 };
+        std::vector<Block> m_Blocks;
+
+        // Position of the reader
+        std::size_t m_NextBlock{ 0 };
+        const std::uint8_t* m_Position{ nullptr };
+        const std::uint8_t* m_End{ nullptr };
+        std::uint32_t m_RemainingEvents{ 0 };
+        std::int64_t m_Time{ 0 };
+        bool m_Corrupted{ false };
+
+        // Event read ahead by Seek
+        Event m_PendingEvent;
+        bool m_HasPendingEvent{ false };
+
+        // Last snapshot decoded, base of the next one
+        IDvfSimulator::OrderBook m_OrderBook;
+        std::vector<std::pair<std::int64_t, std::int64_t>> m_Levels;
+    };
+}
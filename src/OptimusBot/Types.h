@@ -1,11 +1,34 @@
 #pragma once
 
+#include <cstdint>
 #include <optional>
+#include "FixedPoint.h"
 
 /// @brief Grouping of type definitions for small/simple objects used throughout this application
 namespace OptimusBot::Types
 {
-	//Mutable object representing the ETH-USD currently hold
+	struct PriceTag {};
+	struct QuantityTag {};
+	struct NotionalTag {};
+
+	//Fixed-point amounts of the ETH/USD instrument: prices in cents of USD, quantities in 1e-8 ETH, and notionals (price x quantity) in units
+	//of both scales combined, so that the notional of an order is exact. They are converted from/to double at the boundary with the simulators
+	using Price = FixedPoint<PriceTag, 100>;
+	using Quantity = FixedPoint<QuantityTag, 100000000>;
+	using Notional = FixedPoint<NotionalTag, Price::Scale * Quantity::Scale>;
+
+	//Exact notional of a quantity traded at a price (up to about 9e8 USD)
+	constexpr Notional operator*(Price price, Quantity quantity) noexcept
+	{
+		return Notional::FromUnits(price.Units() * quantity.Units());
+	}
+
+	constexpr Notional operator*(Quantity quantity, Price price) noexcept
+	{
+		return price * quantity;
+	}
+
+	//Mutable object representing the ETH-USD currently hold, updated exactly by the fills however long the session
 	struct Wallet
 	{
 		Wallet() = default;
@@ -13,18 +36,29 @@ namespace OptimusBot::Types
 		Wallet (double eth, double usd) : ETH{ eth }, USD{ usd }
 		{}
 
-		double ETH;
-		double USD;
+		Quantity ETH;
+		Notional USD;
 	};
 
 	//Immutable object representing the current best bid/ask pair of the order book
 	struct BestOrder
 	{
-		BestOrder(double bid, double ask) : Bid{ bid }, Ask{ ask }
+		BestOrder(Types::Price bid, Types::Price ask) : Bid{ bid }, Ask{ ask }
 		{}
 
-		const double Bid;
-		const double Ask;
+		const Types::Price Bid;
+		const Types::Price Ask;
+	};
+
+	//Mutable object holding the parameters of the "prudent" strategy, defaulting to its original values
+	struct StrategyParameters
+	{
+		//Bids are priced between BidBand x best bid and the best bid, asks between the best ask and AskBand x best ask
+		double BidBand{ 0.95 };
+		double AskBand{ 1.05 };
+
+		//Share of the ETH hold that the orders of each side can cover in total
+		double Sizing{ 1.0 };
 	};
 
 	//Side of an order placed by the bot
@@ -34,17 +68,55 @@ namespace OptimusBot::Types
 		ASK
 	};
 
+	//Kind of change applied to a price level of the order book
+	enum class LevelAction
+	{
+		ADD,
+		CHANGE,
+		REMOVE
+	};
+
+	//Immutable object representing the change of a single price level of the order book
+	struct LevelDelta
+	{
+		LevelDelta(OrderSide side, LevelAction action, Types::Price price, Quantity volume)
+			: Side{ side }, Action{ action }, Price{ price }, Volume{ volume }
+		{}
+
+		const OrderSide Side;
+		const LevelAction Action;
+		const Types::Price Price;
+		const Quantity Volume; //Always positive, the total volume resting at that price after the change
+	};
+
+	//Immutable object representing an order to be submitted to the market
+	struct OrderRequest
+	{
+		OrderRequest(OrderSide side, Types::Price price, Quantity volume) : Side{ side }, Price{ price }, Volume{ volume }
+		{}
+
+		//Amount following the API conventions: +ve for a bid, -ve for an ask
+		double Amount() const noexcept
+		{
+			return Side == OrderSide::BID ? Volume.ToDouble() : -Volume.ToDouble();
+		}
+
+		const OrderSide Side;
+		const Types::Price Price;
+		const Quantity Volume;
+	};
+
 	//Immutable object representing an order placed by the bot
 	struct BotOrder
 	{
-		BotOrder(OrderSide side, IDvfSimulator::OrderID orderId, double price, double volume)
+		BotOrder(OrderSide side, IDvfSimulator::OrderID orderId, Types::Price price, Quantity volume)
 			: Side{side}, OrderId{orderId}, Price{price}, Volume{volume}
 		{}
 
 		const OrderSide Side;
 		const IDvfSimulator::OrderID OrderId;
-		const double Price;
-		const double Volume;
+		const Types::Price Price;
+		const Quantity Volume;
 
 		//Operator required to ensure BotOrders can be sorted in a set/map
 		bool operator < (const BotOrder& other) const noexcept
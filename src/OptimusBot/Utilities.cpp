@@ -1,81 +1,150 @@
 #include "pch.h"
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include "BestOrderKernels.h"
 #include "Utilities.h"
 
 using namespace OptimusBot::Types;
 
-double OptimusBot::Utilities::Random(double min, double max) noexcept
+namespace
 {
-	if (min < 0 || max - min < 1)
-		return 0.0;
-
-	const auto rnd = min + static_cast <double> (rand()) / (static_cast <double> (RAND_MAX / (max - min)));
+	// The prices and volumes are drawn with a single decimal point, like the ones placed by the original strategy
+	constexpr std::int64_t TenthsPerOne = 10;
 
-	return static_cast<double>(static_cast<int>(rnd * 10.)) / 10.;
-}
+	// Whole number of tenths within [min, max], picked by a uniform double within [0, 1).
+	// Zero if the range is negative or narrower than 1, like the original strategy
+	std::int64_t RandomTenths(double min, double max, double uniform) noexcept
+	{
+		if (min < 0 || max - min < 1)
+			return 0;
 
+		const auto first = static_cast<std::int64_t>(std::ceil(min * TenthsPerOne));
+		const auto last = static_cast<std::int64_t>(std::floor(max * TenthsPerOne));
 
-std::multiset<BotOrder> OptimusBot::Utilities::PlacePrudentOrders(const Wallet& wallet, const BestOrder& bestOrder, int numberOfOrders, const std::function<std::optional<IDvfSimulator::OrderID>(double, double)>& placeOrder) noexcept
-{
-	if (numberOfOrders < 1)
-		return {};
+		return first + static_cast<std::int64_t>(uniform * static_cast<double>(last - first + 1));
+	}
 
-	std::multiset<BotOrder> orders;
+	double UniformRand() noexcept
+	{
+		return static_cast<double>(rand()) / (static_cast<double>(RAND_MAX) + 1.0);
+	}
 
-	// This model the prudent approach, ensuring that the sum of all the orders
-	// does not exceed the current assets hold
-	const auto maxVolumePerOrder = wallet.ETH / numberOfOrders;
+	template <typename Value>
+	Value FromTenths(std::int64_t tenths) noexcept
+	{
+		static_assert(Value::Scale % TenthsPerOne == 0, "A tenth must be a whole number of units");
+		return Value::FromUnits(tenths * (Value::Scale / TenthsPerOne));
+	}
 
-	for (int i = 0; i < numberOfOrders; i++)
+	template <typename RandomFunction>
+	void MakeRequests(const Wallet& wallet, const BestOrder& bestOrder, int numberOfOrders, const StrategyParameters& parameters,
+		RandomFunction&& random, std::vector<OrderRequest>& requests) noexcept
 	{
-		{
-			const auto bidPrice = Random(0.95 * bestOrder.Bid, bestOrder.Bid);
-			const auto bidVolume = Random(0.1, maxVolumePerOrder);
-			const auto bidOrderId = placeOrder(bidPrice, bidVolume);
-			if (bidOrderId)
-				orders.emplace(OrderSide::BID, bidOrderId.value(), bidPrice, bidVolume);
-		}
+		requests.clear();
+
+		if (numberOfOrders < 1)
+			return;
+
+		requests.reserve(2 * static_cast<std::size_t>(numberOfOrders));
+
+		// This model the prudent approach, ensuring that the sum of all the orders
+		// does not exceed the current assets hold
+		const auto maxVolumePerOrder = parameters.Sizing * wallet.ETH.ToDouble() / numberOfOrders;
+		const auto bestBid = bestOrder.Bid.ToDouble();
+		const auto bestAsk = bestOrder.Ask.ToDouble();
 
+		for (int i = 0; i < numberOfOrders; i++)
 		{
-			const auto askPrice = Random(bestOrder.Ask, 1.05 * bestOrder.Ask);
-			const auto askVolume = Random(0.1, maxVolumePerOrder);
-			const auto askOrderId = placeOrder(askPrice, -askVolume);
-			if (askOrderId)
-				orders.emplace(OrderSide::ASK, askOrderId.value(), askPrice, askVolume);
+			{
+				const auto bidPrice = FromTenths<Price>(random(parameters.BidBand * bestBid, bestBid));
+				const auto bidVolume = FromTenths<Quantity>(random(0.1, maxVolumePerOrder));
+				requests.emplace_back(OrderSide::BID, bidPrice, bidVolume);
+			}
+
+			{
+				const auto askPrice = FromTenths<Price>(random(bestAsk, parameters.AskBand * bestAsk));
+				const auto askVolume = FromTenths<Quantity>(random(0.1, maxVolumePerOrder));
+				requests.emplace_back(OrderSide::ASK, askPrice, askVolume);
+			}
 		}
 	}
+}
+
+
+double OptimusBot::Utilities::Random(double min, double max) noexcept
+{
+	return static_cast<double>(RandomTenths(min, max, UniformRand())) / TenthsPerOne;
+}
+
+
+double OptimusBot::Utilities::Random(double min, double max, FastRandom& random) noexcept
+{
+	return static_cast<double>(RandomTenths(min, max, random.NextDouble())) / TenthsPerOne;
+}
+
 
-	return orders;
+void OptimusBot::Utilities::MakePrudentOrderRequests(const Wallet& wallet, const BestOrder& bestOrder, int numberOfOrders, std::vector<OrderRequest>& requests) noexcept
+{
+	const auto random = [](double min, double max) { return RandomTenths(min, max, UniformRand()); };
+	MakeRequests(wallet, bestOrder, numberOfOrders, StrategyParameters{}, random, requests);
+}
+
+
+void OptimusBot::Utilities::MakePrudentOrderRequests(const Wallet& wallet, const BestOrder& bestOrder, int numberOfOrders,
+	const StrategyParameters& parameters, FastRandom& random, std::vector<OrderRequest>& requests) noexcept
+{
+	const auto seededRandom = [&random](double min, double max) { return RandomTenths(min, max, random.NextDouble()); };
+	MakeRequests(wallet, bestOrder, numberOfOrders, parameters, seededRandom, requests);
 }
 
 
 std::optional<BestOrder> OptimusBot::Utilities::ExtractBestOrder(const IDvfSimulator::OrderBook& orderBook) noexcept
 {
-	auto sortedOrderBook = orderBook;
-	std::sort(sortedOrderBook.begin(), sortedOrderBook.end());
+	double bestBid, bestAsk;
+	BestOrderKernels::GetBestKernel()(orderBook.data(), orderBook.size(), bestBid, bestAsk);
 
-	const auto size = sortedOrderBook.size();
+	//failed to retrieve the best order, one side being empty
+	if (bestBid == -std::numeric_limits<double>::infinity() || bestAsk == std::numeric_limits<double>::infinity())
+		return {};
+
+	return BestOrder{ Price{ bestBid }, Price{ bestAsk } };
+}
+
+
+void OptimusBot::Utilities::ExtractBestOrders(const IDvfSimulator::OrderBook* orderBooks, std::size_t count, std::optional<BestOrder>* bestOrders) noexcept
+{
+	const auto kernel = BestOrderKernels::GetBestKernel();
 
-	for (auto i = 0; i < size - 1; i++)
-		if (sortedOrderBook[i].second > 0 && sortedOrderBook[i + 1].second < 0)
-			return BestOrder{ sortedOrderBook[i].first, sortedOrderBook[i + 1].first };
+	for (std::size_t i = 0; i < count; i++)
+	{
+		double bestBid, bestAsk;
+		kernel(orderBooks[i].data(), orderBooks[i].size(), bestBid, bestAsk);
 
-	//failed to retrieve the best order
-	return {};
+		if (bestBid == -std::numeric_limits<double>::infinity() || bestAsk == std::numeric_limits<double>::infinity())
+			bestOrders[i].reset();
+		else
+			bestOrders[i].emplace(Price{ bestBid }, Price{ bestAsk });
+	}
 }
 
 
-std::multiset<BotOrder> OptimusBot::Utilities::EraseFilledOrders(std::multiset<BotOrder>& orders, const BestOrder& bestOrder) noexcept
+std::vector<BotOrder> OptimusBot::Utilities::EraseFilledOrders(std::multiset<BotOrder>& orders, const BestOrder& bestOrder) noexcept
 {
-	std::multiset<BotOrder> filledOrders;
-	const auto copiedOrders = orders; //copy input to allow erasing orders while iterating
+	std::vector<BotOrder> filledOrders;
 
-	for (const auto& order : copiedOrders)
+	// Erasing by iterator rather than by value, which would erase all the orders sharing the same price
+	for (auto it = orders.begin(); it != orders.end();)
 	{
-		if (order.Side == OrderSide::BID && order.Price > bestOrder.Bid
-			|| order.Side == OrderSide::ASK && order.Price < bestOrder.Ask)
+		if ((it->Side == OrderSide::BID && it->Price > bestOrder.Bid)
+			|| (it->Side == OrderSide::ASK && it->Price < bestOrder.Ask))
+		{
+			filledOrders.push_back(*it);
+			it = orders.erase(it);
+		}
+		else
 		{
-			filledOrders.insert(order);
-			orders.erase(order);
+			++it;
 		}
 	}
 
@@ -83,19 +152,19 @@ std::multiset<BotOrder> OptimusBot::Utilities::EraseFilledOrders(std::multiset<B
 }
 
 
-void OptimusBot::Utilities::UpdateWallet(Wallet& wallet, std::multiset<BotOrder> filledOrders) noexcept
+void OptimusBot::Utilities::UpdateWallet(Wallet& wallet, const std::vector<BotOrder>& filledOrders) noexcept
 {
 	for (const auto& order : filledOrders)
 	{
 		if (order.Side == OrderSide::BID)
 		{
 			wallet.ETH += order.Volume;
-			wallet.USD -= order.Volume * order.Price;
+			wallet.USD -= order.Price * order.Volume;
 		}
 		else if (order.Side == OrderSide::ASK)
 		{
 			wallet.ETH -= order.Volume;
-			wallet.USD += order.Volume * order.Price;
+			wallet.USD += order.Price * order.Volume;
 		}
 	}
 }
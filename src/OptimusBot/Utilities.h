@@ -1,7 +1,12 @@
 #pragma once
 
-#include <functional>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <vector>
 #include "DvfSimulator.h"
+#include "FastRandom.h"
+#include "SimulatorExtensions.h"
 #include "Types.h"
 
 /// @brief Grouping of static utilities, implemented as pure functions if possible, used throughout this app
@@ -13,28 +18,104 @@ namespace OptimusBot::Utilities
 	/// @return A positive random number with a single decimal point
 	double Random(double min, double max) noexcept;
 
-	/// @brief Places bid/ask orders, by delegating the work to a lambda, using a "prudent" strategy, ensuring that we have enough assets to cover all orders
+	/// @brief Same as above, drawing from the given generator so that the sequence is reproducible (and thread-safe if the generator is not shared)
+	double Random(double min, double max, FastRandom& random) noexcept;
+
+	/// @brief Builds the bid/ask orders of the "prudent" strategy, ensuring that we have enough assets to cover all orders
+	/// @param wallet Assets currently hold
+	/// @param bestOrder Current best bid/ask pair
+	/// @param numberOfOrders Number of bid or ask orders. In total, twice that number is created, one bid and one ask per iteration
+	/// @param requests Output buffer, cleared then filled with the orders to place
+	void MakePrudentOrderRequests(const Types::Wallet& wallet, const Types::BestOrder& bestOrder, int numberOfOrders, std::vector<Types::OrderRequest>& requests) noexcept;
+
+	/// @brief Same as above, with tuned strategy parameters and a seeded generator, e.g. for reproducible backtests
+	/// @param parameters Price bands and sizing of the orders
+	/// @param random Generator drawing the prices and volumes
+	void MakePrudentOrderRequests(const Types::Wallet& wallet, const Types::BestOrder& bestOrder, int numberOfOrders,
+		const Types::StrategyParameters& parameters, FastRandom& random, std::vector<Types::OrderRequest>& requests) noexcept;
+
+	/// @brief Places the given orders through a gateway, see PlacePrudentOrders
+	/// @return The placed orders, in placement order
+	template <typename Gateway>
+	std::vector<Types::BotOrder> PlaceOrderRequests(const std::vector<Types::OrderRequest>& requests, Gateway&& gateway) noexcept
+	{
+		std::vector<std::optional<IDvfSimulator::OrderID>> orderIds(requests.size());
+
+		if constexpr (std::is_invocable_v<Gateway&, double, double>)
+		{
+			for (std::size_t i = 0; i < requests.size(); i++)
+				orderIds[i] = gateway(requests[i].Price.ToDouble(), requests[i].Amount());
+		}
+		else if constexpr (std::is_base_of_v<IDvfSimulator, std::decay_t<Gateway>>)
+		{
+			PlaceOrders(gateway, requests.data(), requests.size(), orderIds.data());
+		}
+		else
+		{
+			gateway.PlaceOrders(requests.data(), requests.size(), orderIds.data());
+		}
+
+		std::vector<Types::BotOrder> orders;
+		orders.reserve(requests.size());
+
+		for (std::size_t i = 0; i < requests.size(); i++)
+		{
+			if (orderIds[i])
+				orders.emplace_back(requests[i].Side, orderIds[i].value(), requests[i].Price, requests[i].Volume);
+		}
+
+		return orders;
+	}
+
+	/// @brief Places bid/ask orders, by delegating the work to a gateway, using a "prudent" strategy, ensuring that we have enough assets to cover all orders.
+	/// The gateway type is a template parameter, so that calls to it are resolved at compile time
 	/// @param wallet Assets currently hold
 	/// @param bestOrder Current best bid/ask pair
 	/// @param numberOfOrders Number of bid or ask orders. In total, twice that number can be created, one bid and one ask per iteration
-	/// @param placeOrder Lambda, delegating the responsability of calling the relevent API to place the order
-	/// @return A multiset of placed orders. If, for any reason, an order cannot be placed, it will not appear in the output.
-	std::multiset<Types::BotOrder> PlacePrudentOrders(const Types::Wallet& wallet, const Types::BestOrder& bestOrder, int numberOfOrders, const std::function<std::optional<IDvfSimulator::OrderID>(double, double)>& placeOrder) noexcept;
+	/// @param gateway Either a callable (double price, double amount) -> std::optional<OrderID> invoked once per order,
+	/// an IDvfSimulator (batched if it implements IBatchOrderPlacer), or any object providing a PlaceOrders batch method
+	/// @return The placed orders, in placement order. If, for any reason, an order cannot be placed, it will not appear in the output.
+	template <typename Gateway>
+	std::vector<Types::BotOrder> PlacePrudentOrders(const Types::Wallet& wallet, const Types::BestOrder& bestOrder, int numberOfOrders, Gateway&& gateway) noexcept
+	{
+		std::vector<Types::OrderRequest> requests;
+		MakePrudentOrderRequests(wallet, bestOrder, numberOfOrders, requests);
+
+		return PlaceOrderRequests(requests, std::forward<Gateway>(gateway));
+	}
 
-	/// @brief Extracts the best bid/ask pair from an order book
-	/// @param orderBook Order book, as returned by the market simulator
-	/// @return An optional best bid/ask pair
+	/// @brief Same as above, with tuned strategy parameters and a seeded generator, e.g. for reproducible backtests
+	template <typename Gateway>
+	std::vector<Types::BotOrder> PlacePrudentOrders(const Types::Wallet& wallet, const Types::BestOrder& bestOrder, int numberOfOrders,
+		const Types::StrategyParameters& parameters, FastRandom& random, Gateway&& gateway) noexcept
+	{
+		std::vector<Types::OrderRequest> requests;
+		MakePrudentOrderRequests(wallet, bestOrder, numberOfOrders, parameters, random, requests);
+
+		return PlaceOrderRequests(requests, std::forward<Gateway>(gateway));
+	}
+
+	/// @brief Extracts the best bid/ask pair (highest +ve volume price and lowest -ve volume price) from an order book, in a single vectorized pass
+	/// @param orderBook Order book, as returned by the market simulator, in any order
+	/// @return An optional best bid/ask pair, empty if either side of the book is empty
 	std::optional<Types::BestOrder> ExtractBestOrder(const IDvfSimulator::OrderBook& orderBook) noexcept;
 
-	/// @brief Erases the orders that have been filled. This is a non-pure function modifying the input orders
+	/// @brief Batched version of ExtractBestOrder, e.g. for backtests processing many snapshots at once
+	/// @param orderBooks First of the order books to process
+	/// @param count Number of order books
+	/// @param bestOrders Output array of at least count elements, receiving the best bid/ask pair of each order book
+	void ExtractBestOrders(const IDvfSimulator::OrderBook* orderBooks, std::size_t count, std::optional<Types::BestOrder>* bestOrders) noexcept;
+
+	/// @brief Erases the orders that have been filled. This is a non-pure function modifying the input orders.
+	/// Scans all the orders: the Bot relies on PendingOrders instead, whose cost only depends on the number of filled orders
 	/// @param orders Bot orders, passed by reference
 	/// @param bestOrder Pair of current best bis/ask
-	/// @return A multiset of the filled orders (i.e. the ones that have been removed from the input orders)
-	std::multiset<Types::BotOrder> EraseFilledOrders(std::multiset<Types::BotOrder>& orders, const Types::BestOrder& bestOrder) noexcept;
+	/// @return The filled orders (i.e. the ones that have been removed from the input orders), by ascending price
+	std::vector<Types::BotOrder> EraseFilledOrders(std::multiset<Types::BotOrder>& orders, const Types::BestOrder& bestOrder) noexcept;
 
 
 	/// @brief Updates the wallet to reflect the changes of the filled orders on the assets hold. This is a non-pure function modifying the wallet input
 	/// @param wallet Wallet to update
 	/// @param filledOrders Filled orders to process
-	void UpdateWallet(Types::Wallet& wallet, std::multiset<Types::BotOrder> filledOrders) noexcept;
+	void UpdateWallet(Types::Wallet& wallet, const std::vector<Types::BotOrder>& filledOrders) noexcept;
 }
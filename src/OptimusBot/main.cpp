@@ -1,25 +1,210 @@
 // OptimusBot.cpp : This file contains the 'main' function. Program execution begins and ends there.
 //
 #include "pch.h"
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <thread>
+#include "Backtester.h"
 #include "Bot.h"
+#include "BotRuntime.h"
+#include "Logger.h"
+#include "MarketDataPublisher.h"
+#include "MarketModelSimulator.h"
+#include "RecordingSimulator.h"
+#include "StrategyOptimizer.h"
+#include "StreamingMarketSimulator.h"
+
+// Deployment trading on the DeversiFi simulator only, with a bot compiled against it rather than against IDvfSimulator, if defined to 1
+#ifndef OPTIMUSBOT_DEVIRTUALIZED
+#define OPTIMUSBOT_DEVIRTUALIZED 0
+#endif
+
+#if OPTIMUSBOT_DEVIRTUALIZED
+#include "Bot.ipp"
+#endif
 
 using namespace OptimusBot;
 
-int main()
+namespace
 {
+#if OPTIMUSBOT_DEVIRTUALIZED
+    // Default session of a bot whose market, strategy and clock are known at compile time: no virtual call left on its tick path
+    int RunDevirtualized()
+    {
+        using DevirtualizedBot = BasicBot<DirectGateway<DvfSimulator>, PrudentStrategy, SteadyClock>;
+
+        std::unique_ptr<DvfSimulator> simulator{ static_cast<DvfSimulator*>(DvfSimulator::Create()) };
+        DevirtualizedBot bot{ std::move(simulator), 10.0, 2000.0 };
+        if (!bot.PlaceInitialOrders(5))
+        {
+            Logging::Error("Failed to place inital orders, closing the application...");
+            return 0;
+        }
+
+        bot.StartTradingSession();
+        return 1;
+    }
+#endif
+
+    // Replays a recorded file (binary recording, JSON payloads or text snapshots) if one is given, a generated day of 5-second ticks otherwise
+    int RunBacktest(const char* path)
+    {
+        constexpr auto ticksPerDay = std::size_t{ 24 * 60 * 60 / 5 };
+
+        std::unique_ptr<ISnapshotSource> source;
+        if (path && TickFile::TickReader{ path }.IsValid())
+            source = std::make_unique<TickFileSnapshotSource>(path);
+        else if (path && std::string_view{ path }.size() > 5 && std::string_view{ path }.substr(std::string_view{ path }.size() - 5) == ".json")
+            source = std::make_unique<JsonSnapshotSource>(path);
+        else if (path)
+            source = std::make_unique<TextSnapshotSource>(path);
+        else
+            source = std::make_unique<SimulatorSnapshotSource>(
+                std::make_unique<MarketModelSimulator>(MarketModelConfig{}, std::make_unique<RandomWalkProcess>(1.0, 1.0 / 3.0)),
+                ticksPerDay);
+
+        const auto report = Backtester::Run(std::move(source), Backtester::BacktestConfig{});
+        Backtester::PrintReport(std::cout, report);
+
+        return report.InitialOrdersPlaced ? 0 : 1;
+    }
+
+    // Trades with many bots until all their orders are filled, each on its own generated market or, if shared, all on the same one,
+    // whose book is polled once per refresh by a publisher the bots read from
+    int RunBots(int count, bool shared)
+    {
+        constexpr auto initialETH = 10.0;
+        constexpr auto initialUSD = 2000.0;
+
+        // The asset balances of every bot would flood the console
+        Logging::Logger::Instance().SetLevel(Logging::Level::WARNING);
+
+        const auto makeMarket = [](std::uint64_t seed) {
+            MarketModelConfig config;
+            config.Seed = seed;
+            return std::make_unique<MarketModelSimulator>(config, std::make_unique<RandomWalkProcess>(1.0, 1.0 / 3.0));
+        };
+
+        std::optional<MarketDataPublisher> publisher;
+        Scheduler feed;
+        if (shared)
+        {
+            publisher.emplace(makeMarket(0));
+            publisher->Publish();
+            feed.SchedulePeriodic(Bot::MarketRefreshInterval, [&publisher]() { publisher->Publish(); });
+        }
+
+        ThreadPool pool;
+        BotRuntime runtime{ pool };
+        for (int i = 0; i < count; i++)
+        {
+            SimulatorPtr market = shared ? SimulatorPtr{ std::make_unique<MarketDataSubscriber>(*publisher) } : SimulatorPtr{ makeMarket(static_cast<std::uint64_t>(i)) };
+            auto bot = std::make_unique<Bot>(std::move(market), initialETH, initialUSD);
+            if (bot->PlaceInitialOrders(5))
+                runtime.AddBot(std::move(bot));
+        }
+
+        std::thread feedThread;
+        if (shared)
+            feedThread = std::thread{ [&feed]() { feed.Run(); } };
+
+        Logging::Warning("Running {} bots on {} threads{}", runtime.GetBotCount(), pool.GetThreadCount(), shared ? ", sharing the same market" : "");
+        runtime.Run();
+        Logging::Warning("All sessions closed, {} failed", runtime.GetFailedSessionCount());
+
+        if (shared)
+        {
+            feed.Stop();
+            feedThread.join();
+        }
+
+        return 0;
+    }
+
+    // Sweeps a grid of strategy parameters, each candidate being backtested on the same generated days, and prints the best ones
+    int RunOptimizer(int argc, char* argv[])
+    {
+        Optimizer::OptimizerConfig config;
+        config.OrdersEachSide = { 2.0, 10.0, 2.0 };
+        config.BidBand = { 0.90, 0.99, 0.03 };
+        config.AskBand = { 1.01, 1.10, 0.03 };
+        config.Sizing = { 0.25, 1.0, 0.25 };
+
+        for (int i = 2; i < argc; i++)
+        {
+            if (!Optimizer::ParseArgument(argv[i], config))
+            {
+                Logging::Error("Invalid optimizer argument: {}", argv[i]);
+                return 1;
+            }
+        }
+
+        ThreadPool pool;
+        const auto report = Optimizer::Run(config, pool);
+        Optimizer::PrintReport(std::cout, report, 20);
+
+        return report.Ranking.empty() ? 1 : 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Usage: OptimusBot [backtest [snapshots file] | record <recording file> | journal <journal file> | stream | bots <count> [shared] | optimize [name=min:max:step ...]]
+    if (argc > 1 && std::strcmp(argv[1], "backtest") == 0)
+        return RunBacktest(argc > 2 ? argv[2] : nullptr);
+
+    if (argc > 2 && std::strcmp(argv[1], "bots") == 0)
+        return RunBots(std::atoi(argv[2]), argc > 3 && std::strcmp(argv[3], "shared") == 0);
+
+    if (argc > 1 && std::strcmp(argv[1], "optimize") == 0)
+        return RunOptimizer(argc, argv);
+
+#if OPTIMUSBOT_DEVIRTUALIZED
+    if (argc == 1)
+        return RunDevirtualized();
+#endif
+
+    // Create always instantiates a DvfSimulator, which is deleted as such
+    SimulatorPtr simulator{ static_cast<DvfSimulator*>(DvfSimulator::Create()), std::default_delete<DvfSimulator>{} };
+    RecordingSimulator* recorder = nullptr;
+    if (argc > 1 && std::strcmp(argv[1], "stream") == 0)
+    {
+        // Market trading on a thread of its own and pushing its fills and book changes, each event waking the bot up rather than waiting for the next 5-second poll
+        auto streamingSimulator = std::make_unique<StreamingMarketSimulator>(MatchingSimulatorConfig{}, std::make_unique<RandomWalkProcess>(0.05, 1.0 / 3.0));
+        streamingSimulator->Start(std::chrono::milliseconds{ 10 });
+        simulator = std::move(streamingSimulator);
+    }
+    else if (argc > 2 && std::strcmp(argv[1], "record") == 0)
+    {
+        auto recordingSimulator = std::make_unique<RecordingSimulator>(std::move(simulator), argv[2]);
+        recorder = recordingSimulator.get();
+        simulator = std::move(recordingSimulator);
+    }
+
     // Initial assets
     constexpr auto initialETH = 10.0;
     constexpr auto initialUSD = 2000.0;
 
     // Make the bot
-    Bot bot{ std::unique_ptr<IDvfSimulator>(DvfSimulator::Create()), initialETH,  initialUSD };
+    Bot bot{ std::move(simulator), initialETH,  initialUSD };
+    if (recorder)
+        bot.SetFillObserver([recorder](const Types::BotOrder& order) { recorder->RecordFill(order); });
 
-    // Place 5 bid and 5 ask initial orders
-    const auto initialOrderPlaced = bot.PlaceInitialOrders(5);
-    if (!initialOrderPlaced)
+    // Resume the wallet and the pending orders of the previous session, if any, reconciled with the market. The DvfSimulator cannot look
+    // them up: they are cancelled (a new simulator knowing none of them), new orders being placed below
+    if (argc > 2 && std::strcmp(argv[1], "journal") == 0)
+        bot.OpenJournal(argv[2]);
+
+    // Place 5 bid and 5 ask initial orders, unless orders were resumed
+    if (bot.GetPendingOrderCount() == 0)
     {
-        std::cout << "Failed to place inital orders, closing the application..." << std::endl;
-        return 0;
+        const auto initialOrderPlaced = bot.PlaceInitialOrders(5);
+        if (!initialOrderPlaced)
+        {
+            Logging::Error("Failed to place inital orders, closing the application...");
+            return 0;
+        }
     }
 
     // Start trading!
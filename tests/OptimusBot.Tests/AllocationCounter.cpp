@@ -0,0 +1,54 @@
+#include "pch.h"
+#include <cstdlib>
+#include <new>
+#include "AllocationCounter.h"
+
+// Kept in their own translation unit, so that the compiler does not inline the allocation functions below into their callers
+namespace
+{
+	thread_local bool t_Counting = false;
+	thread_local std::size_t t_Allocations = 0;
+}
+
+
+OptimusBot::Tests::AllocationCounter::AllocationCounter() noexcept
+{
+	t_Allocations = 0;
+	t_Counting = true;
+}
+
+
+OptimusBot::Tests::AllocationCounter::~AllocationCounter() noexcept
+{
+	t_Counting = false;
+}
+
+
+std::size_t OptimusBot::Tests::AllocationCounter::GetCount() const noexcept
+{
+	return t_Allocations;
+}
+
+
+// Replacements of the global allocation functions of the test executable, the other forms being implemented in terms of these by the standard library
+void* operator new(std::size_t size)
+{
+	if (t_Counting)
+		t_Allocations++;
+
+	if (const auto memory = std::malloc(size == 0 ? 1 : size))
+		return memory;
+	throw std::bad_alloc{};
+}
+
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+
+namespace OptimusBot::Tests
+{
+	/// @brief Counts the heap allocations made by the current thread during its lifetime, other threads (e.g. the logger's) being ignored.
+	/// Relies on the replacement of the global operator new by the test executable, see AllocationCounter.cpp
+	class AllocationCounter final
+	{
+	public:
+		AllocationCounter() noexcept;
+		~AllocationCounter() noexcept;
+
+		AllocationCounter(const AllocationCounter&) = delete;
+		AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+		std::size_t GetCount() const noexcept;
+	};
+}
@@ -0,0 +1,269 @@
+#include "pch.h"
+#include <atomic>
+#include <mutex>
+#include <set>
+#include "../../src/OptimusBot/AsyncOrderGateway.h"
+#include "../../src/OptimusBot/Bot.h"
+#include "../../src/OptimusBot/LatencySimulator.h"
+#include "../../src/OptimusBot/Logger.h"
+#include "../../src/OptimusBot/MarketModelSimulator.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+using namespace std::chrono_literals;
+
+namespace AsyncOrderGatewayTests
+{
+	constexpr auto roundTrip = 50ms;
+
+	// Venue accepting every order, keeping track of those resting
+	class VenueMock final : public IDvfSimulator
+	{
+	public:
+		explicit VenueMock(std::set<OrderID>& resting) : m_Resting{ resting }
+		{}
+
+		OrderBook GetOrderBook() noexcept override { return { { 100.0, 1.0 }, { 110.0, -1.0 } }; }
+
+		std::optional<OrderID> PlaceOrder(double, double) noexcept override
+		{
+			const std::lock_guard<std::mutex> lock{ m_Mutex };
+			m_Resting.insert(m_NextOid);
+			return m_NextOid++;
+		}
+
+		bool CancelOrder(OrderID oid) noexcept override
+		{
+			const std::lock_guard<std::mutex> lock{ m_Mutex };
+			return m_Resting.erase(oid) == 1;
+		}
+
+	private:
+		std::set<OrderID>& m_Resting;
+		std::mutex m_Mutex;
+		OrderID m_NextOid{ 1 };
+	};
+
+	// Simulator recording how many of its calls overlapped at most
+	class ConcurrencyProbe final : public IDvfSimulator
+	{
+	public:
+		explicit ConcurrencyProbe(std::atomic<int>& maxConcurrentCalls) : m_MaxConcurrentCalls{ maxConcurrentCalls }
+		{}
+
+		OrderBook GetOrderBook() noexcept override
+		{
+			Call();
+			return { { 100.0, 1.0 }, { 110.0, -1.0 } };
+		}
+
+		std::optional<OrderID> PlaceOrder(double, double) noexcept override
+		{
+			Call();
+			return m_NextOid.fetch_add(1);
+		}
+
+		bool CancelOrder(OrderID) noexcept override
+		{
+			Call();
+			return true;
+		}
+
+	private:
+		void Call() noexcept
+		{
+			const auto concurrentCalls = ++m_ConcurrentCalls;
+			auto maxConcurrentCalls = m_MaxConcurrentCalls.load();
+			while (maxConcurrentCalls < concurrentCalls && !m_MaxConcurrentCalls.compare_exchange_weak(maxConcurrentCalls, concurrentCalls))
+			{}
+			std::this_thread::sleep_for(1ms);
+			--m_ConcurrentCalls;
+		}
+
+		std::atomic<int>& m_MaxConcurrentCalls;
+		std::atomic<int> m_ConcurrentCalls{ 0 };
+		std::atomic<OrderID> m_NextOid{ 1 };
+	};
+
+	SimulatorPtr MakeVenue(std::set<IDvfSimulator::OrderID>& resting, std::chrono::steady_clock::duration latency)
+	{
+		return std::make_unique<LatencySimulator>(std::make_unique<VenueMock>(resting), latency);
+	}
+
+	TEST(AsyncOrderGateway, PlacesAndCancelsABatchInASingleRoundTrip)
+	{
+		// Arrange
+		std::set<IDvfSimulator::OrderID> resting;
+		AsyncGatewayConfig config;
+		config.MaxInFlight = 16;
+		AsyncOrderGateway gateway{ MakeVenue(resting, roundTrip), config };
+		std::vector<OrderRequest> requests;
+		for (int i = 0; i < 20; i++)
+			requests.emplace_back(i % 2 ? OrderSide::ASK : OrderSide::BID, Price{ 100.0 + i }, Quantity{ 1.0 });
+		std::vector<std::optional<IDvfSimulator::OrderID>> orderIds(requests.size());
+
+		// Act
+		auto start = std::chrono::steady_clock::now();
+		PlaceOrders(gateway, requests.data(), requests.size(), orderIds.data());
+		const auto placementDuration = std::chrono::steady_clock::now() - start;
+
+		std::vector<IDvfSimulator::OrderID> toCancel;
+		for (const auto& orderId : orderIds)
+		{
+			ASSERT_TRUE(orderId);
+			toCancel.push_back(orderId.value());
+		}
+		bool results[20];
+
+		start = std::chrono::steady_clock::now();
+		CancelOrders(gateway, toCancel.data(), toCancel.size(), results);
+		const auto cancellationDuration = std::chrono::steady_clock::now() - start;
+
+		// Assert: a few round trips at most, rather than the 20 of sequential calls
+		EXPECT_LT(placementDuration, 5 * roundTrip);
+		EXPECT_LT(cancellationDuration, 5 * roundTrip);
+		EXPECT_EQ(std::set<IDvfSimulator::OrderID>(toCancel.begin(), toCancel.end()).size(), 20u);
+		for (const auto result : results)
+			EXPECT_TRUE(result);
+		EXPECT_TRUE(resting.empty());
+		EXPECT_EQ(gateway.GetStatistics().Sent, 40u);
+	}
+
+	TEST(AsyncOrderGateway, TimedOutOrderFailsAndIsCancelledOnceAnswered)
+	{
+		// Arrange
+		std::set<IDvfSimulator::OrderID> resting;
+		AsyncGatewayConfig config;
+		config.Timeout = 20ms;
+		std::optional<IDvfSimulator::OrderID> orderId;
+
+		// Act
+		const auto start = std::chrono::steady_clock::now();
+		{
+			AsyncOrderGateway gateway{ MakeVenue(resting, 200ms), config };
+			orderId = gateway.PlaceOrder(100.0, 1.0);
+			EXPECT_LT(std::chrono::steady_clock::now() - start, 150ms);
+		}
+
+		// Assert: the gateway waited for the late answer before being destroyed
+		EXPECT_FALSE(orderId);
+		EXPECT_TRUE(resting.empty());
+	}
+
+	TEST(AsyncOrderGateway, ReportsTimeoutsAndOrphans)
+	{
+		// Arrange
+		std::set<IDvfSimulator::OrderID> resting;
+		AsyncGatewayConfig config;
+		config.Timeout = 20ms;
+		std::optional<IDvfSimulator::OrderID> orderId;
+		AsyncOrderGateway::Statistics statistics;
+
+		// Act
+		{
+			AsyncOrderGateway gateway{ MakeVenue(resting, 100ms), config };
+			orderId = gateway.PlaceOrder(100.0, 1.0);
+			std::this_thread::sleep_for(300ms);
+			statistics = gateway.GetStatistics();
+		}
+
+		// Assert
+		EXPECT_FALSE(orderId);
+		EXPECT_EQ(statistics.Sent, 1u);
+		EXPECT_EQ(statistics.TimedOut, 1u);
+		EXPECT_EQ(statistics.OrphansCancelled, 1u);
+		EXPECT_TRUE(resting.empty());
+	}
+
+	TEST(AsyncOrderGateway, ReportsCancellationsSucceedingAfterTheirTimeout)
+	{
+		// Arrange
+		std::set<IDvfSimulator::OrderID> resting{ 7 };
+		AsyncGatewayConfig config;
+		config.Timeout = 20ms;
+		bool cancelled = true;
+		AsyncOrderGateway::Statistics statistics;
+
+		// Act
+		{
+			AsyncOrderGateway gateway{ MakeVenue(resting, 100ms), config };
+			cancelled = gateway.CancelOrder(7);
+			std::this_thread::sleep_for(300ms);
+			statistics = gateway.GetStatistics();
+		}
+
+		// Assert: the order left the market although the cancellation was reported as failed
+		EXPECT_FALSE(cancelled);
+		EXPECT_EQ(statistics.TimedOut, 1u);
+		EXPECT_EQ(statistics.LateCancels, 1u);
+		EXPECT_TRUE(resting.empty());
+	}
+
+	TEST(AsyncOrderGateway, SubmittingBlocksWhileTooManyRequestsAreOutstanding)
+	{
+		// Arrange
+		std::set<IDvfSimulator::OrderID> resting;
+		AsyncGatewayConfig config;
+		config.MaxInFlight = 1;
+		config.MaxOutstanding = 2;
+		AsyncOrderGateway gateway{ MakeVenue(resting, 20ms), config };
+		std::vector<std::future<std::optional<IDvfSimulator::OrderID>>> responses;
+
+		// Act
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < 5; i++)
+			responses.push_back(gateway.PlaceOrderAsync(100.0, 1.0));
+		const auto submissionDuration = std::chrono::steady_clock::now() - start;
+
+		// Assert: the last submission waited for the first three requests to be answered
+		EXPECT_GE(submissionDuration, 60ms);
+		for (auto& response : responses)
+			EXPECT_TRUE(response.get());
+	}
+
+	TEST(AsyncOrderGateway, SingleRequestInFlightSerializesTheCallsToTheSimulator)
+	{
+		// Arrange: the default configuration, over a simulator not tolerating concurrent calls
+		std::atomic<int> maxConcurrentCalls{ 0 };
+		AsyncOrderGateway gateway{ std::make_unique<ConcurrencyProbe>(maxConcurrentCalls) };
+		std::vector<std::future<std::optional<IDvfSimulator::OrderID>>> responses;
+
+		// Act: the book is read while the orders are being placed
+		for (int i = 0; i < 20; i++)
+			responses.push_back(gateway.PlaceOrderAsync(100.0, 1.0));
+		for (int i = 0; i < 20; i++)
+			gateway.GetOrderBook();
+		for (auto& response : responses)
+			EXPECT_TRUE(response.get());
+
+		// Assert
+		EXPECT_EQ(maxConcurrentCalls.load(), 1);
+	}
+
+	TEST(AsyncOrderGateway, BotPlacesAndCancelsItsOrdersInBatches)
+	{
+		// Arrange: enough USD for the risk gate to let all the bids through
+		Logging::Logger::Instance().SetLevel(Logging::Level::OFF);
+		auto market = std::make_unique<MarketModelSimulator>(MarketModelConfig{}, std::make_unique<RandomWalkProcess>(0.0, 1.0));
+		AsyncGatewayConfig config;
+		config.MaxInFlight = 16;
+		Bot bot{ std::make_unique<AsyncOrderGateway>(std::make_unique<LatencySimulator>(std::move(market), roundTrip), config), 100.0, 200000.0 };
+
+		// Act
+		auto start = std::chrono::steady_clock::now();
+		ASSERT_TRUE(bot.PlaceInitialOrders(10));
+		const auto placementDuration = std::chrono::steady_clock::now() - start;
+		const auto placedOrders = bot.GetPendingOrderCount();
+
+		start = std::chrono::steady_clock::now();
+		bot.CloseSession();
+		const auto closingDuration = std::chrono::steady_clock::now() - start;
+		Logging::Logger::Instance().SetLevel(Logging::Level::INFO);
+
+		// Assert: one round trip for the book and one for the orders, rather than 20
+		EXPECT_EQ(placedOrders, 20u);
+		EXPECT_LT(placementDuration, 6 * roundTrip);
+		EXPECT_LT(closingDuration, 5 * roundTrip);
+		EXPECT_EQ(bot.GetPendingOrderCount(), 0u);
+	}
+}
@@ -0,0 +1,114 @@
+#include "pch.h"
+#include <cmath>
+#include "../../src/OptimusBot/Backtester.h"
+#include "../../src/OptimusBot/MarketModelSimulator.h"
+
+using namespace OptimusBot;
+using namespace std::chrono_literals;
+
+namespace BacktesterTests
+{
+	constexpr auto ticksPerDay = std::size_t{ 24 * 60 * 60 / 5 };
+
+	std::unique_ptr<ISnapshotSource> MakeSource(std::uint64_t seed, std::size_t ticks)
+	{
+		MarketModelConfig config;
+		config.Seed = seed;
+		return std::make_unique<SimulatorSnapshotSource>(
+			std::make_unique<MarketModelSimulator>(config, std::make_unique<RandomWalkProcess>(1.0, 1.0 / 3.0)), ticks);
+	}
+
+	TEST(Backtester, ReplaysADayOfTicksOnTheVirtualClock)
+	{
+		// Act
+		const auto report = Backtester::Run(MakeSource(7, ticksPerDay), Backtester::BacktestConfig{});
+
+		// Assert
+		const auto& statistics = report.Statistics;
+		ASSERT_TRUE(report.InitialOrdersPlaced);
+		EXPECT_GT(statistics.Snapshots, 1u);
+		EXPECT_LE(statistics.Snapshots, ticksPerDay);
+		// One market refresh per tick, the initial orders being placed on the first one at time 0
+		EXPECT_GE(report.VirtualDuration, (statistics.Snapshots - 1) * 5s);
+		EXPECT_LE(report.VirtualDuration, statistics.Snapshots * 5s);
+		EXPECT_LT(report.WallDuration, 10s);
+		EXPECT_EQ(statistics.OrdersPlaced, 10u);
+		EXPECT_EQ(statistics.OrdersPlaced, statistics.OrdersFilled + statistics.OrdersCancelled);
+	}
+
+	TEST(Backtester, WalletReflectsTheFills)
+	{
+		// Act
+		const auto report = Backtester::Run(MakeSource(3, ticksPerDay), Backtester::BacktestConfig{});
+
+		// Assert
+		const auto& statistics = report.Statistics;
+		EXPECT_NEAR(report.FinalWallet.ETH.ToDouble(), report.InitialWallet.ETH.ToDouble() + statistics.FilledBidVolume - statistics.FilledAskVolume, 1e-9);
+		EXPECT_NEAR(report.PnL - report.PnLVersusHolding,
+			(report.FinalMid - report.InitialMid) * report.InitialWallet.ETH.ToDouble(), 1e-6);
+	}
+
+	TEST(Backtester, SeededBacktestIsReproducible)
+	{
+		// Arrange
+		Backtester::BacktestConfig config;
+		config.StrategySeed = 11;
+		config.Strategy.BidBand = 0.98;
+		config.Strategy.AskBand = 1.02;
+
+		// Act
+		const auto report1 = Backtester::Run(MakeSource(5, ticksPerDay), config);
+		const auto report2 = Backtester::Run(MakeSource(5, ticksPerDay), config);
+
+		// Assert
+		ASSERT_TRUE(report1.InitialOrdersPlaced);
+		EXPECT_EQ(report1.PnL, report2.PnL);
+		EXPECT_EQ(report1.InventoryRisk, report2.InventoryRisk);
+		EXPECT_EQ(report1.Statistics.Snapshots, report2.Statistics.Snapshots);
+		EXPECT_EQ(report1.Statistics.OrdersFilled, report2.Statistics.OrdersFilled);
+		EXPECT_NEAR(report1.InventoryRisk, std::abs((report1.FinalWallet.ETH - report1.InitialWallet.ETH).ToDouble()) * report1.FinalMid, 1e-9);
+	}
+
+	TEST(Backtester, AbortsWithoutSnapshots)
+	{
+		// Act
+		const auto report = Backtester::Run(MakeSource(0, 0), Backtester::BacktestConfig{});
+
+		// Assert
+		EXPECT_FALSE(report.InitialOrdersPlaced);
+		EXPECT_EQ(report.Statistics.OrdersPlaced, 0u);
+	}
+
+	TEST(Backtester, RequotesUntilTheSnapshotsAreExhausted)
+	{
+		// Arrange
+		constexpr auto ticks = std::size_t{ 2000 };
+		Backtester::BacktestConfig config;
+		config.Requoting = RequoterConfig{};
+
+		// Act
+		const auto report = Backtester::Run(MakeSource(5, ticks), config);
+
+		// Assert
+		const auto& statistics = report.Statistics;
+		ASSERT_TRUE(report.InitialOrdersPlaced);
+		EXPECT_EQ(statistics.Snapshots, ticks);
+		EXPECT_GT(statistics.OrdersPlaced, 10u);
+		EXPECT_GT(statistics.OrdersCancelled, 0u);
+		EXPECT_EQ(statistics.OrdersPlaced, statistics.OrdersFilled + statistics.OrdersCancelled);
+	}
+
+	TEST(Backtester, OrdersGoThroughTheRiskGate)
+	{
+		// Arrange
+		Backtester::BacktestConfig config;
+		config.Risk.MaxOpenOrders = 4;
+
+		// Act
+		const auto report = Backtester::Run(MakeSource(7, ticksPerDay), config);
+
+		// Assert
+		ASSERT_TRUE(report.InitialOrdersPlaced);
+		EXPECT_EQ(report.Statistics.OrdersPlaced, 4u);
+	}
+}
@@ -0,0 +1,81 @@
+#include "pch.h"
+#include <limits>
+#include <random>
+#include <vector>
+#include "../../src/OptimusBot/BestOrderKernels.h"
+
+using namespace OptimusBot::BestOrderKernels;
+
+namespace BestOrderKernelsTests
+{
+	// Random book of the given size, including empty/zero volumes and crossed levels
+	std::vector<Level> MakeRandomBook(std::mt19937& generator, std::size_t size)
+	{
+		std::uniform_real_distribution<double> prices(1.0, 1000.0);
+		std::uniform_int_distribution<int> volumes(-4, 4);
+
+		std::vector<Level> book(size);
+		for (auto& level : book)
+			level = { prices(generator), 0.25 * volumes(generator) };
+
+		return book;
+	}
+
+	TEST(BestOrderKernels, ScalarKernelReturnsInfinitiesForEmptyBook)
+	{
+		// Arrange
+		double bestBid, bestAsk;
+
+		// Act
+		ScanScalar(nullptr, 0, bestBid, bestAsk);
+
+		// Assert
+		EXPECT_EQ(bestBid, -std::numeric_limits<double>::infinity());
+		EXPECT_EQ(bestAsk, std::numeric_limits<double>::infinity());
+	}
+
+	TEST(BestOrderKernels, VectorizedKernelsMatchScalarKernel)
+	{
+		std::mt19937 generator{ 42 };
+		std::vector<Kernel> kernels{ &ScanSse2 };
+		if (IsAvx2Supported())
+			kernels.push_back(&ScanAvx2);
+
+		// Sizes around the vector widths exercise the scalar tails
+		for (std::size_t size = 0; size < 40; size++)
+			for (int iteration = 0; iteration < 20; iteration++)
+			{
+				// Arrange
+				const auto book = MakeRandomBook(generator, size);
+				double expectedBid, expectedAsk;
+				ScanScalar(book.data(), book.size(), expectedBid, expectedAsk);
+
+				for (const auto kernel : kernels)
+				{
+					// Act
+					double bestBid, bestAsk;
+					kernel(book.data(), book.size(), bestBid, bestAsk);
+
+					// Assert
+					EXPECT_EQ(expectedBid, bestBid);
+					EXPECT_EQ(expectedAsk, bestAsk);
+				}
+			}
+	}
+
+	TEST(BestOrderKernels, BestKernelMatchesScalarKernelOnDeepBook)
+	{
+		// Arrange
+		std::mt19937 generator{ 7 };
+		const auto book = MakeRandomBook(generator, 100001);
+		double expectedBid, expectedAsk, bestBid, bestAsk;
+
+		// Act
+		ScanScalar(book.data(), book.size(), expectedBid, expectedAsk);
+		GetBestKernel()(book.data(), book.size(), bestBid, bestAsk);
+
+		// Assert
+		EXPECT_EQ(expectedBid, bestBid);
+		EXPECT_EQ(expectedAsk, bestAsk);
+	}
+}
@@ -0,0 +1,136 @@
+#include "pch.h"
+#include <cmath>
+#include "../../src/OptimusBot/BookAnalytics.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+
+namespace BookAnalyticsTests
+{
+	// Book of a single level each side, one unit of volume each
+	void SetTopOfBook(OrderBook& book, double bid, double ask)
+	{
+		book.Clear();
+		book.Apply(LevelDelta{ OrderSide::BID, LevelAction::ADD, Price{ bid }, Quantity{ 1.0 } });
+		book.Apply(LevelDelta{ OrderSide::ASK, LevelAction::ADD, Price{ ask }, Quantity{ 1.0 } });
+	}
+
+	TEST(BookAnalytics, ComputesTheFeaturesOfTheBook)
+	{
+		// Arrange
+		OrderBook book;
+		book.Apply(std::vector<LevelDelta>{
+			{ OrderSide::BID, LevelAction::ADD, Price{ 100.0 }, Quantity{ 1.0 } },
+			{ OrderSide::BID, LevelAction::ADD, Price{ 99.0 }, Quantity{ 3.0 } },
+			{ OrderSide::ASK, LevelAction::ADD, Price{ 101.0 }, Quantity{ 3.0 } },
+			{ OrderSide::ASK, LevelAction::ADD, Price{ 102.0 }, Quantity{ 2.0 } } });
+		BookAnalytics analytics;
+
+		// Act
+		const auto result = analytics.Update(book);
+
+		// Assert
+		ASSERT_TRUE(result);
+		const auto& features = analytics.GetFeatures();
+		EXPECT_EQ(features.Ticks, 1u);
+		EXPECT_DOUBLE_EQ(features.Mid, 100.5);
+		EXPECT_DOUBLE_EQ(features.Spread, 1.0);
+
+		// The heavier best ask pulls the microprice towards the bid
+		EXPECT_DOUBLE_EQ(features.Microprice, (100.0 * 3.0 + 101.0 * 1.0) / 4.0);
+		EXPECT_DOUBLE_EQ(features.BidDepth, 4.0);
+		EXPECT_DOUBLE_EQ(features.AskDepth, 5.0);
+		EXPECT_DOUBLE_EQ(features.Imbalance, -1.0 / 9.0);
+		EXPECT_DOUBLE_EQ(features.BookVwap, (100.0 + 297.0 + 303.0 + 204.0) / 9.0);
+		EXPECT_DOUBLE_EQ(features.RollingVwap, features.BookVwap);
+		EXPECT_DOUBLE_EQ(features.Volatility, 0.0);
+	}
+
+	TEST(BookAnalytics, AccumulatesTheBestLevelsOnly)
+	{
+		// Arrange
+		OrderBook book;
+		for (int level = 0; level < 20; level++)
+		{
+			book.Apply(LevelDelta{ OrderSide::BID, LevelAction::ADD, Price{ 100.0 - level }, Quantity{ 1.0 + level } });
+			book.Apply(LevelDelta{ OrderSide::ASK, LevelAction::ADD, Price{ 101.0 + level }, Quantity{ 1.0 } });
+		}
+
+		BookAnalyticsConfig config;
+		config.DepthLevels = 5;
+		BookAnalytics analytics{ config };
+
+		// Act
+		analytics.Update(book);
+
+		// Assert
+		const auto& features = analytics.GetFeatures();
+		EXPECT_DOUBLE_EQ(features.BidDepth, 1.0 + 2.0 + 3.0 + 4.0 + 5.0);
+		EXPECT_DOUBLE_EQ(features.AskDepth, 5.0);
+		EXPECT_DOUBLE_EQ(features.Imbalance, 10.0 / 20.0);
+	}
+
+	TEST(BookAnalytics, RollsTheWindowOverTheLastTicks)
+	{
+		// Arrange
+		OrderBook book;
+		BookAnalyticsConfig config;
+		config.Window = 2;
+		BookAnalytics analytics{ config };
+
+		// Act & Assert: two rises of 10% have no dispersion
+		SetTopOfBook(book, 99.0, 101.0);
+		analytics.Update(book);
+		SetTopOfBook(book, 109.0, 111.0);
+		analytics.Update(book);
+		SetTopOfBook(book, 120.0, 122.0);
+		analytics.Update(book);
+
+		// The first tick has left the window
+		EXPECT_DOUBLE_EQ(analytics.GetFeatures().RollingVwap, (110.0 + 121.0) / 2.0);
+		EXPECT_NEAR(analytics.GetFeatures().Volatility, 0.0, 1e-9);
+
+		// Act & Assert: a rise then a fall of the same size
+		SetTopOfBook(book, 109.0, 111.0);
+		analytics.Update(book);
+
+		EXPECT_EQ(analytics.GetFeatures().Ticks, 4u);
+		EXPECT_DOUBLE_EQ(analytics.GetFeatures().RollingVwap, (121.0 + 110.0) / 2.0);
+		EXPECT_NEAR(analytics.GetFeatures().Volatility, std::log(1.1), 1e-9);
+	}
+
+	TEST(BookAnalytics, FirstTickHasNoReturnInTheWindow)
+	{
+		// Arrange: a window holding the first tick
+		OrderBook book;
+		BookAnalyticsConfig config;
+		config.Window = 3;
+		BookAnalytics analytics{ config };
+
+		// Act: two rises of 10%
+		SetTopOfBook(book, 99.0, 101.0);
+		analytics.Update(book);
+		SetTopOfBook(book, 109.0, 111.0);
+		analytics.Update(book);
+		SetTopOfBook(book, 120.0, 122.0);
+		analytics.Update(book);
+
+		// Assert: the returns have no dispersion, the first tick not counting as a return of zero
+		EXPECT_NEAR(analytics.GetFeatures().Volatility, 0.0, 1e-9);
+	}
+
+	TEST(BookAnalytics, IgnoresAOneSidedBook)
+	{
+		// Arrange
+		OrderBook book;
+		book.Apply(LevelDelta{ OrderSide::BID, LevelAction::ADD, Price{ 100.0 }, Quantity{ 1.0 } });
+		BookAnalytics analytics;
+
+		// Act
+		const auto result = analytics.Update(book);
+
+		// Assert
+		EXPECT_FALSE(result);
+		EXPECT_EQ(analytics.GetFeatures().Ticks, 0u);
+	}
+}
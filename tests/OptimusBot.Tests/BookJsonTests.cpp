@@ -0,0 +1,109 @@
+#include "pch.h"
+#include <string>
+#include <string_view>
+#include "../../src/OptimusBot/BookJson.h"
+
+using namespace OptimusBot;
+
+namespace BookJsonTests
+{
+	TEST(BookJson, ParsesAPayload)
+	{
+		// Arrange
+		const std::string_view json = "[[205.5,1.25],[206,-0.5],[204.75,3e-1]]";
+		IDvfSimulator::OrderBook orderBook{ {1.0, 1.0} };
+
+		// Act
+		const auto parsed = BookJson::Parse(json, orderBook);
+
+		// Assert
+		EXPECT_TRUE(parsed);
+		EXPECT_EQ(orderBook, (IDvfSimulator::OrderBook{ {205.5, 1.25}, {206.0, -0.5}, {204.75, 0.3} }));
+	}
+
+	TEST(BookJson, ParsesPrettyPrintedPayloadsAndLevelsWithACount)
+	{
+		// Arrange
+		const std::string_view json = "\r\n[\r\n                    [ 205.5 , 3 , 1.25 ] ,\n\t[206, 1, -0.5]\n]\n";
+		const std::string_view empty = " [ ] ";
+		IDvfSimulator::OrderBook orderBook;
+		IDvfSimulator::OrderBook emptyBook{ {1.0, 1.0} };
+
+		// Act
+		const auto parsed = BookJson::Parse(json, orderBook);
+		const auto parsedEmpty = BookJson::Parse(empty, emptyBook);
+
+		// Assert
+		EXPECT_TRUE(parsed);
+		EXPECT_EQ(orderBook, (IDvfSimulator::OrderBook{ {205.5, 1.25}, {206.0, -0.5} }));
+		EXPECT_TRUE(parsedEmpty);
+		EXPECT_TRUE(emptyBook.empty());
+	}
+
+	TEST(BookJson, RejectsMalformedPayloads)
+	{
+		// Arrange
+		const std::string_view payloads[] = {
+			"", "[[205.5,1.25]", "[[205.5]]", "[[1,2,3,4]]", "[[205.5,1.25],]", "[205.5,1.25]",
+			"[[205.5,+1]]", "[[205.5,1..2]]", "[[205.5,1.25]] x", "{\"bids\":[]}",
+			"[[nan,1]]", "[[205.5,inf]]", "[[205.5,-infinity]]", "[[1e400,1]]" };
+		IDvfSimulator::OrderBook orderBook;
+
+		// Act & Assert
+		for (const auto payload : payloads)
+			EXPECT_FALSE(BookJson::Parse(payload, orderBook)) << payload;
+	}
+
+	TEST(BookJson, StreamsPayloadsCutAnywhere)
+	{
+		// Arrange
+		const IDvfSimulator::OrderBook book{ {205.123456789, 1.5}, {1e-8, -123456.75}, {206.0, -0.25} };
+		std::string json;
+		BookJson::Write(book, json);
+		const auto payloads = json + " " + json;
+
+		// Act & Assert: every chunk size, down to a character at a time
+		for (std::size_t chunkSize = 1; chunkSize <= payloads.size(); chunkSize++)
+		{
+			BookJson::StreamingParser parser;
+			IDvfSimulator::OrderBook orderBook;
+			int completed = 0;
+			for (std::size_t offset = 0; offset < payloads.size(); offset += chunkSize)
+			{
+				std::string_view chunk{ payloads.data() + offset, std::min(chunkSize, payloads.size() - offset) };
+				while (!chunk.empty())
+				{
+					const auto status = parser.Feed(chunk, orderBook);
+					ASSERT_NE(status, BookJson::ParseStatus::MALFORMED);
+					if (status == BookJson::ParseStatus::COMPLETE)
+					{
+						EXPECT_EQ(orderBook, book) << chunkSize;
+						completed++;
+					}
+				}
+			}
+			EXPECT_EQ(completed, 2) << chunkSize;
+		}
+	}
+
+	TEST(BookJson, MalformedStreamsAreResetToRecover)
+	{
+		// Arrange
+		BookJson::StreamingParser parser;
+		IDvfSimulator::OrderBook orderBook;
+		std::string_view garbage = "[[1,x";
+		std::string_view payload = "[[1,2]]";
+
+		// Act
+		const auto malformed = parser.Feed(garbage, orderBook);
+		const auto stillMalformed = parser.Feed(payload, orderBook);
+		parser.Reset();
+		const auto recovered = parser.Feed(payload, orderBook);
+
+		// Assert
+		EXPECT_EQ(malformed, BookJson::ParseStatus::MALFORMED);
+		EXPECT_EQ(stillMalformed, BookJson::ParseStatus::MALFORMED);
+		EXPECT_EQ(recovered, BookJson::ParseStatus::COMPLETE);
+		EXPECT_EQ(orderBook, (IDvfSimulator::OrderBook{ {1.0, 2.0} }));
+	}
+}
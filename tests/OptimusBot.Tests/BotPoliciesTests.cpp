@@ -0,0 +1,132 @@
+#include "pch.h"
+#include "../../src/OptimusBot/Bot.ipp"
+#include "../../src/OptimusBot/MarketModelSimulator.h"
+#include "../../src/OptimusBot/StreamingMarketSimulator.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+
+namespace BotPoliciesTests
+{
+	// Parameters fixed at compile time. The bots below are given enough assets for the strategy to place orders of at least 1 ETH
+	struct Tuned
+	{
+		static constexpr StrategyParameters Value{ 0.97, 1.03, 0.5 };
+	};
+
+	// Strategy bidding a single ETH below the best bid, whatever its parameters
+	class SingleBidStrategy final
+	{
+	public:
+		void MakeOrderRequests(const Wallet&, const BestOrder& bestOrder, int, std::vector<OrderRequest>& requests) noexcept
+		{
+			requests.clear();
+			requests.emplace_back(OrderSide::BID, Price{ bestOrder.Bid.ToDouble() - 1.0 }, Quantity{ 1.0 });
+		}
+
+		void MakeOrderRequests(const Wallet& wallet, const BestOrder& bestOrder, int numberOfOrdersEachSide, const StrategyParameters&,
+			FastRandom&, std::vector<OrderRequest>& requests) noexcept
+		{
+			MakeOrderRequests(wallet, bestOrder, numberOfOrdersEachSide, requests);
+		}
+	};
+
+	std::unique_ptr<MarketModelSimulator> MakeMarketModel(std::uint64_t seed)
+	{
+		MarketModelConfig config;
+		config.Seed = seed;
+		return std::make_unique<MarketModelSimulator>(config, std::make_unique<RandomWalkProcess>(5.0, 1.0 / 3.0));
+	}
+
+	std::unique_ptr<StreamingMarketSimulator> MakeStreaming(std::uint64_t seed)
+	{
+		MatchingSimulatorConfig config;
+		config.Seed = seed;
+		return std::make_unique<StreamingMarketSimulator>(config, std::make_unique<RandomWalkProcess>(1.0, 0.5));
+	}
+
+	void ExpectSameState(const Bot& expected, std::size_t pendingOrders, const Wallet& wallet, const RiskGate& riskGate)
+	{
+		EXPECT_EQ(pendingOrders, expected.GetPendingOrderCount());
+		EXPECT_EQ(wallet.ETH, expected.GetWallet().ETH);
+		EXPECT_EQ(wallet.USD, expected.GetWallet().USD);
+		EXPECT_EQ(riskGate.GetCommittedETH(), expected.GetRiskGate().GetCommittedETH());
+		EXPECT_EQ(riskGate.GetCommittedUSD(), expected.GetRiskGate().GetCommittedUSD());
+	}
+
+	TEST(BotPolicies, TunedStrategyPlacesTheOrdersOfItsParameters)
+	{
+		// Arrange
+		Bot expected{ MakeMarketModel(3), 100.0, 20000.0 };
+		BasicBot<SimulatorGateway, TunedPrudentStrategy<Tuned, 42>, IClock> bot{ SimulatorPtr{ MakeMarketModel(3) }, 100.0, 20000.0 };
+
+		// Act
+		ASSERT_TRUE(expected.PlaceInitialOrders(5, Tuned::Value, 42));
+		ASSERT_TRUE(bot.PlaceInitialOrders(5));
+
+		// Assert
+		EXPECT_EQ(bot.GetPendingOrderCount(), 10u);
+		ExpectSameState(expected, bot.GetPendingOrderCount(), bot.GetWallet(), bot.GetRiskGate());
+	}
+
+	TEST(BotPolicies, DirectGatewayTradesLikeTheVirtualOne)
+	{
+		// Arrange
+		Bot expected{ MakeMarketModel(5), 100.0, 20000.0 };
+		BasicBot<DirectGateway<MarketModelSimulator>, PrudentStrategy, IClock> bot{ MakeMarketModel(5), 100.0, 20000.0 };
+		ASSERT_TRUE(expected.PlaceInitialOrders(5, Tuned::Value, 7));
+		ASSERT_TRUE(bot.PlaceInitialOrders(5, Tuned::Value, 7));
+		ASSERT_EQ(bot.GetPendingOrderCount(), 10u);
+
+		// Act
+		for (int tick = 0; tick < 200; tick++)
+		{
+			expected.RefreshMarket();
+			bot.RefreshMarket();
+		}
+
+		// Assert: some orders were filled, the same ones
+		EXPECT_LT(bot.GetPendingOrderCount(), 10u);
+		ExpectSameState(expected, bot.GetPendingOrderCount(), bot.GetWallet(), bot.GetRiskGate());
+	}
+
+	TEST(BotPolicies, DirectGatewaySubscribesToThePushedEvents)
+	{
+		// Arrange: the markets trade on demand, each refresh processing the events of a batch of flow
+		auto expectedSimulator = MakeStreaming(11);
+		auto simulator = MakeStreaming(11);
+		auto& expectedMarket = *expectedSimulator;
+		auto& market = *simulator;
+		Bot expected{ std::move(expectedSimulator), 100.0, 20000.0 };
+		BasicBot<DirectGateway<StreamingMarketSimulator>, PrudentStrategy, IClock> bot{ std::move(simulator), 100.0, 20000.0 };
+		ASSERT_TRUE(expected.PlaceInitialOrders(2, Tuned::Value, 13));
+		ASSERT_TRUE(bot.PlaceInitialOrders(2, Tuned::Value, 13));
+		const auto placed = bot.GetPendingOrderCount();
+
+		// Act
+		for (int tick = 0; tick < 500 && bot.GetPendingOrderCount() == placed; tick++)
+		{
+			expectedMarket.GenerateFlow();
+			market.GenerateFlow();
+			expected.RefreshMarket();
+			bot.RefreshMarket();
+		}
+
+		// Assert
+		EXPECT_NE(bot.GetWallet().ETH, Quantity{ 100.0 });
+		ExpectSameState(expected, bot.GetPendingOrderCount(), bot.GetWallet(), bot.GetRiskGate());
+	}
+
+	TEST(BotPolicies, SeededOrdersAreMadeByTheStrategy)
+	{
+		// Arrange
+		BasicBot<SimulatorGateway, SingleBidStrategy, IClock> bot{ SimulatorPtr{ MakeMarketModel(3) }, 100.0, 20000.0 };
+
+		// Act
+		ASSERT_TRUE(bot.PlaceInitialOrders(5, Tuned::Value, 42));
+
+		// Assert
+		EXPECT_EQ(bot.GetPendingOrderCount(), 1u);
+		EXPECT_EQ(bot.GetRiskGate().GetCommittedETH(), Quantity{});
+	}
+}
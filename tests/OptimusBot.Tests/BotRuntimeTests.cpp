@@ -0,0 +1,100 @@
+#include "pch.h"
+#include <stdexcept>
+#include <thread>
+#include "../../src/OptimusBot/BotRuntime.h"
+#include "../../src/OptimusBot/Logger.h"
+#include "../../src/OptimusBot/MarketModelSimulator.h"
+#include "../../src/OptimusBot/ReplaySimulator.h"
+
+using namespace OptimusBot;
+using namespace std::chrono_literals;
+
+namespace BotRuntimeTests
+{
+	// Bot replaying a generated market, its session ending once the market is exhausted at the latest
+	std::unique_ptr<Bot> MakeBot(std::uint64_t seed, double maxStep, std::size_t ticks, IClock& clock)
+	{
+		MarketModelConfig config;
+		config.Seed = seed;
+		auto source = std::make_unique<SimulatorSnapshotSource>(
+			std::make_unique<MarketModelSimulator>(config, std::make_unique<RandomWalkProcess>(maxStep, 1.0 / 3.0)), ticks);
+
+		auto bot = std::make_unique<Bot>(std::make_unique<ReplaySimulator>(std::move(source)), 10.0, 2000.0, clock);
+		bot->PlaceInitialOrders(5);
+		return bot;
+	}
+
+	class BotRuntimeTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			Logging::Logger::Instance().SetLevel(Logging::Level::OFF);
+		}
+
+		void TearDown() override
+		{
+			Logging::Logger::Instance().SetLevel(Logging::Level::INFO);
+		}
+	};
+
+	TEST_F(BotRuntimeTest, RunsAllSessionsUntilClosed)
+	{
+		// Arrange
+		VirtualClock clock;
+		ThreadPool pool{ 4 };
+		BotRuntime runtime{ pool, clock };
+		for (std::uint64_t i = 0; i < 100; i++)
+			runtime.AddBot(MakeBot(i, 1.0, 100, clock));
+
+		// Act
+		runtime.Run();
+
+		// Assert
+		EXPECT_EQ(runtime.GetBotCount(), 100u);
+		EXPECT_EQ(runtime.GetOpenSessionCount(), 0u);
+		EXPECT_EQ(runtime.GetFailedSessionCount(), 0u);
+		for (BotRuntime::BotId id = 0; id < runtime.GetBotCount(); id++)
+			EXPECT_EQ(runtime.GetBot(id).GetPendingOrderCount(), 0u);
+	}
+
+	TEST_F(BotRuntimeTest, FailingBotIsClosedWithoutAffectingTheOthers)
+	{
+		// Arrange (the markets move fast enough for the orders to be filled)
+		VirtualClock clock;
+		ThreadPool pool{ 4 };
+		BotRuntime runtime{ pool, clock };
+		auto failingBot = MakeBot(0, 20.0, 1000, clock);
+		failingBot->SetFillObserver([](const Types::BotOrder&) { throw std::runtime_error{ "observer failure" }; });
+		runtime.AddBot(std::move(failingBot));
+		for (std::uint64_t i = 1; i < 10; i++)
+			runtime.AddBot(MakeBot(i, 20.0, 1000, clock));
+
+		// Act
+		runtime.Run();
+
+		// Assert
+		EXPECT_EQ(runtime.GetOpenSessionCount(), 0u);
+		EXPECT_EQ(runtime.GetFailedSessionCount(), 1u);
+		EXPECT_EQ(runtime.GetBot(0).GetPendingOrderCount(), 0u);
+	}
+
+	TEST_F(BotRuntimeTest, StopClosesAllSessionsCancellingTheirOrders)
+	{
+		// Arrange (flat markets, in which the orders are never filled)
+		ThreadPool pool{ 4 };
+		BotRuntime runtime{ pool };
+		for (std::uint64_t i = 0; i < 50; i++)
+			runtime.AddBot(MakeBot(i, 0.0, 1000000, SteadyClock::Instance()), 1ms);
+		std::thread stopper{ [&runtime]() { std::this_thread::sleep_for(50ms); runtime.Stop(); } };
+
+		// Act
+		runtime.Run();
+		stopper.join();
+
+		// Assert
+		EXPECT_EQ(runtime.GetOpenSessionCount(), 0u);
+		for (BotRuntime::BotId id = 0; id < runtime.GetBotCount(); id++)
+			EXPECT_EQ(runtime.GetBot(id).GetPendingOrderCount(), 0u);
+	}
+}
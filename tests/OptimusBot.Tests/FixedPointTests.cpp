@@ -0,0 +1,82 @@
+#include "pch.h"
+#include <sstream>
+#include "../../src/OptimusBot/Utilities.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+
+namespace FixedPointTests
+{
+	TEST(FixedPoint, RoundsDoublesToTheNearestUnit)
+	{
+		// Arrange, Act & Assert
+		EXPECT_EQ(Price{ 199.994 }.Units(), 19999);
+		EXPECT_EQ(Price{ 199.996 }.Units(), 20000);
+		EXPECT_EQ(Price{ -0.015 }.Units(), -2);
+		EXPECT_EQ(Quantity{ 0.1 }.Units(), 10000000);
+		EXPECT_EQ(Price{ 0.1 } + Price{ 0.2 }, Price{ 0.3 });
+		EXPECT_DOUBLE_EQ(Quantity{ 1.23456789 }.ToDouble(), 1.23456789);
+	}
+
+	TEST(FixedPoint, ComparesAndComputesExactly)
+	{
+		// Arrange
+		const Price bid{ 199.99 };
+		const Price ask{ 200.01 };
+
+		// Act
+		const auto spread = ask - bid;
+
+		// Assert
+		EXPECT_EQ(spread, Price::FromUnits(2));
+		EXPECT_LT(bid, ask);
+		EXPECT_EQ(-spread + spread, Price{});
+		EXPECT_EQ(spread * 50, Price{ 1.0 });
+	}
+
+	TEST(FixedPoint, PriceTimesQuantityIsAnExactNotional)
+	{
+		// Arrange
+		const Price price{ 1999.99 };
+		const Quantity volume{ 0.12345678 };
+
+		// Act
+		const auto notional = price * volume;
+
+		// Assert
+		EXPECT_EQ(notional.Units(), std::int64_t{ 199999 } * 12345678);
+		EXPECT_EQ(notional, volume * price);
+		EXPECT_NEAR(notional.ToDouble(), 1999.99 * 0.12345678, 1e-9);
+	}
+
+	TEST(FixedPoint, WalletDoesNotDriftOverManyFills)
+	{
+		// Arrange
+		Wallet wallet(10.0, 2000.0);
+		const std::vector<BotOrder> bids{ { OrderSide::BID, 1, Price{ 199.99 }, Quantity{ 0.1 } } };
+		const std::vector<BotOrder> asks{ { OrderSide::ASK, 2, Price{ 199.99 }, Quantity{ 0.1 } } };
+
+		// Act
+		for (int i = 0; i < 100000; i++)
+		{
+			Utilities::UpdateWallet(wallet, bids);
+			Utilities::UpdateWallet(wallet, asks);
+		}
+
+		// Assert
+		EXPECT_EQ(wallet.ETH, Quantity{ 10.0 });
+		EXPECT_EQ(wallet.USD, Notional{ 2000.0 });
+	}
+
+	TEST(FixedPoint, PrintsAsADecimal)
+	{
+		// Arrange
+		std::ostringstream output;
+
+		// Act
+		output << Price{ 199.5 };
+
+		// Assert
+		EXPECT_EQ(output.str(), "199.5");
+	}
+}
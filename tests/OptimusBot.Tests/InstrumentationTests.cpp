@@ -0,0 +1,66 @@
+#include "pch.h"
+#include <thread>
+#include "../../src/OptimusBot/Bot.h"
+#include "../../src/OptimusBot/Instrumentation.h"
+#include "../../src/OptimusBot/MarketModelSimulator.h"
+#include "../../src/OptimusBot/ReplaySimulator.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Instrumentation;
+using namespace std::chrono_literals;
+
+namespace InstrumentationTests
+{
+	TEST(Instrumentation, MeasuresTheEnclosingScope)
+	{
+		// Arrange
+		Reset();
+
+		// Act
+		{
+			OPTIMUSBOT_MEASURE(UPDATE_WALLET);
+			std::this_thread::sleep_for(1ms);
+		}
+
+		// Assert
+		const auto& histogram = GetHistogram(Stage::UPDATE_WALLET);
+#if OPTIMUSBOT_INSTRUMENTATION
+		ASSERT_EQ(histogram.GetCount(), 1u);
+		EXPECT_GE(histogram.GetMax(), 1000000u);
+#else
+		EXPECT_EQ(histogram.GetCount(), 0u);
+#endif
+		EXPECT_EQ(GetHistogram(Stage::PLACE_ORDERS).GetCount(), 0u);
+	}
+
+	TEST(Instrumentation, EveryStageIsNamed)
+	{
+		// Act & Assert
+		for (int i = 0; i < static_cast<int>(Stage::COUNT); i++)
+			EXPECT_STRNE(GetStageName(static_cast<Stage>(i)), "Unknown");
+	}
+
+#if OPTIMUSBOT_INSTRUMENTATION
+	TEST(Instrumentation, BotMeasuresItsTickStages)
+	{
+		// Arrange
+		auto source = std::make_unique<SimulatorSnapshotSource>(
+			std::make_unique<MarketModelSimulator>(MarketModelConfig{}, std::make_unique<RandomWalkProcess>(1.0, 1.0 / 3.0)), 10);
+		Bot bot{ std::make_unique<ReplaySimulator>(std::move(source)), 10.0, 2000.0 };
+		Reset();
+
+		// Act
+		bot.PlaceInitialOrders(5);
+		for (int i = 0; i < 3; i++)
+			bot.RefreshMarket();
+
+		// Assert
+		EXPECT_EQ(GetHistogram(Stage::PLACE_ORDERS).GetCount(), 1u);
+		EXPECT_EQ(GetHistogram(Stage::TICK_TO_DECISION).GetCount(), 3u);
+		EXPECT_EQ(GetHistogram(Stage::ERASE_FILLED_ORDERS).GetCount(), 3u);
+		EXPECT_EQ(GetHistogram(Stage::UPDATE_WALLET).GetCount(), 3u);
+		EXPECT_GE(GetHistogram(Stage::GET_ORDER_BOOK).GetCount(), 4u);
+		EXPECT_GE(GetHistogram(Stage::TICK_TO_DECISION).GetMax(), GetHistogram(Stage::UPDATE_WALLET).GetMax());
+	}
+#endif
+}
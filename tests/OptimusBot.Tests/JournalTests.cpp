@@ -0,0 +1,391 @@
+#include "pch.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include "../../src/OptimusBot/Bot.h"
+#include "../../src/OptimusBot/Journal.h"
+#include "../../src/OptimusBot/PendingOrders.h"
+#include "../../src/OptimusBot/Utilities.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+
+namespace JournalTests
+{
+	// Journal files removed before and after each test
+	class JournalFiles
+	{
+	public:
+		explicit JournalFiles(std::string path)
+			: Path{ std::move(path) }
+		{
+			Remove();
+		}
+
+		~JournalFiles()
+		{
+			Remove();
+		}
+
+		void Remove() const
+		{
+			std::remove(Path.c_str());
+			std::remove((Path + ".snapshot").c_str());
+		}
+
+		const std::string Path;
+	};
+
+	// Orders resting on the venue, which outlives the bots trading on it
+	struct Venue
+	{
+		std::map<IDvfSimulator::OrderID, Quantity> Resting;
+		IDvfSimulator::OrderID LastId{ 100 };
+		bool RejectsCancels{ false };
+		bool RepeatsIds{ false };
+	};
+
+	// Simulator returning a fixed book, which never fills the orders placed away from it
+	class FixedSimulator final : public IDvfSimulator
+	{
+	public:
+		explicit FixedSimulator(Venue& venue) : m_Venue{ venue }
+		{}
+
+		OrderBook GetOrderBook() noexcept override { return { {200.0, 1.0}, {201.0, -1.0} }; }
+
+		std::optional<OrderID> PlaceOrder(double, double amount) noexcept override
+		{
+			if (!m_Venue.RepeatsIds)
+				m_Venue.LastId++;
+			m_Venue.Resting[m_Venue.LastId] = Quantity{ std::abs(amount) };
+			return m_Venue.LastId;
+		}
+
+		bool CancelOrder(OrderID oid) noexcept override
+		{
+			return !m_Venue.RejectsCancels && m_Venue.Resting.erase(oid) == 1;
+		}
+
+	private:
+		Venue& m_Venue;
+	};
+
+	// Same as above, telling which orders rest on it
+	class LookupSimulator final : public IDvfSimulator, public IOrderLookup
+	{
+	public:
+		explicit LookupSimulator(Venue& venue) : m_Market{ venue }, m_Venue{ venue }
+		{}
+
+		OrderBook GetOrderBook() noexcept override { return m_Market.GetOrderBook(); }
+
+		std::optional<OrderID> PlaceOrder(double price, double amount) noexcept override { return m_Market.PlaceOrder(price, amount); }
+
+		bool CancelOrder(OrderID oid) noexcept override { return m_Market.CancelOrder(oid); }
+
+		std::optional<Quantity> GetRemaining(OrderID oid) const noexcept override
+		{
+			const auto it = m_Venue.Resting.find(oid);
+			return it != m_Venue.Resting.end() ? std::optional<Quantity>{ it->second } : std::nullopt;
+		}
+
+	private:
+		FixedSimulator m_Market;
+		Venue& m_Venue;
+	};
+
+	TEST(Journal, NewJournalHasNoState)
+	{
+		// Arrange
+		const JournalFiles files{ "JournalTests.NewJournal.log" };
+
+		// Act
+		const Journal journal{ files.Path };
+
+		// Assert
+		EXPECT_TRUE(journal.IsOpen());
+		EXPECT_FALSE(journal.GetRecoveredState().Restored);
+		EXPECT_EQ(journal.GetRecordCount(), 0u);
+	}
+
+	TEST(Journal, ReplaysTheEventsOfThePreviousSession)
+	{
+		// Arrange
+		const JournalFiles files{ "JournalTests.Replay.log" };
+		{
+			Journal journal{ files.Path };
+			journal.RecordWallet(Wallet{ 10.0, 2000.0 });
+			journal.RecordPlaced({ OrderSide::BID, 1, Price{ 190.0 }, Quantity{ 1.0 } });
+			journal.RecordPlaced({ OrderSide::ASK, 2, Price{ 210.0 }, Quantity{ 2.0 } });
+			journal.RecordPlaced({ OrderSide::ASK, 3, Price{ 220.0 }, Quantity{ 0.5 } });
+			journal.RecordFilled(1);
+			journal.RecordWallet(Wallet{ 11.0, 1810.0 });
+			journal.RecordCancelled(3);
+			ASSERT_TRUE(journal.Commit());
+		}
+
+		// Act
+		const Journal journal{ files.Path };
+		const auto& state = journal.GetRecoveredState();
+
+		// Assert
+		EXPECT_TRUE(state.Restored);
+		EXPECT_EQ(state.RecordsReplayed, 7u);
+		EXPECT_EQ(state.Wallet.ETH, Quantity{ 11.0 });
+		EXPECT_EQ(state.Wallet.USD, Notional{ 1810.0 });
+		ASSERT_EQ(state.PendingOrders.size(), 1u);
+		EXPECT_EQ(state.PendingOrders[0].OrderId, 2u);
+		EXPECT_EQ(state.PendingOrders[0].Side, OrderSide::ASK);
+		EXPECT_EQ(state.PendingOrders[0].Price, Price{ 210.0 });
+		EXPECT_EQ(state.PendingOrders[0].Volume, Quantity{ 2.0 });
+	}
+
+	TEST(Journal, CheckpointCompactsTheLogIntoASnapshot)
+	{
+		// Arrange
+		const JournalFiles files{ "JournalTests.Checkpoint.log" };
+		PendingOrders pendingOrders;
+		pendingOrders.Insert({ OrderSide::BID, 1, Price{ 190.0 }, Quantity{ 1.0 } });
+		pendingOrders.Insert({ OrderSide::ASK, 2, Price{ 210.0 }, Quantity{ 2.0 } });
+		{
+			Journal journal{ files.Path, JournalConfig{ 4096, 4096, false } };
+			for (int i = 0; i < 1000; i++)
+				journal.RecordWallet(Wallet{ 10.0, 2000.0 });
+			journal.RecordPlaced({ OrderSide::BID, 1, Price{ 190.0 }, Quantity{ 1.0 } });
+			journal.RecordPlaced({ OrderSide::ASK, 2, Price{ 210.0 }, Quantity{ 2.0 } });
+			ASSERT_TRUE(journal.Checkpoint(Wallet{ 10.0, 2000.0 }, pendingOrders));
+			EXPECT_EQ(journal.GetRecordCount(), 0u);
+
+			// Act
+			journal.RecordFilled(1);
+			journal.RecordWallet(Wallet{ 11.0, 1810.0 });
+			journal.Commit();
+		}
+		const Journal journal{ files.Path };
+		const auto& state = journal.GetRecoveredState();
+
+		// Assert
+		EXPECT_EQ(state.RecordsReplayed, 2u);
+		EXPECT_EQ(state.Wallet.ETH, Quantity{ 11.0 });
+		ASSERT_EQ(state.PendingOrders.size(), 1u);
+		EXPECT_EQ(state.PendingOrders[0].OrderId, 2u);
+	}
+
+	TEST(Journal, RecordsOlderThanTheSnapshotAreSkipped)
+	{
+		// Arrange: a crash right after a checkpoint leaves the log unchanged
+		const JournalFiles files{ "JournalTests.Stale.log" };
+		PendingOrders pendingOrders;
+		pendingOrders.Insert({ OrderSide::BID, 1, Price{ 190.0 }, Quantity{ 1.0 } });
+		{
+			Journal journal{ files.Path };
+			journal.RecordPlaced({ OrderSide::BID, 1, Price{ 190.0 }, Quantity{ 1.0 } });
+			journal.RecordPlaced({ OrderSide::BID, 2, Price{ 191.0 }, Quantity{ 1.0 } });
+			journal.RecordCancelled(2);
+			journal.Commit();
+			journal.Checkpoint(Wallet{ 10.0, 2000.0 }, pendingOrders);
+		}
+
+		// Act
+		std::size_t replayedAfterCheckpoint;
+		{
+			Journal journal{ files.Path };
+			replayedAfterCheckpoint = journal.GetRecoveredState().RecordsReplayed;
+			journal.RecordFilled(1);
+			journal.Commit();
+		}
+		const Journal journal{ files.Path };
+
+		// Assert
+		EXPECT_EQ(replayedAfterCheckpoint, 0u);
+		EXPECT_EQ(journal.GetRecoveredState().RecordsReplayed, 1u);
+		EXPECT_TRUE(journal.GetRecoveredState().PendingOrders.empty());
+	}
+
+	TEST(Journal, ReplayStopsAtATornRecord)
+	{
+		// Arrange
+		const JournalFiles files{ "JournalTests.Torn.log" };
+		{
+			Journal journal{ files.Path };
+			for (IDvfSimulator::OrderID id = 1; id <= 5; id++)
+				journal.RecordPlaced({ OrderSide::BID, id, Price{ 190.0 }, Quantity{ 1.0 } });
+			journal.Commit();
+		}
+		{
+			// Corrupts the volume of the fourth record
+			std::fstream file{ files.Path, std::ios::in | std::ios::out | std::ios::binary };
+			file.seekp(3 * 32 + 30);
+			file.put('\x7f');
+		}
+
+		// Act
+		Journal journal{ files.Path };
+		journal.RecordPlaced({ OrderSide::BID, 6, Price{ 190.0 }, Quantity{ 1.0 } });
+		journal.Commit();
+		const Journal reopened{ files.Path };
+
+		// Assert: the torn record and the ones after it are dropped, new records following the last valid one
+		EXPECT_EQ(journal.GetRecoveredState().PendingOrders.size(), 3u);
+		EXPECT_EQ(reopened.GetRecoveredState().PendingOrders.size(), 4u);
+	}
+
+	TEST(Journal, BotResumesFromTheJournal)
+	{
+		// Arrange
+		const JournalFiles files{ "JournalTests.Bot.log" };
+		Venue venue;
+		{
+			Bot bot{ std::make_unique<LookupSimulator>(venue), 10.0, 2000.0 };
+			ASSERT_TRUE(bot.OpenJournal(files.Path));
+			ASSERT_TRUE(bot.PlaceInitialOrders(2));
+			ASSERT_EQ(bot.GetPendingOrderCount(), 4u);
+			// The bot goes away without closing its session, as in a crash
+		}
+
+		// Act
+		Bot bot{ std::make_unique<LookupSimulator>(venue), 0.0, 0.0 };
+		const auto opened = bot.OpenJournal(files.Path);
+
+		// Assert
+		EXPECT_TRUE(opened);
+		EXPECT_EQ(bot.GetPendingOrderCount(), 4u);
+		EXPECT_EQ(bot.GetWallet().ETH, Quantity{ 10.0 });
+		EXPECT_EQ(bot.GetWallet().USD, Notional{ 2000.0 });
+		EXPECT_EQ(bot.GetRiskGate().GetOpenOrderCount(), 4u);
+	}
+
+	TEST(Journal, RestoredOrdersAreReconciledWithTheMarket)
+	{
+		// Arrange: while the bot is down, an order leaves the market and another one is half filled
+		const JournalFiles files{ "JournalTests.Reconcile.log" };
+		Venue venue;
+		{
+			Bot bot{ std::make_unique<LookupSimulator>(venue), 10.0, 2000.0 };
+			ASSERT_TRUE(bot.OpenJournal(files.Path));
+			ASSERT_TRUE(bot.PlaceInitialOrders(2));
+		}
+		ASSERT_EQ(venue.Resting.size(), 4u);
+		venue.Resting.erase(venue.Resting.begin());
+		auto& halfFilled = venue.Resting.rbegin()->second;
+		const auto placedVolume = halfFilled;
+		halfFilled = Quantity{ placedVolume.ToDouble() / 2.0 };
+
+		Bot bot{ std::make_unique<LookupSimulator>(venue), 0.0, 0.0 };
+		std::vector<BotOrder> fills;
+		bot.SetFillObserver([&fills](const BotOrder& order) { fills.push_back(order); });
+
+		// Act
+		ASSERT_TRUE(bot.OpenJournal(files.Path));
+		Bot restarted{ std::make_unique<LookupSimulator>(venue), 0.0, 0.0 };
+		ASSERT_TRUE(restarted.OpenJournal(files.Path));
+
+		// Assert: the order gone is dropped for good, the wallet moved by the volume traded
+		Wallet expected{ 10.0, 2000.0 };
+		ASSERT_EQ(fills.size(), 1u);
+		EXPECT_EQ(fills[0].Volume, placedVolume - halfFilled);
+		Utilities::UpdateWallet(expected, fills);
+		EXPECT_EQ(bot.GetPendingOrderCount(), 3u);
+		EXPECT_EQ(bot.GetRiskGate().GetOpenOrderCount(), 3u);
+		EXPECT_EQ(bot.GetWallet().ETH, expected.ETH);
+		EXPECT_EQ(bot.GetWallet().USD, expected.USD);
+		EXPECT_EQ(restarted.GetPendingOrderCount(), 3u);
+		EXPECT_EQ(restarted.GetWallet().ETH, expected.ETH);
+	}
+
+	TEST(Journal, RestoredOrdersAreCancelledOnAMarketUnableToLookThemUp)
+	{
+		// Arrange
+		const JournalFiles files{ "JournalTests.Blind.log" };
+		Venue venue;
+		{
+			Bot bot{ std::make_unique<FixedSimulator>(venue), 10.0, 2000.0 };
+			ASSERT_TRUE(bot.OpenJournal(files.Path));
+			ASSERT_TRUE(bot.PlaceInitialOrders(2));
+		}
+		venue.Resting.erase(venue.Resting.begin());
+
+		// Act
+		Bot bot{ std::make_unique<FixedSimulator>(venue), 0.0, 0.0 };
+		ASSERT_TRUE(bot.OpenJournal(files.Path));
+		Bot restarted{ std::make_unique<FixedSimulator>(venue), 0.0, 0.0 };
+		ASSERT_TRUE(restarted.OpenJournal(files.Path));
+
+		// Assert: none is left on the market nor tracked, the strategy being free to place new ones
+		EXPECT_TRUE(venue.Resting.empty());
+		EXPECT_EQ(bot.GetPendingOrderCount(), 0u);
+		EXPECT_EQ(bot.GetRiskGate().GetOpenOrderCount(), 0u);
+		EXPECT_EQ(restarted.GetPendingOrderCount(), 0u);
+	}
+
+	TEST(Journal, RestoredOrdersAreCountedOverTheRiskLimits)
+	{
+		// Arrange
+		const JournalFiles files{ "JournalTests.Limits.log" };
+		Venue venue;
+		{
+			Bot bot{ std::make_unique<LookupSimulator>(venue), 10.0, 2000.0 };
+			ASSERT_TRUE(bot.OpenJournal(files.Path));
+			ASSERT_TRUE(bot.PlaceInitialOrders(2));
+		}
+
+		RiskLimits limits;
+		limits.MaxOpenOrders = 2;
+		Bot bot{ std::make_unique<LookupSimulator>(venue), 0.0, 0.0 };
+		bot.SetRiskLimits(limits);
+
+		// Act
+		ASSERT_TRUE(bot.OpenJournal(files.Path));
+		const auto restored = bot.GetRiskGate().GetOpenOrderCount();
+		bot.CloseSession();
+
+		// Assert: cancelling all of them brings the gate back to no exposure
+		EXPECT_EQ(restored, 4u);
+		EXPECT_EQ(bot.GetRiskGate().GetOpenOrderCount(), 0u);
+		EXPECT_EQ(bot.GetRiskGate().GetCommittedETH(), Quantity{});
+		EXPECT_EQ(bot.GetRiskGate().GetCommittedUSD(), Notional{});
+	}
+
+	TEST(Journal, OrdersFailingToBeCancelledStayPending)
+	{
+		// Arrange
+		const JournalFiles files{ "JournalTests.FailedCancel.log" };
+		Venue venue;
+		Bot bot{ std::make_unique<LookupSimulator>(venue), 10.0, 2000.0 };
+		ASSERT_TRUE(bot.OpenJournal(files.Path));
+		ASSERT_TRUE(bot.PlaceInitialOrders(2));
+		venue.RejectsCancels = true;
+
+		// Act
+		bot.CloseSession();
+		Bot restarted{ std::make_unique<LookupSimulator>(venue), 0.0, 0.0 };
+		ASSERT_TRUE(restarted.OpenJournal(files.Path));
+
+		// Assert: the next session finds them on the market
+		EXPECT_EQ(bot.GetPendingOrderCount(), 4u);
+		EXPECT_EQ(restarted.GetPendingOrderCount(), 4u);
+	}
+
+	TEST(Journal, OrderIdReturnedTwiceIsTrackedOnce)
+	{
+		// Arrange
+		const JournalFiles files{ "JournalTests.SameId.log" };
+		Venue venue;
+		venue.RepeatsIds = true;
+		Bot bot{ std::make_unique<LookupSimulator>(venue), 10.0, 2000.0 };
+		ASSERT_TRUE(bot.OpenJournal(files.Path));
+
+		// Act
+		ASSERT_TRUE(bot.PlaceInitialOrders(2));
+		Bot restarted{ std::make_unique<LookupSimulator>(venue), 0.0, 0.0 };
+		ASSERT_TRUE(restarted.OpenJournal(files.Path));
+
+		// Assert: the exposure of the orders not tracked is released
+		EXPECT_EQ(bot.GetPendingOrderCount(), 1u);
+		EXPECT_EQ(bot.GetRiskGate().GetOpenOrderCount(), 1u);
+		EXPECT_EQ(restarted.GetPendingOrderCount(), 1u);
+	}
+}
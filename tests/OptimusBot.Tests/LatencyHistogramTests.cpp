@@ -0,0 +1,97 @@
+#include "pch.h"
+#include <thread>
+#include "../../src/OptimusBot/LatencyHistogram.h"
+
+using namespace OptimusBot;
+
+namespace LatencyHistogramTests
+{
+	TEST(LatencyHistogram, SmallValuesAreExact)
+	{
+		// Arrange
+		LatencyHistogram histogram;
+
+		// Act
+		for (std::uint64_t value = 1; value <= 100; value++)
+			histogram.Record(value);
+
+		// Assert
+		EXPECT_EQ(histogram.GetCount(), 100u);
+		EXPECT_EQ(histogram.GetMin(), 1u);
+		EXPECT_EQ(histogram.GetMax(), 100u);
+		EXPECT_EQ(histogram.GetPercentile(50.0), 50u);
+		EXPECT_EQ(histogram.GetPercentile(99.0), 99u);
+		EXPECT_EQ(histogram.GetPercentile(100.0), 100u);
+		EXPECT_DOUBLE_EQ(histogram.GetMean(), 50.5);
+	}
+
+	TEST(LatencyHistogram, PercentilesAreWithinTheBucketPrecision)
+	{
+		// Arrange
+		LatencyHistogram histogram;
+
+		// Act
+		for (std::uint64_t value = 1; value <= 1000000; value++)
+			histogram.Record(value);
+
+		// Assert
+		for (const auto percentile : { 1.0, 25.0, 50.0, 90.0, 99.0, 99.9 })
+		{
+			const auto expected = percentile / 100.0 * 1000000;
+			EXPECT_NEAR(static_cast<double>(histogram.GetPercentile(percentile)), expected, expected / 64.0) << percentile;
+		}
+		EXPECT_EQ(histogram.GetPercentile(100.0), 1000000u);
+	}
+
+	TEST(LatencyHistogram, ClampsHugeValues)
+	{
+		// Arrange
+		LatencyHistogram histogram;
+
+		// Act
+		histogram.Record(std::numeric_limits<std::uint64_t>::max());
+
+		// Assert
+		EXPECT_EQ(histogram.GetMax(), LatencyHistogram::MaxTrackableValue);
+		EXPECT_EQ(histogram.GetPercentile(50.0), LatencyHistogram::MaxTrackableValue);
+	}
+
+	TEST(LatencyHistogram, EmptyAfterReset)
+	{
+		// Arrange
+		LatencyHistogram histogram;
+		histogram.Record(1000);
+
+		// Act
+		histogram.Reset();
+
+		// Assert
+		EXPECT_EQ(histogram.GetCount(), 0u);
+		EXPECT_EQ(histogram.GetMin(), 0u);
+		EXPECT_EQ(histogram.GetMax(), 0u);
+		EXPECT_EQ(histogram.GetPercentile(50.0), 0u);
+	}
+
+	TEST(LatencyHistogram, ConcurrentRecordsAreAllCounted)
+	{
+		// Arrange
+		LatencyHistogram histogram;
+		std::vector<std::thread> threads;
+
+		// Act
+		for (int t = 0; t < 4; t++)
+		{
+			threads.emplace_back([&histogram, t]() {
+				for (std::uint64_t value = 0; value < 100000; value++)
+					histogram.Record(value + t);
+			});
+		}
+		for (auto& thread : threads)
+			thread.join();
+
+		// Assert
+		EXPECT_EQ(histogram.GetCount(), 400000u);
+		EXPECT_EQ(histogram.GetMin(), 0u);
+		EXPECT_EQ(histogram.GetMax(), 100002u);
+	}
+}
@@ -0,0 +1,49 @@
+#include "pch.h"
+#include <thread>
+#include "../../src/OptimusBot/LatencySimulator.h"
+#include "../../src/OptimusBot/MarketModelSimulator.h"
+
+using namespace OptimusBot;
+using namespace std::chrono_literals;
+
+namespace LatencySimulatorTests
+{
+	SimulatorPtr MakeMarket()
+	{
+		return std::make_unique<MarketModelSimulator>(MarketModelConfig{}, std::make_unique<RandomWalkProcess>(1.0, 1.0 / 3.0));
+	}
+
+	TEST(LatencySimulator, EachCallPaysARoundTrip)
+	{
+		// Arrange
+		LatencySimulator simulator{ MakeMarket(), 20ms };
+		const auto start = std::chrono::steady_clock::now();
+
+		// Act
+		const auto orderBook = simulator.GetOrderBook();
+		const auto orderId = simulator.PlaceOrder(150.0, 1.0);
+
+		// Assert
+		EXPECT_GE(std::chrono::steady_clock::now() - start, 40ms);
+		EXPECT_FALSE(orderBook.empty());
+		ASSERT_TRUE(orderId);
+		EXPECT_TRUE(simulator.CancelOrder(orderId.value()));
+	}
+
+	TEST(LatencySimulator, ConcurrentCallsOverlapTheirLatency)
+	{
+		// Arrange
+		LatencySimulator simulator{ MakeMarket(), 100ms };
+		std::vector<std::thread> threads;
+		const auto start = std::chrono::steady_clock::now();
+
+		// Act
+		for (int i = 0; i < 10; i++)
+			threads.emplace_back([&simulator, i]() { simulator.PlaceOrder(150.0 - i, 1.0); });
+		for (auto& thread : threads)
+			thread.join();
+
+		// Assert: far from the 10 round trips of sequential calls
+		EXPECT_LT(std::chrono::steady_clock::now() - start, 500ms);
+	}
+}
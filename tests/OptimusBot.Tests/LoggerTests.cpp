@@ -0,0 +1,190 @@
+#include "pch.h"
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include "../../src/OptimusBot/Logger.h"
+
+using namespace OptimusBot::Logging;
+
+namespace LoggerTests
+{
+	// Keeps the formatted records, optionally holding the background thread until released
+	class CaptureSink final : public ILogSink
+	{
+	public:
+		CaptureSink(std::vector<std::string>& lines, std::atomic<bool>* release = nullptr, std::atomic<bool>* holding = nullptr)
+			: m_Lines{ lines }, m_Release{ release }, m_Holding{ holding }
+		{
+		}
+
+		void Write(const Record& record) override
+		{
+			std::string line;
+			record.AppendText(line);
+			m_Lines.push_back(line);
+
+			if (m_Holding)
+				*m_Holding = true;
+
+			while (m_Release && !m_Release->load())
+				std::this_thread::yield();
+		}
+
+		void Flush() override
+		{
+		}
+
+	private:
+		std::vector<std::string>& m_Lines;
+		std::atomic<bool>* m_Release;
+		std::atomic<bool>* m_Holding;
+	};
+
+	// Redirects the logger to a sink for the duration of a test
+	class LoggerTest : public ::testing::Test
+	{
+	protected:
+		void TearDown() override
+		{
+			Logger::Instance().SetSink(std::make_unique<TextSink>(std::cout));
+			Logger::Instance().SetLevel(Level::INFO);
+			Logger::Instance().SetOverflowPolicy(OverflowPolicy::DROP);
+		}
+	};
+
+	Record MakeRecord(const char* format)
+	{
+		Record record{};
+		record.Format = format;
+		return record;
+	}
+
+	TEST(Record, ReplacesPlaceholdersByTheArguments)
+	{
+		// Arrange
+		auto record = MakeRecord("{} @ {} : {} {} (Id: {}) {}{}");
+		record.Add(-3);
+		record.Add(201.25);
+		record.Add(true);
+		record.Add("BID");
+		record.Add(42u);
+		record.Add('!');
+		record.Add(std::string{ "?" });
+
+		// Act
+		std::string text;
+		record.AppendText(text);
+
+		// Assert
+		EXPECT_EQ(text, "-3 @ 201.25 : true BID (Id: 42) !?");
+	}
+
+	TEST(Record, KeepsExtraPlaceholdersAndTruncatesLongStrings)
+	{
+		// Arrange
+		auto record = MakeRecord("{} {}");
+		record.Add(std::string(200, 'x'));
+
+		// Act
+		std::string text;
+		record.AppendText(text);
+
+		// Assert
+		EXPECT_EQ(text, std::string(Record::textCapacity, 'x') + " {}");
+	}
+
+	TEST_F(LoggerTest, WritesTheRecordsOfAllThreadsOnFlush)
+	{
+		// Arrange
+		std::vector<std::string> lines;
+		Logger::Instance().SetSink(std::make_unique<CaptureSink>(lines));
+
+		// Act
+		std::thread other{ []() { Info("thread {}", 1); } };
+		other.join();
+		Info("thread {}", 0);
+		Debug("filtered out");
+		Logger::Instance().Flush();
+
+		// Assert
+		EXPECT_EQ(lines, (std::vector<std::string>{ "thread 1", "thread 0" }));
+	}
+
+	TEST_F(LoggerTest, DropsAndCountsRecordsWhenTheRingIsFull)
+	{
+		// Arrange (the background thread is held by the first record)
+		std::vector<std::string> lines;
+		std::atomic<bool> release{ false }, holding{ false };
+		Logger::Instance().SetSink(std::make_unique<CaptureSink>(lines, &release, &holding));
+		const auto droppedBefore = Logger::Instance().GetDroppedCount();
+		Info("first");
+		while (!holding)
+			std::this_thread::yield();
+
+		// Act
+		for (int i = 0; i < 2000; i++)
+			Info("record {}", i);
+		release = true;
+		Logger::Instance().Flush();
+
+		// Assert (the warning about the drops is logged as well)
+		const auto dropped = Logger::Instance().GetDroppedCount() - droppedBefore;
+		EXPECT_GT(dropped, 0u);
+		EXPECT_EQ(lines.size() - 2 + dropped, 2000u);
+		EXPECT_EQ(lines.back(), std::to_string(dropped) + " log records dropped, the logging rings being full");
+	}
+
+	TEST_F(LoggerTest, BlockingPolicyLosesNothing)
+	{
+		// Arrange
+		std::vector<std::string> lines;
+		Logger::Instance().SetSink(std::make_unique<CaptureSink>(lines));
+		Logger::Instance().SetOverflowPolicy(OverflowPolicy::BLOCK);
+
+		// Act
+		for (int i = 0; i < 10000; i++)
+			Info("record {}", i);
+		Logger::Instance().Flush();
+
+		// Assert
+		ASSERT_EQ(lines.size(), 10000u);
+		EXPECT_EQ(lines.back(), "record 9999");
+	}
+
+	TEST_F(LoggerTest, BinaryLogDecodesToTheTextLog)
+	{
+		// Arrange
+		const auto path = "LoggerTests.log";
+		std::ostringstream expected;
+		Logger::Instance().SetSink(std::make_unique<TextSink>(expected));
+		Warning("Wallet composed of {} ETH and {} USD", 10.5, 2000);
+		Info("{} order {} placed", "BID", 3u);
+
+		// Act
+		Logger::Instance().SetSink(std::make_unique<BinarySink>(path));
+		Warning("Wallet composed of {} ETH and {} USD", 10.5, 2000);
+		Info("{} order {} placed", "BID", 3u);
+		Logger::Instance().SetSink(std::make_unique<TextSink>(std::cout));
+
+		std::ifstream input{ path, std::ios::binary };
+		std::ostringstream decoded;
+		const auto success = DecodeBinaryLog(input, decoded);
+		input.close();
+		std::remove(path);
+
+		// Assert (same lines, apart from the times)
+		ASSERT_TRUE(success);
+		std::istringstream expectedLines{ expected.str() }, decodedLines{ decoded.str() };
+		std::string expectedLine, decodedLine;
+		auto count = 0;
+		while (std::getline(expectedLines, expectedLine) && std::getline(decodedLines, decodedLine))
+		{
+			EXPECT_EQ(decodedLine.substr(15), expectedLine.substr(15));
+			count++;
+		}
+		EXPECT_EQ(count, 2);
+		EXPECT_NE(expected.str().find("WARN  Wallet composed of 10.5 ETH and 2000 USD"), std::string::npos);
+	}
+}
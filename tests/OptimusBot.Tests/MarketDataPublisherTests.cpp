@@ -0,0 +1,163 @@
+#include "pch.h"
+#include "../../src/OptimusBot/Bot.h"
+#include "../../src/OptimusBot/MarketDataPublisher.h"
+#include "../../src/OptimusBot/MarketModelSimulator.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+
+namespace MarketDataPublisherTests
+{
+	// Simulator returning a fixed snapshot and counting the calls it receives
+	class CountingSimulator final : public IDvfSimulator
+	{
+	public:
+		OrderBook Snapshot;
+		int OrderBookRequests{ 0 };
+		int OrdersPlaced{ 0 };
+		int OrdersCancelled{ 0 };
+
+		OrderBook GetOrderBook() noexcept override
+		{
+			OrderBookRequests++;
+			return Snapshot;
+		}
+
+		std::optional<OrderID> PlaceOrder(double, double) noexcept override
+		{
+			return static_cast<OrderID>(++OrdersPlaced);
+		}
+
+		bool CancelOrder(OrderID) noexcept override
+		{
+			OrdersCancelled++;
+			return true;
+		}
+	};
+
+	TEST(MarketDataPublisher, PublishesEachSideFromTheBestLevel)
+	{
+		// Arrange
+		auto simulator = std::make_unique<CountingSimulator>();
+		simulator->Snapshot = { {199.0, 1.0}, {201.0, -2.0}, {200.0, 3.0}, {203.0, -1.0}, {202.0, -4.0} };
+		MarketDataPublisher publisher{ std::move(simulator) };
+		MarketDataSnapshot snapshot;
+
+		// Act
+		const auto bothSides = publisher.Publish();
+		publisher.GetSnapshot(snapshot);
+		const auto topOfBook = publisher.GetTopOfBook();
+
+		// Assert
+		EXPECT_TRUE(bothSides);
+		EXPECT_EQ(snapshot.Version, 1u);
+		ASSERT_EQ(snapshot.BidCount, 2u);
+		ASSERT_EQ(snapshot.AskCount, 3u);
+		EXPECT_DOUBLE_EQ(snapshot.Bids[0].Price, 200.0);
+		EXPECT_DOUBLE_EQ(snapshot.Bids[1].Price, 199.0);
+		EXPECT_DOUBLE_EQ(snapshot.Asks[0].Price, 201.0);
+		EXPECT_DOUBLE_EQ(snapshot.Asks[2].Price, 203.0);
+		EXPECT_DOUBLE_EQ(snapshot.Asks[1].Volume, 4.0);
+
+		EXPECT_EQ(topOfBook.Version, 1u);
+		EXPECT_EQ(topOfBook.BidVolume, Quantity{ 3.0 });
+		ASSERT_TRUE(topOfBook.GetBestOrder().has_value());
+		EXPECT_EQ(topOfBook.GetBestOrder()->Bid, Price{ 200.0 });
+		EXPECT_EQ(topOfBook.GetBestOrder()->Ask, Price{ 201.0 });
+	}
+
+	TEST(MarketDataPublisher, KeepsTheBestLevelsOfDeepBooks)
+	{
+		// Arrange
+		auto simulator = std::make_unique<CountingSimulator>();
+		for (int i = 0; i < 100; i++)
+			simulator->Snapshot.emplace_back(100.0 + i, 1.0);
+		simulator->Snapshot.emplace_back(250.0, -1.0);
+		MarketDataPublisher publisher{ std::move(simulator) };
+		MarketDataSnapshot snapshot;
+
+		// Act
+		publisher.Publish();
+		publisher.GetSnapshot(snapshot);
+
+		// Assert
+		ASSERT_EQ(snapshot.BidCount, MarketDataSnapshot::MaxLevelsEachSide);
+		EXPECT_DOUBLE_EQ(snapshot.Bids[0].Price, 199.0);
+		EXPECT_DOUBLE_EQ(snapshot.Bids[MarketDataSnapshot::MaxLevelsEachSide - 1].Price, 199.0 - (MarketDataSnapshot::MaxLevelsEachSide - 1));
+	}
+
+	TEST(MarketDataPublisher, SubscribersShareASinglePoll)
+	{
+		// Arrange
+		auto simulator = std::make_unique<CountingSimulator>();
+		simulator->Snapshot = { {200.0, 1.0}, {201.0, -1.0} };
+		auto& market = *simulator;
+		MarketDataPublisher publisher{ std::move(simulator) };
+		std::vector<MarketDataSubscriber> subscribers(8, MarketDataSubscriber{ publisher });
+		IDvfSimulator::OrderBook orderBook;
+
+		// Act
+		publisher.Publish();
+		for (auto& subscriber : subscribers)
+		{
+			subscriber.GetOrderBook(orderBook);
+			subscriber.GetOrderBook(orderBook);
+		}
+
+		// Assert
+		EXPECT_EQ(market.OrderBookRequests, 1);
+		EXPECT_EQ(orderBook, (IDvfSimulator::OrderBook{ {200.0, 1.0}, {201.0, -1.0} }));
+	}
+
+	TEST(MarketDataPublisher, SubscribersForwardTheOrdersToTheMarket)
+	{
+		// Arrange
+		auto simulator = std::make_unique<CountingSimulator>();
+		auto& market = *simulator;
+		MarketDataPublisher publisher{ std::move(simulator) };
+		MarketDataSubscriber subscriber{ publisher };
+		const std::vector<OrderRequest> requests{ OrderRequest{ OrderSide::BID, Price{ 199.0 }, Quantity{ 1.0 } }, OrderRequest{ OrderSide::ASK, Price{ 202.0 }, Quantity{ 1.0 } } };
+		std::vector<std::optional<IDvfSimulator::OrderID>> orderIds(requests.size());
+		bool cancelled[1];
+
+		// Act
+		PlaceOrders(subscriber, requests.data(), requests.size(), orderIds.data());
+		const IDvfSimulator::OrderID firstOrder = orderIds[0].value();
+		CancelOrders(subscriber, &firstOrder, 1, cancelled);
+
+		// Assert
+		EXPECT_EQ(market.OrdersPlaced, 2);
+		EXPECT_EQ(market.OrdersCancelled, 1);
+		EXPECT_TRUE(cancelled[0]);
+	}
+
+	TEST(MarketDataPublisher, BotsTradeOnASharedMarket)
+	{
+		// Arrange
+		MarketModelConfig config;
+		config.Seed = 3;
+		auto simulator = std::make_unique<MarketModelSimulator>(config, std::make_unique<RandomWalkProcess>(5.0, 1.0 / 3.0));
+		MarketDataPublisher publisher{ std::move(simulator) };
+		ASSERT_TRUE(publisher.Publish());
+
+		std::vector<std::unique_ptr<Bot>> bots;
+		for (int i = 0; i < 4; i++)
+		{
+			bots.push_back(std::make_unique<Bot>(std::make_unique<MarketDataSubscriber>(publisher), 10.0, 2000.0));
+			ASSERT_TRUE(bots.back()->PlaceInitialOrders(2));
+		}
+
+		// Act
+		for (int tick = 0; tick < 500; tick++)
+		{
+			publisher.Publish();
+			for (auto& bot : bots)
+				bot->RefreshMarket();
+		}
+
+		// Assert
+		EXPECT_EQ(publisher.GetVersion(), 501u);
+		for (const auto& bot : bots)
+			EXPECT_LT(bot->GetPendingOrderCount(), 4u);
+	}
+}
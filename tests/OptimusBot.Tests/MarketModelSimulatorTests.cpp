@@ -0,0 +1,102 @@
+#include "pch.h"
+#include <algorithm>
+#include "../../src/OptimusBot/MarketModelSimulator.h"
+
+using namespace OptimusBot;
+
+namespace MarketModelSimulatorTests
+{
+	MarketModelSimulator MakeSimulator(std::uint64_t seed, std::size_t depth = 10)
+	{
+		MarketModelConfig config;
+		config.Seed = seed;
+		config.Depth = depth;
+		return MarketModelSimulator{ config, std::make_unique<RandomWalkProcess>(20.0, 1.0 / 3.0) };
+	}
+
+	TEST(MarketModelSimulator, SameSeedGeneratesSameMarket)
+	{
+		// Arrange
+		auto first = MakeSimulator(42);
+		auto second = MakeSimulator(42);
+
+		// Act & Assert
+		for (int i = 0; i < 100; i++)
+			EXPECT_EQ(first.GetOrderBook(), second.GetOrderBook());
+	}
+
+	TEST(MarketModelSimulator, GeneratesConfiguredDepthWithBidsBelowAsks)
+	{
+		// Arrange
+		auto simulator = MakeSimulator(1, 25);
+		IDvfSimulator::OrderBook orderBook;
+
+		for (int i = 0; i < 100; i++)
+		{
+			// Act
+			simulator.GetOrderBook(orderBook);
+
+			// Assert
+			ASSERT_EQ(orderBook.size(), 50u);
+			for (std::size_t level = 0; level < 25; level++)
+			{
+				EXPECT_GT(orderBook[level].first, 0.0);
+				EXPECT_GT(orderBook[level].second, 0.0);
+				EXPECT_LE(orderBook[level].first, simulator.GetBestBid());
+				EXPECT_LT(orderBook[25 + level].second, 0.0);
+				EXPECT_GE(orderBook[25 + level].first, simulator.GetBestAsk());
+			}
+		}
+	}
+
+	TEST(MarketModelSimulator, RejectsOrdersWhichWouldBeFilledImmediately)
+	{
+		// Arrange
+		auto simulator = MakeSimulator(3);
+		simulator.GetOrderBook();
+
+		// Act & Assert
+		EXPECT_FALSE(simulator.PlaceOrder(simulator.GetBestAsk(), 1.0));
+		EXPECT_FALSE(simulator.PlaceOrder(simulator.GetBestBid(), -1.0));
+		EXPECT_TRUE(simulator.PlaceOrder(simulator.GetBestBid(), 1.0));
+		EXPECT_TRUE(simulator.PlaceOrder(simulator.GetBestAsk(), -1.0));
+	}
+
+	TEST(MarketModelSimulator, PlacedOrdersAppearInTheBookUntilCancelled)
+	{
+		// Arrange
+		MarketModelConfig config;
+		auto simulator = MarketModelSimulator{ config, std::make_unique<RandomWalkProcess>(0.0, 1.0) };
+		simulator.GetOrderBook();
+		const auto bidId = simulator.PlaceOrder(simulator.GetBestBid() - 1.23, 0.5);
+		ASSERT_TRUE(bidId);
+
+		// Act
+		const auto withOrder = simulator.GetOrderBook();
+		const bool cancelled = simulator.CancelOrder(bidId.value());
+		const auto withoutOrder = simulator.GetOrderBook();
+
+		// Assert
+		EXPECT_TRUE(cancelled);
+		EXPECT_FALSE(simulator.CancelOrder(bidId.value()));
+		EXPECT_EQ(withOrder.size(), withoutOrder.size() + 1);
+		EXPECT_TRUE(std::is_sorted(withOrder.begin(), withOrder.begin() + 11));
+	}
+
+	TEST(MarketModelSimulator, OrdersAreFilledWhenTheMarketMovesThroughThem)
+	{
+		// Arrange: a market drifting up by 1% per step
+		MarketModelConfig config;
+		auto simulator = MarketModelSimulator{ config, std::make_unique<GbmProcess>(0.01, 0.0, 1.0) };
+		simulator.GetOrderBook();
+		const auto askId = simulator.PlaceOrder(simulator.GetBestAsk() + 1.0, -0.5);
+		ASSERT_TRUE(askId);
+
+		// Act
+		for (int i = 0; i < 10; i++)
+			simulator.GetOrderBook();
+
+		// Assert: a filled order cannot be cancelled anymore
+		EXPECT_FALSE(simulator.CancelOrder(askId.value()));
+	}
+}
@@ -0,0 +1,85 @@
+#include "pch.h"
+#include "../../src/OptimusBot/MatchingEngineSimulator.h"
+#include "../../src/OptimusBot/Utilities.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+
+namespace MatchingEngineSimulatorTests
+{
+	MatchingEngineSimulator MakeSimulator(std::uint64_t seed)
+	{
+		MatchingSimulatorConfig config;
+		config.Seed = seed;
+		return MatchingEngineSimulator{ config, std::make_unique<RandomWalkProcess>(0.0, 0.5) };
+	}
+
+	TEST(MatchingEngineSimulator, ReturnsAnUncrossedBookOfTheConfiguredDepth)
+	{
+		// Arrange
+		auto simulator = MakeSimulator(1);
+
+		for (int i = 0; i < 100; i++)
+		{
+			// Act
+			const auto orderBook = simulator.GetOrderBook();
+
+			// Assert
+			const auto bestOrder = Utilities::ExtractBestOrder(orderBook);
+			ASSERT_TRUE(bestOrder);
+			EXPECT_LT(bestOrder.value().Bid, bestOrder.value().Ask);
+			EXPECT_LE(orderBook.size(), 20u);
+		}
+
+		EXPECT_GT(simulator.GetStatistics().Trades, 0u);
+		EXPECT_GT(simulator.GetStatistics().OrdersCancelled, 0u);
+	}
+
+	TEST(MatchingEngineSimulator, SameSeedGeneratesTheSameMarket)
+	{
+		// Arrange
+		auto simulator1 = MakeSimulator(7);
+		auto simulator2 = MakeSimulator(7);
+
+		// Act & Assert
+		for (int i = 0; i < 50; i++)
+			EXPECT_EQ(simulator1.GetOrderBook(), simulator2.GetOrderBook());
+	}
+
+	TEST(MatchingEngineSimulator, FillsTheOrdersOfTheBotThroughTheFlow)
+	{
+		// Arrange
+		auto simulator = MakeSimulator(3);
+		const auto bestOrder = Utilities::ExtractBestOrder(simulator.GetOrderBook()).value();
+		const auto bid = simulator.PlaceOrder(bestOrder.Bid.ToDouble(), 2.0);
+		const auto crossing = simulator.PlaceOrder(bestOrder.Ask.ToDouble(), 1.0);
+		ASSERT_TRUE(bid);
+
+		// Act
+		for (int i = 0; i < 1000 && simulator.GetRemaining(bid.value()); i++)
+			simulator.GetOrderBook();
+
+		// Assert: post-only, the order filled by the sellers trading through it
+		EXPECT_FALSE(crossing);
+		EXPECT_FALSE(simulator.GetRemaining(bid.value()));
+		EXPECT_FALSE(simulator.CancelOrder(bid.value()));
+		EXPECT_EQ(simulator.GetStatistics().BotOrdersFilled, 1u);
+		EXPECT_DOUBLE_EQ(simulator.GetStatistics().BotFilledVolume, 2.0);
+		EXPECT_GE(simulator.GetStatistics().BotTrades, 1u);
+	}
+
+	TEST(MatchingEngineSimulator, CancelsTheOrdersOfTheBot)
+	{
+		// Arrange
+		auto simulator = MakeSimulator(5);
+		const auto bestOrder = Utilities::ExtractBestOrder(simulator.GetOrderBook()).value();
+		const auto ask = simulator.PlaceOrder(bestOrder.Ask.ToDouble() + 100.0, -1.0);
+		ASSERT_TRUE(ask);
+
+		// Act & Assert
+		EXPECT_EQ(simulator.GetRemaining(ask.value()), Quantity{ 1.0 });
+		EXPECT_TRUE(simulator.CancelOrder(ask.value()));
+		EXPECT_FALSE(simulator.CancelOrder(ask.value()));
+		EXPECT_FALSE(simulator.GetRemaining(ask.value()));
+	}
+}
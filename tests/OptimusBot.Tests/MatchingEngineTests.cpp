@@ -0,0 +1,160 @@
+#include "pch.h"
+#include "../../src/OptimusBot/MatchingEngine.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+
+namespace MatchingEngineTests
+{
+	MatchingEngine::OrderHandle Rest(MatchingEngine& engine, OrderSide side, double price, double volume)
+	{
+		std::vector<MatchingEngine::Trade> trades;
+		return engine.Submit(side, Price{ price }, Quantity{ volume }, OrderType::LIMIT, trades).Resting.value();
+	}
+
+	TEST(MatchingEngine, RestsOrdersAndTracksTheBestPrices)
+	{
+		// Arrange
+		MatchingEngine engine;
+
+		// Act
+		Rest(engine, OrderSide::BID, 99.0, 1.0);
+		Rest(engine, OrderSide::BID, 100.0, 2.0);
+		Rest(engine, OrderSide::BID, 100.0, 0.5);
+		Rest(engine, OrderSide::ASK, 101.0, 1.0);
+
+		// Assert
+		EXPECT_EQ(engine.GetBestBid(), Price{ 100.0 });
+		EXPECT_EQ(engine.GetBestAsk(), Price{ 101.0 });
+		EXPECT_EQ(engine.GetVolumeAt(Price{ 100.0 }), Quantity{ 2.5 });
+		EXPECT_EQ(engine.GetOrderCount(), 4u);
+	}
+
+	TEST(MatchingEngine, MatchesByPriceThenTimePriorityWithPartialFills)
+	{
+		// Arrange
+		MatchingEngine engine;
+		const auto first = Rest(engine, OrderSide::ASK, 101.0, 1.0);
+		const auto second = Rest(engine, OrderSide::ASK, 101.0, 1.0);
+		const auto better = Rest(engine, OrderSide::ASK, 100.5, 0.5);
+		std::vector<MatchingEngine::Trade> trades;
+
+		// Act
+		const auto result = engine.Submit(OrderSide::BID, Price{ 101.0 }, Quantity{ 1.2 }, OrderType::LIMIT, trades);
+
+		// Assert
+		EXPECT_TRUE(result.Accepted);
+		EXPECT_FALSE(result.Resting);
+		EXPECT_EQ(result.Filled, Quantity{ 1.2 });
+		ASSERT_EQ(trades.size(), 2u);
+		EXPECT_EQ(trades[0].Maker, better);
+		EXPECT_EQ(trades[0].Price, Price{ 100.5 });
+		EXPECT_EQ(trades[1].Maker, first);
+		EXPECT_EQ(trades[1].Volume, Quantity{ 0.7 });
+		EXPECT_EQ(trades[1].TakerSide, OrderSide::BID);
+		EXPECT_EQ(engine.GetRemaining(first), Quantity{ 0.3 });
+		EXPECT_EQ(engine.GetRemaining(second), Quantity{ 1.0 });
+		EXPECT_FALSE(engine.GetRemaining(better));
+		EXPECT_EQ(engine.GetBestAsk(), Price{ 101.0 });
+	}
+
+	TEST(MatchingEngine, RestsTheUnmatchedPartOfALimitOrder)
+	{
+		// Arrange
+		MatchingEngine engine;
+		Rest(engine, OrderSide::BID, 100.0, 1.0);
+		std::vector<MatchingEngine::Trade> trades;
+
+		// Act
+		const auto result = engine.Submit(OrderSide::ASK, Price{ 99.0 }, Quantity{ 3.0 }, OrderType::LIMIT, trades);
+
+		// Assert
+		ASSERT_TRUE(result.Resting);
+		EXPECT_EQ(result.Filled, Quantity{ 1.0 });
+		EXPECT_EQ(trades.size(), 1u);
+		EXPECT_EQ(trades[0].Taker, result.Resting.value());
+		EXPECT_FALSE(engine.GetBestBid());
+		EXPECT_EQ(engine.GetBestAsk(), Price{ 99.0 });
+		EXPECT_EQ(engine.GetRemaining(result.Resting.value()), Quantity{ 2.0 });
+	}
+
+	TEST(MatchingEngine, HandlesPostOnlyAndImmediateOrCancelOrders)
+	{
+		// Arrange
+		MatchingEngine engine;
+		Rest(engine, OrderSide::ASK, 101.0, 1.0);
+		std::vector<MatchingEngine::Trade> trades;
+
+		// Act
+		const auto postOnly = engine.Submit(OrderSide::BID, Price{ 101.0 }, Quantity{ 1.0 }, OrderType::POST_ONLY, trades);
+		const auto immediate = engine.Submit(OrderSide::BID, Price{ 102.0 }, Quantity{ 3.0 }, OrderType::IMMEDIATE_OR_CANCEL, trades);
+
+		// Assert
+		EXPECT_FALSE(postOnly.Accepted);
+		EXPECT_TRUE(immediate.Accepted);
+		EXPECT_FALSE(immediate.Resting);
+		EXPECT_EQ(immediate.Filled, Quantity{ 1.0 });
+		EXPECT_EQ(engine.GetOrderCount(), 0u);
+		EXPECT_FALSE(engine.GetBestAsk());
+	}
+
+	TEST(MatchingEngine, CancelsByHandleAndRejectsStaleHandles)
+	{
+		// Arrange
+		MatchingEngine engine;
+		const auto far = Rest(engine, OrderSide::BID, 90.0, 1.0);
+		const auto best = Rest(engine, OrderSide::BID, 100.0, 1.0);
+
+		// Act
+		const auto cancelled = engine.Cancel(best);
+		const auto reused = Rest(engine, OrderSide::BID, 95.0, 1.0);
+
+		// Assert: the next best bid is found across the empty levels, and the node of the cancelled order is reused
+		EXPECT_TRUE(cancelled);
+		EXPECT_NE(reused, best);
+		EXPECT_FALSE(engine.Cancel(best));
+		EXPECT_EQ(engine.GetBestBid(), Price{ 95.0 });
+		EXPECT_TRUE(engine.Cancel(reused));
+		EXPECT_EQ(engine.GetBestBid(), Price{ 90.0 });
+		EXPECT_TRUE(engine.Cancel(far));
+		EXPECT_FALSE(engine.GetBestBid());
+	}
+
+	TEST(MatchingEngine, RejectsOrdersOutOfTheRange)
+	{
+		// Arrange
+		MatchingEngineConfig config;
+		config.MinPrice = 50.0;
+		config.MaxPrice = 150.0;
+		MatchingEngine engine{ config };
+		std::vector<MatchingEngine::Trade> trades;
+
+		// Act & Assert
+		EXPECT_FALSE(engine.Submit(OrderSide::BID, Price{ 49.99 }, Quantity{ 1.0 }, OrderType::LIMIT, trades).Accepted);
+		EXPECT_FALSE(engine.Submit(OrderSide::ASK, Price{ 150.01 }, Quantity{ 1.0 }, OrderType::LIMIT, trades).Accepted);
+		EXPECT_FALSE(engine.Submit(OrderSide::ASK, Price{ 100.0 }, Quantity{}, OrderType::LIMIT, trades).Accepted);
+		EXPECT_TRUE(engine.Submit(OrderSide::ASK, Price{ 150.0 }, Quantity{ 1.0 }, OrderType::LIMIT, trades).Accepted);
+	}
+
+	TEST(MatchingEngine, HoldsAMillionRestingOrders)
+	{
+		// Arrange
+		MatchingEngine engine;
+		std::vector<MatchingEngine::OrderHandle> handles;
+		handles.reserve(1000000);
+
+		// Act
+		for (int i = 0; i < 1000000; i++)
+			handles.push_back(Rest(engine, i % 2 ? OrderSide::ASK : OrderSide::BID, i % 2 ? 200.01 + i % 5000 / 100.0 : 199.99 - i % 5000 / 100.0, 1.0));
+
+		std::vector<MatchingEngine::Trade> trades;
+		const auto sweep = engine.Submit(OrderSide::BID, Price{ 1000.0 }, Quantity{ 600000.0 }, OrderType::IMMEDIATE_OR_CANCEL, trades);
+		for (std::size_t i = 0; i < handles.size(); i += 2)
+			engine.Cancel(handles[i]);
+
+		// Assert
+		EXPECT_EQ(sweep.Filled, Quantity{ 500000.0 });
+		EXPECT_EQ(trades.size(), 500000u);
+		EXPECT_EQ(engine.GetOrderCount(), 0u);
+	}
+}
@@ -0,0 +1,97 @@
+#include "pch.h"
+#include "../../src/OptimusBot/OrderBook.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+
+namespace OrderBookTests
+{
+	TEST(OrderBook, HasNoBestOrderWhenOneSideIsEmpty)
+	{
+		// Arrange
+		OrderBook book;
+
+		// Act
+		book.Apply(LevelDelta{ OrderSide::BID, LevelAction::ADD, Price{ 10.0 }, Quantity{ 1.0 } });
+
+		// Assert
+		EXPECT_FALSE(book.GetBestOrder());
+	}
+
+	TEST(OrderBook, BestOrderIsHighestBidAndLowestAsk)
+	{
+		// Arrange
+		OrderBook book;
+		const std::vector<LevelDelta> deltas{
+			{ OrderSide::BID, LevelAction::ADD, Price{ 9.0 }, Quantity{ 1.0 } },
+			{ OrderSide::BID, LevelAction::ADD, Price{ 10.0 }, Quantity{ 1.0 } },
+			{ OrderSide::BID, LevelAction::ADD, Price{ 8.0 }, Quantity{ 1.0 } },
+			{ OrderSide::ASK, LevelAction::ADD, Price{ 13.0 }, Quantity{ 1.0 } },
+			{ OrderSide::ASK, LevelAction::ADD, Price{ 11.0 }, Quantity{ 1.0 } },
+			{ OrderSide::ASK, LevelAction::ADD, Price{ 12.0 }, Quantity{ 1.0 } } };
+
+		// Act
+		book.Apply(deltas);
+		const auto result = book.GetBestOrder();
+
+		// Assert
+		ASSERT_TRUE(result);
+		EXPECT_EQ(Price{ 10.0 }, result.value().Bid);
+		EXPECT_EQ(Price{ 11.0 }, result.value().Ask);
+		EXPECT_EQ(3u, book.Depth(OrderSide::BID));
+		EXPECT_EQ(3u, book.Depth(OrderSide::ASK));
+	}
+
+	TEST(OrderBook, LevelsAreIndexedFromTheBest)
+	{
+		// Arrange
+		OrderBook book;
+		const std::vector<LevelDelta> deltas{
+			{ OrderSide::BID, LevelAction::ADD, Price{ 9.0 }, Quantity{ 2.0 } },
+			{ OrderSide::BID, LevelAction::ADD, Price{ 10.0 }, Quantity{ 1.0 } },
+			{ OrderSide::ASK, LevelAction::ADD, Price{ 12.0 }, Quantity{ 4.0 } },
+			{ OrderSide::ASK, LevelAction::ADD, Price{ 11.0 }, Quantity{ 3.0 } } };
+
+		// Act
+		book.Apply(deltas);
+
+		// Assert
+		EXPECT_EQ(Price{ 10.0 }, book.PriceAt(OrderSide::BID, 0));
+		EXPECT_EQ(Price{ 9.0 }, book.PriceAt(OrderSide::BID, 1));
+		EXPECT_EQ(Quantity{ 2.0 }, book.VolumeAt(OrderSide::BID, 1));
+		EXPECT_EQ(Price{ 11.0 }, book.PriceAt(OrderSide::ASK, 0));
+		EXPECT_EQ(Quantity{ 4.0 }, book.VolumeAt(OrderSide::ASK, 1));
+		EXPECT_EQ(Quantity{ 3.0 }, book.CumulativeVolume(OrderSide::BID, 5));
+		EXPECT_EQ(Quantity{ 3.0 }, book.CumulativeVolume(OrderSide::ASK, 1));
+	}
+
+	TEST(OrderBook, ChangeUpdatesTheVolumeOfTheLevel)
+	{
+		// Arrange
+		OrderBook book;
+		book.Apply(LevelDelta{ OrderSide::ASK, LevelAction::ADD, Price{ 11.0 }, Quantity{ 3.0 } });
+
+		// Act
+		book.Apply(LevelDelta{ OrderSide::ASK, LevelAction::CHANGE, Price{ 11.0 }, Quantity{ 5.0 } });
+
+		// Assert
+		EXPECT_EQ(1u, book.Depth(OrderSide::ASK));
+		EXPECT_EQ(Quantity{ 5.0 }, book.VolumeAt(OrderSide::ASK, 0));
+	}
+
+	TEST(OrderBook, RemoveErasesTheLevel)
+	{
+		// Arrange
+		OrderBook book;
+		book.Apply(LevelDelta{ OrderSide::BID, LevelAction::ADD, Price{ 10.0 }, Quantity{ 1.0 } });
+		book.Apply(LevelDelta{ OrderSide::BID, LevelAction::ADD, Price{ 9.0 }, Quantity{ 1.0 } });
+
+		// Act
+		book.Apply(LevelDelta{ OrderSide::BID, LevelAction::REMOVE, Price{ 10.0 }, Quantity{ 0.0 } });
+		book.Apply(LevelDelta{ OrderSide::BID, LevelAction::REMOVE, Price{ 42.0 }, Quantity{ 0.0 } });
+
+		// Assert
+		EXPECT_EQ(1u, book.Depth(OrderSide::BID));
+		EXPECT_EQ(Price{ 9.0 }, book.PriceAt(OrderSide::BID, 0));
+	}
+}
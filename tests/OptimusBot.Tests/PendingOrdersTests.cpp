@@ -0,0 +1,135 @@
+#include "pch.h"
+#include <algorithm>
+#include "../../src/OptimusBot/PendingOrders.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+
+namespace PendingOrdersTests
+{
+	TEST(PendingOrders, InsertRejectsDuplicatedOrderId)
+	{
+		// Arrange
+		PendingOrders orders;
+
+		// Act & Assert
+		EXPECT_TRUE(orders.Insert({ OrderSide::BID, 1, Price{ 10.0 }, Quantity{ 1.0 } }));
+		EXPECT_FALSE(orders.Insert({ OrderSide::ASK, 1, Price{ 12.0 }, Quantity{ 1.0 } }));
+		EXPECT_EQ(orders.Size(), 1u);
+	}
+
+	TEST(PendingOrders, FindsOrdersById)
+	{
+		// Arrange
+		PendingOrders orders;
+		orders.Insert({ OrderSide::BID, 1, Price{ 10.0 }, Quantity{ 1.0 } });
+		orders.Insert({ OrderSide::ASK, 2, Price{ 12.0 }, Quantity{ 2.0 } });
+
+		// Act
+		const auto order = orders.Find(2);
+
+		// Assert
+		ASSERT_NE(order, nullptr);
+		EXPECT_EQ(order->Side, OrderSide::ASK);
+		EXPECT_EQ(order->Price, Price{ 12.0 });
+		EXPECT_EQ(orders.Find(3), nullptr);
+	}
+
+	TEST(PendingOrders, EraseFilledRemovesBidsAboveBestBidAndAsksBelowBestAsk)
+	{
+		// Arrange
+		PendingOrders orders;
+		orders.Insert({ OrderSide::BID, 1, Price{ 8.0 }, Quantity{ 1.0 } });
+		orders.Insert({ OrderSide::BID, 2, Price{ 10.0 }, Quantity{ 1.0 } });
+		orders.Insert({ OrderSide::BID, 3, Price{ 9.5 }, Quantity{ 1.0 } });
+		orders.Insert({ OrderSide::ASK, 4, Price{ 12.0 }, Quantity{ 1.0 } });
+		orders.Insert({ OrderSide::ASK, 5, Price{ 14.0 }, Quantity{ 1.0 } });
+		orders.Insert({ OrderSide::ASK, 6, Price{ 11.0 }, Quantity{ 1.0 } });
+		std::vector<BotOrder> filledOrders;
+
+		// Act
+		orders.EraseFilled(BestOrder{ Price{ 9.0 }, Price{ 13.0 } }, filledOrders);
+
+		// Assert
+		ASSERT_EQ(filledOrders.size(), 4u);
+		EXPECT_EQ(filledOrders[0].OrderId, 2u);
+		EXPECT_EQ(filledOrders[1].OrderId, 3u);
+		EXPECT_EQ(filledOrders[2].OrderId, 6u);
+		EXPECT_EQ(filledOrders[3].OrderId, 4u);
+		EXPECT_EQ(orders.Size(), 2u);
+		EXPECT_NE(orders.Find(1), nullptr);
+		EXPECT_NE(orders.Find(5), nullptr);
+	}
+
+	TEST(PendingOrders, EraseFilledKeepsUnfilledOrdersSharingThePriceOfAFilledOrder)
+	{
+		// Arrange
+		PendingOrders orders;
+		orders.Insert({ OrderSide::BID, 1, Price{ 10.0 }, Quantity{ 1.0 } });
+		orders.Insert({ OrderSide::ASK, 2, Price{ 10.0 }, Quantity{ 1.0 } });
+		std::vector<BotOrder> filledOrders;
+
+		// Act
+		orders.EraseFilled(BestOrder{ Price{ 9.0 }, Price{ 8.0 } }, filledOrders);
+
+		// Assert
+		ASSERT_EQ(filledOrders.size(), 1u);
+		EXPECT_EQ(filledOrders[0].OrderId, 1u);
+		EXPECT_NE(orders.Find(2), nullptr);
+	}
+
+	TEST(PendingOrders, ErasedOrdersAreNeitherFilledNorVisited)
+	{
+		// Arrange
+		PendingOrders orders;
+		orders.Insert({ OrderSide::BID, 1, Price{ 10.0 }, Quantity{ 1.0 } });
+		orders.Insert({ OrderSide::BID, 2, Price{ 11.0 }, Quantity{ 1.0 } });
+		std::vector<BotOrder> filledOrders;
+
+		// Act
+		EXPECT_TRUE(orders.Erase(2));
+		EXPECT_FALSE(orders.Erase(2));
+		orders.EraseFilled(BestOrder{ Price{ 5.0 }, Price{ 20.0 } }, filledOrders);
+
+		// Assert
+		ASSERT_EQ(filledOrders.size(), 1u);
+		EXPECT_EQ(filledOrders[0].OrderId, 1u);
+		EXPECT_TRUE(orders.Empty());
+	}
+
+	TEST(PendingOrders, ReinsertedOrderIdIsNotShadowedByItsErasedEntry)
+	{
+		// Arrange
+		PendingOrders orders;
+		orders.Insert({ OrderSide::BID, 1, Price{ 11.0 }, Quantity{ 1.0 } });
+		orders.Erase(1);
+		orders.Insert({ OrderSide::BID, 1, Price{ 8.0 }, Quantity{ 1.0 } });
+		std::vector<BotOrder> filledOrders;
+
+		// Act: only the stale entry at 11.0 is above the best bid
+		orders.EraseFilled(BestOrder{ Price{ 9.0 }, Price{ 20.0 } }, filledOrders);
+
+		// Assert
+		EXPECT_TRUE(filledOrders.empty());
+		ASSERT_NE(orders.Find(1), nullptr);
+		EXPECT_EQ(orders.Find(1)->Price, Price{ 8.0 });
+	}
+
+	TEST(PendingOrders, ForEachVisitsLiveOrdersByAscendingPrice)
+	{
+		// Arrange
+		PendingOrders orders;
+		for (IDvfSimulator::OrderID id = 0; id < 200; id++)
+			orders.Insert({ id % 2 ? OrderSide::BID : OrderSide::ASK, id, Price{ id % 2 ? 100.0 - id : 200.0 + id }, Quantity{ 1.0 } });
+		for (IDvfSimulator::OrderID id = 0; id < 200; id += 3)
+			orders.Erase(id);
+		std::vector<double> prices;
+
+		// Act
+		orders.ForEach([&prices](const BotOrder& order) { prices.push_back(order.Price.ToDouble()); });
+
+		// Assert
+		EXPECT_EQ(prices.size(), orders.Size());
+		EXPECT_TRUE(std::is_sorted(prices.begin(), prices.end()));
+	}
+}
@@ -0,0 +1,82 @@
+#include "pch.h"
+#include <cmath>
+#include "../../src/OptimusBot/PriceProcesses.h"
+
+using namespace OptimusBot;
+
+namespace PriceProcessesTests
+{
+	TEST(RandomWalkProcess, MovesByAtMostTheMaximumStep)
+	{
+		// Arrange
+		FastRandom random{ 1 };
+		RandomWalkProcess process{ 2.0, 0.5 };
+		auto price = 100.0;
+
+		for (int i = 0; i < 10000; i++)
+		{
+			// Act
+			const auto next = process.Next(price, random);
+
+			// Assert
+			EXPECT_LE(std::abs(next - price), 2.0);
+			price = next;
+		}
+	}
+
+	TEST(GbmProcess, WithoutVolatilityGrowsAtTheDriftRate)
+	{
+		// Arrange
+		FastRandom random{ 1 };
+		GbmProcess process{ 0.05, 0.0, 1.0 };
+
+		// Act
+		const auto price = process.Next(100.0, random);
+
+		// Assert
+		EXPECT_NEAR(price, 100.0 * std::exp(0.05), 1e-9);
+	}
+
+	TEST(GbmProcess, StaysPositive)
+	{
+		// Arrange
+		FastRandom random{ 2 };
+		GbmProcess process{ 0.0, 2.0, 1.0 / 365 };
+		auto price = 100.0;
+
+		// Act & Assert
+		for (int i = 0; i < 10000; i++)
+		{
+			price = process.Next(price, random);
+			EXPECT_GT(price, 0.0);
+		}
+	}
+
+	TEST(JumpDiffusionProcess, JumpsWithCertaintyWhenIntensityIsHigh)
+	{
+		// Arrange: no diffusion, a certain jump of exactly +10% in log space
+		FastRandom random{ 3 };
+		JumpDiffusionProcess process{ 0.0, 0.0, 1e9, 0.1, 0.0, 1.0 };
+
+		// Act
+		const auto price = process.Next(100.0, random);
+
+		// Assert
+		EXPECT_NEAR(price, 100.0 * std::exp(0.1), 1e-9);
+	}
+
+	TEST(MeanRevertingProcess, RevertsTowardsTheMean)
+	{
+		// Arrange
+		FastRandom random{ 4 };
+		MeanRevertingProcess process{ 200.0, 50.0, 1.0, 1.0 / 365 };
+		auto price = 300.0;
+
+		// Act
+		for (int i = 0; i < 1000; i++)
+			price = process.Next(price, random);
+
+		// Assert
+		EXPECT_NEAR(price, 200.0, 5.0);
+	}
+}
@@ -0,0 +1,57 @@
+#include "pch.h"
+#include <cstdio>
+#include "../../src/OptimusBot/MarketModelSimulator.h"
+#include "../../src/OptimusBot/RecordingSimulator.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::TickFile;
+using namespace std::chrono_literals;
+
+namespace RecordingSimulatorTests
+{
+	constexpr auto path = "RecordingSimulatorTests.ticks";
+
+	TEST(RecordingSimulator, RecordsTheCallsForwardedToTheSimulator)
+	{
+		// Arrange
+		VirtualClock clock;
+		std::vector<IDvfSimulator::OrderBook> orderBooks;
+		std::optional<IDvfSimulator::OrderID> orderId;
+		{
+			RecordingSimulator simulator{
+				std::make_unique<MarketModelSimulator>(MarketModelConfig{}, std::make_unique<RandomWalkProcess>(0.0, 1.0)), path, clock };
+			ASSERT_TRUE(simulator.IsRecording());
+
+			// Act
+			orderBooks.push_back(simulator.GetOrderBook());
+			clock.AdvanceTo(IClock::TimePoint{ 5s });
+			orderId = simulator.PlaceOrder(195.0, 0.5);
+			orderBooks.push_back(simulator.GetOrderBook());
+			clock.AdvanceTo(IClock::TimePoint{ 10s });
+			simulator.RecordFill(Types::BotOrder{ Types::OrderSide::BID, orderId.value(), Types::Price{ 195.0 }, Types::Quantity{ 0.5 } });
+			simulator.CancelOrder(orderId.value());
+		}
+
+		// Assert
+		TickReader reader{ path };
+		std::vector<Event> events;
+		Event event;
+		while (reader.Next(event))
+		{
+			events.push_back(event);
+			if (event.Type == EventType::SNAPSHOT)
+			{
+				EXPECT_EQ(*event.OrderBook, orderBooks[events.size() == 1 ? 0 : 1]);
+			}
+		}
+		std::remove(path);
+
+		ASSERT_EQ(events.size(), 5u);
+		EXPECT_EQ(events[1].Type, EventType::PLACE_ORDER);
+		EXPECT_EQ(events[1].OrderId, orderId);
+		EXPECT_EQ(events[3].Type, EventType::FILL);
+		EXPECT_EQ(events[3].Time, IClock::TimePoint{ 10s });
+		EXPECT_EQ(events[4].Type, EventType::CANCEL_ORDER);
+		EXPECT_TRUE(events[4].Success);
+	}
+}
@@ -0,0 +1,105 @@
+#include "pch.h"
+#include "../../src/OptimusBot/ReplaySimulator.h"
+
+using namespace OptimusBot;
+
+namespace ReplaySimulatorTests
+{
+	// Replays a fixed sequence of snapshots
+	class VectorSnapshotSource final : public ISnapshotSource
+	{
+	public:
+		explicit VectorSnapshotSource(std::vector<IDvfSimulator::OrderBook> snapshots)
+			: m_Snapshots{ std::move(snapshots) }
+		{
+		}
+
+		bool Next(IDvfSimulator::OrderBook& orderBook) override
+		{
+			if (m_Next == m_Snapshots.size())
+				return false;
+
+			orderBook = m_Snapshots[m_Next++];
+			return true;
+		}
+
+	private:
+		std::vector<IDvfSimulator::OrderBook> m_Snapshots;
+		std::size_t m_Next{ 0 };
+	};
+
+	ReplaySimulator MakeSimulator(std::vector<IDvfSimulator::OrderBook> snapshots)
+	{
+		return ReplaySimulator{ std::make_unique<VectorSnapshotSource>(std::move(snapshots)) };
+	}
+
+	TEST(ReplaySimulator, ReplaysSnapshotsThenReturnsEmptyBooks)
+	{
+		// Arrange
+		const IDvfSimulator::OrderBook first{ {190.0, 1.0}, {200.0, -1.0} };
+		const IDvfSimulator::OrderBook second{ {191.0, 2.0}, {201.0, -2.0} };
+		auto simulator = MakeSimulator({ first, second });
+
+		// Act & Assert
+		EXPECT_EQ(simulator.GetOrderBook(), first);
+		EXPECT_EQ(simulator.GetOrderBook(), second);
+		EXPECT_TRUE(simulator.GetOrderBook().empty());
+		EXPECT_EQ(simulator.GetStatistics().Snapshots, 2u);
+	}
+
+	TEST(ReplaySimulator, RejectsOrdersCrossingTheBook)
+	{
+		// Arrange
+		auto simulator = MakeSimulator({ { {190.0, 1.0}, {200.0, -1.0} } });
+
+		// Act & Assert (nothing replayed yet)
+		EXPECT_FALSE(simulator.PlaceOrder(195.0, 1.0));
+
+		simulator.GetOrderBook();
+		EXPECT_FALSE(simulator.PlaceOrder(200.0, 1.0));
+		EXPECT_FALSE(simulator.PlaceOrder(190.0, -1.0));
+		EXPECT_FALSE(simulator.PlaceOrder(195.0, 0.0));
+		EXPECT_TRUE(simulator.PlaceOrder(195.0, 1.0));
+		EXPECT_TRUE(simulator.PlaceOrder(196.0, -1.0));
+		EXPECT_EQ(simulator.GetStatistics().OrdersRejected, 4u);
+		EXPECT_EQ(simulator.GetStatistics().OrdersPlaced, 2u);
+	}
+
+	TEST(ReplaySimulator, FillsOrdersOnceTheMarketMovesThroughThem)
+	{
+		// Arrange
+		auto simulator = MakeSimulator({
+			{ {190.0, 1.0}, {200.0, -1.0} },
+			{ {180.0, 1.0}, {189.0, -1.0} },
+			{ {211.0, 1.0}, {220.0, -1.0} } });
+		simulator.GetOrderBook();
+		simulator.PlaceOrder(195.0, 0.5);
+		simulator.PlaceOrder(175.0, 0.25);
+		simulator.PlaceOrder(210.0, -0.75);
+
+		// Act & Assert (the market moves down through the 195 bid, the 175 bid still rests in the book)
+		const auto orderBook = simulator.GetOrderBook();
+		EXPECT_EQ(orderBook.size(), 4u);
+		EXPECT_EQ(simulator.GetStatistics().OrdersFilled, 1u);
+		EXPECT_DOUBLE_EQ(simulator.GetStatistics().FilledBidVolume, 0.5);
+
+		// Act & Assert (then up through the 210 ask)
+		simulator.GetOrderBook();
+		EXPECT_EQ(simulator.GetStatistics().OrdersFilled, 2u);
+		EXPECT_DOUBLE_EQ(simulator.GetStatistics().FilledAskVolume, 0.75);
+		EXPECT_EQ(simulator.GetLastBestOrder().value().Bid, Types::Price{ 211.0 });
+	}
+
+	TEST(ReplaySimulator, CancelsRestingOrdersOnly)
+	{
+		// Arrange
+		auto simulator = MakeSimulator({ { {190.0, 1.0}, {200.0, -1.0} } });
+		simulator.GetOrderBook();
+		const auto oid = simulator.PlaceOrder(195.0, 1.0);
+
+		// Act & Assert
+		EXPECT_TRUE(simulator.CancelOrder(oid.value()));
+		EXPECT_FALSE(simulator.CancelOrder(oid.value()));
+		EXPECT_EQ(simulator.GetStatistics().OrdersCancelled, 1u);
+	}
+}
@@ -0,0 +1,233 @@
+#include "pch.h"
+#include "../../src/OptimusBot/Requoter.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+
+namespace RequoterTests
+{
+	const Wallet wallet(10.0, 2000.0);
+
+	// Sends the actions to the pending orders, as the bot does once the venue acknowledged them
+	void Apply(const RequoteActions& actions, PendingOrders& pendingOrders, IDvfSimulator::OrderID& nextId)
+	{
+		for (const auto orderId : actions.Cancels)
+			pendingOrders.Erase(orderId);
+
+		for (const auto& request : actions.Places)
+			pendingOrders.Insert({ request.Side, nextId++, request.Price, request.Volume });
+	}
+
+	RequoterConfig Unlimited()
+	{
+		RequoterConfig config;
+		config.MaxActionsPerTick = 0;
+		return config;
+	}
+
+	TEST(Requoter, PlacesTheWholeLadderWhenNothingIsPending)
+	{
+		// Arrange
+		Requoter requoter{ Unlimited() };
+		PendingOrders pendingOrders;
+		RequoteActions actions;
+
+		// Act
+		requoter.Diff(BestOrder{ Price{ 100.0 }, Price{ 101.0 } }, wallet, pendingOrders, actions);
+
+		// Assert
+		EXPECT_TRUE(actions.Cancels.empty());
+		ASSERT_EQ(actions.Places.size(), 10u);
+		EXPECT_EQ(actions.Kept, 0u);
+		EXPECT_EQ(actions.Deferred, 0u);
+
+		// Sides alternate from the touch outwards, the sizing covering half of the assets on each side
+		EXPECT_EQ(actions.Places[0].Side, OrderSide::BID);
+		EXPECT_EQ(actions.Places[0].Price, Price{ 99.5 });
+		EXPECT_EQ(actions.Places[0].Volume, Quantity{ 2.0 });
+		EXPECT_EQ(actions.Places[1].Side, OrderSide::ASK);
+		EXPECT_EQ(actions.Places[1].Price, Price{ 101.51 });
+		EXPECT_EQ(actions.Places[1].Volume, Quantity{ 1.0 });
+		EXPECT_EQ(actions.Places[8].Price, Price{ 97.5 });
+	}
+
+	TEST(Requoter, KeepsOrdersWithinTheTolerance)
+	{
+		// Arrange
+		Requoter requoter{ Unlimited() };
+		PendingOrders pendingOrders;
+		RequoteActions actions;
+		IDvfSimulator::OrderID nextId = 1;
+		requoter.Diff(BestOrder{ Price{ 100.0 }, Price{ 101.0 } }, wallet, pendingOrders, actions);
+		Apply(actions, pendingOrders, nextId);
+
+		// Act
+		requoter.Diff(BestOrder{ Price{ 100.05 }, Price{ 100.95 } }, wallet, pendingOrders, actions);
+
+		// Assert
+		EXPECT_TRUE(actions.Cancels.empty());
+		EXPECT_TRUE(actions.Places.empty());
+		EXPECT_EQ(actions.Kept, 10u);
+	}
+
+	TEST(Requoter, ShiftsTheLadderWithAFewMessagesWhenTheMarketMoves)
+	{
+		// Arrange
+		Requoter requoter{ Unlimited() };
+		PendingOrders pendingOrders;
+		RequoteActions actions;
+		IDvfSimulator::OrderID nextId = 1;
+		requoter.Diff(BestOrder{ Price{ 100.0 }, Price{ 101.0 } }, wallet, pendingOrders, actions);
+		Apply(actions, pendingOrders, nextId);
+
+		// Act: a move up by about a level
+		requoter.Diff(BestOrder{ Price{ 100.5 }, Price{ 101.5 } }, wallet, pendingOrders, actions);
+
+		// Assert: the outermost bid and the innermost ask are withdrawn, a bid and an ask are added at the other ends
+		EXPECT_EQ(actions.Kept, 8u);
+		ASSERT_EQ(actions.Cancels.size(), 2u);
+		ASSERT_EQ(actions.Places.size(), 2u);
+		EXPECT_EQ(pendingOrders.Find(actions.Cancels[0])->Price, Price{ 97.5 });
+		EXPECT_EQ(pendingOrders.Find(actions.Cancels[1])->Price, Price{ 101.51 });
+		EXPECT_EQ(actions.Places[0].Price, Price{ 100.0 });
+		EXPECT_EQ(actions.Places[1].Side, OrderSide::ASK);
+		EXPECT_GT(actions.Places[1].Price, Price{ 103.5 });
+	}
+
+	TEST(Requoter, RateLimitsTheActionsCancellationsFirst)
+	{
+		// Arrange
+		RequoterConfig config;
+		config.MaxActionsPerTick = 3;
+		Requoter requoter{ config };
+		PendingOrders pendingOrders;
+		RequoteActions actions;
+		IDvfSimulator::OrderID nextId = 1;
+		pendingOrders.Insert({ OrderSide::BID, nextId++, Price{ 90.0 }, Quantity{ 1.0 } });
+		pendingOrders.Insert({ OrderSide::ASK, nextId++, Price{ 110.0 }, Quantity{ 1.0 } });
+
+		// Act
+		requoter.Diff(BestOrder{ Price{ 100.0 }, Price{ 101.0 } }, wallet, pendingOrders, actions);
+
+		// Assert
+		EXPECT_EQ(actions.Cancels.size(), 2u);
+		ASSERT_EQ(actions.Places.size(), 1u);
+		EXPECT_EQ(actions.Places[0].Price, Price{ 99.5 });
+		EXPECT_EQ(actions.Deferred, 10u - 1u);
+	}
+
+	TEST(Requoter, ConvergesOverTheTicksUnderTheRateLimit)
+	{
+		// Arrange
+		RequoterConfig config;
+		config.MaxActionsPerTick = 4;
+		Requoter requoter{ config };
+		PendingOrders pendingOrders;
+		RequoteActions actions;
+		IDvfSimulator::OrderID nextId = 1;
+		const BestOrder bestOrder{ Price{ 100.0 }, Price{ 101.0 } };
+
+		// Act
+		for (int tick = 0; tick < 3; tick++)
+		{
+			requoter.Diff(bestOrder, wallet, pendingOrders, actions);
+			Apply(actions, pendingOrders, nextId);
+		}
+		requoter.Diff(bestOrder, wallet, pendingOrders, actions);
+
+		// Assert
+		EXPECT_EQ(pendingOrders.Size(), 10u);
+		EXPECT_EQ(actions.Kept, 10u);
+		EXPECT_TRUE(actions.Places.empty());
+	}
+
+	TEST(Requoter, ReplacesOrdersPartiallyFilledBelowTheWantedVolume)
+	{
+		// Arrange: the innermost bid filled down to a quarter of its volume
+		Requoter requoter{ Unlimited() };
+		PendingOrders pendingOrders;
+		RequoteActions actions;
+		IDvfSimulator::OrderID nextId = 1;
+		const BestOrder bestOrder{ Price{ 100.0 }, Price{ 101.0 } };
+		requoter.Diff(bestOrder, wallet, pendingOrders, actions);
+		Apply(actions, pendingOrders, nextId);
+
+		const auto innermost = actions.Places[0];
+		const auto orderId = static_cast<IDvfSimulator::OrderID>(nextId - actions.Places.size());
+		pendingOrders.Erase(orderId);
+		pendingOrders.Insert({ OrderSide::BID, orderId, innermost.Price, Quantity{ 0.5 } });
+
+		// Act
+		requoter.Diff(bestOrder, wallet, pendingOrders, actions);
+
+		// Assert
+		EXPECT_EQ(actions.Kept, 9u);
+		ASSERT_EQ(actions.Cancels.size(), 1u);
+		EXPECT_EQ(actions.Cancels[0], orderId);
+		ASSERT_EQ(actions.Places.size(), 1u);
+		EXPECT_EQ(actions.Places[0].Price, innermost.Price);
+		EXPECT_EQ(actions.Places[0].Volume, innermost.Volume);
+	}
+
+	TEST(Requoter, SizesTheNewQuotesFromTheUncommittedAssets)
+	{
+		// Arrange: asks far from the market committing all but 1 ETH, which the new ladder does not cancel in full
+		auto config = Unlimited();
+		config.LevelsEachSide = 2;
+		Requoter requoter{ config };
+		PendingOrders pendingOrders;
+		RequoteActions actions;
+		pendingOrders.Insert({ OrderSide::ASK, 1, Price{ 101.51 }, Quantity{ 9.0 } });
+
+		// Act
+		requoter.Diff(BestOrder{ Price{ 100.0 }, Price{ 101.0 } }, wallet, pendingOrders, actions);
+
+		// Assert: the ask left to place gets the 1 ETH not committed, short of the 2.5 ETH of a level
+		EXPECT_EQ(actions.Kept, 1u);
+		EXPECT_TRUE(actions.Cancels.empty());
+		ASSERT_EQ(actions.Places.size(), 3u);
+		EXPECT_EQ(actions.Places[1].Side, OrderSide::ASK);
+		EXPECT_EQ(actions.Places[1].Volume, Quantity{ 1.0 });
+	}
+
+	TEST(Requoter, CancelsEverythingWithoutAssets)
+	{
+		// Arrange
+		Requoter requoter{ Unlimited() };
+		PendingOrders pendingOrders;
+		RequoteActions actions;
+		IDvfSimulator::OrderID nextId = 1;
+		requoter.Diff(BestOrder{ Price{ 100.0 }, Price{ 101.0 } }, wallet, pendingOrders, actions);
+		Apply(actions, pendingOrders, nextId);
+
+		// Act
+		requoter.Diff(BestOrder{ Price{ 100.0 }, Price{ 101.0 } }, Wallet(0.0, 0.0), pendingOrders, actions);
+
+		// Assert
+		EXPECT_EQ(actions.Cancels.size(), 10u);
+		EXPECT_TRUE(actions.Places.empty());
+	}
+
+	TEST(Requoter, SkewsTheLadderTowardsTheMicroprice)
+	{
+		// Arrange
+		auto config = Unlimited();
+		config.MicropriceSkew = 1.0;
+		Requoter requoter{ config };
+		PendingOrders pendingOrders;
+		RequoteActions actions;
+
+		BookFeatures features;
+		features.Ticks = 1;
+		features.Mid = 100.5;
+		features.Microprice = 100.9;
+
+		// Act
+		requoter.Diff(BestOrder{ Price{ 100.0 }, Price{ 101.0 } }, wallet, pendingOrders, actions, &features);
+
+		// Assert: both ladders move up by the distance of the microprice to the mid
+		ASSERT_EQ(actions.Places.size(), 10u);
+		EXPECT_EQ(actions.Places[0].Price, Price{ 100.4 * 0.995 });
+		EXPECT_EQ(actions.Places[1].Price, Price{ 101.4 * 1.005 });
+	}
+}
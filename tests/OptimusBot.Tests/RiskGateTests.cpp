@@ -0,0 +1,140 @@
+#include "pch.h"
+#include "../../src/OptimusBot/RiskGate.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+
+namespace RiskGateTests
+{
+	const Wallet wallet(10.0, 2000.0);
+
+	TEST(RiskGate, CommitsTheAssetsOfTheOpenOrders)
+	{
+		// Arrange
+		RiskGate gate{ wallet };
+
+		// Act
+		const auto bid = gate.Reserve({ OrderSide::BID, Price{ 190.0 }, Quantity{ 2.0 } });
+		const auto ask = gate.Reserve({ OrderSide::ASK, Price{ 210.0 }, Quantity{ 3.0 } });
+
+		// Assert
+		EXPECT_EQ(bid, RiskCheck::PASSED);
+		EXPECT_EQ(ask, RiskCheck::PASSED);
+		EXPECT_EQ(gate.GetCommittedUSD(), Notional{ 380.0 });
+		EXPECT_EQ(gate.GetCommittedETH(), Quantity{ 3.0 });
+		EXPECT_EQ(gate.GetOpenNotional(), Notional{ 1010.0 });
+		EXPECT_EQ(gate.GetOpenOrderCount(), 2u);
+	}
+
+	TEST(RiskGate, RejectsOrdersNotCoveredByTheUncommittedAssets)
+	{
+		// Arrange
+		RiskGate gate{ wallet };
+		gate.Reserve({ OrderSide::ASK, Price{ 210.0 }, Quantity{ 8.0 } });
+		gate.Reserve({ OrderSide::BID, Price{ 190.0 }, Quantity{ 10.0 } });
+
+		// Act & Assert
+		EXPECT_EQ(gate.Reserve({ OrderSide::ASK, Price{ 211.0 }, Quantity{ 2.00000001 } }), RiskCheck::ETH_NOT_COVERED);
+		EXPECT_EQ(gate.Reserve({ OrderSide::ASK, Price{ 211.0 }, Quantity{ 2.0 } }), RiskCheck::PASSED);
+		EXPECT_EQ(gate.Reserve({ OrderSide::BID, Price{ 100.01 }, Quantity{ 1.0 } }), RiskCheck::USD_NOT_COVERED);
+		EXPECT_EQ(gate.Reserve({ OrderSide::BID, Price{ 100.0 }, Quantity{ 1.0 } }), RiskCheck::PASSED);
+		EXPECT_EQ(gate.GetRejectedCount(), 2u);
+	}
+
+	TEST(RiskGate, EnforcesTheConfiguredLimits)
+	{
+		// Arrange
+		RiskLimits limits;
+		limits.MaxOrderNotional = 500.0;
+		limits.MaxOpenNotional = 800.0;
+		limits.MaxOpenOrders = 3;
+		limits.MaxPosition = 12.0;
+		limits.MinPosition = 8.0;
+		RiskGate gate{ wallet, limits };
+
+		// Act & Assert
+		EXPECT_EQ(gate.Check({ OrderSide::BID, Price{ 200.0 }, Quantity{ 2.6 } }), RiskCheck::ORDER_NOTIONAL_LIMIT);
+		EXPECT_EQ(gate.Check({ OrderSide::BID, Price{ 100.0 }, Quantity{ 2.5 } }), RiskCheck::POSITION_LIMIT);
+		EXPECT_EQ(gate.Check({ OrderSide::ASK, Price{ 100.0 }, Quantity{ 2.5 } }), RiskCheck::POSITION_LIMIT);
+		EXPECT_EQ(gate.Reserve({ OrderSide::BID, Price{ 200.0 }, Quantity{ 2.0 } }), RiskCheck::PASSED);
+		EXPECT_EQ(gate.Reserve({ OrderSide::ASK, Price{ 300.0 }, Quantity{ 1.0 } }), RiskCheck::PASSED);
+		EXPECT_EQ(gate.Check({ OrderSide::ASK, Price{ 100.01 }, Quantity{ 1.0 } }), RiskCheck::OPEN_NOTIONAL_LIMIT);
+		EXPECT_EQ(gate.Reserve({ OrderSide::ASK, Price{ 100.0 }, Quantity{ 0.001 } }), RiskCheck::PASSED);
+		EXPECT_EQ(gate.Check({ OrderSide::ASK, Price{ 1.0 }, Quantity{ 0.001 } }), RiskCheck::OPEN_ORDERS_LIMIT);
+	}
+
+	TEST(RiskGate, ReleasingRestoresTheExposureExactly)
+	{
+		// Arrange
+		RiskGate gate{ wallet };
+		const OrderRequest bid{ OrderSide::BID, Price{ 199.99 }, Quantity{ 0.12345678 } };
+
+		// Act
+		for (int i = 0; i < 100000; i++)
+		{
+			gate.Reserve(bid);
+			gate.Release(bid.Side, bid.Price, bid.Volume);
+		}
+
+		// Assert
+		EXPECT_EQ(gate.GetCommittedUSD(), Notional{});
+		EXPECT_EQ(gate.GetOpenNotional(), Notional{});
+		EXPECT_EQ(gate.GetOpenOrderCount(), 0u);
+	}
+
+	TEST(RiskGate, FillsFreeTheCommitmentsAgainstTheMovedAssets)
+	{
+		// Arrange
+		auto assets = wallet;
+		RiskGate gate{ assets };
+		gate.Reserve({ OrderSide::ASK, Price{ 210.0 }, Quantity{ 10.0 } });
+
+		// Act: the owner of the wallet moves the assets of the fill
+		assets.ETH -= Quantity{ 10.0 };
+		assets.USD += Notional{ 2100.0 };
+		gate.OnFilled({ OrderSide::ASK, 1, Price{ 210.0 }, Quantity{ 10.0 } });
+
+		// Assert
+		EXPECT_EQ(gate.GetCommittedETH(), Quantity{});
+		EXPECT_EQ(gate.GetOpenOrderCount(), 0u);
+		EXPECT_EQ(gate.Check({ OrderSide::ASK, Price{ 210.0 }, Quantity{ 0.1 } }), RiskCheck::ETH_NOT_COVERED);
+		EXPECT_EQ(gate.Check({ OrderSide::BID, Price{ 200.0 }, Quantity{ 20.0 } }), RiskCheck::PASSED);
+	}
+
+	TEST(RiskGate, PartialFillsKeepTheOrderOpen)
+	{
+		// Arrange
+		RiskGate gate{ wallet };
+		gate.Reserve({ OrderSide::BID, Price{ 200.0 }, Quantity{ 4.0 } });
+
+		// Act
+		gate.OnPartialFill({ OrderSide::BID, 1, Price{ 200.0 }, Quantity{ 1.5 } });
+
+		// Assert
+		EXPECT_EQ(gate.GetCommittedUSD(), Notional{ 500.0 });
+		EXPECT_EQ(gate.GetOpenOrderCount(), 1u);
+
+		gate.OnFilled({ OrderSide::BID, 1, Price{ 200.0 }, Quantity{ 2.5 } });
+		EXPECT_EQ(gate.GetCommittedUSD(), Notional{});
+		EXPECT_EQ(gate.GetOpenOrderCount(), 0u);
+	}
+
+	TEST(RiskGate, NewLimitsApplyToTheNextOrders)
+	{
+		// Arrange
+		RiskGate gate{ wallet };
+		gate.Reserve({ OrderSide::BID, Price{ 200.0 }, Quantity{ 2.0 } });
+		RiskLimits limits;
+		limits.MaxOpenOrders = 1;
+
+		// Act
+		gate.SetLimits(limits);
+
+		// Assert
+		EXPECT_EQ(gate.GetOpenOrderCount(), 1u);
+		EXPECT_EQ(gate.Check({ OrderSide::BID, Price{ 200.0 }, Quantity{ 1.0 } }), RiskCheck::OPEN_ORDERS_LIMIT);
+		gate.ReleaseAll();
+		EXPECT_EQ(gate.GetCommittedUSD(), Notional{});
+		EXPECT_EQ(gate.Check({ OrderSide::BID, Price{ 200.0 }, Quantity{ 1.0 } }), RiskCheck::PASSED);
+	}
+}
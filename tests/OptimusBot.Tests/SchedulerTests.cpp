@@ -0,0 +1,188 @@
+#include "pch.h"
+#include <thread>
+#include <vector>
+#include "../../src/OptimusBot/Clock.h"
+#include "../../src/OptimusBot/Scheduler.ipp"
+
+using namespace OptimusBot;
+using namespace std::chrono_literals;
+
+namespace SchedulerTests
+{
+	TEST(Scheduler, RunReturnsImmediatelyWhenNoTaskIsScheduled)
+	{
+		// Arrange
+		Scheduler scheduler;
+
+		// Act & Assert (would hang otherwise)
+		scheduler.Run();
+	}
+
+	TEST(Scheduler, ExecutesPeriodicTaskUntilStopped)
+	{
+		// Arrange
+		Scheduler scheduler;
+		auto counter{ 0 };
+		scheduler.SchedulePeriodic(1ms, [&]() { if (++counter == 3) scheduler.Stop(); });
+
+		// Act
+		scheduler.Run();
+
+		// Assert
+		EXPECT_EQ(counter, 3);
+	}
+
+	TEST(Scheduler, ExecutesTasksInDeadlineOrder)
+	{
+		// Arrange
+		Scheduler scheduler;
+		std::vector<int> executions;
+		scheduler.SchedulePeriodic(30ms, [&]() { executions.push_back(30); scheduler.Stop(); });
+		scheduler.SchedulePeriodic(10ms, [&]() { executions.push_back(10); });
+
+		// Act
+		scheduler.Run();
+
+		// Assert
+		ASSERT_GE(executions.size(), 3u);
+		EXPECT_EQ(executions.front(), 10);
+		EXPECT_EQ(executions.back(), 30);
+	}
+
+	TEST(Scheduler, CancelledTaskIsNotExecuted)
+	{
+		// Arrange
+		Scheduler scheduler;
+		auto cancelledCounter{ 0 };
+		auto counter{ 0 };
+		const auto id = scheduler.SchedulePeriodic(1ms, [&]() { cancelledCounter++; });
+		scheduler.SchedulePeriodic(5ms, [&]() { if (++counter == 2) scheduler.Stop(); });
+
+		// Act
+		EXPECT_TRUE(scheduler.Cancel(id));
+		scheduler.Run();
+
+		// Assert
+		EXPECT_EQ(cancelledCounter, 0);
+		EXPECT_FALSE(scheduler.Cancel(id));
+	}
+
+	TEST(Scheduler, TaskCanCancelItself)
+	{
+		// Arrange
+		Scheduler scheduler;
+		auto counter{ 0 };
+		Scheduler::TaskId id{};
+		id = scheduler.SchedulePeriodic(1ms, [&]() { counter++; scheduler.Cancel(id); });
+
+		// Act (returns since no task remains)
+		scheduler.Run();
+
+		// Assert
+		EXPECT_EQ(counter, 1);
+	}
+
+	TEST(Scheduler, StopWakesUpSleepingRunEarly)
+	{
+		// Arrange
+		Scheduler scheduler;
+		auto counter{ 0 };
+		scheduler.SchedulePeriodic(1h, [&]() { counter++; });
+		std::thread stopper{ [&]() { std::this_thread::sleep_for(10ms); scheduler.Stop(); } };
+
+		// Act
+		const auto start = std::chrono::steady_clock::now();
+		scheduler.Run();
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		stopper.join();
+
+		// Assert
+		EXPECT_EQ(counter, 0);
+		EXPECT_LT(elapsed, 10s);
+	}
+
+	TEST(Scheduler, VirtualClockRunsWithoutWaiting)
+	{
+		// Arrange
+		VirtualClock clock;
+		Scheduler scheduler{ clock };
+		auto counter{ 0 };
+		scheduler.SchedulePeriodic(1h, [&]() { if (++counter == 24) scheduler.Stop(); });
+
+		// Act
+		const auto start = std::chrono::steady_clock::now();
+		scheduler.Run();
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+
+		// Assert
+		EXPECT_EQ(counter, 24);
+		EXPECT_EQ(clock.Now(), IClock::TimePoint{} + 24h);
+		EXPECT_LT(elapsed, 10s);
+	}
+
+	TEST(Scheduler, WokenTaskIsExecutedRightAway)
+	{
+		// Arrange
+		VirtualClock clock;
+		Scheduler scheduler{ clock };
+		std::vector<IClock::TimePoint> executions;
+		const auto id = scheduler.SchedulePeriodic(10s, [&]() {
+			executions.push_back(clock.Now());
+			if (executions.size() == 2)
+				scheduler.Stop();
+		});
+
+		// Act
+		const auto woken = scheduler.Wake(id);
+		scheduler.Run();
+
+		// Assert: right away, then one period later
+		EXPECT_TRUE(woken);
+		ASSERT_EQ(executions.size(), 2u);
+		EXPECT_EQ(executions[0], IClock::TimePoint{});
+		EXPECT_EQ(executions[1], IClock::TimePoint{} + 10s);
+		EXPECT_FALSE(scheduler.Wake(id + 1));
+	}
+
+	TEST(Scheduler, TaskWokenWhileExecutingIsExecutedAgain)
+	{
+		// Arrange
+		VirtualClock clock;
+		Scheduler scheduler{ clock };
+		std::vector<IClock::TimePoint> executions;
+		Scheduler::TaskId id{ 0 };
+		id = scheduler.SchedulePeriodic(1s, [&]() {
+			executions.push_back(clock.Now());
+			if (executions.size() == 1)
+				scheduler.Wake(id);
+			else
+				scheduler.Stop();
+		});
+
+		// Act
+		scheduler.Run();
+
+		// Assert
+		ASSERT_EQ(executions.size(), 2u);
+		EXPECT_EQ(executions[1], executions[0]);
+	}
+
+	TEST(Scheduler, WakeInterruptsTheSleep)
+	{
+		// Arrange: a scheduler of the wall clock, without virtual call
+		BasicScheduler<SteadyClock> scheduler{ SteadyClock::Instance() };
+		auto counter{ 0 };
+		const auto id = scheduler.SchedulePeriodic(1h, [&]() { ++counter; scheduler.Stop(); });
+
+		// Act
+		const auto start = std::chrono::steady_clock::now();
+		std::thread waker{ [&]() { std::this_thread::sleep_for(20ms); scheduler.Wake(id); } };
+		scheduler.Run();
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		waker.join();
+
+		// Assert
+		EXPECT_EQ(counter, 1);
+		EXPECT_LT(elapsed, 10s);
+	}
+}
@@ -0,0 +1,83 @@
+#include "pch.h"
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../../src/OptimusBot/SeqLock.h"
+
+using namespace OptimusBot;
+
+namespace SeqLockTests
+{
+	// Value whose words are all written with the same number, so that a torn copy is detected
+	struct Tagged
+	{
+		std::array<std::uint64_t, 16> Words{};
+	};
+
+	TEST(SeqLock, LoadsTheLatestValueStored)
+	{
+		// Arrange
+		SeqLock<Tagged> seqLock;
+		Tagged value;
+		value.Words.fill(7);
+
+		// Act
+		const auto initial = seqLock.Load();
+		seqLock.Store(value);
+		const auto latest = seqLock.Load();
+
+		// Assert
+		EXPECT_EQ(initial.Words[0], 0u);
+		EXPECT_EQ(latest.Words[15], 7u);
+		EXPECT_EQ(seqLock.GetVersion(), 1u);
+	}
+
+	TEST(SeqLock, ReadersNeverSeeTornValues)
+	{
+		// Arrange
+		constexpr std::uint64_t stores = 200000;
+		SeqLock<Tagged> seqLock;
+		std::atomic<bool> done{ false };
+		std::atomic<int> tornReads{ 0 };
+		std::atomic<int> backwardReads{ 0 };
+
+		const auto read = [&]() {
+			std::uint64_t previous = 0;
+			Tagged value;
+			while (!done.load(std::memory_order_acquire))
+			{
+				seqLock.Load(value);
+				for (const auto word : value.Words)
+				{
+					if (word != value.Words[0])
+						tornReads++;
+				}
+				if (value.Words[0] < previous)
+					backwardReads++;
+				previous = value.Words[0];
+			}
+		};
+
+		// Act
+		std::vector<std::thread> readers;
+		for (int i = 0; i < 3; i++)
+			readers.emplace_back(read);
+
+		Tagged value;
+		for (std::uint64_t i = 1; i <= stores; i++)
+		{
+			value.Words.fill(i);
+			seqLock.Store(value);
+		}
+		done.store(true, std::memory_order_release);
+		for (auto& reader : readers)
+			reader.join();
+
+		// Assert
+		EXPECT_EQ(tornReads.load(), 0);
+		EXPECT_EQ(backwardReads.load(), 0);
+		EXPECT_EQ(seqLock.Load().Words[0], stores);
+		EXPECT_EQ(seqLock.GetVersion(), stores);
+	}
+}
@@ -0,0 +1,127 @@
+#include "pch.h"
+#include "../../src/OptimusBot/OrderBook.h"
+#include "../../src/OptimusBot/SnapshotDeltaAdapter.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+
+namespace SnapshotDeltaAdapterTests
+{
+	// Simulator replaying a fixed snapshot
+	class FixedSimulator : public IDvfSimulator
+	{
+	public:
+		OrderBook Snapshot;
+
+		OrderBook GetOrderBook() noexcept override { return Snapshot; }
+		std::optional<OrderID> PlaceOrder(double, double) noexcept override { return {}; }
+		bool CancelOrder(OrderID) noexcept override { return false; }
+	};
+
+	TEST(SnapshotDeltaAdapter, FirstSnapshotIsDescribedAsAdditions)
+	{
+		// Arrange
+		FixedSimulator simulator;
+		simulator.Snapshot = { {1.0, 1.0}, {2.0, 2.0}, {3.0, -1.0} };
+		SnapshotDeltaAdapter adapter{ simulator };
+		std::vector<LevelDelta> deltas;
+
+		// Act
+		adapter.GetOrderBookDeltas(deltas);
+
+		// Assert
+		ASSERT_EQ(deltas.size(), 3u);
+		for (const auto& delta : deltas)
+			EXPECT_EQ(delta.Action, LevelAction::ADD);
+		EXPECT_EQ(deltas[2].Side, OrderSide::ASK);
+		EXPECT_EQ(deltas[2].Volume, Quantity{ 1.0 });
+	}
+
+	TEST(SnapshotDeltaAdapter, IdenticalSnapshotsProduceNoDelta)
+	{
+		// Arrange
+		FixedSimulator simulator;
+		simulator.Snapshot = { {2.0, 1.0}, {1.0, 1.0}, {3.0, -1.0} };
+		SnapshotDeltaAdapter adapter{ simulator };
+		std::vector<LevelDelta> deltas;
+		adapter.GetOrderBookDeltas(deltas);
+		deltas.clear();
+
+		// Act
+		adapter.GetOrderBookDeltas(deltas);
+
+		// Assert
+		EXPECT_TRUE(deltas.empty());
+	}
+
+	TEST(SnapshotDiffer, ProducesAddChangeAndRemoveDeltas)
+	{
+		// Arrange
+		SnapshotDiffer differ;
+		std::vector<LevelDelta> deltas;
+		differ.Diff({ {1.0, 1.0}, {2.0, 1.0}, {3.0, -1.0} }, deltas);
+		deltas.clear();
+
+		// Act
+		differ.Diff({ {2.0, 5.0}, {2.5, 1.0}, {3.0, -1.0} }, deltas);
+
+		// Assert
+		ASSERT_EQ(deltas.size(), 3u);
+		EXPECT_EQ(deltas[0].Action, LevelAction::REMOVE);
+		EXPECT_EQ(deltas[0].Price, Price{ 1.0 });
+		EXPECT_EQ(deltas[1].Action, LevelAction::CHANGE);
+		EXPECT_EQ(deltas[1].Volume, Quantity{ 5.0 });
+		EXPECT_EQ(deltas[2].Action, LevelAction::ADD);
+		EXPECT_EQ(deltas[2].Price, Price{ 2.5 });
+	}
+
+	TEST(SnapshotDiffer, AggregatesLevelsSharingTheSamePrice)
+	{
+		// Arrange
+		SnapshotDiffer differ;
+		std::vector<LevelDelta> deltas;
+
+		// Act
+		differ.Diff({ {1.0, 1.0}, {1.0, 0.5}, {3.0, -1.0} }, deltas);
+
+		// Assert
+		ASSERT_EQ(deltas.size(), 2u);
+		EXPECT_EQ(deltas[0].Volume, Quantity{ 1.5 });
+	}
+
+	TEST(SnapshotDiffer, DeltasRebuildTheLatestSnapshot)
+	{
+		// Arrange
+		SnapshotDiffer differ;
+		OrderBook book;
+		std::vector<LevelDelta> deltas;
+		IDvfSimulator::OrderBook snapshot;
+
+		// Act
+		for (int i = 0; i < 100; i++)
+		{
+			snapshot.clear();
+			for (int level = 0; level < 10; level++)
+			{
+				snapshot.push_back({ 100.0 - level * 2 - rand() % 2, 1.0 + rand() % 4 });
+				snapshot.push_back({ 110.0 + level * 2 + rand() % 2, -1.0 - rand() % 4 });
+			}
+
+			deltas.clear();
+			differ.Diff(snapshot, deltas);
+			book.Apply(deltas);
+		}
+
+		// Assert
+		std::set<double> bidPrices;
+		std::set<double> askPrices;
+		for (const auto& [price, volume] : snapshot)
+			(volume > 0 ? bidPrices : askPrices).insert(price);
+
+		ASSERT_TRUE(book.GetBestOrder());
+		EXPECT_EQ(book.GetBestOrder().value().Bid, Price{ *bidPrices.rbegin() });
+		EXPECT_EQ(book.GetBestOrder().value().Ask, Price{ *askPrices.begin() });
+		EXPECT_EQ(book.Depth(OrderSide::BID), bidPrices.size());
+		EXPECT_EQ(book.Depth(OrderSide::ASK), askPrices.size());
+	}
+}
@@ -0,0 +1,75 @@
+#include "pch.h"
+#include <cstdio>
+#include <fstream>
+#include "../../src/OptimusBot/SnapshotSources.h"
+
+using namespace OptimusBot;
+
+namespace SnapshotSourcesTests
+{
+	TEST(TextSnapshotSource, ReadsBackWrittenSnapshots)
+	{
+		// Arrange
+		const auto path = "SnapshotSourcesTests.txt";
+		const std::vector<IDvfSimulator::OrderBook> snapshots{
+			{ {190.25, 1.5}, {200.125, -0.333333} },
+			{},
+			{ {1234.56789, 0.01} } };
+		{
+			std::ofstream file{ path };
+			for (const auto& snapshot : snapshots)
+				TextSnapshotSource::Write(file, snapshot);
+		}
+
+		// Act
+		TextSnapshotSource source{ path };
+		std::vector<IDvfSimulator::OrderBook> readSnapshots;
+		IDvfSimulator::OrderBook orderBook;
+		while (source.Next(orderBook))
+			readSnapshots.push_back(orderBook);
+		std::remove(path);
+
+		// Assert
+		EXPECT_EQ(readSnapshots, snapshots);
+	}
+
+	TEST(TextSnapshotSource, MissingFileIsAnEmptySource)
+	{
+		// Arrange
+		TextSnapshotSource source{ "DoesNotExist.txt" };
+		IDvfSimulator::OrderBook orderBook;
+
+		// Act & Assert
+		EXPECT_FALSE(source.Next(orderBook));
+	}
+
+	TEST(JsonSnapshotSource, ReadsPayloadsAcrossChunks)
+	{
+		// Arrange
+		const auto path = "SnapshotSourcesTests.json";
+		const std::vector<IDvfSimulator::OrderBook> snapshots{
+			{ {190.25, 1.5}, {200.125, -0.333333} },
+			{},
+			{ {1234.56789, 0.01}, {1300.5, -12.75} } };
+		{
+			std::ofstream file{ path, std::ios::binary };
+			std::string json;
+			for (const auto& snapshot : snapshots)
+			{
+				BookJson::Write(snapshot, json);
+				file << json << "\n";
+			}
+		}
+
+		// Act (a chunk size cutting the numbers)
+		JsonSnapshotSource source{ path, 7 };
+		std::vector<IDvfSimulator::OrderBook> readSnapshots;
+		IDvfSimulator::OrderBook orderBook;
+		while (source.Next(orderBook))
+			readSnapshots.push_back(orderBook);
+		std::remove(path);
+
+		// Assert
+		EXPECT_EQ(readSnapshots, snapshots);
+	}
+}
@@ -0,0 +1,65 @@
+#include "pch.h"
+#include <thread>
+#include "../../src/OptimusBot/SpscRing.h"
+
+using namespace OptimusBot;
+
+namespace SpscRingTests
+{
+	TEST(SpscRing, HoldsCapacityElements)
+	{
+		// Arrange
+		SpscRing<int> ring{ 3 };
+
+		// Act & Assert (rounded up to 4 slots)
+		for (int i = 0; i < 4; i++)
+		{
+			auto slot = ring.TryClaim();
+			ASSERT_NE(slot, nullptr);
+			*slot = i;
+			ring.Publish();
+		}
+		EXPECT_EQ(ring.TryClaim(), nullptr);
+
+		EXPECT_EQ(*ring.Front(), 0);
+		ring.Pop();
+		EXPECT_NE(ring.TryClaim(), nullptr);
+	}
+
+	TEST(SpscRing, TransfersElementsInOrderBetweenThreads)
+	{
+		// Arrange
+		constexpr auto count = 1000000;
+		SpscRing<int> ring{ 64 };
+		std::vector<int> received;
+		received.reserve(count);
+
+		// Act
+		std::thread consumer{ [&]() {
+			while (received.size() < count)
+			{
+				if (const auto element = ring.Front())
+				{
+					received.push_back(*element);
+					ring.Pop();
+				}
+			}
+		} };
+
+		for (int i = 0; i < count; i++)
+		{
+			int* slot;
+			while (!(slot = ring.TryClaim()))
+				std::this_thread::yield();
+			*slot = i;
+			ring.Publish();
+		}
+		consumer.join();
+
+		// Assert
+		ASSERT_EQ(received.size(), static_cast<std::size_t>(count));
+		for (int i = 0; i < count; i++)
+			ASSERT_EQ(received[i], i);
+		EXPECT_TRUE(ring.Empty());
+	}
+}
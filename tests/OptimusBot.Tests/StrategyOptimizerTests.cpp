@@ -0,0 +1,135 @@
+#include "pch.h"
+#include "../../src/OptimusBot/MarketModelSimulator.h"
+#include "../../src/OptimusBot/StrategyOptimizer.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Optimizer;
+
+namespace StrategyOptimizerTests
+{
+	// Short and volatile markets, for the orders to be filled within a few hundred ticks
+	std::unique_ptr<ISnapshotSource> MakeMarket(std::uint64_t seed)
+	{
+		MarketModelConfig config;
+		config.Seed = seed;
+		return std::make_unique<SimulatorSnapshotSource>(
+			std::make_unique<MarketModelSimulator>(config, std::make_unique<RandomWalkProcess>(5.0, 1.0 / 3.0)), 500);
+	}
+
+	OptimizerConfig MakeConfig()
+	{
+		OptimizerConfig config;
+		config.OrdersEachSide = { 2.0, 6.0, 2.0 };
+		config.BidBand = { 0.90, 0.99, 0.03 };
+		config.Sizing = { 0.5, 1.0, 0.5 };
+		config.Scenarios = 4;
+		config.Seed = 123;
+		config.MakeMarket = MakeMarket;
+		return config;
+	}
+
+	TEST(ParameterRange, IncludesTheUpperBound)
+	{
+		// Act
+		const auto values = ParameterRange{ 0.90, 0.99, 0.03 }.Values();
+
+		// Assert
+		ASSERT_EQ(values.size(), 4u);
+		EXPECT_DOUBLE_EQ(values.front(), 0.90);
+		EXPECT_DOUBLE_EQ(values.back(), 0.99);
+	}
+
+	TEST(ParameterRange, SingleValueWithoutStep)
+	{
+		// Act & Assert
+		EXPECT_EQ((ParameterRange{ 5.0, 5.0, 0.0 }.Values()), (std::vector<double>{ 5.0 }));
+		EXPECT_EQ((ParameterRange{ 5.0, 10.0, 0.0 }.Values()), (std::vector<double>{ 5.0 }));
+	}
+
+	TEST(ParseArgument, ParsesRangesAndSettings)
+	{
+		// Arrange
+		OptimizerConfig config;
+
+		// Act & Assert
+		EXPECT_TRUE(ParseArgument("orders=2:10:2", config));
+		EXPECT_TRUE(ParseArgument("eth=20", config));
+		EXPECT_TRUE(ParseArgument("bid=0.9:0.95", config));
+		EXPECT_TRUE(ParseArgument("scenarios=64", config));
+		EXPECT_EQ(config.OrdersEachSide.Values().size(), 5u);
+		EXPECT_EQ(config.InitialETH.Values(), (std::vector<double>{ 20.0 }));
+		EXPECT_EQ(config.BidBand.Values(), (std::vector<double>{ 0.9 }));
+		EXPECT_EQ(config.Scenarios, 64u);
+	}
+
+	TEST(ParseArgument, RejectsMalformedArguments)
+	{
+		// Arrange
+		OptimizerConfig config;
+
+		// Act & Assert
+		EXPECT_FALSE(ParseArgument("orders", config));
+		EXPECT_FALSE(ParseArgument("unknown=1", config));
+		EXPECT_FALSE(ParseArgument("orders=abc", config));
+		EXPECT_FALSE(ParseArgument("orders=10:2", config));
+		EXPECT_FALSE(ParseArgument("orders=2:10:", config));
+		EXPECT_FALSE(ParseArgument("orders=2:10:2x", config));
+		EXPECT_FALSE(ParseArgument("scenarios=-", config));
+		EXPECT_EQ(config.OrdersEachSide.Values(), (std::vector<double>{ 5.0 }));
+	}
+
+	TEST(StrategyOptimizer, EnumeratesTheGrid)
+	{
+		// Act
+		const auto candidates = MakeCandidates(MakeConfig());
+
+		// Assert: 3 x 4 x 2 candidates, the other parameters being fixed
+		ASSERT_EQ(candidates.size(), 24u);
+		EXPECT_EQ(candidates.front().OrdersEachSide, 2);
+		EXPECT_EQ(candidates.back().OrdersEachSide, 6);
+		EXPECT_DOUBLE_EQ(candidates.back().Strategy.AskBand, 1.05);
+	}
+
+	TEST(StrategyOptimizer, RanksTheCandidatesBestFirst)
+	{
+		// Arrange
+		ThreadPool pool{ 4 };
+
+		// Act
+		const auto report = Optimizer::Run(MakeConfig(), pool);
+
+		// Assert
+		ASSERT_EQ(report.Ranking.size(), 24u);
+		EXPECT_EQ(report.Backtests, 24u * 4u);
+		for (std::size_t i = 1; i < report.Ranking.size(); i++)
+			EXPECT_GE(report.Ranking[i - 1].MeanPnLVersusHolding, report.Ranking[i].MeanPnLVersusHolding);
+		for (const auto& result : report.Ranking)
+		{
+			EXPECT_EQ(result.Runs, 4u);
+			EXPECT_EQ(result.AbortedRuns, 0u);
+			EXPECT_LE(result.WorstPnL, result.MeanPnL);
+		}
+	}
+
+	TEST(StrategyOptimizer, ResultsDoNotDependOnTheNumberOfThreads)
+	{
+		// Arrange
+		ThreadPool singleThread{ 1 };
+		ThreadPool manyThreads{ 8 };
+
+		// Act
+		const auto report1 = Optimizer::Run(MakeConfig(), singleThread);
+		const auto report2 = Optimizer::Run(MakeConfig(), manyThreads);
+
+		// Assert
+		ASSERT_EQ(report1.Ranking.size(), report2.Ranking.size());
+		for (std::size_t i = 0; i < report1.Ranking.size(); i++)
+		{
+			EXPECT_EQ(report1.Ranking[i].Parameters.OrdersEachSide, report2.Ranking[i].Parameters.OrdersEachSide);
+			EXPECT_EQ(report1.Ranking[i].Parameters.Strategy.BidBand, report2.Ranking[i].Parameters.Strategy.BidBand);
+			EXPECT_EQ(report1.Ranking[i].MeanPnL, report2.Ranking[i].MeanPnL);
+			EXPECT_EQ(report1.Ranking[i].MeanFillRate, report2.Ranking[i].MeanFillRate);
+			EXPECT_EQ(report1.Ranking[i].MeanInventoryRisk, report2.Ranking[i].MeanInventoryRisk);
+		}
+	}
+}
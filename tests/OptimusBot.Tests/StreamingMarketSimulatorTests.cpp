@@ -0,0 +1,265 @@
+#include "pch.h"
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include "../../src/OptimusBot/Bot.h"
+#include "../../src/OptimusBot/StreamingMarketSimulator.h"
+#include "../../src/OptimusBot/Utilities.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Types;
+
+namespace StreamingMarketSimulatorTests
+{
+	// Listener keeping the events it receives, and the book they describe
+	class RecordingListener final : public IMarketEventListener
+	{
+	public:
+		OrderBook Book;
+		std::vector<FillEvent> Fills;
+		std::vector<IDvfSimulator::OrderID> Cancels;
+
+		void OnFill(const FillEvent& fill) noexcept override
+		{
+			Fills.push_back(fill);
+		}
+
+		void OnCancel(IDvfSimulator::OrderID orderId) noexcept override
+		{
+			Cancels.push_back(orderId);
+		}
+
+		void OnBookChange(const LevelDelta& delta) noexcept override
+		{
+			Book.Apply(delta);
+		}
+	};
+
+	// Market pushing no event but the cancellation of every order placed, when told to from another thread
+	class ScriptedEventSource final : public IDvfSimulator, public IMarketEventSource
+	{
+	public:
+		OrderBook GetOrderBook() noexcept override { return { {200.0, 1.0}, {201.0, -1.0} }; }
+		std::optional<OrderID> PlaceOrder(double, double) noexcept override { return ++m_LastId; }
+		bool CancelOrder(OrderID) noexcept override { return true; }
+
+		void Subscribe(IMarketEventListener* listener) noexcept override
+		{
+			const std::lock_guard<std::mutex> lock{ m_Mutex };
+			m_Listener = listener;
+			if (!m_Listener)
+				return;
+
+			m_Listener->OnBookChange(LevelDelta{ OrderSide::BID, LevelAction::ADD, Price{ 200.0 }, Quantity{ 1.0 } });
+			m_Listener->OnBookChange(LevelDelta{ OrderSide::ASK, LevelAction::ADD, Price{ 201.0 }, Quantity{ 1.0 } });
+		}
+
+		void CancelAll()
+		{
+			const std::lock_guard<std::mutex> lock{ m_Mutex };
+			for (OrderID oid = 1; oid <= m_LastId; oid++)
+				m_Listener->OnCancel(oid);
+		}
+
+	private:
+		std::mutex m_Mutex;
+		IMarketEventListener* m_Listener{ nullptr };
+		OrderID m_LastId{ 0 };
+	};
+
+	std::unique_ptr<StreamingMarketSimulator> MakeSimulator(std::uint64_t seed, double maxStep = 0.0)
+	{
+		MatchingSimulatorConfig config;
+		config.Seed = seed;
+		return std::make_unique<StreamingMarketSimulator>(config, std::make_unique<RandomWalkProcess>(maxStep, 0.5));
+	}
+
+	// Whether the book of the listener holds every level of the engine, and nothing else
+	void ExpectSameBook(const OrderBook& book, const MatchingEngine& engine)
+	{
+		for (const auto side : { OrderSide::BID, OrderSide::ASK })
+		{
+			std::size_t level = 0;
+			engine.ForEachLevel(side, std::numeric_limits<std::size_t>::max(), [&](Price price, Quantity volume) {
+				ASSERT_LT(level, book.Depth(side));
+				EXPECT_EQ(book.PriceAt(side, level), price);
+				EXPECT_EQ(book.VolumeAt(side, level), volume);
+				level++;
+			});
+			EXPECT_EQ(book.Depth(side), level);
+		}
+	}
+
+	TEST(StreamingMarketSimulator, MaintainsTheBookOfTheSubscriber)
+	{
+		// Arrange
+		auto simulator = MakeSimulator(1, 0.5);
+		RecordingListener listener;
+
+		// Act & Assert: the whole book on subscription, then its changes
+		simulator->Subscribe(&listener);
+		ExpectSameBook(listener.Book, simulator->GetEngine());
+
+		for (int i = 0; i < 100; i++)
+			EXPECT_GT(simulator->GenerateFlow(), 0u);
+
+		ExpectSameBook(listener.Book, simulator->GetEngine());
+		EXPECT_EQ(simulator->GetStatistics().Batches, 100u);
+	}
+
+	TEST(StreamingMarketSimulator, FlowRunsOnItsOwnThreadOnceStarted)
+	{
+		using namespace std::chrono_literals;
+
+		// Arrange
+		auto simulator = MakeSimulator(2, 0.5);
+		RecordingListener listener;
+		simulator->Subscribe(&listener);
+
+		// Act
+		simulator->Start(1ms);
+		std::this_thread::sleep_for(50ms);
+		simulator->Stop();
+		const auto batches = simulator->GetStatistics().Batches;
+		simulator->GetOrderBook();
+
+		// Assert: the market traded on its own, and not anymore on demand once started
+		EXPECT_GT(batches, 0u);
+		EXPECT_EQ(simulator->GetStatistics().Batches, batches);
+		ExpectSameBook(listener.Book, simulator->GetEngine());
+	}
+
+	TEST(StreamingMarketSimulator, PushesTheFillsOfTheSubscriber)
+	{
+		// Arrange
+		auto simulator = MakeSimulator(3);
+		RecordingListener listener;
+		simulator->Subscribe(&listener);
+		const auto bestBid = listener.Book.PriceAt(OrderSide::BID, 0);
+		const auto bid = simulator->PlaceOrder(bestBid.ToDouble(), 2.0);
+		ASSERT_TRUE(bid);
+
+		// Act
+		for (int i = 0; i < 1000 && simulator->GetRemaining(bid.value()); i++)
+			simulator->GenerateFlow();
+
+		// Assert: every trade through the order is reported, the last one completing it
+		ASSERT_FALSE(listener.Fills.empty());
+		Quantity filled;
+		for (const auto& fill : listener.Fills)
+		{
+			EXPECT_EQ(fill.OrderId, bid.value());
+			EXPECT_EQ(fill.Side, OrderSide::BID);
+			EXPECT_EQ(fill.Price, bestBid);
+			filled += fill.Volume;
+			EXPECT_EQ(fill.Remaining, Quantity{ 2.0 } - filled);
+		}
+
+		EXPECT_EQ(filled, Quantity{ 2.0 });
+		EXPECT_FALSE(simulator->GetRemaining(bid.value()));
+		EXPECT_TRUE(listener.Cancels.empty());
+		ExpectSameBook(listener.Book, simulator->GetEngine());
+	}
+
+	TEST(StreamingMarketSimulator, PushesTheCancellations)
+	{
+		// Arrange
+		auto simulator = MakeSimulator(5);
+		RecordingListener listener;
+		simulator->Subscribe(&listener);
+		const auto ask = simulator->PlaceOrder(listener.Book.PriceAt(OrderSide::ASK, 0).ToDouble() + 1.0, -1.0);
+		ASSERT_TRUE(ask);
+
+		// Act
+		const auto cancelled = simulator->CancelOrder(ask.value());
+		const auto cancelledAgain = simulator->CancelOrder(ask.value());
+
+		// Assert
+		EXPECT_TRUE(cancelled);
+		EXPECT_FALSE(cancelledAgain);
+		ASSERT_EQ(listener.Cancels.size(), 1u);
+		EXPECT_EQ(listener.Cancels[0], ask.value());
+		ExpectSameBook(listener.Book, simulator->GetEngine());
+	}
+
+	TEST(StreamingMarketSimulator, BotProcessesThePushedFills)
+	{
+		// Arrange
+		constexpr auto initialETH = 10.0;
+		constexpr auto initialUSD = 2000.0;
+		auto simulator = MakeSimulator(7, 1.0);
+		auto& market = *simulator;
+		Bot bot{ std::move(simulator), initialETH, initialUSD };
+
+		Wallet expected{ initialETH, initialUSD };
+		std::vector<BotOrder> fills;
+		bot.SetFillObserver([&fills](const BotOrder& order) { fills.push_back(order); });
+		ASSERT_TRUE(bot.PlaceInitialOrders(2));
+		const auto placed = bot.GetPendingOrderCount();
+
+		// Act
+		for (int tick = 0; tick < 500 && bot.GetPendingOrderCount() == placed; tick++)
+		{
+			market.GenerateFlow();
+			bot.RefreshMarket();
+		}
+
+		// Assert: the wallet moved by exactly the volumes traded
+		ASSERT_FALSE(fills.empty());
+		Utilities::UpdateWallet(expected, fills);
+		EXPECT_EQ(bot.GetWallet().ETH, expected.ETH);
+		EXPECT_EQ(bot.GetWallet().USD, expected.USD);
+	}
+
+	TEST(StreamingMarketSimulator, PartialFillKeepsTheOrderOpen)
+	{
+		// Arrange: orders far larger than those of the other participants
+		auto simulator = MakeSimulator(7, 1.0);
+		auto& market = *simulator;
+		Bot bot{ std::move(simulator), 100.0, 20000.0 };
+		ASSERT_TRUE(bot.PlaceInitialOrders(2, StrategyParameters{}, 1));
+		const auto placed = bot.GetPendingOrderCount();
+		ASSERT_EQ(bot.GetRiskGate().GetOpenOrderCount(), placed);
+
+		std::vector<BotOrder> fills;
+		bot.SetFillObserver([&fills](const BotOrder& order) { fills.push_back(order); });
+
+		// Act
+		for (int tick = 0; tick < 500 && fills.empty(); tick++)
+		{
+			market.GenerateFlow();
+			bot.RefreshMarket();
+		}
+
+		// Assert: the filled order is still pending, and still counted as open by the gate
+		ASSERT_FALSE(fills.empty());
+		EXPECT_EQ(bot.GetPendingOrderCount(), placed);
+		EXPECT_EQ(bot.GetRiskGate().GetOpenOrderCount(), placed);
+	}
+
+	TEST(StreamingMarketSimulator, PushedEventsWakeTheBotUp)
+	{
+		using namespace std::chrono_literals;
+
+		// Arrange
+		auto source = std::make_unique<ScriptedEventSource>();
+		auto& market = *source;
+		Bot bot{ std::move(source), 10.0, 2000.0 };
+		ASSERT_TRUE(bot.PlaceInitialOrders(2));
+
+		// Act: the orders are cancelled by the market while the session is running
+		std::thread marketThread{ [&market]() {
+			std::this_thread::sleep_for(100ms);
+			market.CancelAll();
+		} };
+		const auto start = std::chrono::steady_clock::now();
+		bot.StartTradingSession();
+		const auto sessionDuration = std::chrono::steady_clock::now() - start;
+		marketThread.join();
+
+		// Assert: the session closed as soon as the cancellations came in, rather than on the next 5-second refresh
+		EXPECT_EQ(bot.GetPendingOrderCount(), 0u);
+		EXPECT_LT(sessionDuration, 2s);
+	}
+}
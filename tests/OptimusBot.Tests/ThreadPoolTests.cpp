@@ -0,0 +1,115 @@
+#include "pch.h"
+#include <atomic>
+#include <stdexcept>
+#include "../../src/OptimusBot/ThreadPool.h"
+
+using namespace OptimusBot;
+using namespace std::chrono_literals;
+
+namespace ThreadPoolTests
+{
+	TEST(ThreadPool, ExecutesAllPostedTasks)
+	{
+		// Arrange
+		ThreadPool pool{ 4 };
+		std::atomic<int> counter{ 0 };
+
+		// Act
+		for (int i = 0; i < 10000; i++)
+			pool.Post([&counter]() { counter++; });
+		pool.WaitIdle();
+
+		// Assert
+		EXPECT_EQ(counter, 10000);
+	}
+
+	TEST(ThreadPool, SubmitDeliversResultsAndExceptions)
+	{
+		// Arrange
+		ThreadPool pool{ 2 };
+
+		// Act
+		auto result = pool.Submit([]() { return 42; });
+		auto failure = pool.Submit([]() -> int { throw std::runtime_error{ "failure" }; });
+
+		// Assert
+		EXPECT_EQ(result.get(), 42);
+		EXPECT_THROW(failure.get(), std::runtime_error);
+	}
+
+	TEST(ThreadPool, FailingTaskDoesNotAffectTheOthers)
+	{
+		// Arrange
+		ThreadPool pool{ 1 };
+		std::atomic<int> counter{ 0 };
+
+		// Act
+		pool.Post([]() { throw std::runtime_error{ "failure" }; });
+		pool.Post([&counter]() { counter++; });
+		pool.WaitIdle();
+
+		// Assert
+		EXPECT_EQ(counter, 1);
+	}
+
+	TEST(ThreadPool, WaitIdleIncludesTasksPostedByTasks)
+	{
+		// Arrange
+		ThreadPool pool{ 4 };
+		std::atomic<int> counter{ 0 };
+
+		// Act
+		for (int i = 0; i < 100; i++)
+		{
+			pool.Post([&pool, &counter]() {
+				for (int j = 0; j < 100; j++)
+					pool.Post([&counter]() { counter++; });
+			});
+		}
+		pool.WaitIdle();
+
+		// Assert
+		EXPECT_EQ(counter, 10000);
+	}
+
+	TEST(ThreadPool, IdleWorkersStealTasksQueuedBehindABusyOne)
+	{
+		// Arrange (the tasks posted from within a task are queued on its worker, which stays busy)
+		ThreadPool pool{ 2 };
+		std::atomic<bool> release{ false };
+		std::atomic<int> counter{ 0 };
+
+		// Act
+		pool.Post([&]() {
+			for (int i = 0; i < 10; i++)
+				pool.Post([&counter]() { counter++; });
+			while (!release)
+				std::this_thread::yield();
+		});
+		const auto deadline = std::chrono::steady_clock::now() + 10s;
+		while (counter < 10 && std::chrono::steady_clock::now() < deadline)
+			std::this_thread::yield();
+		const auto executedWhileBusy = counter.load();
+		release = true;
+		pool.WaitIdle();
+
+		// Assert
+		EXPECT_EQ(executedWhileBusy, 10);
+	}
+
+	TEST(ThreadPool, DestructorRunsTheQueuedTasks)
+	{
+		// Arrange
+		std::atomic<int> counter{ 0 };
+
+		// Act
+		{
+			ThreadPool pool{ 2 };
+			for (int i = 0; i < 1000; i++)
+				pool.Post([&counter]() { counter++; });
+		}
+
+		// Assert
+		EXPECT_EQ(counter, 1000);
+	}
+}
@@ -0,0 +1,94 @@
+#include "pch.h"
+#include "AllocationCounter.h"
+#include "../../src/OptimusBot/Bot.h"
+#include "../../src/OptimusBot/MarketModelSimulator.h"
+#include "../../src/OptimusBot/PendingOrders.h"
+#include "../../src/OptimusBot/ReplaySimulator.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::Tests;
+using namespace OptimusBot::Types;
+
+namespace TickAllocationTests
+{
+	// Market reverting around its initial mid, so that the bot keeps pending orders for the whole session
+	std::unique_ptr<MarketModelSimulator> MakeMarket(std::size_t depth)
+	{
+		MarketModelConfig config;
+		config.Depth = depth;
+		config.LevelSpacing = 0.01;
+		return std::make_unique<MarketModelSimulator>(config,
+			std::make_unique<MeanRevertingProcess>(config.InitialMid, 50.0, 5.0, 1.0 / (365.0 * 24.0 * 720.0)));
+	}
+
+	TEST(TickAllocations, CounterSeesHeapAllocations)
+	{
+		// Arrange
+		AllocationCounter counter;
+
+		// Act
+		const auto memory = std::make_unique<double[]>(16);
+
+		// Assert
+		EXPECT_EQ(counter.GetCount(), 1u);
+	}
+
+	TEST(TickAllocations, SteadyStateTickDoesNotAllocate)
+	{
+		// Arrange
+		Bot bot{ MakeMarket(100), 10.0, 2000.0 };
+		ASSERT_TRUE(bot.PlaceInitialOrders(5));
+		for (int i = 0; i < 100; i++)
+			bot.RefreshMarket();
+
+		// Act
+		AllocationCounter counter;
+		for (int i = 0; i < 1000; i++)
+			bot.RefreshMarket();
+
+		// Assert
+		EXPECT_EQ(counter.GetCount(), 0u);
+		EXPECT_GT(bot.GetPendingOrderCount(), 0u);
+	}
+
+	TEST(TickAllocations, ReplayedTickDoesNotAllocate)
+	{
+		// Arrange
+		auto source = std::make_unique<SimulatorSnapshotSource>(MakeMarket(100), 2000);
+		Bot bot{ std::make_unique<ReplaySimulator>(std::move(source)), 10.0, 2000.0 };
+		ASSERT_TRUE(bot.PlaceInitialOrders(5));
+		for (int i = 0; i < 100; i++)
+			bot.RefreshMarket();
+
+		// Act
+		AllocationCounter counter;
+		for (int i = 0; i < 1000; i++)
+			bot.RefreshMarket();
+
+		// Assert
+		EXPECT_EQ(counter.GetCount(), 0u);
+	}
+
+	TEST(TickAllocations, PendingOrdersRecycleTheirNodes)
+	{
+		// Arrange
+		PendingOrders orders;
+		std::vector<BotOrder> filledOrders;
+		filledOrders.reserve(100);
+		const auto placeAndFill = [&orders, &filledOrders](IDvfSimulator::OrderID firstId) {
+			for (IDvfSimulator::OrderID id = firstId; id < firstId + 100; id++)
+				orders.Insert({ OrderSide::BID, id, Price{ 100.0 + static_cast<double>(id - firstId) / 100.0 }, Quantity{ 1.0 } });
+			orders.EraseFilled({ Price{ 50.0 }, Price{ 150.0 } }, filledOrders);
+		};
+		placeAndFill(0);
+
+		// Act
+		AllocationCounter counter;
+		for (IDvfSimulator::OrderID firstId = 100; firstId < 10000; firstId += 100)
+			placeAndFill(firstId);
+
+		// Assert
+		EXPECT_EQ(counter.GetCount(), 0u);
+		EXPECT_TRUE(orders.Empty());
+	}
+}
@@ -0,0 +1,229 @@
+#include "pch.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "../../src/OptimusBot/MarketModelSimulator.h"
+#include "../../src/OptimusBot/SnapshotSources.h"
+#include "../../src/OptimusBot/TickFile.h"
+
+using namespace OptimusBot;
+using namespace OptimusBot::TickFile;
+using namespace std::chrono_literals;
+
+namespace TickFileTests
+{
+	constexpr auto path = "TickFileTests.ticks";
+
+	IClock::TimePoint At(std::chrono::seconds time)
+	{
+		return IClock::TimePoint{ time };
+	}
+
+	std::vector<IDvfSimulator::OrderBook> MakeSnapshots(std::size_t count)
+	{
+		MarketModelConfig config;
+		config.Seed = 5;
+		MarketModelSimulator simulator{ config, std::make_unique<RandomWalkProcess>(1.0, 1.0 / 3.0) };
+
+		// Rounded to the precision of the recording, which is otherwise lossy at the last bits of the generated prices
+		std::vector<IDvfSimulator::OrderBook> snapshots;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			auto orderBook = simulator.GetOrderBook();
+			for (auto& [price, volume] : orderBook)
+				price = std::round(price * 1e6) / 1e6;
+			snapshots.push_back(std::move(orderBook));
+		}
+		return snapshots;
+	}
+
+	// Writes one snapshot per second, 3 snapshots per block
+	void WriteSnapshots(const std::vector<IDvfSimulator::OrderBook>& snapshots)
+	{
+		WriterConfig config;
+		config.SnapshotsPerBlock = 3;
+		TickWriter writer{ path, config };
+		for (std::size_t i = 0; i < snapshots.size(); i++)
+			writer.WriteSnapshot(At(std::chrono::seconds(i)), snapshots[i]);
+	}
+
+	std::vector<IDvfSimulator::OrderBook> ReadSnapshots(TickReader& reader)
+	{
+		std::vector<IDvfSimulator::OrderBook> snapshots;
+		Event event;
+		while (reader.Next(event))
+			snapshots.push_back(*event.OrderBook);
+		return snapshots;
+	}
+
+	void CorruptByte(std::size_t offset)
+	{
+		std::fstream file{ path, std::ios::binary | std::ios::in | std::ios::out };
+		file.seekg(offset);
+		const auto byte = static_cast<char>(file.get() ^ 0x5A);
+		file.seekp(offset);
+		file.put(byte);
+	}
+
+	TEST(TickFile, RoundTripsSnapshotsAndOrderEvents)
+	{
+		// Arrange
+		const IDvfSimulator::OrderBook first{ {190.25, 1.5}, {189.0, 0.12345678}, {200.5, -2.0} };
+		const IDvfSimulator::OrderBook second{ {190.5, 1.0}, {200.25, -0.5} };
+		const IDvfSimulator::OrderBook third{ {191.0, 3.0}, {189.75, 1.0}, {201.0, -1.0}, {202.0, -1.0} };
+		{
+			WriterConfig config;
+			config.SnapshotsPerBlock = 2;
+			TickWriter writer{ path, config };
+			writer.WriteSnapshot(At(0s), first);
+			writer.WritePlaceOrder(At(1s), 195.5, 0.75, 7);
+			writer.WritePlaceOrder(At(1s), 185.0, -0.5, std::nullopt);
+			writer.WriteSnapshot(At(5s), second);
+			writer.WriteSnapshot(At(10s), third);
+			writer.WriteFill(At(10s), Types::BotOrder{ Types::OrderSide::ASK, 8, Types::Price{ 199.5 }, Types::Quantity{ 0.25 } });
+			writer.WriteCancelOrder(At(12s), 7, true);
+		}
+
+		// Act
+		TickReader reader{ path };
+		std::vector<Event> events;
+		std::vector<IDvfSimulator::OrderBook> snapshots;
+		Event event;
+		while (reader.Next(event))
+		{
+			events.push_back(event);
+			if (event.Type == EventType::SNAPSHOT)
+				snapshots.push_back(*event.OrderBook);
+		}
+		const auto blockCount = reader.GetBlockCount();
+		std::remove(path);
+
+		// Assert
+		ASSERT_EQ(events.size(), 7u);
+		EXPECT_EQ(blockCount, 2u);
+		EXPECT_EQ(snapshots, (std::vector<IDvfSimulator::OrderBook>{ first, second, third }));
+
+		EXPECT_EQ(events[1].Type, EventType::PLACE_ORDER);
+		EXPECT_EQ(events[1].Time, At(1s));
+		EXPECT_EQ(events[1].Price, 195.5);
+		EXPECT_EQ(events[1].Amount, 0.75);
+		EXPECT_EQ(events[1].OrderId, 7u);
+		EXPECT_FALSE(events[2].OrderId);
+		EXPECT_EQ(events[2].Amount, -0.5);
+
+		EXPECT_EQ(events[5].Type, EventType::FILL);
+		EXPECT_EQ(events[5].OrderId, 8u);
+		EXPECT_EQ(events[5].Price, 199.5);
+		EXPECT_EQ(events[5].Amount, -0.25);
+
+		EXPECT_EQ(events[6].Type, EventType::CANCEL_ORDER);
+		EXPECT_EQ(events[6].Time, At(12s));
+		EXPECT_EQ(events[6].OrderId, 7u);
+		EXPECT_TRUE(events[6].Success);
+	}
+
+	TEST(TickFile, SeeksToTheFirstEventAtOrAfterTheGivenTime)
+	{
+		// Arrange
+		const auto snapshots = MakeSnapshots(20);
+		WriteSnapshots(snapshots);
+		TickReader reader{ path };
+		Event event;
+
+		// Act & Assert
+		reader.Seek(At(10s));
+		ASSERT_TRUE(reader.Next(event));
+		EXPECT_EQ(event.Time, At(10s));
+		EXPECT_EQ(*event.OrderBook, snapshots[10]);
+		ASSERT_TRUE(reader.Next(event));
+		EXPECT_EQ(*event.OrderBook, snapshots[11]);
+
+		reader.Seek(At(0s));
+		EXPECT_EQ(ReadSnapshots(reader).size(), 20u);
+
+		reader.Seek(At(100s));
+		EXPECT_FALSE(reader.Next(event));
+
+		EXPECT_EQ(reader.GetTimeRange().value(), std::make_pair(At(0s), At(19s)));
+		std::remove(path);
+	}
+
+	TEST(TickFile, StopsReadingAtACorruptedBlock)
+	{
+		// Arrange (the file header is 8 bytes long, block headers 32 bytes long starting with the payload size after a 4 bytes magic)
+		const auto snapshots = MakeSnapshots(9);
+		WriteSnapshots(snapshots);
+		std::uint8_t payloadSize[4];
+		std::ifstream{ path, std::ios::binary }.seekg(8 + 4).read(reinterpret_cast<char*>(payloadSize), sizeof(payloadSize));
+		const auto secondBlockOffset = 8 + 32 + (payloadSize[0] | payloadSize[1] << 8 | payloadSize[2] << 16 | payloadSize[3] << 24);
+		CorruptByte(secondBlockOffset + 32 + 5);
+
+		// Act
+		TickReader reader{ path };
+		const auto readSnapshots = ReadSnapshots(reader);
+		std::remove(path);
+
+		// Assert
+		EXPECT_EQ(reader.GetBlockCount(), 3u);
+		EXPECT_EQ(readSnapshots, std::vector<IDvfSimulator::OrderBook>(snapshots.begin(), snapshots.begin() + 3));
+	}
+
+	TEST(TickFile, IgnoresATruncatedLastBlock)
+	{
+		// Arrange
+		const auto snapshots = MakeSnapshots(8);
+		WriteSnapshots(snapshots);
+		std::string content;
+		{
+			std::ifstream file{ path, std::ios::binary };
+			content.assign(std::istreambuf_iterator<char>{ file }, {});
+		}
+		std::ofstream{ path, std::ios::binary | std::ios::trunc }.write(content.data(), content.size() - 1);
+
+		// Act
+		TickReader reader{ path };
+		const auto readSnapshots = ReadSnapshots(reader);
+		std::remove(path);
+
+		// Assert
+		EXPECT_EQ(readSnapshots, std::vector<IDvfSimulator::OrderBook>(snapshots.begin(), snapshots.begin() + 6));
+	}
+
+	TEST(TickFile, IsMuchSmallerThanTextSnapshots)
+	{
+		// Arrange
+		const auto snapshots = MakeSnapshots(1000);
+		std::ostringstream text;
+		for (const auto& snapshot : snapshots)
+			TextSnapshotSource::Write(text, snapshot);
+
+		// Act
+		{
+			TickWriter writer{ path };
+			for (std::size_t i = 0; i < snapshots.size(); i++)
+				writer.WriteSnapshot(At(std::chrono::seconds(5 * i)), snapshots[i]);
+		}
+		const auto binarySize = static_cast<std::size_t>(std::ifstream{ path, std::ios::binary | std::ios::ate }.tellg());
+		std::remove(path);
+
+		// Assert (the generated volumes being redrawn at every tick, this is the worst case of the encoding)
+		EXPECT_LT(binarySize * 2, text.str().size());
+	}
+
+	TEST(TickFile, InvalidFileIsAnEmptyRecording)
+	{
+		// Arrange
+		std::ofstream{ path } << "190.5 1.0 200.5 -1.0\n";
+
+		// Act
+		TickReader reader{ path };
+		Event event;
+		const auto hasEvent = reader.Next(event);
+		std::remove(path);
+
+		// Assert
+		EXPECT_FALSE(reader.IsValid());
+		EXPECT_FALSE(hasEvent);
+	}
+}
@@ -1,4 +1,7 @@
 #include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
 #include "../../src/OptimusBot/Utilities.h"
 
 using namespace OptimusBot::Utilities;
@@ -19,11 +22,29 @@ namespace UtilitiesTests
 			}
 	}
 
+	TEST(Random, ReturnsTenthsWithinRangeOfLargeValues)
+	{
+		// Arrange
+		const auto min = 3e9;
+		const auto max = min + 10.0;
+
+		for (int i = 0; i < 1000; i++)
+		{
+			// Act
+			const auto value = Random(min, max);
+
+			// Assert
+			EXPECT_GE(value, min);
+			EXPECT_LE(value, max);
+			EXPECT_DOUBLE_EQ(value * 10.0, std::round(value * 10.0));
+		}
+	}
+
 	TEST(PlacePrudentOrders, ReturnsEmptyIfNumberOfOrdersSmallerThanOne)
 	{
 		// Arrange
 		const Wallet wallet(1.0, 10.0);
-		const BestOrder bestOrder(50.0, 51.0);
+		const BestOrder bestOrder(Price{ 50.0 }, Price{ 51.0 });
 		const auto dummyLambda = [](double, double) {return std::optional<IDvfSimulator::OrderID>{}; };
 
 		// Act & Assert
@@ -34,7 +55,7 @@ namespace UtilitiesTests
 	{
 		// Arrange
 		const Wallet wallet(1.0, 10.0);
-		const BestOrder bestOrder(50.0, 51.0);
+		const BestOrder bestOrder(Price{ 50.0 }, Price{ 51.0 });
 		const auto lambdaReturningEmpty = [](double, double) {return std::optional<IDvfSimulator::OrderID>{}; };
 
 		// Act & Assert
@@ -45,7 +66,7 @@ namespace UtilitiesTests
 	{
 		// Arrange
 		const Wallet wallet(1.0, 10.0);
-		const BestOrder bestOrder(50.0, 51.0);
+		const BestOrder bestOrder(Price{ 50.0 }, Price{ 51.0 });
 		constexpr auto numberOfOrders{ 5 };
 		auto counter{ 0 };
 		const auto placeOrderMock = [&counter](double, double) {counter++;  return std::optional<IDvfSimulator::OrderID>{}; };
@@ -61,7 +82,7 @@ namespace UtilitiesTests
 	{
 		// Arrange
 		const Wallet wallet(1.0, 10.0);
-		const BestOrder bestOrder(50.0, 51.0);
+		const BestOrder bestOrder(Price{ 50.0 }, Price{ 51.0 });
 		const auto placeOrderMock = [](double, double) {return std::optional<IDvfSimulator::OrderID>{rand()}; };
 
 		// Act & Assert
@@ -74,7 +95,7 @@ namespace UtilitiesTests
 		const Wallet wallet(1.0, 10.0);
 		constexpr auto bestBid = 50;
 		constexpr auto bestAsk = 51;
-		const BestOrder bestOrder(bestBid, bestAsk);
+		const BestOrder bestOrder(Price{ bestBid }, Price{ bestAsk });
 		const auto placeOrderMock = [](double, double) {return std::optional<IDvfSimulator::OrderID>{rand()}; };
 
 		// Act
@@ -84,12 +105,103 @@ namespace UtilitiesTests
 		for (const auto& order : orders)
 		{
 			if (order.Side == OrderSide::BID)
-				EXPECT_TRUE(0.95 * bestBid <= order.Price && order.Price <= bestBid);
+				EXPECT_TRUE(Price{ 0.95 * bestBid } <= order.Price && order.Price <= Price{ bestBid });
+			else
+				EXPECT_TRUE(Price{ bestAsk } <= order.Price && order.Price <= Price{ 1.05 * bestAsk });
+		}
+	}
+
+	TEST(PlacePrudentOrders, SeededOrdersAreReproducibleAndWithinTheStrategyBands)
+	{
+		// Arrange
+		const Wallet wallet(100.0, 10.0);
+		const BestOrder bestOrder(Price{ 200.0 }, Price{ 210.0 });
+		StrategyParameters parameters;
+		parameters.BidBand = 0.9;
+		parameters.AskBand = 1.2;
+		parameters.Sizing = 0.5;
+		const auto placeOrderMock = [](double, double) {return std::optional<IDvfSimulator::OrderID>{1}; };
+		OptimusBot::FastRandom random1{ 42 };
+		OptimusBot::FastRandom random2{ 42 };
+
+		// Act
+		const auto orders1 = PlacePrudentOrders(wallet, bestOrder, 5, parameters, random1, placeOrderMock);
+		const auto orders2 = PlacePrudentOrders(wallet, bestOrder, 5, parameters, random2, placeOrderMock);
+
+		// Assert
+		ASSERT_EQ(orders1.size(), 10);
+		ASSERT_EQ(orders2.size(), 10);
+		for (std::size_t i = 0; i < orders1.size(); i++)
+		{
+			EXPECT_EQ(orders1[i].Price, orders2[i].Price);
+			EXPECT_EQ(orders1[i].Volume, orders2[i].Volume);
+
+			// At most half the ETH hold over the 5 orders of each side
+			EXPECT_LE(orders1[i].Volume, Quantity{ 10.0 });
+			if (orders1[i].Side == OrderSide::BID)
+				EXPECT_TRUE(Price{ 0.9 * 200.0 } <= orders1[i].Price && orders1[i].Price <= Price{ 200.0 });
 			else
-				EXPECT_TRUE(bestAsk <= order.Price && order.Price <= 1.05*bestAsk);
+				EXPECT_TRUE(Price{ 210.0 } <= orders1[i].Price && orders1[i].Price <= Price{ 1.2 * 210.0 });
 		}
 	}
 
+	// Simulator counting the calls made to its single and batched order placement methods
+	class CountingSimulator : public IDvfSimulator
+	{
+	public:
+		int PlaceOrderCalls{ 0 };
+
+		OrderBook GetOrderBook() noexcept override { return {}; }
+		std::optional<OrderID> PlaceOrder(double, double) noexcept override { return ++PlaceOrderCalls; }
+		bool CancelOrder(OrderID) noexcept override { return false; }
+	};
+
+	class CountingBatchSimulator : public CountingSimulator, public OptimusBot::IBatchOrderPlacer
+	{
+	public:
+		int PlaceOrdersCalls{ 0 };
+
+		void PlaceOrders(const OrderRequest*, std::size_t count, std::optional<OrderID>* orderIds) noexcept override
+		{
+			PlaceOrdersCalls++;
+			for (std::size_t i = 0; i < count; i++)
+				orderIds[i] = i % 2 ? std::optional<OrderID>{} : std::optional<OrderID>{ static_cast<OrderID>(i) };
+		}
+	};
+
+	TEST(PlacePrudentOrders, PlacesOrdersOneByOneIfSimulatorDoesNotSupportBatches)
+	{
+		// Arrange
+		const Wallet wallet(1.0, 10.0);
+		const BestOrder bestOrder(Price{ 50.0 }, Price{ 51.0 });
+		CountingSimulator simulator;
+
+		// Act
+		const auto orders = PlacePrudentOrders(wallet, bestOrder, 5, static_cast<IDvfSimulator&>(simulator));
+
+		// Assert
+		EXPECT_EQ(simulator.PlaceOrderCalls, 10);
+		EXPECT_EQ(orders.size(), 10);
+	}
+
+	TEST(PlacePrudentOrders, PlacesAllOrdersInASingleBatchIfSimulatorSupportsIt)
+	{
+		// Arrange
+		const Wallet wallet(1.0, 10.0);
+		const BestOrder bestOrder(Price{ 50.0 }, Price{ 51.0 });
+		CountingBatchSimulator simulator;
+
+		// Act
+		const auto orders = PlacePrudentOrders(wallet, bestOrder, 5, static_cast<IDvfSimulator&>(simulator));
+
+		// Assert: only the bids got an id from the batch
+		EXPECT_EQ(simulator.PlaceOrdersCalls, 1);
+		EXPECT_EQ(simulator.PlaceOrderCalls, 0);
+		ASSERT_EQ(orders.size(), 5);
+		for (const auto& order : orders)
+			EXPECT_EQ(order.Side, OrderSide::BID);
+	}
+
 	TEST(ExtractBestOrder, GetsTheBestBidAskPairFromSortedOrderBook)
 	{
 		// Arrange 
@@ -100,8 +212,8 @@ namespace UtilitiesTests
 
 		// Assert
 		ASSERT_TRUE(result);
-		EXPECT_EQ(3.0, result.value().Bid);
-		EXPECT_EQ(4.0, result.value().Ask);
+		EXPECT_EQ(Price{ 3.0 }, result.value().Bid);
+		EXPECT_EQ(Price{ 4.0 }, result.value().Ask);
 	}
 
 	TEST(ExtractBestOrder, GetsTheBestBidAskPairFromUnsortedOrderBook)
@@ -114,17 +226,96 @@ namespace UtilitiesTests
 
 		// Assert
 		ASSERT_TRUE(result);
-		EXPECT_EQ(3.0, result.value().Bid);
-		EXPECT_EQ(4.0, result.value().Ask);
+		EXPECT_EQ(Price{ 3.0 }, result.value().Bid);
+		EXPECT_EQ(Price{ 4.0 }, result.value().Ask);
+	}
+
+	TEST(ExtractBestOrder, ReturnsEmptyForEmptyOrderBook)
+	{
+		// Arrange
+		const IDvfSimulator::OrderBook orderBook;
+
+		// Act & Assert
+		EXPECT_FALSE(ExtractBestOrder(orderBook));
+	}
+
+	TEST(ExtractBestOrder, ReturnsEmptyIfOneSideIsMissing)
+	{
+		// Arrange
+		const IDvfSimulator::OrderBook bidsOnly{ {1.0, 1.0}, {2.0, 1.0}, {3.0, 1.0} };
+		const IDvfSimulator::OrderBook asksOnly{ {4.0, -1.0}, {5.0, -1.0}, {6.0, -1.0} };
+
+		// Act & Assert
+		EXPECT_FALSE(ExtractBestOrder(bidsOnly));
+		EXPECT_FALSE(ExtractBestOrder(asksOnly));
+	}
+
+	TEST(ExtractBestOrder, MatchesSortBasedImplementationOnRandomOrderBooks)
+	{
+		// Former implementation, sorting a copy of the book and looking for the bid/ask boundary
+		const auto sortBasedExtractBestOrder = [](IDvfSimulator::OrderBook orderBook) -> std::optional<BestOrder> {
+			std::sort(orderBook.begin(), orderBook.end());
+			for (std::size_t i = 0; i + 1 < orderBook.size(); i++)
+				if (orderBook[i].second > 0 && orderBook[i + 1].second < 0)
+					return BestOrder{ Price{ orderBook[i].first }, Price{ orderBook[i + 1].first } };
+			return {};
+		};
+
+		// Using the "property-based testing" approach again, on uncrossed books of various sizes
+		for (int iteration = 0; iteration < 500; iteration++)
+		{
+			// Arrange
+			IDvfSimulator::OrderBook orderBook;
+			const auto levels = 1 + rand() % 300;
+			const auto mid = 100.0 + rand() % 1000;
+			for (int i = 0; i < levels; i++)
+			{
+				orderBook.push_back({ mid - 1.0 - Random(0, 50), 0.25 * (1 + rand() % 10) });
+				orderBook.push_back({ mid + 1.0 + Random(0, 50), -0.25 * (1 + rand() % 10) });
+			}
+			std::shuffle(orderBook.begin(), orderBook.end(), std::mt19937{ static_cast<unsigned>(iteration) });
+
+			// Act
+			const auto result = ExtractBestOrder(orderBook);
+			const auto expected = sortBasedExtractBestOrder(orderBook);
+
+			// Assert
+			ASSERT_TRUE(result);
+			ASSERT_TRUE(expected);
+			EXPECT_EQ(expected.value().Bid, result.value().Bid);
+			EXPECT_EQ(expected.value().Ask, result.value().Ask);
+		}
+	}
+
+	TEST(ExtractBestOrders, ExtractsTheBestBidAskPairOfEachOrderBook)
+	{
+		// Arrange
+		const std::vector<IDvfSimulator::OrderBook> orderBooks{
+			{ {2.0, 1.0}, {3.0, 1.0}, {1.0, 1.0}, {5.0, -1.0}, {6.0, -1.0}, {4.0, -1.0} },
+			{},
+			{ {10.0, 1.0}, {11.0, -1.0} } };
+		std::vector<std::optional<BestOrder>> results(orderBooks.size());
+
+		// Act
+		ExtractBestOrders(orderBooks.data(), orderBooks.size(), results.data());
+
+		// Assert
+		ASSERT_TRUE(results[0]);
+		EXPECT_EQ(Price{ 3.0 }, results[0].value().Bid);
+		EXPECT_EQ(Price{ 4.0 }, results[0].value().Ask);
+		EXPECT_FALSE(results[1]);
+		ASSERT_TRUE(results[2]);
+		EXPECT_EQ(Price{ 10.0 }, results[2].value().Bid);
+		EXPECT_EQ(Price{ 11.0 }, results[2].value().Ask);
 	}
 
 	TEST(EraseFilledOrders, ErasesOrdersWithBidPriceGreaterThanTheBestBid)
 	{
 		// Arrange
-		const BotOrder bid { OrderSide::BID, {}, 10.0, {} };
-		const BotOrder ask { OrderSide::ASK, {}, 14.0, {} };
+		const BotOrder bid { OrderSide::BID, {}, Price{ 10.0 }, {} };
+		const BotOrder ask { OrderSide::ASK, {}, Price{ 14.0 }, {} };
 		std::multiset<BotOrder> orders{ bid, ask, bid, ask  };
-		const BestOrder bestOrder{ 9.0, 12.0 };
+		const BestOrder bestOrder{ Price{ 9.0 }, Price{ 12.0 } };
 
 		// Act
 		const auto result = EraseFilledOrders(orders, bestOrder);
@@ -146,10 +337,10 @@ namespace UtilitiesTests
 	TEST(EraseFilledOrders, ErasesOrdersWithAskPriceSmallerThanTheBestAsk)
 	{
 		// Arrange
-		const BotOrder bid{ OrderSide::BID, {}, 10.0, {} };
-		const BotOrder ask{ OrderSide::ASK, {}, 14.0, {} };
+		const BotOrder bid{ OrderSide::BID, {}, Price{ 10.0 }, {} };
+		const BotOrder ask{ OrderSide::ASK, {}, Price{ 14.0 }, {} };
 		std::multiset<BotOrder> orders{ bid, ask, bid, ask };
-		const BestOrder bestOrder{ 11.0, 15.0 };
+		const BestOrder bestOrder{ Price{ 11.0 }, Price{ 15.0 } };
 
 		// Act
 		const auto result = EraseFilledOrders(orders, bestOrder);
@@ -168,32 +359,50 @@ namespace UtilitiesTests
 		ASSERT_EQ(orders.begin()->Volume, bid.Volume);
 	}
 
+	TEST(EraseFilledOrders, KeepsUnfilledOrdersSharingThePriceOfAFilledOrder)
+	{
+		// Arrange
+		const BotOrder bid{ OrderSide::BID, 1, Price{ 10.0 }, {} };
+		const BotOrder ask{ OrderSide::ASK, 2, Price{ 10.0 }, {} };
+		std::multiset<BotOrder> orders{ bid, ask };
+		const BestOrder bestOrder{ Price{ 9.0 }, Price{ 8.0 } };
+
+		// Act
+		const auto result = EraseFilledOrders(orders, bestOrder);
+
+		// Assert
+		ASSERT_EQ(result.size(), 1);
+		ASSERT_EQ(result.begin()->OrderId, bid.OrderId);
+		ASSERT_EQ(orders.size(), 1);
+		ASSERT_EQ(orders.begin()->OrderId, ask.OrderId);
+	}
+
 	TEST(UpdateWallet, AddsEthAndRemovesUsdForBidFilledOrders)
 	{
 		// Arrange
-		const BotOrder bid{ OrderSide::BID, {}, 10.0, 1.2 };
+		const BotOrder bid{ OrderSide::BID, {}, Price{ 10.0 }, Quantity{ 1.2 } };
 		Wallet wallet{ 1.0, 15.0 };
 
 		// Act
 		UpdateWallet(wallet, { bid });
 
 		// Assert
-		ASSERT_DOUBLE_EQ(wallet.ETH, 2.2);
-		ASSERT_DOUBLE_EQ(wallet.USD, 3);
+		ASSERT_EQ(wallet.ETH, Quantity{ 2.2 });
+		ASSERT_EQ(wallet.USD, Notional{ 3.0 });
 	}
 
 	TEST(UpdateWallet, RemovessEthAndAsssUsdForAskFilledOrders)
 	{
 		// Arrange
-		const BotOrder ask{ OrderSide::ASK, {}, 10.0, 1.2 };
+		const BotOrder ask{ OrderSide::ASK, {}, Price{ 10.0 }, Quantity{ 1.2 } };
 		Wallet wallet{ 1.5, 15.0 };
 
 		// Act
 		UpdateWallet(wallet, { ask });
 
 		// Assert
-		ASSERT_DOUBLE_EQ(wallet.ETH, 0.3);
-		ASSERT_DOUBLE_EQ(wallet.USD, 27.0);
+		ASSERT_EQ(wallet.ETH, Quantity{ 0.3 });
+		ASSERT_EQ(wallet.USD, Notional{ 27.0 });
 	}
 }
 